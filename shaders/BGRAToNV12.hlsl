@@ -0,0 +1,81 @@
+// BGRA to NV12 Conversion Compute Shader
+// NV12格式：Y平面（每像素1字节）+ 交错的UV平面（每个2x2块一对UV，UVUV...），
+// 两个平面使用相同的行步长，UV平面紧随Y平面（与NV12ToRGBA.hlsl的输入布局相同）
+
+// 输入BGRA纹理
+Texture2D<float4> InputTexture : register(t0);
+
+// 输出NV12数据缓冲区 - 使用ByteAddressBuffer配合RAW缓冲区
+RWByteAddressBuffer OutputBuffer : register(u0);
+
+// 常量缓冲区
+cbuffer NV12OutputParams : register(b0)
+{
+    uint ImageWidth;     // 图像宽度
+    uint ImageHeight;    // 图像高度
+    uint OutputStride;   // 两个平面共用的行步长（字节，4的倍数）
+    uint UVPlaneOffset;  // UV平面相对缓冲区起始的字节偏移
+};
+
+// BT.601 RGB到YUV转换（限制范围），与BGRAToYUY2.hlsl相同
+float3 RGBToYUV(float3 rgb)
+{
+    // 确保输入RGB在[0,1]范围内
+    rgb = saturate(rgb);
+
+    float Y = 0.299f * rgb.r + 0.587f * rgb.g + 0.114f * rgb.b;
+    float U = -0.14713f * rgb.r - 0.28886f * rgb.g + 0.436f * rgb.b;
+    float V = 0.615f * rgb.r - 0.51499f * rgb.g - 0.10001f * rgb.b;
+
+    // 转换到8位范围：Y:[16,235], UV:[16,240]
+    Y = Y * 219.0f + 16.0f;
+    U = (U + 0.5f) * 224.0f + 16.0f;
+    V = (V + 0.5f) * 224.0f + 16.0f;
+
+    return float3(clamp(Y, 16.0f, 235.0f), clamp(U, 16.0f, 240.0f), clamp(V, 16.0f, 240.0f));
+}
+
+// 超出图像的位置取最后一列/行（奇数宽度/高度时2x2块复制边缘像素）
+float3 LoadYUV(int2 pos)
+{
+    pos = min(pos, int2(ImageWidth - 1, ImageHeight - 1));
+    return RGBToYUV(InputTexture.Load(int3(pos, 0)).rgb);
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 id : SV_DispatchThreadID)
+{
+    // 每个线程处理4x2像素（两个2x2块）：两行各写一个32位的Y字，UV平面写一个32位字
+    uint2 pixelPos = uint2(id.x * 4, id.y * 2);
+    if (pixelPos.x >= ImageWidth || pixelPos.y >= ImageHeight)
+        return;
+
+    uint yWord0 = 0;
+    uint yWord1 = 0;
+    uint uvWord = 0;
+    [unroll]
+    for (uint block = 0; block < 2; block++)
+    {
+        int2 pos = int2(pixelPos) + int2(block * 2, 0);
+        float3 yuv00 = LoadYUV(pos);
+        float3 yuv01 = LoadYUV(pos + int2(1, 0));
+        float3 yuv10 = LoadYUV(pos + int2(0, 1));
+        float3 yuv11 = LoadYUV(pos + int2(1, 1));
+
+        uint shift = block * 16;
+        yWord0 |= ((uint)round(yuv00.x) | ((uint)round(yuv01.x) << 8)) << shift;
+        yWord1 |= ((uint)round(yuv10.x) | ((uint)round(yuv11.x) << 8)) << shift;
+
+        // 色度取2x2块四个像素的平均值（与CPU的BGRAToNV12RowPair_Float相同的求和顺序）
+        float2 uv = (yuv00.yz + yuv01.yz + yuv10.yz + yuv11.yz) * 0.25f;
+        uvWord |= ((uint)round(uv.x) | ((uint)round(uv.y) << 8)) << shift;
+    }
+
+    // 宽度不是4的倍数时最后一个字的多余字节落在行填充中（行步长至少为宽度向上取整到4）
+    OutputBuffer.Store(pixelPos.y * OutputStride + pixelPos.x, yWord0);
+    if (pixelPos.y + 1 < ImageHeight)
+    {
+        OutputBuffer.Store((pixelPos.y + 1) * OutputStride + pixelPos.x, yWord1);
+    }
+    OutputBuffer.Store(UVPlaneOffset + (pixelPos.y / 2) * OutputStride + pixelPos.x, uvWord);
+}
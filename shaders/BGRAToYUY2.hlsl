@@ -14,8 +14,54 @@ cbuffer ConversionParams : register(b0)
     uint ImageHeight;    // 图像高度
     uint OutputStride;   // 输出行步长（字节）
     uint Padding;        // 对齐填充
+    uint RegionLeft;     // 本次调度转换的区域（RegionLeft为偶数），整帧转换时为整个图像
+    uint RegionTop;
+    uint RegionRight;
+    uint RegionBottom;
+    uint MoveSourceLeft; // CSMove：目标区域左上角对应的源位置（MoveSourceLeft为偶数）
+    uint MoveSourceTop;
+    int SourceOriginX;   // 输出像素(x, y)在输入纹理中的位置为SourceOrigin + x * XStep + y * YStep：
+    int SourceOriginY;   // 裁剪转换时原点为裁剪区域的左上角，旋转/翻转时步长为0或±1，其余情况为恒等映射
+    int XStepX;
+    int XStepY;
+    int YStepX;
+    int YStepY;
+    int CursorLeft;      // 鼠标指针左上角在输入纹理中的位置
+    int CursorTop;
+    uint CursorWidth;
+    uint CursorHeight;
+    uint CursorMode;     // 0：不合成，1：按alpha混合，2：dst = (dst & 掩码) ^ 颜色
+    uint3 CursorPadding;
 };
 
+// CSMove的源数据：移动前输出缓冲区源行的副本（与输出缓冲区布局相同），
+// 避免源和目标区域重叠时读到已经写入的数据
+ByteAddressBuffer MoveSource : register(t1);
+
+// 归一化的鼠标指针（CursorOverlay.h），每像素两个32位值：颜色0xAARRGGBB、掩码0x00RRGGBB
+ByteAddressBuffer CursorPixels : register(t2);
+
+// 在输入纹理sourcePos处的像素上合成指针（与CPU的CompositeCursorRow相同的规则）
+float3 CompositeCursor(float3 rgb, int2 sourcePos)
+{
+    int2 cursorPos = sourcePos - int2(CursorLeft, CursorTop);
+    if (CursorMode == 0 || cursorPos.x < 0 || cursorPos.y < 0 ||
+        cursorPos.x >= (int)CursorWidth || cursorPos.y >= (int)CursorHeight)
+        return rgb;
+
+    uint2 pixel = CursorPixels.Load2(((uint)cursorPos.y * CursorWidth + (uint)cursorPos.x) * 8);
+    uint3 color = uint3((pixel.x >> 16) & 0xFF, (pixel.x >> 8) & 0xFF, pixel.x & 0xFF);
+    if (CursorMode == 1)
+    {
+        float alpha = (float)(pixel.x >> 24) / 255.0f;
+        return lerp(rgb, (float3)color / 255.0f, alpha);
+    }
+
+    uint3 mask = uint3((pixel.y >> 16) & 0xFF, (pixel.y >> 8) & 0xFF, pixel.y & 0xFF);
+    uint3 value = (uint3)round(saturate(rgb) * 255.0f);
+    return (float3)((value & mask) ^ color) / 255.0f;
+}
+
 // BT.601颜色转换系数（标准RGB到YUV转换）
 // 颜色空间转换函数
 float3 RGBToYUV(float3 rgb)
@@ -50,27 +96,34 @@ uint PackYUY2(uint y0, uint u, uint y1, uint v)
 [numthreads(16, 16, 1)]
 void CSMain(uint3 id : SV_DispatchThreadID)
 {
-    // 每个线程处理2个水平相邻的像素
-    uint2 pixelPos = uint2(id.x * 2, id.y);
+    // 每个线程处理2个水平相邻的像素，线程坐标相对于转换区域的左上角
+    uint2 pixelPos = uint2(RegionLeft + id.x * 2, RegionTop + id.y);
     
-    // 边界检查 - 确保不超出图像范围
-    if (pixelPos.x >= ImageWidth || pixelPos.y >= ImageHeight)
+    // 边界检查 - 确保不超出转换区域和图像范围
+    if (pixelPos.x >= RegionRight || pixelPos.y >= RegionBottom ||
+        pixelPos.x >= ImageWidth || pixelPos.y >= ImageHeight)
         return;
     
-    // 读取两个相邻的BGRA像素
-    float4 pixel0 = InputTexture.Load(uint3(pixelPos.x, pixelPos.y, 0));
+    // 读取两个相邻的输出像素对应的BGRA像素（ImageWidth/ImageHeight为输出尺寸，
+    // 裁剪转换时像素对从裁剪区域的左边缘开始配对，SourceOriginX可以是奇数；
+    // 旋转90/270度时一个像素对来自输入纹理中同一列的相邻两行）
+    int2 xStep = int2(XStepX, XStepY);
+    int2 sourcePos = int2(SourceOriginX, SourceOriginY) + (int)pixelPos.x * xStep + (int)pixelPos.y * int2(YStepX, YStepY);
+    float4 pixel0 = InputTexture.Load(int3(sourcePos, 0));
     float4 pixel1 = pixel0; // 默认复制第一个像素
     
     // 处理奇数宽度情况
     if ((pixelPos.x + 1) < ImageWidth)
     {
-        pixel1 = InputTexture.Load(uint3(pixelPos.x + 1, pixelPos.y, 0));
+        pixel1 = InputTexture.Load(int3(sourcePos + xStep, 0));
     }
     
     // BGRA纹理格式处理
-    // 对于DXGI_FORMAT_B8G8R8A8_UNORM，需要交换B和R通道
-    float3 rgb0 = float3(pixel0.b, pixel0.g, pixel0.r);  // BGRA -> RGB
-    float3 rgb1 = float3(pixel1.b, pixel1.g, pixel1.r);  // BGRA -> RGB
+    // 对于DXGI_FORMAT_B8G8R8A8_UNORM，采样器已按分量语义返回(r,g,b,a)，
+    // 无需手动交换B和R通道（与CPU实现ColorConversionMath.h保持一致）
+    // 指针在转换时直接合成到这两个像素上（位置在输入纹理坐标中判断，随裁剪和旋转一起变换）
+    float3 rgb0 = CompositeCursor(pixel0.rgb, sourcePos);
+    float3 rgb1 = (pixelPos.x + 1) < ImageWidth ? CompositeCursor(pixel1.rgb, sourcePos + xStep) : rgb0;
     
     // 移除调试代码，使用真实的输入数据
     
@@ -93,14 +146,23 @@ void CSMain(uint3 id : SV_DispatchThreadID)
     // 打包成YUY2格式：[Y0 U0 Y1 V0]
     uint packedYUY2 = PackYUY2(y0, u, y1, v);
     
-    // 计算输出缓冲区字节偏移
-    uint outputIndex = (pixelPos.y * ((ImageWidth + 1) / 2)) + (id.x);
-    uint byteOffset = outputIndex * 4; // 每个YUY2像素对占4字节
+    // 计算输出缓冲区字节偏移，按OutputStride寻址以支持带行填充的输出
+    // （每个YUY2像素对占4字节，OutputStride必须是4的倍数）
+    uint byteOffset = pixelPos.y * OutputStride + (pixelPos.x / 2) * 4;
     
-    // 确保索引在有效范围内
-    uint maxIndex = ((ImageWidth + 1) / 2) * ImageHeight;
-    if (outputIndex < maxIndex) {
-        // 使用ByteAddressBuffer的Store方法写入YUV转换后的数据
-        OutputBuffer.Store(byteOffset, packedYUY2);
-    }
-}
\ No newline at end of file
+    // 使用ByteAddressBuffer的Store方法写入YUV转换后的数据
+    OutputBuffer.Store(byteOffset, packedYUY2);
+}
+
+// 在已转换的YUY2输出上移动区域（滚动、拖动窗口），每个线程复制一个像素对
+[numthreads(16, 16, 1)]
+void CSMove(uint3 id : SV_DispatchThreadID)
+{
+    uint2 pixelPos = uint2(RegionLeft + id.x * 2, RegionTop + id.y);
+    if (pixelPos.x >= RegionRight || pixelPos.y >= RegionBottom)
+        return;
+
+    uint2 sourcePos = uint2(MoveSourceLeft + id.x * 2, MoveSourceTop + id.y);
+    uint packedYUY2 = MoveSource.Load(sourcePos.y * OutputStride + (sourcePos.x / 2) * 4);
+    OutputBuffer.Store(pixelPos.y * OutputStride + (pixelPos.x / 2) * 4, packedYUY2);
+}
@@ -14,6 +14,14 @@ cbuffer NV12ConversionParams : register(b0)
     uint ImageHeight;    // 图像高度
     uint YPlaneStride;   // Y平面行步长
     uint UVPlaneStride;  // UV平面行步长
+    uint UVPlaneOffset;  // UV平面相对缓冲区起始的字节偏移
+    int OutputOriginX;   // 源像素(x, y)写到OutputOrigin + x * ColumnStep + y * RowStep（旋转/翻转）
+    int OutputOriginY;
+    int ColumnStepX;
+    int ColumnStepY;
+    int RowStepX;
+    int RowStepY;
+    uint Padding;        // 对齐填充
 };
 
 // BT.601 YUV到RGB转换矩阵
@@ -41,6 +49,14 @@ float3 YUVToRGB(float y, float u, float v)
     return rgb;
 }
 
+// ByteAddressBuffer.Load要求地址4字节对齐且返回整个32位字，
+// 读取单个字节时需要按对齐地址读取后移位取出
+uint LoadByte(uint byteOffset)
+{
+    uint word = InputBuffer.Load(byteOffset & ~3u);
+    return (word >> ((byteOffset & 3u) * 8u)) & 0xFFu;
+}
+
 [numthreads(16, 16, 1)]
 void CSMain(uint3 id : SV_DispatchThreadID)
 {
@@ -54,18 +70,17 @@ void CSMain(uint3 id : SV_DispatchThreadID)
     uint yOffset = pixelPos.y * YPlaneStride + pixelPos.x;
     
     // 读取Y值
-    uint yValue = InputBuffer.Load(yOffset);
+    uint yValue = LoadByte(yOffset);
     float y = (float)yValue;
     
     // 计算UV平面中的位置（UV是2:1采样）
     uint uvX = (pixelPos.x / 2) * 2;  // 确保是偶数位置
     uint uvY = pixelPos.y / 2;
-    uint uvPlaneOffset = ImageWidth * ImageHeight;  // UV平面在Y平面之后
-    uint uvOffset = uvPlaneOffset + uvY * UVPlaneStride + uvX;
+    uint uvOffset = UVPlaneOffset + uvY * UVPlaneStride + uvX;
     
     // 读取UV值（NV12格式中UV是交错存储的）
-    uint uValue = InputBuffer.Load(uvOffset);
-    uint vValue = InputBuffer.Load(uvOffset + 1);
+    uint uValue = LoadByte(uvOffset);
+    uint vValue = LoadByte(uvOffset + 1);
     
     float u = (float)uValue;
     float v = (float)vValue;
@@ -73,7 +88,9 @@ void CSMain(uint3 id : SV_DispatchThreadID)
     // 转换YUV到RGB
     float3 rgb = YUVToRGB(y, u, v);
     
-    // 输出RGBA（Alpha设为1.0）
+    // 输出RGBA（Alpha设为1.0），旋转/翻转时写到变换后的位置
     float4 rgba = float4(rgb, 1.0f);
-    OutputTexture[pixelPos] = rgba;
+    int2 outputPos = int2(OutputOriginX, OutputOriginY) + (int)pixelPos.x * int2(ColumnStepX, ColumnStepY) +
+                     (int)pixelPos.y * int2(RowStepX, RowStepY);
+    OutputTexture[uint2(outputPos)] = rgba;
 }
@@ -0,0 +1,286 @@
+#include "BGRAScaleKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    const int kColumnShift = kScaleFilterBits - kScaleIntermediateBits;
+    const int kRowShift = kScaleFilterBits + kScaleIntermediateBits;
+
+    // 以输出样本间距为单位的滤波半径
+    double GetFilterRadius(ScaleFilter filter)
+    {
+        switch (filter)
+        {
+        case ScaleFilter::Bilinear: return 1.0;
+        case ScaleFilter::Bicubic:  return 2.0;
+        default:                    return 0.5;
+        }
+    }
+
+    double EvaluateFilter(ScaleFilter filter, double t)
+    {
+        t = std::fabs(t);
+        if (filter == ScaleFilter::Bilinear)
+            return t < 1.0 ? 1.0 - t : 0.0;
+
+        // Catmull-Rom（a = -0.5）
+        const double a = -0.5;
+        if (t < 1.0)
+            return ((a + 2.0) * t - (a + 3.0)) * t * t + 1.0;
+        if (t < 2.0)
+            return ((a * t - 5.0 * a) * t + 8.0 * a) * t - 4.0 * a;
+        return 0.0;
+    }
+}
+
+void ScaleColumnTail_C(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT first, UINT count,
+                       short* dstRow)
+{
+    for (UINT i = first; i < count; i++)
+    {
+        const BYTE* src = srcRow + i;
+        int sum = 1 << (kColumnShift - 1);
+        for (UINT k = 0; k < taps; k++)
+        {
+            sum += weights[k] * src[k * pitch];
+        }
+        dstRow[i] = static_cast<short>((std::min)((std::max)(sum >> kColumnShift, 0), kScaleIntermediateMax));
+    }
+}
+
+void ScaleColumn_C(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT count, short* dstRow)
+{
+    ScaleColumnTail_C(srcRow, pitch, weights, taps, 0, count, dstRow);
+}
+
+void ScaleRowTail_C(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT first, UINT width,
+                    BYTE* dstRow)
+{
+    UINT stride = GetScaleWeightStride(taps);
+    for (UINT x = first; x < width; x++)
+    {
+        const short* src = srcRow + (size_t)starts[x] * 4;
+        const short* w = weights + (size_t)x * stride;
+        for (UINT c = 0; c < 4; c++)
+        {
+            int sum = 1 << (kRowShift - 1);
+            for (UINT k = 0; k < taps; k++)
+            {
+                sum += w[k] * src[k * 4 + c];
+            }
+            dstRow[x * 4 + c] = static_cast<BYTE>((std::min)((std::max)(sum >> kRowShift, 0), 255));
+        }
+    }
+}
+
+void ScaleRow_C(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT width, BYTE* dstRow)
+{
+    ScaleRowTail_C(srcRow, starts, weights, taps, 0, width, dstRow);
+}
+
+void ScaleBoxTail_C(const BYTE* srcRow, size_t pitch, UINT factor, UINT first, UINT width, BYTE* dstRow)
+{
+    UINT round = (factor * factor) / 2;
+    int shift = factor == 4 ? 4 : 2;
+    for (UINT x = first; x < width; x++)
+    {
+        const BYTE* src = srcRow + (size_t)x * factor * 4;
+        for (UINT c = 0; c < 4; c++)
+        {
+            UINT sum = round;
+            for (UINT row = 0; row < factor; row++)
+            {
+                for (UINT k = 0; k < factor; k++)
+                {
+                    sum += src[row * pitch + k * 4 + c];
+                }
+            }
+            dstRow[x * 4 + c] = static_cast<BYTE>(sum >> shift);
+        }
+    }
+}
+
+void ScaleBox2x_C(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow)
+{
+    ScaleBoxTail_C(srcRow, pitch, 2, 0, width, dstRow);
+}
+
+void ScaleBox4x_C(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow)
+{
+    ScaleBoxTail_C(srcRow, pitch, 4, 0, width, dstRow);
+}
+
+HRESULT BuildScaleFilterTable(UINT sourceSize, UINT destinationSize, ScaleFilter filter, ScaleFilterTable& table)
+{
+    if (sourceSize == 0 || destinationSize == 0 || filter == ScaleFilter::Auto)
+        return E_INVALIDARG;
+
+    // 缩小时滤波器按比例展宽（每个输出样本覆盖scale个源样本），放大时保持原宽度
+    double scale = static_cast<double>(sourceSize) / destinationSize;
+    double filterScale = (std::max)(scale, 1.0);
+    double support = GetFilterRadius(filter) * filterScale;
+
+    // 第i个输出样本覆盖的源样本区间[first, last]
+    auto getWindow = [&](UINT i, int& first, int& last)
+    {
+        if (filter == ScaleFilter::Box)
+        {
+            first = static_cast<int>(std::floor(i * scale));
+            last = static_cast<int>(std::ceil((i + 1) * scale)) - 1;
+        }
+        else
+        {
+            double center = (i + 0.5) * scale;
+            first = static_cast<int>(std::floor(center - support));
+            last = static_cast<int>(std::ceil(center + support)) - 1;
+        }
+    };
+
+    // taps取实际最宽的窗口（整数倍Box缩小时正好为缩小倍数，而不是按支撑范围估计的上界）
+    UINT taps = 1;
+    for (UINT i = 0; i < destinationSize; i++)
+    {
+        int first;
+        int last;
+        getWindow(i, first, last);
+        taps = (std::max)(taps, static_cast<UINT>(last - first + 1));
+    }
+    taps = (std::min)(taps, sourceSize);
+    UINT stride = GetScaleWeightStride(taps);
+
+    std::vector<double> folded;
+    try
+    {
+        table.Starts.resize(destinationSize);
+        table.Weights.assign((size_t)destinationSize * stride, 0);
+        folded.resize(taps);
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate scale filter table");
+        table.Taps = 0;
+        return E_OUTOFMEMORY;
+    }
+    table.SourceSize = sourceSize;
+    table.DestinationSize = destinationSize;
+    table.Filter = filter;
+    table.Taps = taps;
+
+    for (UINT i = 0; i < destinationSize; i++)
+    {
+        // 坐标以源像素的左边缘为0，第j个源像素的中心为j + 0.5
+        double center = (i + 0.5) * scale;
+        int first;
+        int last;
+        getWindow(i, first, last);
+
+        int start = (std::min)((std::max)(first, 0), static_cast<int>(sourceSize - taps));
+        std::fill(folded.begin(), folded.end(), 0.0);
+        double sum = 0.0;
+        for (int j = first; j <= last; j++)
+        {
+            double weight;
+            if (filter == ScaleFilter::Box)
+            {
+                // 源像素[j, j + 1)与输出像素覆盖的[i * scale, (i + 1) * scale)的重叠长度
+                weight = (std::min)(j + 1.0, (i + 1) * scale) - (std::max)(static_cast<double>(j), i * scale);
+                weight = (std::max)(weight, 0.0);
+            }
+            else
+            {
+                weight = EvaluateFilter(filter, (j + 0.5 - center) / filterScale);
+            }
+            int index = (std::min)((std::max)(j, 0), static_cast<int>(sourceSize) - 1);
+            folded[index - start] += weight;
+            sum += weight;
+        }
+
+        // 量化为Q14，舍入误差补到绝对值最大的系数上，保证系数之和正好为1 << kScaleFilterBits
+        short* weights = table.Weights.data() + (size_t)i * stride;
+        int total = 0;
+        UINT largest = 0;
+        for (UINT k = 0; k < taps; k++)
+        {
+            double normalized = sum != 0.0 ? folded[k] / sum : (k == 0 ? 1.0 : 0.0);
+            weights[k] = static_cast<short>(std::lround(normalized * (1 << kScaleFilterBits)));
+            total += weights[k];
+            if (std::abs(weights[k]) > std::abs(weights[largest]))
+                largest = k;
+        }
+        weights[largest] = static_cast<short>(weights[largest] + ((1 << kScaleFilterBits) - total));
+        table.Starts[i] = start;
+    }
+
+    return S_OK;
+}
+
+ScaleFilter ResolveScaleFilter(ScaleFilter filter, UINT sourceWidth, UINT sourceHeight,
+                               UINT destinationWidth, UINT destinationHeight)
+{
+    if (filter != ScaleFilter::Auto)
+        return filter;
+
+    bool integerRatio = destinationWidth != 0 && destinationHeight != 0 &&
+                        sourceWidth % destinationWidth == 0 && sourceHeight % destinationHeight == 0;
+    return integerRatio ? ScaleFilter::Box : ScaleFilter::Bicubic;
+}
+
+const char* GetScaleFilterName(ScaleFilter filter)
+{
+    switch (filter)
+    {
+    case ScaleFilter::Auto:     return "Auto";
+    case ScaleFilter::Box:      return "Box";
+    case ScaleFilter::Bilinear: return "Bilinear";
+    case ScaleFilter::Bicubic:  return "Bicubic";
+    }
+    return "Unknown";
+}
+
+ScaleBoxFunc GetScaleBoxKernel(const ScaleKernels& kernels, ScaleFilter filter, UINT sourceWidth, UINT sourceHeight,
+                               UINT destinationWidth, UINT destinationHeight, UINT* factor)
+{
+    UINT ratio = filter == ScaleFilter::Box && destinationWidth != 0 ? sourceWidth / destinationWidth : 0;
+    if (sourceWidth != destinationWidth * ratio || sourceHeight != destinationHeight * ratio)
+        ratio = 0;
+
+    ScaleBoxFunc kernel = ratio == 2 ? kernels.Box2x : ratio == 4 ? kernels.Box4x : nullptr;
+    if (factor)
+        *factor = kernel ? ratio : 0;
+    return kernel;
+}
+
+ScaleKernels GetScaleKernels(SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    ScaleKernels kernels = { ScaleColumn_C, ScaleRow_C, ScaleBox2x_C, ScaleBox4x_C };
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernels.Column = ScaleColumn_AVX2;
+        kernels.Row = ScaleRow_AVX2;
+        kernels.Box2x = ScaleBox2x_AVX2;
+        kernels.Box4x = ScaleBox4x_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernels.Column = ScaleColumn_SSE41;
+        kernels.Row = ScaleRow_SSE41;
+        kernels.Box2x = ScaleBox2x_SSE41;
+        kernels.Box4x = ScaleBox4x_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernels;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+#include <vector>
+
+// BGRA缩放的CPU内核（CpuBGRAToYUY2Converter::ConvertScaled使用）
+// 可分离的多相滤波，逐个输出行处理：先做垂直滤波（读取源图像中相邻的Taps行，按分量加权求和）得到源宽度的中间行，
+// 再做水平滤波得到输出宽度的BGRA行，随后直接交给BGRA到YUY2的行内核。
+// 中间行和BGRA行都在每个任务自己的暂存缓冲区中（留在L1/L2），不产生整帧的中间图像，
+// 源图像的每一行只从内存读取一次（相邻输出行共用的源行在缓存中）。
+// 定点格式：滤波系数为Q14（每个输出样本的系数之和为1 << 14），
+// 中间行为Q7（8位分量值 * 128，钳位到[0, 255 * 128]），输出钳位到[0, 255]。
+// 所有内核逐位一致；SIMD内核最高提供AVX2版本。
+// 两个方向都是2x或4x的Box缩小另有专用内核：相邻行、相邻像素的分量直接相加后舍入移位，
+// 不经过中间行和滤波表。结果与同尺寸的多相滤波逐位相同（等权系数下两者都是舍入后的平均值）。
+
+const int kScaleFilterBits = 14;
+const int kScaleIntermediateBits = 7;
+const int kScaleIntermediateMax = 255 << kScaleIntermediateBits;
+
+enum class ScaleFilter
+{
+    Auto,       // 两个方向都是整数倍缩小（含1x）时用Box，否则用Bicubic
+    Box,        // 面积平均，2x/4x等整数倍缩小时为等权平均
+    Bilinear,   // 三角滤波，缩小时支撑范围按比例扩大（抗锯齿）
+    Bicubic     // Catmull-Rom，缩小时支撑范围按比例扩大
+};
+
+// 一个方向的滤波表：第i个输出样本使用源样本Starts[i] .. Starts[i] + Taps - 1，
+// 系数从Weights[i * GetScaleWeightStride(Taps)]开始，Taps之后补0到偶数个。
+// 所有窗口都在源图像内（超出边缘的部分按复制边缘样本合并到边缘的系数上）
+struct ScaleFilterTable
+{
+    UINT SourceSize = 0;
+    UINT DestinationSize = 0;
+    ScaleFilter Filter = ScaleFilter::Auto;
+    UINT Taps = 0;
+    std::vector<int> Starts;
+    std::vector<short> Weights;
+};
+
+inline UINT GetScaleWeightStride(UINT taps)
+{
+    return (taps + 1) & ~1u;
+}
+
+// 垂直滤波：srcRow为窗口的第一行，依次取taps行（行步长pitch），每行的前count个字节（BGRA分量）加权求和，
+// 写出count个Q7值
+typedef void (*ScaleColumnFunc)(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT count,
+                                short* dstRow);
+// 水平滤波：srcRow为Q7中间行（每像素4个分量），按滤波表写出width个BGRA像素。
+// 中间行在源宽度之后需要再有一个像素的可读填充（奇数taps时成对读取，多读的像素系数为0）
+typedef void (*ScaleRowFunc)(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT width,
+                             BYTE* dstRow);
+
+// Box整数倍缩小：从srcRow开始读取factor行（行步长pitch），每个输出像素为factor x factor个源像素的舍入平均，
+// 写出width个BGRA像素（读取factor * width个源像素）。ScaleBox2x/ScaleBox4x分别对应factor为2和4
+typedef void (*ScaleBoxFunc)(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow);
+
+struct ScaleKernels
+{
+    ScaleColumnFunc Column;
+    ScaleRowFunc Row;
+    ScaleBoxFunc Box2x;
+    ScaleBoxFunc Box4x;
+};
+
+void ScaleColumn_C(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT count, short* dstRow);
+void ScaleRow_C(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT width, BYTE* dstRow);
+void ScaleBox2x_C(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow);
+void ScaleBox4x_C(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+void ScaleColumn_SSE41(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT count, short* dstRow);
+void ScaleRow_SSE41(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT width, BYTE* dstRow);
+void ScaleBox2x_SSE41(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow);
+void ScaleBox4x_SSE41(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow);
+void ScaleColumn_AVX2(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT count, short* dstRow);
+void ScaleRow_AVX2(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT width, BYTE* dstRow);
+void ScaleBox2x_AVX2(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow);
+void ScaleBox4x_AVX2(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow);
+#endif
+
+// 从第first个分量/像素开始用标量代码处理到结尾，供SIMD内核处理尾部
+void ScaleColumnTail_C(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT first, UINT count,
+                       short* dstRow);
+void ScaleRowTail_C(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT first, UINT width,
+                    BYTE* dstRow);
+void ScaleBoxTail_C(const BYTE* srcRow, size_t pitch, UINT factor, UINT first, UINT width, BYTE* dstRow);
+
+// 生成sourceSize到destinationSize的滤波表（filter不能为Auto）。table的缓冲区被复用
+HRESULT BuildScaleFilterTable(UINT sourceSize, UINT destinationSize, ScaleFilter filter, ScaleFilterTable& table);
+// Auto按尺寸选择实际使用的滤波器，其余原样返回
+ScaleFilter ResolveScaleFilter(ScaleFilter filter, UINT sourceWidth, UINT sourceHeight,
+                               UINT destinationWidth, UINT destinationHeight);
+const char* GetScaleFilterName(ScaleFilter filter);
+// filter（已经过ResolveScaleFilter）为Box且两个方向都正好缩小2倍或4倍时返回对应的专用内核，否则返回nullptr，
+// 使用多相滤波表
+ScaleBoxFunc GetScaleBoxKernel(const ScaleKernels& kernels, ScaleFilter filter, UINT sourceWidth, UINT sourceHeight,
+                               UINT destinationWidth, UINT destinationHeight, UINT* factor = nullptr);
+
+// 返回不超过level的最优内核（该转换最高提供AVX2版本）
+ScaleKernels GetScaleKernels(SimdLevel level, SimdLevel* selectedLevel = nullptr);
@@ -0,0 +1,173 @@
+#include "BGRAScaleKernels.h"
+#include "ColorConversionMath.h"
+#include <cstring>
+#include <immintrin.h>
+
+// AVX2内核：算法与SSE4.1版本相同。
+// 垂直滤波每次处理32个分量（unpack在128位通道内进行，packs后恢复原顺序）；
+// 水平滤波每次处理两个输出像素，每个128位通道一个。
+// Box 2x/4x内核每个128位通道处理连续的4个源像素，最后用permute恢复输出像素的顺序
+namespace
+{
+    const int kColumnShift = kScaleFilterBits - kScaleIntermediateBits;
+    const int kRowShift = kScaleFilterBits + kScaleIntermediateBits;
+
+    inline __m128i LoadPixelPair(const short* src)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+
+    // rows行中从src开始的8个像素按行相加；每个通道中low为前两个像素、high为后两个像素的16位分量
+    inline void SumColumns(const BYTE* src, size_t pitch, UINT rows, __m256i& low, __m256i& high)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        low = zero;
+        high = zero;
+        for (UINT row = 0; row < rows; row++)
+        {
+            __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + row * pitch));
+            low = _mm256_add_epi16(low, _mm256_unpacklo_epi8(pixels, zero));
+            high = _mm256_add_epi16(high, _mm256_unpackhi_epi8(pixels, zero));
+        }
+    }
+
+    // 每个通道：[a0 a1]、[b0 b1] -> [a0 + a1, b0 + b1]
+    inline __m256i SumPixelPairs(__m256i a, __m256i b)
+    {
+        return _mm256_add_epi16(_mm256_unpacklo_epi64(a, b), _mm256_unpackhi_epi64(a, b));
+    }
+}
+
+void ScaleColumn_AVX2(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT count, short* dstRow)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi32(1 << (kColumnShift - 1));
+    const __m256i maxValue = _mm256_set1_epi16(static_cast<short>(kScaleIntermediateMax));
+
+    UINT i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const BYTE* src = srcRow + i;
+        __m256i acc0 = round;
+        __m256i acc1 = round;
+        __m256i acc2 = round;
+        __m256i acc3 = round;
+        for (UINT k = 0; k < taps; k += 2)
+        {
+            const BYTE* a = src + k * pitch;
+            __m256i aLow = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)));
+            __m256i aHigh = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16)));
+            __m256i bLow = zero;
+            __m256i bHigh = zero;
+            if (k + 1 < taps)
+            {
+                const BYTE* b = a + pitch;
+                bLow = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+                bHigh = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16)));
+            }
+            __m256i w = _mm256_set1_epi32(PackCoefficientPair(weights[k], k + 1 < taps ? weights[k + 1] : 0));
+
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_unpacklo_epi16(aLow, bLow), w));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_unpackhi_epi16(aLow, bLow), w));
+            acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_unpacklo_epi16(aHigh, bHigh), w));
+            acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_unpackhi_epi16(aHigh, bHigh), w));
+        }
+
+        __m256i low = _mm256_packs_epi32(_mm256_srai_epi32(acc0, kColumnShift), _mm256_srai_epi32(acc1, kColumnShift));
+        __m256i high = _mm256_packs_epi32(_mm256_srai_epi32(acc2, kColumnShift), _mm256_srai_epi32(acc3, kColumnShift));
+        low = _mm256_min_epi16(_mm256_max_epi16(low, zero), maxValue);
+        high = _mm256_min_epi16(_mm256_max_epi16(high, zero), maxValue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstRow + i), low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstRow + i + 16), high);
+    }
+
+    ScaleColumnTail_C(srcRow, pitch, weights, taps, i, count, dstRow);
+}
+
+void ScaleRow_AVX2(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT width, BYTE* dstRow)
+{
+    const __m256i interleave = _mm256_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15,
+                                                0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+    const __m256i round = _mm256_set1_epi32(1 << (kRowShift - 1));
+    UINT stride = GetScaleWeightStride(taps);
+
+    UINT x = 0;
+    for (; x + 2 <= width; x += 2)
+    {
+        const short* src0 = srcRow + (size_t)starts[x] * 4;
+        const short* src1 = srcRow + (size_t)starts[x + 1] * 4;
+        const short* w0 = weights + (size_t)x * stride;
+        const short* w1 = w0 + stride;
+        __m256i acc = round;
+        for (UINT k = 0; k < taps; k += 2)
+        {
+            __m256i pixels = _mm256_set_m128i(LoadPixelPair(src1 + k * 4), LoadPixelPair(src0 + k * 4));
+            __m256i w = _mm256_set_m128i(_mm_set1_epi32(PackCoefficientPair(w1[k], w1[k + 1])),
+                                         _mm_set1_epi32(PackCoefficientPair(w0[k], w0[k + 1])));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_shuffle_epi8(pixels, interleave), w));
+        }
+
+        __m256i packed = _mm256_srai_epi32(acc, kRowShift);
+        packed = _mm256_packs_epi32(packed, packed);
+        packed = _mm256_packus_epi16(packed, packed);
+        __m128i pair = _mm_unpacklo_epi32(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dstRow + (size_t)x * 4), pair);
+    }
+
+    ScaleRowTail_C(srcRow, starts, weights, taps, x, width, dstRow);
+}
+
+void ScaleBox2x_AVX2(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow)
+{
+    const __m256i round = _mm256_set1_epi16(2);
+
+    // 每次读取16个源像素，输出8个像素
+    UINT x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        const BYTE* src = srcRow + (size_t)x * 8;
+        __m256i low0;
+        __m256i high0;
+        __m256i low1;
+        __m256i high1;
+        SumColumns(src, pitch, 2, low0, high0);
+        SumColumns(src + 32, pitch, 2, low1, high1);
+
+        // [o0 o1 | o2 o3]、[o4 o5 | o6 o7]，packus后为[o0 o1 o4 o5 | o2 o3 o6 o7]
+        __m256i sum0 = _mm256_srli_epi16(_mm256_add_epi16(SumPixelPairs(low0, high0), round), 2);
+        __m256i sum1 = _mm256_srli_epi16(_mm256_add_epi16(SumPixelPairs(low1, high1), round), 2);
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum0, sum1), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstRow + (size_t)x * 4), packed);
+    }
+
+    ScaleBoxTail_C(srcRow, pitch, 2, x, width, dstRow);
+}
+
+void ScaleBox4x_AVX2(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow)
+{
+    const __m256i round = _mm256_set1_epi16(8);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    // 每次读取32个源像素，输出8个像素
+    UINT x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        const BYTE* src = srcRow + (size_t)x * 16;
+        __m256i quads[4];
+        for (UINT i = 0; i < 4; i++)
+        {
+            __m256i low;
+            __m256i high;
+            SumColumns(src + i * 32, pitch, 4, low, high);
+            quads[i] = _mm256_add_epi16(low, high);
+        }
+
+        // [o0 o2 | o1 o3]、[o4 o6 | o5 o7]，packus后为[o0 o2 o4 o6 | o1 o3 o5 o7]
+        __m256i sum0 = _mm256_srli_epi16(_mm256_add_epi16(SumPixelPairs(quads[0], quads[1]), round), 4);
+        __m256i sum1 = _mm256_srli_epi16(_mm256_add_epi16(SumPixelPairs(quads[2], quads[3]), round), 4);
+        __m256i packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(sum0, sum1), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstRow + (size_t)x * 4), packed);
+    }
+
+    ScaleBoxTail_C(srcRow, pitch, 4, x, width, dstRow);
+}
@@ -0,0 +1,159 @@
+#include "BGRAScaleKernels.h"
+#include "ColorConversionMath.h"
+#include <cstring>
+#include <smmintrin.h>
+
+// SSE4.1内核
+// 垂直滤波每次处理16个分量：相邻两行的分量交错成16位对，与(w[k], w[k + 1])做pmaddwd，奇数taps的最后一行与0配对。
+// 水平滤波每次处理一个输出像素：窗口中相邻两个像素的同一分量交错成16位对，
+// 一次pmaddwd同时得到4个分量的两个抽头之和。
+// Box 2x/4x内核把源像素扩展为16位后先按行相加，再把相邻像素（各占64位）用unpacklo/hi_epi64配对相加
+namespace
+{
+    const int kColumnShift = kScaleFilterBits - kScaleIntermediateBits;
+    const int kRowShift = kScaleFilterBits + kScaleIntermediateBits;
+
+    inline __m128i WeightPair(const short* weights, UINT k, UINT taps)
+    {
+        return _mm_set1_epi32(PackCoefficientPair(weights[k], k + 1 < taps ? weights[k + 1] : 0));
+    }
+
+    // rows行中从src开始的4个像素按行相加，low为前两个像素、high为后两个像素的16位分量
+    inline void SumColumns(const BYTE* src, size_t pitch, UINT rows, __m128i& low, __m128i& high)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        low = zero;
+        high = zero;
+        for (UINT row = 0; row < rows; row++)
+        {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + row * pitch));
+            low = _mm_add_epi16(low, _mm_unpacklo_epi8(pixels, zero));
+            high = _mm_add_epi16(high, _mm_unpackhi_epi8(pixels, zero));
+        }
+    }
+
+    // [a0 a1]、[b0 b1]（每项一个像素的4个16位分量）-> [a0 + a1, b0 + b1]
+    inline __m128i SumPixelPairs(__m128i a, __m128i b)
+    {
+        return _mm_add_epi16(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b));
+    }
+}
+
+void ScaleColumn_SSE41(const BYTE* srcRow, size_t pitch, const short* weights, UINT taps, UINT count, short* dstRow)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << (kColumnShift - 1));
+    const __m128i maxValue = _mm_set1_epi16(static_cast<short>(kScaleIntermediateMax));
+
+    UINT i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const BYTE* src = srcRow + i;
+        __m128i acc0 = round;
+        __m128i acc1 = round;
+        __m128i acc2 = round;
+        __m128i acc3 = round;
+        for (UINT k = 0; k < taps; k += 2)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k * pitch));
+            __m128i b = k + 1 < taps ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (k + 1) * pitch)) : zero;
+            __m128i w = WeightPair(weights, k, taps);
+
+            __m128i aLow = _mm_unpacklo_epi8(a, zero);
+            __m128i aHigh = _mm_unpackhi_epi8(a, zero);
+            __m128i bLow = _mm_unpacklo_epi8(b, zero);
+            __m128i bHigh = _mm_unpackhi_epi8(b, zero);
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi16(aLow, bLow), w));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi16(aLow, bLow), w));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi16(aHigh, bHigh), w));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi16(aHigh, bHigh), w));
+        }
+
+        // packs饱和到int16后再钳位，与先钳位的结果相同（上限小于32767）
+        __m128i low = _mm_packs_epi32(_mm_srai_epi32(acc0, kColumnShift), _mm_srai_epi32(acc1, kColumnShift));
+        __m128i high = _mm_packs_epi32(_mm_srai_epi32(acc2, kColumnShift), _mm_srai_epi32(acc3, kColumnShift));
+        low = _mm_min_epi16(_mm_max_epi16(low, zero), maxValue);
+        high = _mm_min_epi16(_mm_max_epi16(high, zero), maxValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + i), low);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + i + 8), high);
+    }
+
+    ScaleColumnTail_C(srcRow, pitch, weights, taps, i, count, dstRow);
+}
+
+void ScaleRow_SSE41(const short* srcRow, const int* starts, const short* weights, UINT taps, UINT width, BYTE* dstRow)
+{
+    // [B0 G0 R0 A0 B1 G1 R1 A1] -> [B0 B1 G0 G1 R0 R1 A0 A1]
+    const __m128i interleave = _mm_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+    const __m128i round = _mm_set1_epi32(1 << (kRowShift - 1));
+    UINT stride = GetScaleWeightStride(taps);
+
+    for (UINT x = 0; x < width; x++)
+    {
+        const short* src = srcRow + (size_t)starts[x] * 4;
+        const short* w = weights + (size_t)x * stride;
+        __m128i acc = round;
+        for (UINT k = 0; k < taps; k += 2)
+        {
+            // 奇数taps时多读的像素在填充或下一个抽头位置上，系数为0
+            __m128i pixels = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k * 4)), interleave);
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(pixels, _mm_set1_epi32(PackCoefficientPair(w[k], w[k + 1]))));
+        }
+
+        __m128i packed = _mm_srai_epi32(acc, kRowShift);
+        packed = _mm_packs_epi32(packed, packed);
+        packed = _mm_packus_epi16(packed, packed);
+        UINT pixel = static_cast<UINT>(_mm_cvtsi128_si32(packed));
+        memcpy(dstRow + (size_t)x * 4, &pixel, sizeof(pixel));
+    }
+}
+
+void ScaleBox2x_SSE41(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow)
+{
+    const __m128i round = _mm_set1_epi16(2);
+
+    // 每次读取8个源像素，输出4个像素
+    UINT x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        const BYTE* src = srcRow + (size_t)x * 8;
+        __m128i low0;
+        __m128i high0;
+        __m128i low1;
+        __m128i high1;
+        SumColumns(src, pitch, 2, low0, high0);
+        SumColumns(src + 16, pitch, 2, low1, high1);
+
+        __m128i sum01 = _mm_srli_epi16(_mm_add_epi16(SumPixelPairs(low0, high0), round), 2);
+        __m128i sum23 = _mm_srli_epi16(_mm_add_epi16(SumPixelPairs(low1, high1), round), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + (size_t)x * 4), _mm_packus_epi16(sum01, sum23));
+    }
+
+    ScaleBoxTail_C(srcRow, pitch, 2, x, width, dstRow);
+}
+
+void ScaleBox4x_SSE41(const BYTE* srcRow, size_t pitch, UINT width, BYTE* dstRow)
+{
+    const __m128i round = _mm_set1_epi16(8);
+
+    // 每次读取16个源像素，输出4个像素；16个分量之和不超过4080，16位不会溢出
+    UINT x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        const BYTE* src = srcRow + (size_t)x * 16;
+        __m128i quads[4];
+        for (UINT i = 0; i < 4; i++)
+        {
+            __m128i low;
+            __m128i high;
+            SumColumns(src + i * 16, pitch, 4, low, high);
+            quads[i] = _mm_add_epi16(low, high);
+        }
+
+        __m128i sum01 = _mm_srli_epi16(_mm_add_epi16(SumPixelPairs(quads[0], quads[1]), round), 4);
+        __m128i sum23 = _mm_srli_epi16(_mm_add_epi16(SumPixelPairs(quads[2], quads[3]), round), 4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + (size_t)x * 4), _mm_packus_epi16(sum01, sum23));
+    }
+
+    ScaleBoxTail_C(srcRow, pitch, 4, x, width, dstRow);
+}
@@ -0,0 +1,310 @@
+#include "BGRAToNV12Converter.h"
+#include <d3dcompiler.h>
+#include <fstream>
+#include <vector>
+
+BGRAToNV12Converter::BGRAToNV12Converter()
+    : m_device(nullptr)
+    , m_context(nullptr)
+    , m_computeShader(nullptr)
+    , m_constantBuffer(nullptr)
+    , m_initialized(false)
+    , m_lastLogTime(std::chrono::steady_clock::now())
+{
+}
+
+BGRAToNV12Converter::~BGRAToNV12Converter()
+{
+    Cleanup();
+}
+
+HRESULT BGRAToNV12Converter::Initialize(ID3D11Device* device, ID3D11DeviceContext* context)
+{
+    if (!device || !context)
+        return E_INVALIDARG;
+
+    m_device = device;
+    m_context = context;
+    m_device->AddRef();
+    m_context->AddRef();
+
+    try
+    {
+        ThrowIfFailed(CompileShader(), "Failed to compile BGRA to NV12 shader");
+
+        // 创建常量缓冲区
+        D3D11_BUFFER_DESC cbDesc = {};
+        cbDesc.ByteWidth = sizeof(NV12OutputParams);
+        cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+        cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+        ThrowIfFailed(m_device->CreateBuffer(&cbDesc, nullptr, &m_constantBuffer),
+                     "Failed to create constant buffer");
+
+        m_initialized = true;
+        LogMessage("BGRA to NV12 converter initialized successfully");
+        return S_OK;
+    }
+    catch (const std::exception& e)
+    {
+        LogError(std::string("BGRA to NV12 converter initialization failed: ") + e.what());
+        Cleanup();
+        return E_FAIL;
+    }
+}
+
+HRESULT BGRAToNV12Converter::CompileShader()
+{
+    // 读取shader文件
+    std::ifstream shaderFile("shaders/BGRAToNV12.hlsl");
+    if (!shaderFile.is_open())
+    {
+        LogError("Cannot open shader file: shaders/BGRAToNV12.hlsl");
+        return E_FAIL;
+    }
+
+    std::string shaderSource((std::istreambuf_iterator<char>(shaderFile)),
+                            std::istreambuf_iterator<char>());
+    shaderFile.close();
+
+    ID3DBlob* shaderBlob = nullptr;
+    ID3DBlob* errorBlob = nullptr;
+
+    HRESULT hr = D3DCompile(
+        shaderSource.c_str(),
+        shaderSource.size(),
+        "BGRAToNV12.hlsl",
+        nullptr,
+        nullptr,
+        "CSMain",
+        "cs_5_0",
+        D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION,
+        0,
+        &shaderBlob,
+        &errorBlob
+    );
+
+    if (FAILED(hr))
+    {
+        if (errorBlob)
+        {
+            LogError(std::string("BGRA to NV12 shader compilation error: ") +
+                    (char*)errorBlob->GetBufferPointer());
+            errorBlob->Release();
+        }
+        return hr;
+    }
+
+    hr = m_device->CreateComputeShader(
+        shaderBlob->GetBufferPointer(),
+        shaderBlob->GetBufferSize(),
+        nullptr,
+        &m_computeShader
+    );
+
+    shaderBlob->Release();
+    return hr;
+}
+
+D3D11_BUFFER_DESC BGRAToNV12Converter::GetOutputBufferDesc(UINT width, UINT height, UINT outputPitch)
+{
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = GetOutputBufferSize(width, height, outputPitch);
+    bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+    bufferDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+    bufferDesc.CPUAccessFlags = 0;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+    bufferDesc.StructureByteStride = 0; // 原始缓冲区不需要结构大小
+    return bufferDesc;
+}
+
+HRESULT BGRAToNV12Converter::CreateOutputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer,
+                                                UINT outputPitch)
+{
+    UINT pitch = GetOutputPitch(width, outputPitch);
+    if (width == 0 || height == 0 || pitch % 4 != 0 || pitch < ((width + 3) & ~3u))
+        return E_INVALIDARG;
+
+    D3D11_BUFFER_DESC bufferDesc = GetOutputBufferDesc(width, height, outputPitch);
+
+    HRESULT hr = m_device->CreateBuffer(&bufferDesc, nullptr, outBuffer);
+    if (FAILED(hr))
+    {
+        LogError("Failed to create NV12 output buffer");
+    }
+
+    return hr;
+}
+
+HRESULT BGRAToNV12Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
+                                    UINT width, UINT height, UINT outputPitch)
+{
+    if (!m_initialized || !inputTexture || !outputBuffer || width == 0 || height == 0)
+        return E_INVALIDARG;
+
+    // 每个线程按4个像素写一个32位字，行步长必须能容纳宽度向上取整到4
+    UINT pitch = GetOutputPitch(width, outputPitch);
+    if (pitch % 4 != 0 || pitch < ((width + 3) & ~3u))
+        return E_INVALIDARG;
+
+    D3D11_TEXTURE2D_DESC texDesc;
+    inputTexture->GetDesc(&texDesc);
+    if (width > texDesc.Width || height > texDesc.Height)
+        return E_INVALIDARG;
+
+    // 与BGRAToYUY2Converter支持的桌面格式相同，SRGB格式按UNORM读取
+    DXGI_FORMAT srvFormat;
+    switch (texDesc.Format)
+    {
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        srvFormat = DXGI_FORMAT_B8G8R8A8_UNORM;
+        break;
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        srvFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+        break;
+    default:
+        LogError("Unsupported texture format for NV12 conversion: " + std::to_string(texDesc.Format));
+        return E_INVALIDARG;
+    }
+
+    ID3D11ShaderResourceView* inputSRV = nullptr;
+    ID3D11UnorderedAccessView* outputUAV = nullptr;
+    try
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = srvFormat;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Texture2D.MipLevels = 1;
+        ThrowIfFailed(m_device->CreateShaderResourceView(inputTexture, &srvDesc, &inputSRV),
+                     "Failed to create input SRV");
+
+        // 元素数量为输出缓冲区的32位元素数量（两个平面，含行填充）
+        D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+        uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;  // 必须使用TYPELESS配合RAW缓冲区
+        uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+        uavDesc.Buffer.FirstElement = 0;
+        uavDesc.Buffer.NumElements = GetOutputBufferSize(width, height, outputPitch) / 4;
+        uavDesc.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;
+        ThrowIfFailed(m_device->CreateUnorderedAccessView(outputBuffer, &uavDesc, &outputUAV),
+                     "Failed to create output UAV");
+
+        // 更新常量缓冲区
+        D3D11_MAPPED_SUBRESOURCE mappedResource;
+        ThrowIfFailed(m_context->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource),
+                     "Failed to map constant buffer");
+
+        NV12OutputParams* params = (NV12OutputParams*)mappedResource.pData;
+        params->ImageWidth = width;
+        params->ImageHeight = height;
+        params->OutputStride = pitch;
+        params->UVPlaneOffset = pitch * height;
+
+        m_context->Unmap(m_constantBuffer, 0);
+
+        // 设置Compute Shader管线
+        m_context->CSSetShader(m_computeShader, nullptr, 0);
+        m_context->CSSetShaderResources(0, 1, &inputSRV);
+        m_context->CSSetUnorderedAccessViews(0, 1, &outputUAV, nullptr);
+        m_context->CSSetConstantBuffers(0, 1, &m_constantBuffer);
+
+        // 每个线程处理4x2像素，线程组大小是8x8，所以每个线程组处理32x16个像素
+        UINT dispatchX = ((width + 3) / 4 + 7) / 8;
+        UINT dispatchY = ((height + 1) / 2 + 7) / 8;
+        m_context->Dispatch(dispatchX, dispatchY, 1);
+
+        // 清理管线状态
+        ID3D11ShaderResourceView* nullSRV = nullptr;
+        ID3D11UnorderedAccessView* nullUAV = nullptr;
+        m_context->CSSetShaderResources(0, 1, &nullSRV);
+        m_context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+
+        SAFE_RELEASE(outputUAV);
+        SAFE_RELEASE(inputSRV);
+
+        // 每10秒输出一次成功日志
+        auto currentTime = std::chrono::steady_clock::now();
+        auto timeDiff = std::chrono::duration_cast<std::chrono::seconds>(currentTime - m_lastLogTime);
+        if (timeDiff.count() >= 10)
+        {
+            LogMessage("BGRA to NV12 conversion completed successfully");
+            m_lastLogTime = currentTime;
+        }
+
+        return S_OK;
+    }
+    catch (const std::exception& e)
+    {
+        SAFE_RELEASE(outputUAV);
+        SAFE_RELEASE(inputSRV);
+        LogError(std::string("BGRA to NV12 conversion failed: ") + e.what());
+        return E_FAIL;
+    }
+}
+
+HRESULT BGRAToNV12Converter::ReadOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height,
+                                             const ImageView& destination, UINT outputPitch)
+{
+    if (!m_initialized || !buffer || !IsImageViewValid(destination, 2, width, height) ||
+        destination.Planes[0].RowBytes < width ||
+        destination.Planes[1].RowBytes < ((width + 1) / 2) * 2 ||
+        destination.Planes[1].Height < (height + 1) / 2)
+        return E_INVALIDARG;
+
+    UINT pitch = GetOutputPitch(width, outputPitch);
+    UINT dataSize = GetOutputBufferSize(width, height, outputPitch);
+
+    // 创建staging buffer用于读回
+    D3D11_BUFFER_DESC stagingDesc = {};
+    stagingDesc.ByteWidth = dataSize;
+    stagingDesc.Usage = D3D11_USAGE_STAGING;
+    stagingDesc.BindFlags = 0;
+    stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    stagingDesc.MiscFlags = 0;
+
+    ID3D11Buffer* stagingBuffer = nullptr;
+    HRESULT hr = m_device->CreateBuffer(&stagingDesc, nullptr, &stagingBuffer);
+    if (FAILED(hr))
+    {
+        LogError("Failed to create NV12 staging buffer");
+        return hr;
+    }
+
+    // 输出缓冲区可能大于本次输出，只复制有效区域
+    D3D11_BOX box = { 0, 0, 0, dataSize, 1, 1 };
+    m_context->CopySubresourceRegion(stagingBuffer, 0, 0, 0, 0, buffer, 0, &box);
+
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    hr = m_context->Map(stagingBuffer, 0, D3D11_MAP_READ, 0, &mappedResource);
+    if (SUCCEEDED(hr))
+    {
+        // 按视图中各平面的行步长逐行复制有效数据
+        const BYTE* ySrc = static_cast<const BYTE*>(mappedResource.pData);
+        const BYTE* uvSrc = ySrc + (size_t)pitch * height;
+        const ImagePlane& yPlane = destination.Planes[0];
+        const ImagePlane& uvPlane = destination.Planes[1];
+        for (UINT y = 0; y < height; y++)
+        {
+            memcpy(yPlane.Data + (size_t)y * yPlane.Pitch, ySrc + (size_t)y * pitch, width);
+        }
+        for (UINT y = 0; y < (height + 1) / 2; y++)
+        {
+            memcpy(uvPlane.Data + (size_t)y * uvPlane.Pitch, uvSrc + (size_t)y * pitch, ((width + 1) / 2) * 2);
+        }
+        m_context->Unmap(stagingBuffer, 0);
+    }
+
+    stagingBuffer->Release();
+    return hr;
+}
+
+void BGRAToNV12Converter::Cleanup()
+{
+    SAFE_RELEASE(m_constantBuffer);
+    SAFE_RELEASE(m_computeShader);
+    SAFE_RELEASE(m_context);
+    SAFE_RELEASE(m_device);
+    m_initialized = false;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "ImageView.h"
+#include "Utils.h"
+#include <chrono>
+
+struct NV12OutputParams
+{
+    UINT ImageWidth;
+    UINT ImageHeight;
+    UINT OutputStride;    // 两个平面共用的行步长
+    UINT UVPlaneOffset;   // UV平面相对缓冲区起始的字节偏移
+};
+
+// BGRA到NV12的GPU转换器（编码器输入），接口与BGRAToYUY2Converter相同。
+// 每个线程读取4x2像素，同时写出两行Y和一行UV（2x2块平均），源纹理只读取一遍，
+// 不经过YUY2再降采样。输出缓冲区布局与NV12ToRGBAConverter的输入相同：
+// Y平面在前，UV平面紧随其后，两个平面使用相同的行步长
+class BGRAToNV12Converter
+{
+public:
+    BGRAToNV12Converter();
+    ~BGRAToNV12Converter();
+
+    HRESULT Initialize(ID3D11Device* device, ID3D11DeviceContext* context);
+    // outputPitch为输出缓冲区的行步长（字节，4的倍数且不小于宽度），0表示宽度向上取整到4
+    HRESULT Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
+                   UINT width, UINT height, UINT outputPitch = 0);
+    HRESULT CreateOutputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer, UINT outputPitch = 0);
+    // 读回到调用者的NV12视图（两个平面的行步长可以与输出缓冲区不同）
+    HRESULT ReadOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height,
+                            const ImageView& destination, UINT outputPitch = 0);
+    void Cleanup();
+
+    static UINT GetOutputPitch(UINT width, UINT outputPitch)
+    {
+        return outputPitch ? outputPitch : (width + 3) & ~3u;
+    }
+
+    static UINT GetOutputBufferSize(UINT width, UINT height, UINT outputPitch)
+    {
+        return GetOutputPitch(width, outputPitch) * (height + (height + 1) / 2);
+    }
+
+    // 输出缓冲区的资源描述，CreateOutputBuffer和帧池共用
+    static D3D11_BUFFER_DESC GetOutputBufferDesc(UINT width, UINT height, UINT outputPitch = 0);
+
+private:
+    HRESULT CompileShader();
+
+    ID3D11Device* m_device;
+    ID3D11DeviceContext* m_context;
+    ID3D11ComputeShader* m_computeShader;
+    ID3D11Buffer* m_constantBuffer;
+    bool m_initialized;
+
+    // 用于控制日志输出频率
+    std::chrono::steady_clock::time_point m_lastLogTime;
+};
@@ -0,0 +1,165 @@
+#include "BGRAToYUV420Kernels.h"
+#include "ColorConversionMath.h"
+
+namespace
+{
+    // 转换x处的2x2块（奇数宽度时x1 == x），写出Y并返回块平均后的U、V
+    inline void ConvertBlockFixed(const BYTE* srcRow0, const BYTE* row1, BYTE* yRow0, BYTE* yRow1,
+                                  UINT x, UINT width, BYTE& uOut, BYTE& vOut)
+    {
+        UINT x1 = (x + 1 < width) ? x + 1 : x;
+        const BYTE* p[4] = { srcRow0 + x * 4, srcRow0 + x1 * 4, row1 + x * 4, row1 + x1 * 4 };
+
+        UINT u = 0;
+        UINT v = 0;
+        for (UINT i = 0; i < 4; i++)
+        {
+            u += static_cast<UINT>(FixedU(p[i][2], p[i][1], p[i][0]));
+            v += static_cast<UINT>(FixedV(p[i][2], p[i][1], p[i][0]));
+        }
+
+        yRow0[x] = static_cast<BYTE>(FixedY(p[0][2], p[0][1], p[0][0]));
+        if (x + 1 < width)
+            yRow0[x + 1] = static_cast<BYTE>(FixedY(p[1][2], p[1][1], p[1][0]));
+        if (yRow1)
+        {
+            yRow1[x] = static_cast<BYTE>(FixedY(p[2][2], p[2][1], p[2][0]));
+            if (x + 1 < width)
+                yRow1[x + 1] = static_cast<BYTE>(FixedY(p[3][2], p[3][1], p[3][0]));
+        }
+        uOut = static_cast<BYTE>(FixedAverageUV4(u));
+        vOut = static_cast<BYTE>(FixedAverageUV4(v));
+    }
+
+    inline void ConvertBlockFloat(const BYTE* srcRow0, const BYTE* row1, BYTE* yRow0, BYTE* yRow1,
+                                  UINT x, UINT width, BYTE& uOut, BYTE& vOut)
+    {
+        UINT x1 = (x + 1 < width) ? x + 1 : x;
+        const BYTE* p[4] = { srcRow0 + x * 4, srcRow0 + x1 * 4, row1 + x * 4, row1 + x1 * 4 };
+
+        YUVFloat yuv[4];
+        for (UINT i = 0; i < 4; i++)
+        {
+            yuv[i] = RGBToYUV(UnormToFloat(p[i][2]), UnormToFloat(p[i][1]), UnormToFloat(p[i][0]));
+        }
+
+        yRow0[x] = static_cast<BYTE>(RoundToUInt(yuv[0].Y));
+        if (x + 1 < width)
+            yRow0[x + 1] = static_cast<BYTE>(RoundToUInt(yuv[1].Y));
+        if (yRow1)
+        {
+            yRow1[x] = static_cast<BYTE>(RoundToUInt(yuv[2].Y));
+            if (x + 1 < width)
+                yRow1[x + 1] = static_cast<BYTE>(RoundToUInt(yuv[3].Y));
+        }
+        uOut = static_cast<BYTE>(RoundToUInt((yuv[0].U + yuv[1].U + yuv[2].U + yuv[3].U) * 0.25f));
+        vOut = static_cast<BYTE>(RoundToUInt((yuv[0].V + yuv[1].V + yuv[2].V + yuv[3].V) * 0.25f));
+    }
+}
+
+void BGRAToNV12RowPairTail_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT firstPixel, UINT width)
+{
+    // 奇数高度的最后一行：色度只来自这一行（两行相同）
+    const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+    for (UINT x = firstPixel; x < width; x += 2)
+    {
+        ConvertBlockFixed(srcRow0, row1, yRow0, yRow1, x, width, uvRow[x], uvRow[x + 1]);
+    }
+}
+
+void BGRAToNV12RowPair_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                         BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width)
+{
+    BGRAToNV12RowPairTail_C(srcRow0, srcRow1, yRow0, yRow1, uvRow, 0, width);
+}
+
+void BGRAToNV12RowPair_Float(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width)
+{
+    const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+    for (UINT x = 0; x < width; x += 2)
+    {
+        ConvertBlockFloat(srcRow0, row1, yRow0, yRow1, x, width, uvRow[x], uvRow[x + 1]);
+    }
+}
+
+void BGRAToI420RowPairTail_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT firstPixel, UINT width)
+{
+    const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+    for (UINT x = firstPixel; x < width; x += 2)
+    {
+        ConvertBlockFixed(srcRow0, row1, yRow0, yRow1, x, width, uRow[x / 2], vRow[x / 2]);
+    }
+}
+
+void BGRAToI420RowPair_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                         BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width)
+{
+    BGRAToI420RowPairTail_C(srcRow0, srcRow1, yRow0, yRow1, uRow, vRow, 0, width);
+}
+
+void BGRAToI420RowPair_Float(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width)
+{
+    const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+    for (UINT x = 0; x < width; x += 2)
+    {
+        ConvertBlockFloat(srcRow0, row1, yRow0, yRow1, x, width, uRow[x / 2], vRow[x / 2]);
+    }
+}
+
+BGRAToNV12RowPairFunc GetBGRAToNV12RowPairKernel(SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    BGRAToNV12RowPairFunc kernel = BGRAToNV12RowPair_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernel = BGRAToNV12RowPair_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = BGRAToNV12RowPair_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
+
+BGRAToI420RowPairFunc GetBGRAToI420RowPairKernel(SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    BGRAToI420RowPairFunc kernel = BGRAToI420RowPair_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernel = BGRAToI420RowPair_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = BGRAToI420RowPair_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
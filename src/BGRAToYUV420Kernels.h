@@ -0,0 +1,54 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+
+// BGRA到4:2:0（NV12、I420/YV12）的CPU行对内核
+// 一次读取两行源像素，每个2x2块只读取一次：写出两行Y以及一行交错的UV（NV12，U在前）
+// 或各一行U和V（I420/YV12，两种格式只是U、V平面的顺序不同，由调用者给出平面指针），
+// 不产生YUY2等中间格式，也不需要第二遍降采样。
+// UV取2x2块四个像素的定点UV（各自钳位后）之和的平均值（FixedAverageUV4），
+// 奇数宽度时最后一列复制自身，srcRow1/yRow1为空时（奇数高度的最后一行）第二行取第一行。
+// 所有内核使用ColorConversionMath.h中的定点公式，输出逐位一致；SIMD内核最高提供AVX2版本。
+typedef void (*BGRAToNV12RowPairFunc)(const BYTE* srcRow0, const BYTE* srcRow1,
+                                      BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width);
+
+void BGRAToNV12RowPair_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                         BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width);
+// 浮点参考（与shader公式相同，UV为四个浮点值的平均），ConversionPrecision::FloatReference使用
+void BGRAToNV12RowPair_Float(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+void BGRAToNV12RowPair_SSE41(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width);
+void BGRAToNV12RowPair_AVX2(const BYTE* srcRow0, const BYTE* srcRow1,
+                            BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width);
+#endif
+
+// 从第firstPixel个像素（必须为偶数）开始用标量定点代码转换到行尾，供SIMD内核处理尾部
+void BGRAToNV12RowPairTail_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT firstPixel, UINT width);
+
+// 返回不超过level的最优内核（该转换最高提供AVX2版本）
+BGRAToNV12RowPairFunc GetBGRAToNV12RowPairKernel(SimdLevel level, SimdLevel* selectedLevel = nullptr);
+
+// 平面4:2:0：uRow、vRow各写(width + 1) / 2个字节
+typedef void (*BGRAToI420RowPairFunc)(const BYTE* srcRow0, const BYTE* srcRow1,
+                                      BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width);
+
+void BGRAToI420RowPair_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                         BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width);
+void BGRAToI420RowPair_Float(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+void BGRAToI420RowPair_SSE41(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width);
+void BGRAToI420RowPair_AVX2(const BYTE* srcRow0, const BYTE* srcRow1,
+                            BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width);
+#endif
+
+void BGRAToI420RowPairTail_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT firstPixel, UINT width);
+
+BGRAToI420RowPairFunc GetBGRAToI420RowPairKernel(SimdLevel level, SimdLevel* selectedLevel = nullptr);
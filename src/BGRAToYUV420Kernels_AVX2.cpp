@@ -0,0 +1,166 @@
+#include "BGRAToYUV420Kernels.h"
+#include "ColorConversionMath.h"
+#include <immintrin.h>
+
+// AVX2内核：每个32位通道一个BGRA像素，定点公式与BGRAToYUY2Kernels_AVX2.cpp相同。
+// 每次迭代处理两行各32个像素：写出两行各32个Y和16个UV对（32字节），或各16个U和V。
+// 打包和水平相加都在128位通道内进行，最后用一次跨通道置换恢复像素顺序
+namespace
+{
+    struct CoefficientVectors
+    {
+        __m256i BRHigh;
+        __m256i BRLow;
+        __m256i GOneHigh;
+        __m256i GOneLow;
+    };
+
+    struct KernelConstants
+    {
+        CoefficientVectors Y;
+        CoefficientVectors U;
+        CoefficientVectors V;
+    };
+
+    inline CoefficientVectors LoadCoefficients(int coefB, int coefR, int coefG, int coefOne)
+    {
+        CoefficientVectors c;
+        c.BRHigh = _mm256_set1_epi32(PackCoefficientPair(CoefficientHigh(coefB), CoefficientHigh(coefR)));
+        c.BRLow = _mm256_set1_epi32(PackCoefficientPair(CoefficientLow(coefB), CoefficientLow(coefR)));
+        c.GOneHigh = _mm256_set1_epi32(PackCoefficientPair(CoefficientHigh(coefG), CoefficientHigh(coefOne)));
+        c.GOneLow = _mm256_set1_epi32(PackCoefficientPair(CoefficientLow(coefG), CoefficientLow(coefOne)));
+        return c;
+    }
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.Y = LoadCoefficients(kYCoefB, kYCoefR, kYCoefG, kYCoefOne);
+        c.U = LoadCoefficients(kUCoefB, kUCoefR, kUCoefG, kUVCoefOne);
+        c.V = LoadCoefficients(kVCoefB, kVCoefR, kVCoefG, kUVCoefOne);
+        return c;
+    }
+
+    inline __m256i MultiplyAdd(__m256i br, __m256i gOne, const CoefficientVectors& c)
+    {
+        __m256i high = _mm256_add_epi32(_mm256_madd_epi16(br, c.BRHigh), _mm256_madd_epi16(gOne, c.GOneHigh));
+        __m256i low = _mm256_add_epi32(_mm256_madd_epi16(br, c.BRLow), _mm256_madd_epi16(gOne, c.GOneLow));
+        return _mm256_add_epi32(_mm256_slli_epi32(high, kCoefSplitShift), low);
+    }
+
+    // 转换8个像素：y为钳位后的8位Y，u/v累加钳位后的定点UV（保留小数位）
+    inline __m256i ConvertPixels8(__m256i pixels, const KernelConstants& c, __m256i& u, __m256i& v)
+    {
+        const __m256i maskBR = _mm256_set1_epi32(0x00FF00FF);
+        const __m256i maskG = _mm256_set1_epi32(0x000000FF);
+        const __m256i oneLane = _mm256_set1_epi32(kFixedOneLane << 16);
+        const __m256i uvMin = _mm256_set1_epi32(kUVFixedMin);
+        const __m256i uvMax = _mm256_set1_epi32(kUVFixedMax);
+
+        __m256i br = _mm256_and_si256(pixels, maskBR);
+        __m256i gOne = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), maskG), oneLane);
+
+        __m256i y = _mm256_srai_epi32(MultiplyAdd(br, gOne, c.Y), kFixedShift);
+        y = _mm256_min_epi32(_mm256_max_epi32(y, _mm256_set1_epi32(16)), _mm256_set1_epi32(235));
+        u = _mm256_add_epi32(u, _mm256_min_epi32(_mm256_max_epi32(MultiplyAdd(br, gOne, c.U), uvMin), uvMax));
+        v = _mm256_add_epi32(v, _mm256_min_epi32(_mm256_max_epi32(MultiplyAdd(br, gOne, c.V), uvMin), uvMax));
+        return y;
+    }
+
+    // 相邻像素再相加得到2x2块的平均值，通道内顺序为[a0 a1 b0 b1 | a2 a3 b2 b3]（按块编号）
+    inline __m256i AverageBlocks(__m256i a, __m256i b)
+    {
+        // 四个值之和按无符号数解释（见FixedAverageUV4）
+        const __m256i uvRound = _mm256_set1_epi32(1 << (kFixedShift + 1));
+        return _mm256_srli_epi32(_mm256_add_epi32(_mm256_hadd_epi32(a, b), uvRound), kFixedShift + 2);
+    }
+
+    // 四个向量（各8个32位值）在通道内打包后32位单元的顺序为[0 4 1 5 2 6 3 7]，恢复为顺序排列
+    inline __m256i RestoreOrder(__m256i packed)
+    {
+        return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    }
+
+    inline __m256i PackY(const __m256i* y)
+    {
+        return RestoreOrder(_mm256_packus_epi16(_mm256_packs_epi32(y[0], y[1]), _mm256_packs_epi32(y[2], y[3])));
+    }
+
+    // 转换两行各32个像素：写出两行Y，返回16个2x2块的U、V平均值（各两个向量，块顺序见AverageBlocks）
+    inline void ConvertRowPair32(const BYTE* src0Bytes, const BYTE* src1Bytes, BYTE* yRow0, BYTE* yRow1,
+                                 const KernelConstants& c, __m256i* uAverage, __m256i* vAverage)
+    {
+        const __m256i* src0 = reinterpret_cast<const __m256i*>(src0Bytes);
+        const __m256i* src1 = reinterpret_cast<const __m256i*>(src1Bytes);
+
+        __m256i u[4];
+        __m256i v[4];
+        __m256i y0[4];
+        __m256i y1[4];
+        for (int i = 0; i < 4; i++)
+        {
+            u[i] = _mm256_setzero_si256();
+            v[i] = _mm256_setzero_si256();
+            y0[i] = ConvertPixels8(_mm256_loadu_si256(src0 + i), c, u[i], v[i]);
+            y1[i] = ConvertPixels8(_mm256_loadu_si256(src1 + i), c, u[i], v[i]);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(yRow0), PackY(y0));
+        if (yRow1)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(yRow1), PackY(y1));
+        }
+
+        uAverage[0] = AverageBlocks(u[0], u[1]);
+        uAverage[1] = AverageBlocks(u[2], u[3]);
+        vAverage[0] = AverageBlocks(v[0], v[1]);
+        vAverage[1] = AverageBlocks(v[2], v[3]);
+    }
+}
+
+void BGRAToNV12RowPair_AVX2(const BYTE* srcRow0, const BYTE* srcRow1,
+                            BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width)
+{
+    const KernelConstants c = LoadConstants();
+    const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+
+    UINT x = 0;
+    for (; x + 32 <= width; x += 32)
+    {
+        __m256i u[2];
+        __m256i v[2];
+        ConvertRowPair32(srcRow0 + x * 4, row1 + x * 4, yRow0 + x, yRow1 ? yRow1 + x : nullptr, c, u, v);
+
+        // 每个32位通道为一个UV对（U | V << 8），打包为16个16位值后每个32位单元为两个UV对
+        __m256i uvLow = _mm256_or_si256(u[0], _mm256_slli_epi32(v[0], 8));
+        __m256i uvHigh = _mm256_or_si256(u[1], _mm256_slli_epi32(v[1], 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(uvRow + x), RestoreOrder(_mm256_packus_epi32(uvLow, uvHigh)));
+    }
+
+    BGRAToNV12RowPairTail_C(srcRow0, srcRow1, yRow0, yRow1, uvRow, x, width);
+}
+
+void BGRAToI420RowPair_AVX2(const BYTE* srcRow0, const BYTE* srcRow1,
+                            BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width)
+{
+    const KernelConstants c = LoadConstants();
+    const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+
+    UINT x = 0;
+    for (; x + 32 <= width; x += 32)
+    {
+        __m256i u[2];
+        __m256i v[2];
+        ConvertRowPair32(srcRow0 + x * 4, row1 + x * 4, yRow0 + x, yRow1 ? yRow1 + x : nullptr, c, u, v);
+
+        // 先把U、V各自打包为16个按顺序排列的16位值，再打包为字节：
+        // 通道内为[U0-7 V0-7 | U8-15 V8-15]，64位置换后低128位为U，高128位为V
+        __m256i uWords = RestoreOrder(_mm256_packs_epi32(u[0], u[1]));
+        __m256i vWords = RestoreOrder(_mm256_packs_epi32(v[0], v[1]));
+        __m256i uv = _mm256_permute4x64_epi64(_mm256_packus_epi16(uWords, vWords), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(uRow + x / 2), _mm256_castsi256_si128(uv));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(vRow + x / 2), _mm256_extracti128_si256(uv, 1));
+    }
+
+    BGRAToI420RowPairTail_C(srcRow0, srcRow1, yRow0, yRow1, uRow, vRow, x, width);
+}
@@ -0,0 +1,152 @@
+#include "BGRAToYUV420Kernels.h"
+#include "ColorConversionMath.h"
+#include <smmintrin.h>
+
+// SSE4.1内核：算法与AVX2版本相同，每个寄存器处理4个像素，每次迭代处理两行各16个像素
+namespace
+{
+    struct CoefficientVectors
+    {
+        __m128i BRHigh;
+        __m128i BRLow;
+        __m128i GOneHigh;
+        __m128i GOneLow;
+    };
+
+    struct KernelConstants
+    {
+        CoefficientVectors Y;
+        CoefficientVectors U;
+        CoefficientVectors V;
+    };
+
+    inline CoefficientVectors LoadCoefficients(int coefB, int coefR, int coefG, int coefOne)
+    {
+        CoefficientVectors c;
+        c.BRHigh = _mm_set1_epi32(PackCoefficientPair(CoefficientHigh(coefB), CoefficientHigh(coefR)));
+        c.BRLow = _mm_set1_epi32(PackCoefficientPair(CoefficientLow(coefB), CoefficientLow(coefR)));
+        c.GOneHigh = _mm_set1_epi32(PackCoefficientPair(CoefficientHigh(coefG), CoefficientHigh(coefOne)));
+        c.GOneLow = _mm_set1_epi32(PackCoefficientPair(CoefficientLow(coefG), CoefficientLow(coefOne)));
+        return c;
+    }
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.Y = LoadCoefficients(kYCoefB, kYCoefR, kYCoefG, kYCoefOne);
+        c.U = LoadCoefficients(kUCoefB, kUCoefR, kUCoefG, kUVCoefOne);
+        c.V = LoadCoefficients(kVCoefB, kVCoefR, kVCoefG, kUVCoefOne);
+        return c;
+    }
+
+    inline __m128i MultiplyAdd(__m128i br, __m128i gOne, const CoefficientVectors& c)
+    {
+        __m128i high = _mm_add_epi32(_mm_madd_epi16(br, c.BRHigh), _mm_madd_epi16(gOne, c.GOneHigh));
+        __m128i low = _mm_add_epi32(_mm_madd_epi16(br, c.BRLow), _mm_madd_epi16(gOne, c.GOneLow));
+        return _mm_add_epi32(_mm_slli_epi32(high, kCoefSplitShift), low);
+    }
+
+    // 转换4个像素：y为钳位后的8位Y，u/v累加钳位后的定点UV（保留小数位）
+    inline __m128i ConvertPixels4(__m128i pixels, const KernelConstants& c, __m128i& u, __m128i& v)
+    {
+        const __m128i maskBR = _mm_set1_epi32(0x00FF00FF);
+        const __m128i maskG = _mm_set1_epi32(0x000000FF);
+        const __m128i oneLane = _mm_set1_epi32(kFixedOneLane << 16);
+        const __m128i uvMin = _mm_set1_epi32(kUVFixedMin);
+        const __m128i uvMax = _mm_set1_epi32(kUVFixedMax);
+
+        __m128i br = _mm_and_si128(pixels, maskBR);
+        __m128i gOne = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 8), maskG), oneLane);
+
+        __m128i y = _mm_srai_epi32(MultiplyAdd(br, gOne, c.Y), kFixedShift);
+        y = _mm_min_epi32(_mm_max_epi32(y, _mm_set1_epi32(16)), _mm_set1_epi32(235));
+        u = _mm_add_epi32(u, _mm_min_epi32(_mm_max_epi32(MultiplyAdd(br, gOne, c.U), uvMin), uvMax));
+        v = _mm_add_epi32(v, _mm_min_epi32(_mm_max_epi32(MultiplyAdd(br, gOne, c.V), uvMin), uvMax));
+        return y;
+    }
+
+    // 两个垂直方向已相加的UV向量（各4个像素）中相邻像素再相加，得到4个2x2块的平均值
+    inline __m128i AverageBlocks(__m128i a, __m128i b)
+    {
+        // 四个值之和按无符号数解释（见FixedAverageUV4）
+        const __m128i uvRound = _mm_set1_epi32(1 << (kFixedShift + 1));
+        return _mm_srli_epi32(_mm_add_epi32(_mm_hadd_epi32(a, b), uvRound), kFixedShift + 2);
+    }
+
+    // 转换两行各16个像素：写出两行Y，返回8个2x2块的U、V平均值（各两个向量，每个32位通道一个块）
+    inline void ConvertRowPair16(const BYTE* src0Bytes, const BYTE* src1Bytes, BYTE* yRow0, BYTE* yRow1,
+                                 const KernelConstants& c, __m128i* uAverage, __m128i* vAverage)
+    {
+        const __m128i* src0 = reinterpret_cast<const __m128i*>(src0Bytes);
+        const __m128i* src1 = reinterpret_cast<const __m128i*>(src1Bytes);
+
+        __m128i u[4];
+        __m128i v[4];
+        __m128i y0[4];
+        __m128i y1[4];
+        for (int i = 0; i < 4; i++)
+        {
+            u[i] = _mm_setzero_si128();
+            v[i] = _mm_setzero_si128();
+            y0[i] = ConvertPixels4(_mm_loadu_si128(src0 + i), c, u[i], v[i]);
+            y1[i] = ConvertPixels4(_mm_loadu_si128(src1 + i), c, u[i], v[i]);
+        }
+
+        __m128i packedY0 = _mm_packus_epi16(_mm_packs_epi32(y0[0], y0[1]), _mm_packs_epi32(y0[2], y0[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(yRow0), packedY0);
+        if (yRow1)
+        {
+            __m128i packedY1 = _mm_packus_epi16(_mm_packs_epi32(y1[0], y1[1]), _mm_packs_epi32(y1[2], y1[3]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(yRow1), packedY1);
+        }
+
+        uAverage[0] = AverageBlocks(u[0], u[1]);
+        uAverage[1] = AverageBlocks(u[2], u[3]);
+        vAverage[0] = AverageBlocks(v[0], v[1]);
+        vAverage[1] = AverageBlocks(v[2], v[3]);
+    }
+}
+
+void BGRAToNV12RowPair_SSE41(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uvRow, UINT width)
+{
+    const KernelConstants c = LoadConstants();
+    const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+
+    UINT x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i u[2];
+        __m128i v[2];
+        ConvertRowPair16(srcRow0 + x * 4, row1 + x * 4, yRow0 + x, yRow1 ? yRow1 + x : nullptr, c, u, v);
+
+        // 每个32位通道为一个UV对（U | V << 8），打包为8个16位值
+        __m128i uvLow = _mm_or_si128(u[0], _mm_slli_epi32(v[0], 8));
+        __m128i uvHigh = _mm_or_si128(u[1], _mm_slli_epi32(v[1], 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(uvRow + x), _mm_packus_epi32(uvLow, uvHigh));
+    }
+
+    BGRAToNV12RowPairTail_C(srcRow0, srcRow1, yRow0, yRow1, uvRow, x, width);
+}
+
+void BGRAToI420RowPair_SSE41(const BYTE* srcRow0, const BYTE* srcRow1,
+                             BYTE* yRow0, BYTE* yRow1, BYTE* uRow, BYTE* vRow, UINT width)
+{
+    const KernelConstants c = LoadConstants();
+    const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+
+    UINT x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i u[2];
+        __m128i v[2];
+        ConvertRowPair16(srcRow0 + x * 4, row1 + x * 4, yRow0 + x, yRow1 ? yRow1 + x : nullptr, c, u, v);
+
+        // 低8字节为8个U，高8字节为8个V
+        __m128i uv = _mm_packus_epi16(_mm_packs_epi32(u[0], u[1]), _mm_packs_epi32(v[0], v[1]));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(uRow + x / 2), uv);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(vRow + x / 2), _mm_srli_si128(uv, 8));
+    }
+
+    BGRAToI420RowPairTail_C(srcRow0, srcRow1, yRow0, yRow1, uRow, vRow, x, width);
+}
@@ -0,0 +1,116 @@
+#include "BGRAToYUV444Kernels.h"
+#include "ColorConversionMath.h"
+
+void BGRAToI444RowTail_C(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT firstPixel, UINT width)
+{
+    for (UINT x = firstPixel; x < width; x++)
+    {
+        const BYTE* p = srcRow + x * 4;
+        yRow[x] = static_cast<BYTE>(FixedY(p[2], p[1], p[0]));
+        uRow[x] = static_cast<BYTE>(FixedRoundUV(FixedU(p[2], p[1], p[0])));
+        vRow[x] = static_cast<BYTE>(FixedRoundUV(FixedV(p[2], p[1], p[0])));
+    }
+}
+
+void BGRAToAYUVRowTail_C(const BYTE* srcRow, BYTE* dstRow, UINT firstPixel, UINT width)
+{
+    for (UINT x = firstPixel; x < width; x++)
+    {
+        const BYTE* p = srcRow + x * 4;
+        BYTE* out = dstRow + x * 4;
+        out[0] = static_cast<BYTE>(FixedRoundUV(FixedV(p[2], p[1], p[0])));
+        out[1] = static_cast<BYTE>(FixedRoundUV(FixedU(p[2], p[1], p[0])));
+        out[2] = static_cast<BYTE>(FixedY(p[2], p[1], p[0]));
+        out[3] = p[3];
+    }
+}
+
+void BGRAToI444Row_C(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width)
+{
+    BGRAToI444RowTail_C(srcRow, yRow, uRow, vRow, 0, width);
+}
+
+void BGRAToAYUVRow_C(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    BGRAToAYUVRowTail_C(srcRow, dstRow, 0, width);
+}
+
+void BGRAToI444Row_Float(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width)
+{
+    for (UINT x = 0; x < width; x++)
+    {
+        const BYTE* p = srcRow + x * 4;
+        YUVFloat yuv = RGBToYUV(UnormToFloat(p[2]), UnormToFloat(p[1]), UnormToFloat(p[0]));
+        yRow[x] = static_cast<BYTE>(RoundToUInt(yuv.Y));
+        uRow[x] = static_cast<BYTE>(RoundToUInt(yuv.U));
+        vRow[x] = static_cast<BYTE>(RoundToUInt(yuv.V));
+    }
+}
+
+void BGRAToAYUVRow_Float(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    for (UINT x = 0; x < width; x++)
+    {
+        const BYTE* p = srcRow + x * 4;
+        BYTE* out = dstRow + x * 4;
+        YUVFloat yuv = RGBToYUV(UnormToFloat(p[2]), UnormToFloat(p[1]), UnormToFloat(p[0]));
+        out[0] = static_cast<BYTE>(RoundToUInt(yuv.V));
+        out[1] = static_cast<BYTE>(RoundToUInt(yuv.U));
+        out[2] = static_cast<BYTE>(RoundToUInt(yuv.Y));
+        out[3] = p[3];
+    }
+}
+
+BGRAToI444RowFunc GetBGRAToI444RowKernel(SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    BGRAToI444RowFunc kernel = BGRAToI444Row_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernel = BGRAToI444Row_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = BGRAToI444Row_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
+
+BGRAToAYUVRowFunc GetBGRAToAYUVRowKernel(SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    BGRAToAYUVRowFunc kernel = BGRAToAYUVRow_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernel = BGRAToAYUVRow_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = BGRAToAYUVRow_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
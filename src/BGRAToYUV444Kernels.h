@@ -0,0 +1,32 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+
+// BGRA到4:4:4（不降采样色度）的CPU行转换内核，用于文字较多的屏幕内容：
+//   I444：Y、U、V三个平面，每个像素各1字节
+//   AYUV：打包格式，每个像素4字节，内存字节序为[V U Y A]（与DXGI_FORMAT_AYUV相同），A取自源像素
+// 每个像素的Y、U、V与YUY2/NV12使用同一套定点公式，只是UV不做平均（FixedRoundUV），
+// 因此平坦区域的结果与YUY2相同。所有内核输出逐位一致；SIMD内核最高提供AVX2版本
+typedef void (*BGRAToI444RowFunc)(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width);
+typedef void (*BGRAToAYUVRowFunc)(const BYTE* srcRow, BYTE* dstRow, UINT width);
+
+void BGRAToI444Row_C(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width);
+void BGRAToAYUVRow_C(const BYTE* srcRow, BYTE* dstRow, UINT width);
+// 浮点参考（与shader公式相同），ConversionPrecision::FloatReference使用
+void BGRAToI444Row_Float(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width);
+void BGRAToAYUVRow_Float(const BYTE* srcRow, BYTE* dstRow, UINT width);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+void BGRAToI444Row_SSE41(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width);
+void BGRAToAYUVRow_SSE41(const BYTE* srcRow, BYTE* dstRow, UINT width);
+void BGRAToI444Row_AVX2(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width);
+void BGRAToAYUVRow_AVX2(const BYTE* srcRow, BYTE* dstRow, UINT width);
+#endif
+
+// 从第firstPixel个像素开始用标量定点代码转换到行尾，供SIMD内核处理尾部
+void BGRAToI444RowTail_C(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT firstPixel, UINT width);
+void BGRAToAYUVRowTail_C(const BYTE* srcRow, BYTE* dstRow, UINT firstPixel, UINT width);
+
+// 返回不超过level的最优内核（该转换最高提供AVX2版本）
+BGRAToI444RowFunc GetBGRAToI444RowKernel(SimdLevel level, SimdLevel* selectedLevel = nullptr);
+BGRAToAYUVRowFunc GetBGRAToAYUVRowKernel(SimdLevel level, SimdLevel* selectedLevel = nullptr);
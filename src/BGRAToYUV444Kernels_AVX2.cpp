@@ -0,0 +1,133 @@
+#include "BGRAToYUV444Kernels.h"
+#include "ColorConversionMath.h"
+#include <immintrin.h>
+
+// AVX2内核：每个32位通道一个BGRA像素，定点公式与BGRAToYUY2Kernels_AVX2.cpp相同。
+// 每次迭代处理32个像素；I444的打包在128位通道内进行，最后用一次跨通道置换恢复像素顺序，
+// AYUV每个32位通道直接就是一个输出像素，不需要打包
+namespace
+{
+    struct CoefficientVectors
+    {
+        __m256i BRHigh;
+        __m256i BRLow;
+        __m256i GOneHigh;
+        __m256i GOneLow;
+    };
+
+    struct KernelConstants
+    {
+        CoefficientVectors Y;
+        CoefficientVectors U;
+        CoefficientVectors V;
+    };
+
+    inline CoefficientVectors LoadCoefficients(int coefB, int coefR, int coefG, int coefOne)
+    {
+        CoefficientVectors c;
+        c.BRHigh = _mm256_set1_epi32(PackCoefficientPair(CoefficientHigh(coefB), CoefficientHigh(coefR)));
+        c.BRLow = _mm256_set1_epi32(PackCoefficientPair(CoefficientLow(coefB), CoefficientLow(coefR)));
+        c.GOneHigh = _mm256_set1_epi32(PackCoefficientPair(CoefficientHigh(coefG), CoefficientHigh(coefOne)));
+        c.GOneLow = _mm256_set1_epi32(PackCoefficientPair(CoefficientLow(coefG), CoefficientLow(coefOne)));
+        return c;
+    }
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.Y = LoadCoefficients(kYCoefB, kYCoefR, kYCoefG, kYCoefOne);
+        c.U = LoadCoefficients(kUCoefB, kUCoefR, kUCoefG, kUVCoefOne);
+        c.V = LoadCoefficients(kVCoefB, kVCoefR, kVCoefG, kUVCoefOne);
+        return c;
+    }
+
+    inline __m256i MultiplyAdd(__m256i br, __m256i gOne, const CoefficientVectors& c)
+    {
+        __m256i high = _mm256_add_epi32(_mm256_madd_epi16(br, c.BRHigh), _mm256_madd_epi16(gOne, c.GOneHigh));
+        __m256i low = _mm256_add_epi32(_mm256_madd_epi16(br, c.BRLow), _mm256_madd_epi16(gOne, c.GOneLow));
+        return _mm256_add_epi32(_mm256_slli_epi32(high, kCoefSplitShift), low);
+    }
+
+    // 转换8个像素：每个32位通道得到一个8位的Y、U、V
+    inline void ConvertPixels8(__m256i pixels, const KernelConstants& c, __m256i& y, __m256i& u, __m256i& v)
+    {
+        const __m256i maskBR = _mm256_set1_epi32(0x00FF00FF);
+        const __m256i maskG = _mm256_set1_epi32(0x000000FF);
+        const __m256i oneLane = _mm256_set1_epi32(kFixedOneLane << 16);
+        const __m256i uvMin = _mm256_set1_epi32(kUVFixedMin);
+        const __m256i uvMax = _mm256_set1_epi32(kUVFixedMax);
+        const __m256i uvRound = _mm256_set1_epi32(1 << (kFixedShift - 1));
+
+        __m256i br = _mm256_and_si256(pixels, maskBR);
+        __m256i gOne = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), maskG), oneLane);
+
+        y = _mm256_srai_epi32(MultiplyAdd(br, gOne, c.Y), kFixedShift);
+        y = _mm256_min_epi32(_mm256_max_epi32(y, _mm256_set1_epi32(16)), _mm256_set1_epi32(235));
+        u = _mm256_min_epi32(_mm256_max_epi32(MultiplyAdd(br, gOne, c.U), uvMin), uvMax);
+        v = _mm256_min_epi32(_mm256_max_epi32(MultiplyAdd(br, gOne, c.V), uvMin), uvMax);
+        u = _mm256_srli_epi32(_mm256_add_epi32(u, uvRound), kFixedShift);
+        v = _mm256_srli_epi32(_mm256_add_epi32(v, uvRound), kFixedShift);
+    }
+
+    // 四个向量（各8个32位值）在通道内打包后32位单元的顺序为[0 4 1 5 2 6 3 7]，恢复为顺序排列
+    inline __m256i PackBytes(const __m256i* values)
+    {
+        __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(values[0], values[1]),
+                                             _mm256_packs_epi32(values[2], values[3]));
+        return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    }
+}
+
+void BGRAToI444Row_AVX2(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width)
+{
+    const KernelConstants c = LoadConstants();
+
+    UINT x = 0;
+    for (; x + 32 <= width; x += 32)
+    {
+        const __m256i* src = reinterpret_cast<const __m256i*>(srcRow + x * 4);
+
+        __m256i y[4];
+        __m256i u[4];
+        __m256i v[4];
+        for (int i = 0; i < 4; i++)
+        {
+            ConvertPixels8(_mm256_loadu_si256(src + i), c, y[i], u[i], v[i]);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(yRow + x), PackBytes(y));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(uRow + x), PackBytes(u));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(vRow + x), PackBytes(v));
+    }
+
+    BGRAToI444RowTail_C(srcRow, yRow, uRow, vRow, x, width);
+}
+
+void BGRAToAYUVRow_AVX2(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    const KernelConstants c = LoadConstants();
+    const __m256i maskA = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+    UINT x = 0;
+    for (; x + 32 <= width; x += 32)
+    {
+        const __m256i* src = reinterpret_cast<const __m256i*>(srcRow + x * 4);
+        __m256i* dst = reinterpret_cast<__m256i*>(dstRow + x * 4);
+        for (int i = 0; i < 4; i++)
+        {
+            __m256i pixels = _mm256_loadu_si256(src + i);
+            __m256i y;
+            __m256i u;
+            __m256i v;
+            ConvertPixels8(pixels, c, y, u, v);
+
+            // V | U << 8 | Y << 16 | A << 24
+            __m256i ayuv = _mm256_or_si256(_mm256_or_si256(v, _mm256_slli_epi32(u, 8)),
+                                           _mm256_or_si256(_mm256_slli_epi32(y, 16),
+                                                           _mm256_and_si256(pixels, maskA)));
+            _mm256_storeu_si256(dst + i, ayuv);
+        }
+    }
+
+    BGRAToAYUVRowTail_C(srcRow, dstRow, x, width);
+}
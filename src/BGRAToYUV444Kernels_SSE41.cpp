@@ -0,0 +1,127 @@
+#include "BGRAToYUV444Kernels.h"
+#include "ColorConversionMath.h"
+#include <smmintrin.h>
+
+// SSE4.1内核：算法与AVX2版本相同，每个寄存器处理4个像素，每次迭代处理16个像素
+namespace
+{
+    struct CoefficientVectors
+    {
+        __m128i BRHigh;
+        __m128i BRLow;
+        __m128i GOneHigh;
+        __m128i GOneLow;
+    };
+
+    struct KernelConstants
+    {
+        CoefficientVectors Y;
+        CoefficientVectors U;
+        CoefficientVectors V;
+    };
+
+    inline CoefficientVectors LoadCoefficients(int coefB, int coefR, int coefG, int coefOne)
+    {
+        CoefficientVectors c;
+        c.BRHigh = _mm_set1_epi32(PackCoefficientPair(CoefficientHigh(coefB), CoefficientHigh(coefR)));
+        c.BRLow = _mm_set1_epi32(PackCoefficientPair(CoefficientLow(coefB), CoefficientLow(coefR)));
+        c.GOneHigh = _mm_set1_epi32(PackCoefficientPair(CoefficientHigh(coefG), CoefficientHigh(coefOne)));
+        c.GOneLow = _mm_set1_epi32(PackCoefficientPair(CoefficientLow(coefG), CoefficientLow(coefOne)));
+        return c;
+    }
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.Y = LoadCoefficients(kYCoefB, kYCoefR, kYCoefG, kYCoefOne);
+        c.U = LoadCoefficients(kUCoefB, kUCoefR, kUCoefG, kUVCoefOne);
+        c.V = LoadCoefficients(kVCoefB, kVCoefR, kVCoefG, kUVCoefOne);
+        return c;
+    }
+
+    inline __m128i MultiplyAdd(__m128i br, __m128i gOne, const CoefficientVectors& c)
+    {
+        __m128i high = _mm_add_epi32(_mm_madd_epi16(br, c.BRHigh), _mm_madd_epi16(gOne, c.GOneHigh));
+        __m128i low = _mm_add_epi32(_mm_madd_epi16(br, c.BRLow), _mm_madd_epi16(gOne, c.GOneLow));
+        return _mm_add_epi32(_mm_slli_epi32(high, kCoefSplitShift), low);
+    }
+
+    // 转换4个像素：每个32位通道得到一个8位的Y、U、V
+    inline void ConvertPixels4(__m128i pixels, const KernelConstants& c, __m128i& y, __m128i& u, __m128i& v)
+    {
+        const __m128i maskBR = _mm_set1_epi32(0x00FF00FF);
+        const __m128i maskG = _mm_set1_epi32(0x000000FF);
+        const __m128i oneLane = _mm_set1_epi32(kFixedOneLane << 16);
+        const __m128i uvMin = _mm_set1_epi32(kUVFixedMin);
+        const __m128i uvMax = _mm_set1_epi32(kUVFixedMax);
+        const __m128i uvRound = _mm_set1_epi32(1 << (kFixedShift - 1));
+
+        __m128i br = _mm_and_si128(pixels, maskBR);
+        __m128i gOne = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 8), maskG), oneLane);
+
+        y = _mm_srai_epi32(MultiplyAdd(br, gOne, c.Y), kFixedShift);
+        y = _mm_min_epi32(_mm_max_epi32(y, _mm_set1_epi32(16)), _mm_set1_epi32(235));
+        u = _mm_min_epi32(_mm_max_epi32(MultiplyAdd(br, gOne, c.U), uvMin), uvMax);
+        v = _mm_min_epi32(_mm_max_epi32(MultiplyAdd(br, gOne, c.V), uvMin), uvMax);
+        u = _mm_srli_epi32(_mm_add_epi32(u, uvRound), kFixedShift);
+        v = _mm_srli_epi32(_mm_add_epi32(v, uvRound), kFixedShift);
+    }
+
+    inline __m128i PackBytes(const __m128i* values)
+    {
+        return _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+    }
+}
+
+void BGRAToI444Row_SSE41(const BYTE* srcRow, BYTE* yRow, BYTE* uRow, BYTE* vRow, UINT width)
+{
+    const KernelConstants c = LoadConstants();
+
+    UINT x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        const __m128i* src = reinterpret_cast<const __m128i*>(srcRow + x * 4);
+
+        __m128i y[4];
+        __m128i u[4];
+        __m128i v[4];
+        for (int i = 0; i < 4; i++)
+        {
+            ConvertPixels4(_mm_loadu_si128(src + i), c, y[i], u[i], v[i]);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(yRow + x), PackBytes(y));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(uRow + x), PackBytes(u));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(vRow + x), PackBytes(v));
+    }
+
+    BGRAToI444RowTail_C(srcRow, yRow, uRow, vRow, x, width);
+}
+
+void BGRAToAYUVRow_SSE41(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    const KernelConstants c = LoadConstants();
+    const __m128i maskA = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    UINT x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        const __m128i* src = reinterpret_cast<const __m128i*>(srcRow + x * 4);
+        __m128i* dst = reinterpret_cast<__m128i*>(dstRow + x * 4);
+        for (int i = 0; i < 4; i++)
+        {
+            __m128i pixels = _mm_loadu_si128(src + i);
+            __m128i y;
+            __m128i u;
+            __m128i v;
+            ConvertPixels4(pixels, c, y, u, v);
+
+            // 每个32位通道直接就是一个输出像素：V | U << 8 | Y << 16 | A << 24
+            __m128i ayuv = _mm_or_si128(_mm_or_si128(v, _mm_slli_epi32(u, 8)),
+                                        _mm_or_si128(_mm_slli_epi32(y, 16), _mm_and_si128(pixels, maskA)));
+            _mm_storeu_si128(dst + i, ayuv);
+        }
+    }
+
+    BGRAToAYUVRowTail_C(srcRow, dstRow, x, width);
+}
@@ -7,7 +7,28 @@ BGRAToYUY2Converter::BGRAToYUY2Converter()
     : m_device(nullptr)
     , m_context(nullptr)
     , m_computeShader(nullptr)
+    , m_moveShader(nullptr)
+    , m_moveScratchBuffer(nullptr)
+    , m_moveScratchSRV(nullptr)
+    , m_moveScratchSize(0)
+    , m_cursorBuffer(nullptr)
+    , m_cursorSRV(nullptr)
+    , m_cursorWidth(0)
+    , m_cursorHeight(0)
+    , m_cursorAlphaBlend(false)
+    , m_cursorX(0)
+    , m_cursorY(0)
+    , m_cursorVisible(false)
     , m_constantBuffer(nullptr)
+    , m_stagingBuffer(nullptr)
+    , m_stagingBufferSize(0)
+    , m_stagingMapped(false)
+    , m_inputVerifyTexture(nullptr)
+    , m_completionQuery(nullptr)
+    , m_inputViews()
+    , m_outputViews()
+    , m_nextInputView(0)
+    , m_nextOutputView(0)
     , m_initialized(false)
     , m_lastLogTime(std::chrono::steady_clock::now())
 {
@@ -42,6 +63,12 @@ HRESULT BGRAToYUY2Converter::Initialize(ID3D11Device* device, ID3D11DeviceContex
         ThrowIfFailed(m_device->CreateBuffer(&cbDesc, nullptr, &m_constantBuffer),
                      "Failed to create constant buffer");
 
+        // 创建用于等待GPU完成的事件查询
+        D3D11_QUERY_DESC queryDesc = {};
+        queryDesc.Query = D3D11_QUERY_EVENT;
+        ThrowIfFailed(m_device->CreateQuery(&queryDesc, &m_completionQuery),
+                     "Failed to create completion query");
+
         m_initialized = true;
         LogMessage("BGRA to YUY2 converter initialized successfully");
         return S_OK;
@@ -68,16 +95,28 @@ HRESULT BGRAToYUY2Converter::CompileShader()
                             std::istreambuf_iterator<char>());
     shaderFile.close();
 
+    // 同一文件中的转换和区域移动两个入口
+    HRESULT hr = CompileEntryPoint(shaderSource, "CSMain", &m_computeShader);
+    if (SUCCEEDED(hr))
+    {
+        hr = CompileEntryPoint(shaderSource, "CSMove", &m_moveShader);
+    }
+    return hr;
+}
+
+HRESULT BGRAToYUY2Converter::CompileEntryPoint(const std::string& source, const char* entryPoint,
+                                              ID3D11ComputeShader** outShader)
+{
     ID3DBlob* shaderBlob = nullptr;
     ID3DBlob* errorBlob = nullptr;
 
     HRESULT hr = D3DCompile(
-        shaderSource.c_str(),
-        shaderSource.size(),
+        source.c_str(),
+        source.size(),
         "BGRAToYUY2.hlsl",
         nullptr,
         nullptr,
-        "CSMain",
+        entryPoint,
         "cs_5_0",
         D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION,
         0,
@@ -100,16 +139,16 @@ HRESULT BGRAToYUY2Converter::CompileShader()
         shaderBlob->GetBufferPointer(),
         shaderBlob->GetBufferSize(),
         nullptr,
-        &m_computeShader
+        outShader
     );
 
     shaderBlob->Release();
     return hr;
 }
 
-HRESULT BGRAToYUY2Converter::CreateOutputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer)
+D3D11_BUFFER_DESC BGRAToYUY2Converter::GetOutputBufferDesc(UINT width, UINT height, UINT outputPitch)
 {
-    UINT yuy2Size = ((width + 1) / 2) * height * 4; // YUY2格式大小
+    UINT yuy2Size = GetOutputPitch(width, outputPitch) * height; // YUY2格式大小（含行填充）
 
     D3D11_BUFFER_DESC bufferDesc = {};
     bufferDesc.ByteWidth = yuy2Size;
@@ -118,6 +157,17 @@ HRESULT BGRAToYUY2Converter::CreateOutputBuffer(UINT width, UINT height, ID3D11B
     bufferDesc.CPUAccessFlags = 0;
     bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
     bufferDesc.StructureByteStride = 0; // 原始缓冲区不需要结构大小
+    return bufferDesc;
+}
+
+HRESULT BGRAToYUY2Converter::CreateOutputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer,
+                                                UINT outputPitch)
+{
+    UINT pitch = GetOutputPitch(width, outputPitch);
+    if (pitch % 4 != 0 || pitch < ((width + 1) / 2) * 4)
+        return E_INVALIDARG;
+
+    D3D11_BUFFER_DESC bufferDesc = GetOutputBufferDesc(width, height, outputPitch);
 
     HRESULT hr = m_device->CreateBuffer(&bufferDesc, nullptr, outBuffer);
     if (FAILED(hr))
@@ -128,12 +178,210 @@ HRESULT BGRAToYUY2Converter::CreateOutputBuffer(UINT width, UINT height, ID3D11B
     return hr;
 }
 
+D3D11_TEXTURE2D_DESC BGRAToYUY2Converter::GetInputTextureDesc(UINT width, UINT height)
+{
+    D3D11_TEXTURE2D_DESC textureDesc = {};
+    textureDesc.Width = width;
+    textureDesc.Height = height;
+    textureDesc.MipLevels = 1;
+    textureDesc.ArraySize = 1;
+    textureDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    textureDesc.SampleDesc.Count = 1;
+    textureDesc.SampleDesc.Quality = 0;
+    textureDesc.Usage = D3D11_USAGE_DEFAULT;
+    textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    textureDesc.CPUAccessFlags = 0;
+    textureDesc.MiscFlags = 0;
+    return textureDesc;
+}
+
+HRESULT BGRAToYUY2Converter::CreateInputTexture(UINT width, UINT height, ID3D11Texture2D** outTexture)
+{
+    D3D11_TEXTURE2D_DESC textureDesc = GetInputTextureDesc(width, height);
+
+    HRESULT hr = m_device->CreateTexture2D(&textureDesc, nullptr, outTexture);
+    if (FAILED(hr))
+    {
+        LogError("Failed to create input BGRA texture");
+    }
+
+    return hr;
+}
+
+HRESULT BGRAToYUY2Converter::WriteBGRAData(ID3D11Texture2D* texture, const ImageView& source)
+{
+    if (!texture || !IsImageViewValid(source, 1, source.Width, source.Height) ||
+        source.Planes[0].RowBytes < source.Width * 4)
+        return E_INVALIDARG;
+
+    // UpdateSubresource按源行步长读取，带填充的缓冲区可以直接上传
+    D3D11_BOX box = { 0, 0, 0, source.Width, source.Height, 1 };
+    m_context->UpdateSubresource(texture, 0, &box, source.Planes[0].Data, source.Planes[0].Pitch, 0);
+    return S_OK;
+}
+
+ID3D11View* BGRAToYUY2Converter::FindCachedView(const CachedView* cache, ID3D11Resource* resource, UINT key)
+{
+    for (UINT i = 0; i < kViewCacheSize; i++)
+    {
+        if (cache[i].View && cache[i].Resource == resource && cache[i].Key == key)
+            return cache[i].View;
+    }
+    return nullptr;
+}
+
+void BGRAToYUY2Converter::StoreCachedView(CachedView* cache, UINT& nextSlot, ID3D11Resource* resource,
+                                          UINT key, ID3D11View* view)
+{
+    // 轮换替换最早的缓存项
+    CachedView& entry = cache[nextSlot];
+    SAFE_RELEASE(entry.View);
+    entry.Resource = resource;
+    entry.Key = key;
+    entry.View = view;
+    nextSlot = (nextSlot + 1) % kViewCacheSize;
+}
+
+void BGRAToYUY2Converter::ClearViewCache(CachedView* cache)
+{
+    for (UINT i = 0; i < kViewCacheSize; i++)
+    {
+        SAFE_RELEASE(cache[i].View);
+        cache[i].Resource = nullptr;
+        cache[i].Key = 0;
+    }
+}
+
+HRESULT BGRAToYUY2Converter::GetInputView(ID3D11Texture2D* texture, DXGI_FORMAT format,
+                                         ID3D11ShaderResourceView** outView)
+{
+    ID3D11View* cached = FindCachedView(m_inputViews, texture, format);
+    if (cached)
+    {
+        *outView = static_cast<ID3D11ShaderResourceView*>(cached);
+        return S_OK;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = format;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = 1;
+
+    ID3D11ShaderResourceView* view = nullptr;
+    HRESULT hr = m_device->CreateShaderResourceView(texture, &srvDesc, &view);
+    if (FAILED(hr))
+        return hr;
+
+    StoreCachedView(m_inputViews, m_nextInputView, texture, format, view);
+    *outView = view;
+    return S_OK;
+}
+
+HRESULT BGRAToYUY2Converter::GetOutputView(ID3D11Buffer* buffer, UINT numElements,
+                                          ID3D11UnorderedAccessView** outView)
+{
+    ID3D11View* cached = FindCachedView(m_outputViews, buffer, numElements);
+    if (cached)
+    {
+        *outView = static_cast<ID3D11UnorderedAccessView*>(cached);
+        return S_OK;
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;  // 必须使用TYPELESS配合RAW缓冲区
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.FirstElement = 0;
+    uavDesc.Buffer.NumElements = numElements;
+    uavDesc.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;  // 必须使用RAW标志
+
+    ID3D11UnorderedAccessView* view = nullptr;
+    HRESULT hr = m_device->CreateUnorderedAccessView(buffer, &uavDesc, &view);
+    if (FAILED(hr))
+        return hr;
+
+    StoreCachedView(m_outputViews, m_nextOutputView, buffer, numElements, view);
+    *outView = view;
+    return S_OK;
+}
+
+HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
+                                    UINT width, UINT height, UINT outputPitch)
+{
+    ImageRect fullFrame = MakeImageRect(0, 0, width, height);
+    return ConvertRegions(inputTexture, outputBuffer, width, height, &fullFrame, 1, outputPitch, true);
+}
+
+HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
+                                    UINT width, UINT height, const ImageRect* dirtyRects, UINT rectCount,
+                                    UINT outputPitch)
+{
+    if (rectCount > 0 && !dirtyRects)
+        return E_INVALIDARG;
+    return ConvertRegions(inputTexture, outputBuffer, width, height, dirtyRects, rectCount, outputPitch, false);
+}
+
+HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
+                                    UINT sourceWidth, UINT sourceHeight, const ImageOrientation& orientation,
+                                    UINT outputPitch)
+{
+    UINT width;
+    UINT height;
+    GetOrientedSize(orientation, sourceWidth, sourceHeight, width, height);
+    ImageRect fullFrame = MakeImageRect(0, 0, width, height);
+    return Convert(inputTexture, outputBuffer, sourceWidth, sourceHeight, orientation, &fullFrame, 1, outputPitch);
+}
+
 HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
-                                    UINT width, UINT height)
+                                    UINT sourceWidth, UINT sourceHeight, const ImageOrientation& orientation,
+                                    const ImageRect* dirtyRects, UINT rectCount, UINT outputPitch)
+{
+    if (!inputTexture || sourceWidth == 0 || sourceHeight == 0 || (rectCount > 0 && !dirtyRects))
+        return E_INVALIDARG;
+
+    D3D11_TEXTURE2D_DESC texDesc;
+    inputTexture->GetDesc(&texDesc);
+    if (sourceWidth > texDesc.Width || sourceHeight > texDesc.Height)
+        return E_INVALIDARG;
+
+    UINT width;
+    UINT height;
+    GetOrientedSize(orientation, sourceWidth, sourceHeight, width, height);
+    ImageOrientationMap map = GetImageOrientationMap(orientation, sourceWidth, sourceHeight);
+    return ConvertRegions(inputTexture, outputBuffer, width, height, dirtyRects, rectCount, outputPitch, false, &map);
+}
+
+HRESULT BGRAToYUY2Converter::ConvertCrop(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
+                                        const ImageRect& sourceRect, UINT outputPitch)
+{
+    if (!inputTexture || IsImageRectEmpty(sourceRect))
+        return E_INVALIDARG;
+
+    D3D11_TEXTURE2D_DESC texDesc;
+    inputTexture->GetDesc(&texDesc);
+    if (sourceRect.Right > texDesc.Width || sourceRect.Bottom > texDesc.Height)
+        return E_INVALIDARG;
+
+    // 在输出坐标系中整帧转换，着色器读取输入时加上区域的偏移
+    UINT width = sourceRect.Right - sourceRect.Left;
+    UINT height = sourceRect.Bottom - sourceRect.Top;
+    ImageRect fullFrame = MakeImageRect(0, 0, width, height);
+    ImageOrientationMap map = GetImageOrientationMap(MakeImageOrientation(ImageRotation::None), width, height);
+    map.OriginX = static_cast<int>(sourceRect.Left);
+    map.OriginY = static_cast<int>(sourceRect.Top);
+    return ConvertRegions(inputTexture, outputBuffer, width, height, &fullFrame, 1, outputPitch, false, &map);
+}
+
+HRESULT BGRAToYUY2Converter::ConvertRegions(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
+                                           UINT width, UINT height, const ImageRect* rects, UINT rectCount,
+                                           UINT outputPitch, bool verifyInput, const ImageOrientationMap* map)
 {
     if (!m_initialized || !inputTexture || !outputBuffer)
         return E_INVALIDARG;
 
+    UINT pitch = GetOutputPitch(width, outputPitch);
+    if (pitch % 4 != 0 || pitch < ((width + 1) / 2) * 4)
+        return E_INVALIDARG;
+
     try
     {
         // 验证输入纹理的有效性
@@ -159,6 +407,7 @@ HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer
         }
         
         // 验证输入纹理是否有数据（AMD显卡修复验证）
+        // staging纹理常驻，只在尺寸或格式变化时重新创建
         D3D11_TEXTURE2D_DESC inputVerifyDesc = {};
         inputVerifyDesc.Width = texDesc.Width;
         inputVerifyDesc.Height = texDesc.Height;
@@ -171,9 +420,24 @@ HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer
         inputVerifyDesc.BindFlags = 0;
         inputVerifyDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
         inputVerifyDesc.MiscFlags = 0;
-        
-        ID3D11Texture2D* inputVerifyTexture = nullptr;
-        if (SUCCEEDED(m_device->CreateTexture2D(&inputVerifyDesc, nullptr, &inputVerifyTexture)))
+
+        if (verifyInput && m_inputVerifyTexture)
+        {
+            D3D11_TEXTURE2D_DESC currentDesc;
+            m_inputVerifyTexture->GetDesc(&currentDesc);
+            if (currentDesc.Width != inputVerifyDesc.Width || currentDesc.Height != inputVerifyDesc.Height ||
+                currentDesc.Format != inputVerifyDesc.Format)
+            {
+                SAFE_RELEASE(m_inputVerifyTexture);
+            }
+        }
+        if (verifyInput && !m_inputVerifyTexture)
+        {
+            m_device->CreateTexture2D(&inputVerifyDesc, nullptr, &m_inputVerifyTexture);
+        }
+
+        ID3D11Texture2D* inputVerifyTexture = verifyInput ? m_inputVerifyTexture : nullptr;
+        if (inputVerifyTexture)
         {
             m_context->CopyResource(inputVerifyTexture, inputTexture);
             m_context->Flush();
@@ -193,25 +457,21 @@ HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer
                 LogMessage("[YUV] Input texture has " + std::to_string(inputNonZero) + "/100 valid pixels");
                 m_context->Unmap(inputVerifyTexture, 0);
             }
-            inputVerifyTexture->Release();
         }
 
-        // 创建输入纹理的SRV
+        // 获取输入纹理的SRV（来自缓存，不需要释放）
         ID3D11ShaderResourceView* inputSRV = nullptr;
-        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        DXGI_FORMAT srvFormat;
         
         // 使用与纹理相同的格式，但转换为非SRGB版本以便计算
         if (texDesc.Format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB)
-            srvDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+            srvFormat = DXGI_FORMAT_B8G8R8A8_UNORM;
         else if (texDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
-            srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            srvFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
         else
-            srvDesc.Format = texDesc.Format; // 使用原始格式
-            
-        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MipLevels = 1;
+            srvFormat = texDesc.Format; // 使用原始格式
 
-        HRESULT srvResult = m_device->CreateShaderResourceView(inputTexture, &srvDesc, &inputSRV);
+        HRESULT srvResult = GetInputView(inputTexture, srvFormat, &inputSRV);
         if (FAILED(srvResult))
         {
             LogError("Failed to create input SRV. Texture may be in invalid state. HRESULT: 0x" + 
@@ -219,65 +479,83 @@ HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer
             return srvResult;
         }
 
-        // 创建输出缓冲区的UAV
+        // 获取输出缓冲区的UAV（来自缓存，不需要释放）
+        // 元素数量为输出缓冲区的32位元素数量（含行填充）
         ID3D11UnorderedAccessView* outputUAV = nullptr;
-        D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
-        uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;  // 必须使用TYPELESS配合RAW缓冲区
-        uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
-        uavDesc.Buffer.FirstElement = 0;
-        uavDesc.Buffer.NumElements = ((width + 1) / 2) * height; // YUY2像素对数量
-        uavDesc.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;  // 必须使用RAW标志
-
-        ThrowIfFailed(m_device->CreateUnorderedAccessView(outputBuffer, &uavDesc, &outputUAV),
+        ThrowIfFailed(GetOutputView(outputBuffer, pitch / 4 * height, &outputUAV),
                      "Failed to create output UAV");
 
-        // 更新常量缓冲区
-        D3D11_MAPPED_SUBRESOURCE mappedResource;
-        ThrowIfFailed(m_context->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource),
-                     "Failed to map constant buffer");
-
-        ConversionParams* params = (ConversionParams*)mappedResource.pData;
-        params->ImageWidth = width;
-        params->ImageHeight = height;
-        params->OutputStride = ((width + 1) / 2) * 4;
-        params->Padding = 0;
-
-        m_context->Unmap(m_constantBuffer, 0);
-
         // 设置Compute Shader管线
         m_context->CSSetShader(m_computeShader, nullptr, 0);
         m_context->CSSetShaderResources(0, 1, &inputSRV);
+        m_context->CSSetShaderResources(2, 1, &m_cursorSRV);
         m_context->CSSetUnorderedAccessViews(0, 1, &outputUAV, nullptr);
         m_context->CSSetConstantBuffers(0, 1, &m_constantBuffer);
 
-        // 计算调度参数
-        // 每个线程处理2个水平像素，线程组大小是16x16
-        // 所以每个线程组处理32x16个像素
-        UINT dispatchX = ((width + 1) / 2 + 15) / 16;  // 输出宽度是(width+1)/2，每个线程组16个线程
-        UINT dispatchY = (height + 15) / 16;
-
-        // 执行Compute Shader
+        // 每个区域一次调度：更新常量缓冲区中的区域后调度覆盖该区域的线程组
         LogMessage("[YUV] Converting BGRA to YUY2...");
-        m_context->Dispatch(dispatchX, dispatchY, 1);
+        UINT dispatchCount = 0;
+        for (UINT i = 0; i < rectCount; i++)
+        {
+            ImageRect region = rects[i];
+            if (!ClipImageRect(region, width, height))
+                continue;
+            AlignImageRectToPixelPairs(region, width);
+
+            D3D11_MAPPED_SUBRESOURCE mappedResource;
+            ThrowIfFailed(m_context->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource),
+                         "Failed to map constant buffer");
+
+            ConversionParams* params = (ConversionParams*)mappedResource.pData;
+            params->ImageWidth = width;
+            params->ImageHeight = height;
+            params->OutputStride = pitch;
+            params->Padding = 0;
+            params->RegionLeft = region.Left;
+            params->RegionTop = region.Top;
+            params->RegionRight = region.Right;
+            params->RegionBottom = region.Bottom;
+            params->MoveSourceLeft = 0;
+            params->MoveSourceTop = 0;
+            SetSourceMap(params, map);
+            SetCursorParams(params);
+
+            m_context->Unmap(m_constantBuffer, 0);
+
+            // 计算调度参数
+            // 每个线程处理2个水平像素，线程组大小是16x16
+            // 所以每个线程组处理32x16个像素
+            UINT regionWidth = region.Right - region.Left;
+            UINT regionHeight = region.Bottom - region.Top;
+            UINT dispatchX = ((regionWidth + 1) / 2 + 15) / 16;
+            UINT dispatchY = (regionHeight + 15) / 16;
+
+            // 执行Compute Shader
+            m_context->Dispatch(dispatchX, dispatchY, 1);
+            dispatchCount++;
+        }
+
+        if (dispatchCount == 0)
+        {
+            // 没有变化的区域，输出缓冲区已经是最新的
+            ID3D11ShaderResourceView* nullSRV = nullptr;
+            ID3D11UnorderedAccessView* nullUAV = nullptr;
+            m_context->CSSetShaderResources(0, 1, &nullSRV);
+            m_context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+            return S_OK;
+        }
         
         // 强制等待GPU完成
         m_context->Flush();
         
         // 添加GPU同步点
-        D3D11_QUERY_DESC queryDesc = {};
-        queryDesc.Query = D3D11_QUERY_EVENT;
-        ID3D11Query* query = nullptr;
-        if (SUCCEEDED(m_device->CreateQuery(&queryDesc, &query)))
+        m_context->End(m_completionQuery);
+        BOOL queryData = FALSE;
+        while (m_context->GetData(m_completionQuery, &queryData, sizeof(BOOL), 0) != S_OK)
         {
-            m_context->End(query);
-            BOOL queryData = FALSE;
-            while (m_context->GetData(query, &queryData, sizeof(BOOL), 0) != S_OK)
-            {
-                // 等待GPU完成
-            }
-            query->Release();
-            LogMessage("[YUV] Conversion completed");
+            // 等待GPU完成
         }
+        LogMessage("[YUV] Conversion completed");
 
         // 清理管线状态
         ID3D11ShaderResourceView* nullSRV = nullptr;
@@ -285,8 +563,6 @@ HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer
         m_context->CSSetShaderResources(0, 1, &nullSRV);
         m_context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
 
-        inputSRV->Release();
-        outputUAV->Release();
 
         // 每10秒输出一次成功日志
         auto currentTime = std::chrono::steady_clock::now();
@@ -306,48 +582,360 @@ HRESULT BGRAToYUY2Converter::Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer
     }
 }
 
-HRESULT BGRAToYUY2Converter::ReadOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height,
-                                             BYTE** outData, UINT& dataSize)
+void BGRAToYUY2Converter::SetSourceMap(ConversionParams* params, const ImageOrientationMap* map)
 {
-    if (!buffer || !outData)
+    params->SourceOriginX = map ? map->OriginX : 0;
+    params->SourceOriginY = map ? map->OriginY : 0;
+    params->XStepX = map ? map->XStepX : 1;
+    params->XStepY = map ? map->XStepY : 0;
+    params->YStepX = map ? map->YStepX : 0;
+    params->YStepY = map ? map->YStepY : 1;
+}
+
+void BGRAToYUY2Converter::SetCursorParams(ConversionParams* params) const
+{
+    bool enabled = m_cursorVisible && m_cursorSRV;
+    params->CursorLeft = m_cursorX;
+    params->CursorTop = m_cursorY;
+    params->CursorWidth = enabled ? m_cursorWidth : 0;
+    params->CursorHeight = enabled ? m_cursorHeight : 0;
+    params->CursorMode = enabled ? (m_cursorAlphaBlend ? 1 : 2) : 0;
+    params->CursorPadding[0] = params->CursorPadding[1] = params->CursorPadding[2] = 0;
+}
+
+HRESULT BGRAToYUY2Converter::SetCursorShape(const CursorImage& cursor)
+{
+    if (!m_initialized || cursor.Width == 0 || cursor.Height == 0 ||
+        cursor.Colors.size() < (size_t)cursor.Width * cursor.Height ||
+        (!cursor.AlphaBlend && cursor.Masks.size() < cursor.Colors.size()))
         return E_INVALIDARG;
 
-    dataSize = ((width + 1) / 2) * height * 4;
+    // 颜色和掩码交错存放，着色器一次Load2读取一个像素；形状很少变化，每次重新创建缓冲区
+    std::vector<UINT> pixels((size_t)cursor.Width * cursor.Height * 2);
+    for (size_t i = 0; i < pixels.size() / 2; i++)
+    {
+        pixels[i * 2] = cursor.Colors[i];
+        pixels[i * 2 + 1] = cursor.AlphaBlend ? 0 : cursor.Masks[i];
+    }
+
+    SAFE_RELEASE(m_cursorSRV);
+    SAFE_RELEASE(m_cursorBuffer);
+    m_cursorWidth = m_cursorHeight = 0;
+
+    D3D11_BUFFER_DESC cursorDesc = {};
+    cursorDesc.ByteWidth = static_cast<UINT>(pixels.size() * sizeof(UINT));
+    cursorDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    cursorDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    cursorDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = pixels.data();
+    HRESULT hr = m_device->CreateBuffer(&cursorDesc, &initData, &m_cursorBuffer);
+    if (FAILED(hr))
+    {
+        LogError("Failed to create cursor buffer");
+        return hr;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFEREX;
+    srvDesc.BufferEx.FirstElement = 0;
+    srvDesc.BufferEx.NumElements = static_cast<UINT>(pixels.size());
+    srvDesc.BufferEx.Flags = D3D11_BUFFEREX_SRV_FLAG_RAW;
+    hr = m_device->CreateShaderResourceView(m_cursorBuffer, &srvDesc, &m_cursorSRV);
+    if (FAILED(hr))
+    {
+        LogError("Failed to create cursor SRV");
+        SAFE_RELEASE(m_cursorBuffer);
+        return hr;
+    }
 
-    // 创建staging buffer用于CPU读取
-    D3D11_BUFFER_DESC stagingDesc = {};
-    stagingDesc.ByteWidth = dataSize;
-    stagingDesc.Usage = D3D11_USAGE_STAGING;
-    stagingDesc.BindFlags = 0;
-    stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-    stagingDesc.MiscFlags = 0;
+    m_cursorWidth = cursor.Width;
+    m_cursorHeight = cursor.Height;
+    m_cursorAlphaBlend = cursor.AlphaBlend;
+    return S_OK;
+}
+
+void BGRAToYUY2Converter::SetCursorPosition(int x, int y, bool visible)
+{
+    m_cursorX = x;
+    m_cursorY = y;
+    m_cursorVisible = visible;
+}
+
+HRESULT BGRAToYUY2Converter::EnsureMoveScratch(UINT size)
+{
+    if (m_moveScratchBuffer && m_moveScratchSize >= size)
+        return S_OK;
+
+    SAFE_RELEASE(m_moveScratchSRV);
+    SAFE_RELEASE(m_moveScratchBuffer);
+    m_moveScratchSize = 0;
+
+    D3D11_BUFFER_DESC scratchDesc = {};
+    scratchDesc.ByteWidth = size;
+    scratchDesc.Usage = D3D11_USAGE_DEFAULT;
+    scratchDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    scratchDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+    HRESULT hr = m_device->CreateBuffer(&scratchDesc, nullptr, &m_moveScratchBuffer);
+    if (FAILED(hr))
+    {
+        LogError("Failed to create move scratch buffer");
+        return hr;
+    }
 
-    ID3D11Buffer* stagingBuffer = nullptr;
-    HRESULT hr = m_device->CreateBuffer(&stagingDesc, nullptr, &stagingBuffer);
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFEREX;
+    srvDesc.BufferEx.FirstElement = 0;
+    srvDesc.BufferEx.NumElements = size / 4;
+    srvDesc.BufferEx.Flags = D3D11_BUFFEREX_SRV_FLAG_RAW;
+    hr = m_device->CreateShaderResourceView(m_moveScratchBuffer, &srvDesc, &m_moveScratchSRV);
     if (FAILED(hr))
+    {
+        LogError("Failed to create move scratch SRV");
+        SAFE_RELEASE(m_moveScratchBuffer);
         return hr;
+    }
+
+    m_moveScratchSize = size;
+    return S_OK;
+}
+
+HRESULT BGRAToYUY2Converter::MoveRegions(ID3D11Buffer* outputBuffer, UINT width, UINT height,
+                                         const ImageMove* moves, UINT moveCount, UINT outputPitch)
+{
+    if (!m_initialized || !outputBuffer || (moveCount > 0 && !moves))
+        return E_INVALIDARG;
+    if (moveCount == 0)
+        return S_OK;
+
+    UINT pitch = GetOutputPitch(width, outputPitch);
+    if (pitch % 4 != 0 || pitch < ((width + 1) / 2) * 4)
+        return E_INVALIDARG;
+
+    for (UINT i = 0; i < moveCount; i++)
+    {
+        const ImageRect& dest = moves[i].Destination;
+        ImageRect source = GetImageMoveSource(moves[i]);
+        if (((dest.Left | dest.Right | source.Left) & 1) != 0 ||
+            IsImageRectEmpty(dest) || dest.Right > width || dest.Bottom > height ||
+            source.Right > width || source.Bottom > height)
+            return E_INVALIDARG;
+    }
+
+    try
+    {
+        ThrowIfFailed(EnsureMoveScratch(pitch * height), "Failed to prepare move scratch buffer");
+
+        ID3D11UnorderedAccessView* outputUAV = nullptr;
+        ThrowIfFailed(GetOutputView(outputBuffer, pitch / 4 * height, &outputUAV),
+                     "Failed to create output UAV");
+
+        m_context->CSSetShader(m_moveShader, nullptr, 0);
+        m_context->CSSetConstantBuffers(0, 1, &m_constantBuffer);
+
+        for (UINT i = 0; i < moveCount; i++)
+        {
+            const ImageMove& move = moves[i];
+            UINT rows = move.Destination.Bottom - move.Destination.Top;
+
+            // 源行是输出缓冲区中连续的一段，一次复制到暂存缓冲区的相同偏移
+            // （复制前解除绑定，缓冲区不能同时作为SRV读取和复制目标）
+            ID3D11ShaderResourceView* nullSRV = nullptr;
+            ID3D11UnorderedAccessView* nullUAV = nullptr;
+            m_context->CSSetShaderResources(1, 1, &nullSRV);
+            m_context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+
+            D3D11_BOX sourceBox = {};
+            sourceBox.left = move.SourceTop * pitch;
+            sourceBox.right = (move.SourceTop + rows) * pitch;
+            sourceBox.top = 0;
+            sourceBox.bottom = 1;
+            sourceBox.front = 0;
+            sourceBox.back = 1;
+            m_context->CopySubresourceRegion(m_moveScratchBuffer, 0, sourceBox.left, 0, 0, outputBuffer, 0, &sourceBox);
+
+            D3D11_MAPPED_SUBRESOURCE mappedResource;
+            ThrowIfFailed(m_context->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource),
+                         "Failed to map constant buffer");
+
+            ConversionParams* params = (ConversionParams*)mappedResource.pData;
+            params->ImageWidth = width;
+            params->ImageHeight = height;
+            params->OutputStride = pitch;
+            params->Padding = 0;
+            params->RegionLeft = move.Destination.Left;
+            params->RegionTop = move.Destination.Top;
+            params->RegionRight = move.Destination.Right;
+            params->RegionBottom = move.Destination.Bottom;
+            params->MoveSourceLeft = move.SourceLeft;
+            params->MoveSourceTop = move.SourceTop;
+            SetSourceMap(params, nullptr);
+            params->CursorMode = 0;
+
+            m_context->Unmap(m_constantBuffer, 0);
+
+            m_context->CSSetShaderResources(1, 1, &m_moveScratchSRV);
+            m_context->CSSetUnorderedAccessViews(0, 1, &outputUAV, nullptr);
+
+            UINT dispatchX = ((move.Destination.Right - move.Destination.Left) / 2 + 15) / 16;
+            UINT dispatchY = (rows + 15) / 16;
+            m_context->Dispatch(dispatchX, dispatchY, 1);
+        }
+
+        // 清理管线状态，之后的Convert或读回按提交顺序在移动完成后执行
+        ID3D11ShaderResourceView* nullSRV = nullptr;
+        ID3D11UnorderedAccessView* nullUAV = nullptr;
+        m_context->CSSetShaderResources(1, 1, &nullSRV);
+        m_context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+        return S_OK;
+    }
+    catch (const std::exception& e)
+    {
+        LogError(std::string("Region move failed: ") + e.what());
+        return E_FAIL;
+    }
+}
+
+HRESULT BGRAToYUY2Converter::CopyAndMapStaging(ID3D11Buffer* buffer, UINT dataSize,
+                                              D3D11_MAPPED_SUBRESOURCE& mapped)
+{
+    if (m_stagingMapped)
+    {
+        LogError("Output staging buffer is still mapped");
+        return E_FAIL;
+    }
+
+    // 常驻staging buffer，只在容量不足时重新创建
+    if (!m_stagingBuffer || m_stagingBufferSize < dataSize)
+    {
+        SAFE_RELEASE(m_stagingBuffer);
+        m_stagingBufferSize = 0;
+
+        D3D11_BUFFER_DESC stagingDesc = {};
+        stagingDesc.ByteWidth = dataSize;
+        stagingDesc.Usage = D3D11_USAGE_STAGING;
+        stagingDesc.BindFlags = 0;
+        stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+        stagingDesc.MiscFlags = 0;
+
+        HRESULT hr = m_device->CreateBuffer(&stagingDesc, nullptr, &m_stagingBuffer);
+        if (FAILED(hr))
+        {
+            LogError("Failed to create output staging buffer");
+            return hr;
+        }
+        m_stagingBufferSize = dataSize;
+    }
+
+    // staging buffer可能大于本次输出，只复制有效区域
+    D3D11_BOX box = { 0, 0, 0, dataSize, 1, 1 };
+    m_context->CopySubresourceRegion(m_stagingBuffer, 0, 0, 0, 0, buffer, 0, &box);
+
+    HRESULT hr = m_context->Map(m_stagingBuffer, 0, D3D11_MAP_READ, 0, &mapped);
+    if (SUCCEEDED(hr))
+    {
+        m_stagingMapped = true;
+    }
+    return hr;
+}
+
+HRESULT BGRAToYUY2Converter::ReadOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height,
+                                             BYTE** outData, UINT& dataSize, UINT outputPitch)
+{
+    if (!buffer || !outData)
+        return E_INVALIDARG;
 
-    // 复制数据到staging buffer
-    m_context->CopyResource(stagingBuffer, buffer);
+    // 返回的数据保留输出缓冲区的行步长
+    dataSize = GetOutputPitch(width, outputPitch) * height;
 
-    // 映射并读取数据
     D3D11_MAPPED_SUBRESOURCE mappedResource;
-    hr = m_context->Map(stagingBuffer, 0, D3D11_MAP_READ, 0, &mappedResource);
-    
+    HRESULT hr = CopyAndMapStaging(buffer, dataSize, mappedResource);
     if (SUCCEEDED(hr))
     {
         *outData = new BYTE[dataSize];
         memcpy(*outData, mappedResource.pData, dataSize);
-        m_context->Unmap(stagingBuffer, 0);
+        UnmapOutputBuffer();
     }
 
-    stagingBuffer->Release();
     return hr;
 }
 
+HRESULT BGRAToYUY2Converter::ReadOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height,
+                                             const ImageView& destination, UINT outputPitch)
+{
+    if (!buffer || !IsImageViewValid(destination, 1, width, height) ||
+        destination.Planes[0].RowBytes < ((width + 1) / 2) * 4)
+        return E_INVALIDARG;
+
+    ImageView source;
+    HRESULT hr = MapOutputBuffer(buffer, width, height, source, outputPitch);
+    if (FAILED(hr))
+        return hr;
+
+    // 行步长相同时整块复制，否则逐行复制有效数据
+    const ImagePlane& src = source.Planes[0];
+    const ImagePlane& dst = destination.Planes[0];
+    if (src.Pitch == dst.Pitch)
+    {
+        memcpy(dst.Data, src.Data, GetImagePlaneSize(src));
+    }
+    else
+    {
+        for (UINT y = 0; y < height; y++)
+        {
+            memcpy(dst.Data + (size_t)y * dst.Pitch, src.Data + (size_t)y * src.Pitch, src.RowBytes);
+        }
+    }
+
+    UnmapOutputBuffer();
+    return S_OK;
+}
+
+HRESULT BGRAToYUY2Converter::MapOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height,
+                                            ImageView& outView, UINT outputPitch)
+{
+    if (!m_initialized || !buffer || width == 0 || height == 0)
+        return E_INVALIDARG;
+
+    UINT pitch = GetOutputPitch(width, outputPitch);
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    HRESULT hr = CopyAndMapStaging(buffer, pitch * height, mappedResource);
+    if (FAILED(hr))
+        return hr;
+
+    outView = MakeYUY2ImageView(static_cast<BYTE*>(mappedResource.pData), width, height, pitch);
+    return S_OK;
+}
+
+void BGRAToYUY2Converter::UnmapOutputBuffer()
+{
+    if (m_stagingMapped)
+    {
+        m_context->Unmap(m_stagingBuffer, 0);
+        m_stagingMapped = false;
+    }
+}
+
 void BGRAToYUY2Converter::Cleanup()
 {
+    UnmapOutputBuffer();
+    ClearViewCache(m_inputViews);
+    ClearViewCache(m_outputViews);
+    SAFE_RELEASE(m_completionQuery);
+    SAFE_RELEASE(m_inputVerifyTexture);
+    SAFE_RELEASE(m_stagingBuffer);
+    m_stagingBufferSize = 0;
     SAFE_RELEASE(m_constantBuffer);
+    SAFE_RELEASE(m_moveScratchSRV);
+    SAFE_RELEASE(m_moveScratchBuffer);
+    m_moveScratchSize = 0;
+    SAFE_RELEASE(m_cursorSRV);
+    SAFE_RELEASE(m_cursorBuffer);
+    m_cursorWidth = m_cursorHeight = 0;
+    m_cursorVisible = false;
+    SAFE_RELEASE(m_moveShader);
     SAFE_RELEASE(m_computeShader);
     SAFE_RELEASE(m_context);
     SAFE_RELEASE(m_device);
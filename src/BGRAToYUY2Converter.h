@@ -1,4 +1,6 @@
 #pragma once
+#include "CursorOverlay.h"
+#include "ImageView.h"
 #include "Utils.h"
 #include <chrono>
 
@@ -8,6 +10,29 @@ struct ConversionParams
     UINT ImageHeight;
     UINT OutputStride;
     UINT Padding;
+    // 本次调度转换的区域（Left为偶数），整帧转换时为整个图像
+    UINT RegionLeft;
+    UINT RegionTop;
+    UINT RegionRight;
+    UINT RegionBottom;
+    // 区域移动（CSMove）时目标区域左上角对应的源位置
+    UINT MoveSourceLeft;
+    UINT MoveSourceTop;
+    // 输出像素(x, y)在输入纹理中的位置为SourceOrigin + x * XStep + y * YStep（见ImageOrientationMap）：
+    // 裁剪转换时原点为裁剪区域的左上角，旋转/翻转转换时步长为0或±1，其余情况为恒等映射
+    INT SourceOriginX;
+    INT SourceOriginY;
+    INT XStepX;
+    INT XStepY;
+    INT YStepX;
+    INT YStepY;
+    // 鼠标指针：左上角在输入纹理中的位置和尺寸，CursorMode为0（不合成）、1（按alpha混合）或2（掩码异或）
+    INT CursorLeft;
+    INT CursorTop;
+    UINT CursorWidth;
+    UINT CursorHeight;
+    UINT CursorMode;
+    UINT CursorPadding[3];      // 常量缓冲区大小须为16字节的倍数
 };
 
 class BGRAToYUY2Converter
@@ -17,20 +42,121 @@ public:
     ~BGRAToYUY2Converter();
 
     HRESULT Initialize(ID3D11Device* device, ID3D11DeviceContext* context);
+    // outputPitch为输出缓冲区的行步长（字节，4的倍数），0表示紧凑布局
     HRESULT Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
-                   UINT width, UINT height);
-    HRESULT CreateOutputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer);
+                   UINT width, UINT height, UINT outputPitch = 0);
+    // 增量转换：只重新转换dirtyRects覆盖的区域（裁剪到图像内并扩展到偶数x边界，每个矩形一次调度），
+    // outputBuffer其余部分保持不变，由调用者保证其中是之前转换的结果（见DirtyRegionTracker）。
+    // rectCount为0时不提交任何GPU工作
+    HRESULT Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer,
+                   UINT width, UINT height, const ImageRect* dirtyRects, UINT rectCount, UINT outputPitch = 0);
+    // 旋转/翻转转换（旋转的显示器）：输入纹理中sourceWidth x sourceHeight的图像按orientation变换后输出，
+    // 输出尺寸见GetOrientedSize。着色器按映射读取输入像素，不需要单独的旋转pass
+    HRESULT Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer, UINT sourceWidth, UINT sourceHeight,
+                   const ImageOrientation& orientation, UINT outputPitch = 0);
+    // 旋转/翻转的增量转换：dirtyRects是输出图像中的坐标（见TransformImageRect），其余同增量Convert
+    HRESULT Convert(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer, UINT sourceWidth, UINT sourceHeight,
+                   const ImageOrientation& orientation, const ImageRect* dirtyRects, UINT rectCount,
+                   UINT outputPitch = 0);
+    // 裁剪转换（窗口/区域采集）：只转换输入纹理中的sourceRect，写到sourceRect尺寸的紧凑输出中。
+    // Left可以是奇数，像素对从sourceRect.Left开始配对（与先复制出该区域再整帧转换的结果相同），
+    // 耗时与区域面积成正比。sourceRect必须在纹理范围内
+    HRESULT ConvertCrop(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer, const ImageRect& sourceRect,
+                        UINT outputPitch = 0);
+    // 在已转换的输出上按顺序执行区域移动（滚动、拖动窗口），源和目标可以重叠。
+    // 移动的目标区域和源x必须是偶数（整像素对，见DirtyRegionTracker::GetUpdateRects）；
+    // 源行先复制到常驻的暂存缓冲区，再由CSMove写到目标位置，之后的Convert等待全部完成
+    HRESULT MoveRegions(ID3D11Buffer* outputBuffer, UINT width, UINT height,
+                        const ImageMove* moves, UINT moveCount, UINT outputPitch = 0);
+    // 鼠标指针合成：之后的各种Convert在转换时把指针合成到它覆盖的像素上（位置是输入纹理中的坐标，
+    // 随裁剪和旋转一起变换），不需要单独的叠加遍。形状只在变化时上传（SetCursorShape），
+    // 位置每帧设置；增量转换时调用者需要把指针新旧位置覆盖的区域加入脏矩形
+    HRESULT SetCursorShape(const CursorImage& cursor);
+    void SetCursorPosition(int x, int y, bool visible);
+    HRESULT CreateOutputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer, UINT outputPitch = 0);
+    // 兼容接口：返回new[]分配的副本，调用者负责delete[]
     HRESULT ReadOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height, 
-                            BYTE** outData, UINT& dataSize);
+                            BYTE** outData, UINT& dataSize, UINT outputPitch = 0);
+    // 直接读回到调用者预先分配的内存（destination可带行填充），不产生额外分配和复制
+    HRESULT ReadOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height,
+                            const ImageView& destination, UINT outputPitch = 0);
+    // 映射常驻staging buffer并返回指向其中数据的视图，视图在UnmapOutputBuffer之前有效；
+    // 映射期间不能再次读回。
+    // 读回接口只使用staging buffer，可以在流水线的输出线程上与Convert并发调用（设备需开启多线程保护）
+    HRESULT MapOutputBuffer(ID3D11Buffer* buffer, UINT width, UINT height,
+                           ImageView& outView, UINT outputPitch = 0);
+    void UnmapOutputBuffer();
+    // 从CPU内存上传BGRA图像，按视图的行步长直接上传，无需先重新打包
+    HRESULT CreateInputTexture(UINT width, UINT height, ID3D11Texture2D** outTexture);
+    HRESULT WriteBGRAData(ID3D11Texture2D* texture, const ImageView& source);
     void Cleanup();
 
+    static UINT GetOutputPitch(UINT width, UINT outputPitch)
+    {
+        return outputPitch ? outputPitch : ((width + 1) / 2) * 4;
+    }
+
+    // 输出缓冲区的资源描述，CreateOutputBuffer和帧池（FramePool::AcquireBuffer）共用
+    static D3D11_BUFFER_DESC GetOutputBufferDesc(UINT width, UINT height, UINT outputPitch = 0);
+    // 输入纹理的资源描述，CreateInputTexture和帧池（FramePool::AcquireTexture）共用
+    static D3D11_TEXTURE2D_DESC GetInputTextureDesc(UINT width, UINT height);
+
 private:
     HRESULT CompileShader();
+    HRESULT CompileEntryPoint(const std::string& source, const char* entryPoint, ID3D11ComputeShader** outShader);
+    // 暂存缓冲区与输出缓冲区布局相同，容量不足时重新创建
+    HRESULT EnsureMoveScratch(UINT size);
+    // verifyInput：整帧转换时检查输入纹理是否有数据（AMD显卡修复验证），增量转换时跳过这次整帧回读
+    // map：输出坐标到输入纹理坐标的映射（裁剪、旋转/翻转），nullptr为恒等映射
+    HRESULT ConvertRegions(ID3D11Texture2D* inputTexture, ID3D11Buffer* outputBuffer, UINT width, UINT height,
+                          const ImageRect* rects, UINT rectCount, UINT outputPitch, bool verifyInput,
+                          const ImageOrientationMap* map = nullptr);
+    static void SetSourceMap(ConversionParams* params, const ImageOrientationMap* map);
+    void SetCursorParams(ConversionParams* params) const;
+    // 将输出缓冲区复制到常驻staging buffer（容量不足时才重新创建）并映射
+    HRESULT CopyAndMapStaging(ID3D11Buffer* buffer, UINT dataSize, D3D11_MAPPED_SUBRESOURCE& mapped);
+
+    // SRV/UAV缓存：帧池中的资源每帧轮换复用，视图随资源一起复用而不必每帧创建。
+    // 缓存的视图持有资源引用，缓存期间资源地址不会被新资源复用
+    struct CachedView
+    {
+        ID3D11Resource* Resource;
+        UINT Key;           // SRV为格式，UAV为元素数量
+        ID3D11View* View;
+    };
+    static const UINT kViewCacheSize = 4;
+
+    HRESULT GetInputView(ID3D11Texture2D* texture, DXGI_FORMAT format, ID3D11ShaderResourceView** outView);
+    HRESULT GetOutputView(ID3D11Buffer* buffer, UINT numElements, ID3D11UnorderedAccessView** outView);
+    static ID3D11View* FindCachedView(const CachedView* cache, ID3D11Resource* resource, UINT key);
+    static void StoreCachedView(CachedView* cache, UINT& nextSlot, ID3D11Resource* resource, UINT key, ID3D11View* view);
+    static void ClearViewCache(CachedView* cache);
 
     ID3D11Device* m_device;
     ID3D11DeviceContext* m_context;
     ID3D11ComputeShader* m_computeShader;
+    ID3D11ComputeShader* m_moveShader;
+    ID3D11Buffer* m_moveScratchBuffer;      // 区域移动的源行副本
+    ID3D11ShaderResourceView* m_moveScratchSRV;
+    UINT m_moveScratchSize;
+    ID3D11Buffer* m_cursorBuffer;           // 归一化的指针像素，每像素两个32位值（颜色、掩码）
+    ID3D11ShaderResourceView* m_cursorSRV;
+    UINT m_cursorWidth;
+    UINT m_cursorHeight;
+    bool m_cursorAlphaBlend;
+    int m_cursorX;
+    int m_cursorY;
+    bool m_cursorVisible;
     ID3D11Buffer* m_constantBuffer;
+    ID3D11Buffer* m_stagingBuffer;      // 读回用的常驻staging buffer
+    UINT m_stagingBufferSize;
+    bool m_stagingMapped;
+    ID3D11Texture2D* m_inputVerifyTexture;  // 输入数据检查用的常驻staging纹理
+    ID3D11Query* m_completionQuery;         // 等待GPU完成的常驻事件查询
+    CachedView m_inputViews[kViewCacheSize];
+    CachedView m_outputViews[kViewCacheSize];
+    UINT m_nextInputView;
+    UINT m_nextOutputView;
     bool m_initialized;
     
     // 用于控制日志输出频率
@@ -0,0 +1,108 @@
+#include "BGRAToYUY2Kernels.h"
+#include "ColorConversionMath.h"
+#include <cstdlib>
+#include <cstring>
+
+void BGRAToYUY2RowTail_C(const BYTE* srcRow, BYTE* dstRow, UINT firstPixel, UINT width)
+{
+    for (UINT x = firstPixel; x < width; x += 2)
+    {
+        const BYTE* pixel0 = srcRow + x * 4;
+        // 处理奇数宽度情况：最后一个像素复制自身
+        const BYTE* pixel1 = (x + 1 < width) ? pixel0 + 4 : pixel0;
+
+        UINT packed = ConvertPixelPairToYUY2Fixed(pixel0, pixel1);
+        memcpy(dstRow + (x / 2) * 4, &packed, sizeof(packed));
+    }
+}
+
+UINT BGRAToYUY2Row_C(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    BGRAToYUY2RowTail_C(srcRow, dstRow, 0, width);
+    return 0;
+}
+
+UINT ConvertSolidPixelToYUY2(UINT pixel)
+{
+    BYTE bytes[4];
+    memcpy(bytes, &pixel, sizeof(bytes));
+    return ConvertPixelPairToYUY2Fixed(bytes, bytes);
+}
+
+UINT BGRAToYUY2Row_Float(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    for (UINT x = 0; x < width; x += 2)
+    {
+        const BYTE* pixel0 = srcRow + x * 4;
+        const BYTE* pixel1 = (x + 1 < width) ? pixel0 + 4 : pixel0;
+
+        UINT packed = ConvertPixelPairToYUY2(pixel0, pixel1);
+        memcpy(dstRow + (x / 2) * 4, &packed, sizeof(packed));
+    }
+    return 0;
+}
+
+FixedPointDeviation MeasureFixedPointDeviation()
+{
+    FixedPointDeviation result = {};
+
+    for (int r = 0; r < 256; r++)
+    {
+        for (int g = 0; g < 256; g++)
+        {
+            for (int b = 0; b < 256; b++)
+            {
+                YUVFloat yuv = RGBToYUV(UnormToFloat(static_cast<BYTE>(r)), UnormToFloat(static_cast<BYTE>(g)),
+                                        UnormToFloat(static_cast<BYTE>(b)));
+
+                // UV按两个相同像素组成的像素对比较，与实际转换的平均及舍入过程一致
+                int deltaY = static_cast<int>(FixedY(r, g, b)) - static_cast<int>(RoundToUInt(yuv.Y));
+                int deltaU = static_cast<int>(FixedAverageUV(FixedU(r, g, b) * 2)) -
+                             static_cast<int>(RoundToUInt((yuv.U + yuv.U) * 0.5f));
+                int deltaV = static_cast<int>(FixedAverageUV(FixedV(r, g, b) * 2)) -
+                             static_cast<int>(RoundToUInt((yuv.V + yuv.V) * 0.5f));
+
+                result.MismatchY += deltaY != 0;
+                result.MismatchU += deltaU != 0;
+                result.MismatchV += deltaV != 0;
+                result.MaxDeviation = (std::max)(result.MaxDeviation,
+                                               (std::max)(std::abs(deltaY), (std::max)(std::abs(deltaU), std::abs(deltaV))));
+                result.SampleCount++;
+            }
+        }
+    }
+
+    return result;
+}
+
+BGRAToYUY2RowFunc GetBGRAToYUY2RowKernel(SimdLevel level, SimdLevel* selectedLevel, bool solidFastPath)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    BGRAToYUY2RowFunc kernel = BGRAToYUY2Row_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX512BW)
+    {
+        kernel = solidFastPath ? BGRAToYUY2RowSolid_AVX512BW : BGRAToYUY2Row_AVX512BW;
+        chosen = SimdLevel::AVX512BW;
+    }
+    else if (level >= SimdLevel::AVX2)
+    {
+        kernel = solidFastPath ? BGRAToYUY2RowSolid_AVX2 : BGRAToYUY2Row_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = solidFastPath ? BGRAToYUY2RowSolid_SSE41 : BGRAToYUY2Row_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+
+// BGRA到YUY2的CPU行转换内核
+// 所有内核使用ColorConversionMath.h中的16位定点公式，输出逐位一致；
+// SIMD内核只处理完整的像素块，剩余像素（含奇数宽度）由标量代码完成。
+// 纯色快速路径（RowSolid内核）：每个像素块（SSE4.1为16、AVX2为32、AVX-512为64个像素）先与块的第一个像素比较，
+// 整块颜色相同（窗口背景、编辑器、幻灯片等平坦区域）时只计算一次打包好的YUY2字并整块宽存储，
+// 跳过逐像素的定点运算；颜色不同时只多了一次比较。
+// 返回值为由纯色快速路径写出的像素数，没有快速路径的内核返回0
+typedef UINT (*BGRAToYUY2RowFunc)(const BYTE* srcRow, BYTE* dstRow, UINT width);
+
+// 定点路径相对浮点路径的偏差统计（穷举全部2^24种RGB输入）
+struct FixedPointDeviation
+{
+    unsigned long long SampleCount;
+    unsigned long long MismatchY;
+    unsigned long long MismatchU;
+    unsigned long long MismatchV;
+    int MaxDeviation;
+};
+
+UINT BGRAToYUY2Row_C(const BYTE* srcRow, BYTE* dstRow, UINT width);
+UINT BGRAToYUY2Row_Float(const BYTE* srcRow, BYTE* dstRow, UINT width);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+UINT BGRAToYUY2Row_SSE41(const BYTE* srcRow, BYTE* dstRow, UINT width);
+UINT BGRAToYUY2Row_AVX2(const BYTE* srcRow, BYTE* dstRow, UINT width);
+UINT BGRAToYUY2Row_AVX512BW(const BYTE* srcRow, BYTE* dstRow, UINT width);
+UINT BGRAToYUY2RowSolid_SSE41(const BYTE* srcRow, BYTE* dstRow, UINT width);
+UINT BGRAToYUY2RowSolid_AVX2(const BYTE* srcRow, BYTE* dstRow, UINT width);
+UINT BGRAToYUY2RowSolid_AVX512BW(const BYTE* srcRow, BYTE* dstRow, UINT width);
+#endif
+
+// 从第firstPixel个像素（必须为偶数）开始用标量定点代码转换到行尾，供SIMD内核处理尾部
+void BGRAToYUY2RowTail_C(const BYTE* srcRow, BYTE* dstRow, UINT firstPixel, UINT width);
+// 两个像素都是pixel的像素对的YUY2字（纯色快速路径使用，结果与逐像素转换相同）
+UINT ConvertSolidPixelToYUY2(UINT pixel);
+
+FixedPointDeviation MeasureFixedPointDeviation();
+
+// 返回不超过level的最优内核；level为CPU不支持或未编译的等级时自动降级。
+// solidFastPath选择带纯色快速路径的SIMD内核（标量内核没有快速路径）
+BGRAToYUY2RowFunc GetBGRAToYUY2RowKernel(SimdLevel level, SimdLevel* selectedLevel = nullptr,
+                                         bool solidFastPath = false);
@@ -0,0 +1,155 @@
+#include "BGRAToYUY2Kernels.h"
+#include "ColorConversionMath.h"
+#include <immintrin.h>
+
+// AVX2内核：每个32位通道一个BGRA像素。
+// (B | R<<16) 与 (G | 256<<16) 两个16位对分别与打包系数做pmaddwd，
+// 两次乘加之和即为该像素的定点结果，无需通道重排。
+// Q22系数拆为高低两部分，各做一次乘加后合并（见ColorConversionMath.h）。
+namespace
+{
+    struct CoefficientVectors
+    {
+        __m256i BRHigh;
+        __m256i BRLow;
+        __m256i GOneHigh;
+        __m256i GOneLow;
+    };
+
+    struct KernelConstants
+    {
+        CoefficientVectors Y;
+        CoefficientVectors U;
+        CoefficientVectors V;
+    };
+
+    inline CoefficientVectors LoadCoefficients(int coefB, int coefR, int coefG, int coefOne)
+    {
+        CoefficientVectors c;
+        c.BRHigh = _mm256_set1_epi32(PackCoefficientPair(CoefficientHigh(coefB), CoefficientHigh(coefR)));
+        c.BRLow = _mm256_set1_epi32(PackCoefficientPair(CoefficientLow(coefB), CoefficientLow(coefR)));
+        c.GOneHigh = _mm256_set1_epi32(PackCoefficientPair(CoefficientHigh(coefG), CoefficientHigh(coefOne)));
+        c.GOneLow = _mm256_set1_epi32(PackCoefficientPair(CoefficientLow(coefG), CoefficientLow(coefOne)));
+        return c;
+    }
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.Y = LoadCoefficients(kYCoefB, kYCoefR, kYCoefG, kYCoefOne);
+        c.U = LoadCoefficients(kUCoefB, kUCoefR, kUCoefG, kUVCoefOne);
+        c.V = LoadCoefficients(kVCoefB, kVCoefR, kVCoefG, kUVCoefOne);
+        return c;
+    }
+
+    inline __m256i MultiplyAdd(__m256i br, __m256i gOne, const CoefficientVectors& c)
+    {
+        __m256i high = _mm256_add_epi32(_mm256_madd_epi16(br, c.BRHigh), _mm256_madd_epi16(gOne, c.GOneHigh));
+        __m256i low = _mm256_add_epi32(_mm256_madd_epi16(br, c.BRLow), _mm256_madd_epi16(gOne, c.GOneLow));
+        return _mm256_add_epi32(_mm256_slli_epi32(high, kCoefSplitShift), low);
+    }
+
+    // 转换8个像素，结果的每个64位通道低32位为一个打包好的YUY2像素对
+    inline __m256i ConvertPixels8(__m256i pixels, const KernelConstants& c)
+    {
+        const __m256i maskBR = _mm256_set1_epi32(0x00FF00FF);
+        const __m256i maskG = _mm256_set1_epi32(0x000000FF);
+        const __m256i oneLane = _mm256_set1_epi32(kFixedOneLane << 16);
+        const __m256i uvMin = _mm256_set1_epi32(kUVFixedMin);
+        const __m256i uvMax = _mm256_set1_epi32(kUVFixedMax);
+        const __m256i uvRound = _mm256_set1_epi32(1 << kFixedShift);
+
+        __m256i br = _mm256_and_si256(pixels, maskBR);
+        __m256i gOne = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), maskG), oneLane);
+
+        __m256i y = MultiplyAdd(br, gOne, c.Y);
+        __m256i u = MultiplyAdd(br, gOne, c.U);
+        __m256i v = MultiplyAdd(br, gOne, c.V);
+
+        y = _mm256_srai_epi32(y, kFixedShift);
+        y = _mm256_min_epi32(_mm256_max_epi32(y, _mm256_set1_epi32(16)), _mm256_set1_epi32(235));
+        u = _mm256_min_epi32(_mm256_max_epi32(u, uvMin), uvMax);
+        v = _mm256_min_epi32(_mm256_max_epi32(v, uvMin), uvMax);
+
+        // 相邻像素组合：低32位得到 Y0 | Y1<<16 以及 U0+U1、V0+V1
+        __m256i yPair = _mm256_or_si256(y, _mm256_srli_epi64(y, 16));
+        __m256i uPair = _mm256_add_epi32(u, _mm256_srli_epi64(u, 32));
+        __m256i vPair = _mm256_add_epi32(v, _mm256_srli_epi64(v, 32));
+        uPair = _mm256_srli_epi32(_mm256_add_epi32(uPair, uvRound), kFixedShift + 1);
+        vPair = _mm256_srli_epi32(_mm256_add_epi32(vPair, uvRound), kFixedShift + 1);
+
+        return _mm256_or_si256(yPair, _mm256_or_si256(_mm256_slli_epi32(uPair, 8), _mm256_slli_epi32(vPair, 24)));
+    }
+
+    // 合并两组结果中偶数通道的像素对，得到连续的8个YUY2像素对
+    inline __m256i MergePairs(__m256i a, __m256i b)
+    {
+        __m256i mixed = _mm256_blend_epi32(a, _mm256_slli_epi64(b, 32), 0xAA);
+        return _mm256_permutevar8x32_epi32(mixed, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7));
+    }
+}
+
+namespace
+{
+    template <bool SolidFastPath>
+    inline UINT ConvertRow(const BYTE* srcRow, BYTE* dstRow, UINT width)
+    {
+        const KernelConstants c = LoadConstants();
+        UINT solidPixels = 0;
+        // 最近一个纯色块的颜色和对应的YUY2字，相邻的纯色块通常颜色相同
+        UINT solidColor = 0;
+        bool solidValid = false;
+        __m256i solidWord = _mm256_setzero_si256();
+
+        // 每次迭代处理32个像素（16个像素对）
+        UINT x = 0;
+        for (; x + 32 <= width; x += 32)
+        {
+            const __m256i* src = reinterpret_cast<const __m256i*>(srcRow + x * 4);
+            __m256i* dst = reinterpret_cast<__m256i*>(dstRow + x * 2);
+
+            __m256i p0 = _mm256_loadu_si256(src + 0);
+            __m256i p1 = _mm256_loadu_si256(src + 1);
+            __m256i p2 = _mm256_loadu_si256(src + 2);
+            __m256i p3 = _mm256_loadu_si256(src + 3);
+
+            if (SolidFastPath)
+            {
+                __m256i first = _mm256_broadcastd_epi32(_mm256_castsi256_si128(p0));
+                __m256i same = _mm256_and_si256(
+                    _mm256_and_si256(_mm256_cmpeq_epi32(p0, first), _mm256_cmpeq_epi32(p1, first)),
+                    _mm256_and_si256(_mm256_cmpeq_epi32(p2, first), _mm256_cmpeq_epi32(p3, first)));
+                if (_mm256_movemask_epi8(same) == -1)
+                {
+                    UINT color = static_cast<UINT>(_mm256_cvtsi256_si32(p0));
+                    if (!solidValid || color != solidColor)
+                    {
+                        solidColor = color;
+                        solidValid = true;
+                        solidWord = _mm256_set1_epi32(static_cast<int>(ConvertSolidPixelToYUY2(color)));
+                    }
+                    _mm256_storeu_si256(dst + 0, solidWord);
+                    _mm256_storeu_si256(dst + 1, solidWord);
+                    solidPixels += 32;
+                    continue;
+                }
+            }
+
+            _mm256_storeu_si256(dst + 0, MergePairs(ConvertPixels8(p0, c), ConvertPixels8(p1, c)));
+            _mm256_storeu_si256(dst + 1, MergePairs(ConvertPixels8(p2, c), ConvertPixels8(p3, c)));
+        }
+
+        BGRAToYUY2RowTail_C(srcRow, dstRow, x, width);
+        return solidPixels;
+    }
+}
+
+UINT BGRAToYUY2Row_AVX2(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    return ConvertRow<false>(srcRow, dstRow, width);
+}
+
+UINT BGRAToYUY2RowSolid_AVX2(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    return ConvertRow<true>(srcRow, dstRow, width);
+}
@@ -0,0 +1,147 @@
+#include "BGRAToYUY2Kernels.h"
+#include "ColorConversionMath.h"
+#include <immintrin.h>
+
+// AVX-512BW内核：算法与AVX2版本相同，每个寄存器处理16个像素，
+// 像素对的压缩直接使用vpmovqd（截取每个64位通道的低32位）
+namespace
+{
+    struct CoefficientVectors
+    {
+        __m512i BRHigh;
+        __m512i BRLow;
+        __m512i GOneHigh;
+        __m512i GOneLow;
+    };
+
+    struct KernelConstants
+    {
+        CoefficientVectors Y;
+        CoefficientVectors U;
+        CoefficientVectors V;
+    };
+
+    inline CoefficientVectors LoadCoefficients(int coefB, int coefR, int coefG, int coefOne)
+    {
+        CoefficientVectors c;
+        c.BRHigh = _mm512_set1_epi32(PackCoefficientPair(CoefficientHigh(coefB), CoefficientHigh(coefR)));
+        c.BRLow = _mm512_set1_epi32(PackCoefficientPair(CoefficientLow(coefB), CoefficientLow(coefR)));
+        c.GOneHigh = _mm512_set1_epi32(PackCoefficientPair(CoefficientHigh(coefG), CoefficientHigh(coefOne)));
+        c.GOneLow = _mm512_set1_epi32(PackCoefficientPair(CoefficientLow(coefG), CoefficientLow(coefOne)));
+        return c;
+    }
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.Y = LoadCoefficients(kYCoefB, kYCoefR, kYCoefG, kYCoefOne);
+        c.U = LoadCoefficients(kUCoefB, kUCoefR, kUCoefG, kUVCoefOne);
+        c.V = LoadCoefficients(kVCoefB, kVCoefR, kVCoefG, kUVCoefOne);
+        return c;
+    }
+
+    inline __m512i MultiplyAdd(__m512i br, __m512i gOne, const CoefficientVectors& c)
+    {
+        __m512i high = _mm512_add_epi32(_mm512_madd_epi16(br, c.BRHigh), _mm512_madd_epi16(gOne, c.GOneHigh));
+        __m512i low = _mm512_add_epi32(_mm512_madd_epi16(br, c.BRLow), _mm512_madd_epi16(gOne, c.GOneLow));
+        return _mm512_add_epi32(_mm512_slli_epi32(high, kCoefSplitShift), low);
+    }
+
+    // 转换16个像素，返回8个连续的YUY2像素对
+    inline __m256i ConvertPixels16(__m512i pixels, const KernelConstants& c)
+    {
+        const __m512i maskBR = _mm512_set1_epi32(0x00FF00FF);
+        const __m512i maskG = _mm512_set1_epi32(0x000000FF);
+        const __m512i oneLane = _mm512_set1_epi32(kFixedOneLane << 16);
+        const __m512i uvMin = _mm512_set1_epi32(kUVFixedMin);
+        const __m512i uvMax = _mm512_set1_epi32(kUVFixedMax);
+        const __m512i uvRound = _mm512_set1_epi32(1 << kFixedShift);
+
+        __m512i br = _mm512_and_si512(pixels, maskBR);
+        __m512i gOne = _mm512_or_si512(_mm512_and_si512(_mm512_srli_epi32(pixels, 8), maskG), oneLane);
+
+        __m512i y = MultiplyAdd(br, gOne, c.Y);
+        __m512i u = MultiplyAdd(br, gOne, c.U);
+        __m512i v = MultiplyAdd(br, gOne, c.V);
+
+        y = _mm512_srai_epi32(y, kFixedShift);
+        y = _mm512_min_epi32(_mm512_max_epi32(y, _mm512_set1_epi32(16)), _mm512_set1_epi32(235));
+        u = _mm512_min_epi32(_mm512_max_epi32(u, uvMin), uvMax);
+        v = _mm512_min_epi32(_mm512_max_epi32(v, uvMin), uvMax);
+
+        __m512i yPair = _mm512_or_si512(y, _mm512_srli_epi64(y, 16));
+        __m512i uPair = _mm512_add_epi32(u, _mm512_srli_epi64(u, 32));
+        __m512i vPair = _mm512_add_epi32(v, _mm512_srli_epi64(v, 32));
+        uPair = _mm512_srli_epi32(_mm512_add_epi32(uPair, uvRound), kFixedShift + 1);
+        vPair = _mm512_srli_epi32(_mm512_add_epi32(vPair, uvRound), kFixedShift + 1);
+
+        __m512i packed = _mm512_or_si512(yPair, _mm512_or_si512(_mm512_slli_epi32(uPair, 8), _mm512_slli_epi32(vPair, 24)));
+        return _mm512_cvtepi64_epi32(packed);
+    }
+}
+
+namespace
+{
+    template <bool SolidFastPath>
+    inline UINT ConvertRow(const BYTE* srcRow, BYTE* dstRow, UINT width)
+    {
+        const KernelConstants c = LoadConstants();
+        UINT solidPixels = 0;
+        // 最近一个纯色块的颜色和对应的YUY2字，相邻的纯色块通常颜色相同
+        UINT solidColor = 0;
+        bool solidValid = false;
+        __m512i solidWord = _mm512_setzero_si512();
+
+        // 每次迭代处理64个像素（32个像素对）
+        UINT x = 0;
+        for (; x + 64 <= width; x += 64)
+        {
+            const BYTE* src = srcRow + x * 4;
+            BYTE* dst = dstRow + x * 2;
+
+            __m512i p0 = _mm512_loadu_si512(src + 0);
+            __m512i p1 = _mm512_loadu_si512(src + 64);
+            __m512i p2 = _mm512_loadu_si512(src + 128);
+            __m512i p3 = _mm512_loadu_si512(src + 192);
+
+            if (SolidFastPath)
+            {
+                __m512i first = _mm512_broadcastd_epi32(_mm512_castsi512_si128(p0));
+                __mmask16 same = _mm512_cmpeq_epi32_mask(p0, first) & _mm512_cmpeq_epi32_mask(p1, first) &
+                                 _mm512_cmpeq_epi32_mask(p2, first) & _mm512_cmpeq_epi32_mask(p3, first);
+                if (same == 0xFFFF)
+                {
+                    UINT color = static_cast<UINT>(_mm_cvtsi128_si32(_mm512_castsi512_si128(p0)));
+                    if (!solidValid || color != solidColor)
+                    {
+                        solidColor = color;
+                        solidValid = true;
+                        solidWord = _mm512_set1_epi32(static_cast<int>(ConvertSolidPixelToYUY2(color)));
+                    }
+                    _mm512_storeu_si512(dst + 0, solidWord);
+                    _mm512_storeu_si512(dst + 64, solidWord);
+                    solidPixels += 64;
+                    continue;
+                }
+            }
+
+            __m512i out0 = _mm512_inserti64x4(_mm512_castsi256_si512(ConvertPixels16(p0, c)), ConvertPixels16(p1, c), 1);
+            __m512i out1 = _mm512_inserti64x4(_mm512_castsi256_si512(ConvertPixels16(p2, c)), ConvertPixels16(p3, c), 1);
+            _mm512_storeu_si512(dst + 0, out0);
+            _mm512_storeu_si512(dst + 64, out1);
+        }
+
+        BGRAToYUY2RowTail_C(srcRow, dstRow, x, width);
+        return solidPixels;
+    }
+}
+
+UINT BGRAToYUY2Row_AVX512BW(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    return ConvertRow<false>(srcRow, dstRow, width);
+}
+
+UINT BGRAToYUY2RowSolid_AVX512BW(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    return ConvertRow<true>(srcRow, dstRow, width);
+}
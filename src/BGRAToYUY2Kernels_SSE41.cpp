@@ -0,0 +1,150 @@
+#include "BGRAToYUY2Kernels.h"
+#include "ColorConversionMath.h"
+#include <smmintrin.h>
+
+// SSE4.1内核：算法与AVX2版本相同，每个寄存器处理4个像素
+namespace
+{
+    struct CoefficientVectors
+    {
+        __m128i BRHigh;
+        __m128i BRLow;
+        __m128i GOneHigh;
+        __m128i GOneLow;
+    };
+
+    struct KernelConstants
+    {
+        CoefficientVectors Y;
+        CoefficientVectors U;
+        CoefficientVectors V;
+    };
+
+    inline CoefficientVectors LoadCoefficients(int coefB, int coefR, int coefG, int coefOne)
+    {
+        CoefficientVectors c;
+        c.BRHigh = _mm_set1_epi32(PackCoefficientPair(CoefficientHigh(coefB), CoefficientHigh(coefR)));
+        c.BRLow = _mm_set1_epi32(PackCoefficientPair(CoefficientLow(coefB), CoefficientLow(coefR)));
+        c.GOneHigh = _mm_set1_epi32(PackCoefficientPair(CoefficientHigh(coefG), CoefficientHigh(coefOne)));
+        c.GOneLow = _mm_set1_epi32(PackCoefficientPair(CoefficientLow(coefG), CoefficientLow(coefOne)));
+        return c;
+    }
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.Y = LoadCoefficients(kYCoefB, kYCoefR, kYCoefG, kYCoefOne);
+        c.U = LoadCoefficients(kUCoefB, kUCoefR, kUCoefG, kUVCoefOne);
+        c.V = LoadCoefficients(kVCoefB, kVCoefR, kVCoefG, kUVCoefOne);
+        return c;
+    }
+
+    inline __m128i MultiplyAdd(__m128i br, __m128i gOne, const CoefficientVectors& c)
+    {
+        __m128i high = _mm_add_epi32(_mm_madd_epi16(br, c.BRHigh), _mm_madd_epi16(gOne, c.GOneHigh));
+        __m128i low = _mm_add_epi32(_mm_madd_epi16(br, c.BRLow), _mm_madd_epi16(gOne, c.GOneLow));
+        return _mm_add_epi32(_mm_slli_epi32(high, kCoefSplitShift), low);
+    }
+
+    // 转换4个像素，结果的每个64位通道低32位为一个打包好的YUY2像素对
+    inline __m128i ConvertPixels4(__m128i pixels, const KernelConstants& c)
+    {
+        const __m128i maskBR = _mm_set1_epi32(0x00FF00FF);
+        const __m128i maskG = _mm_set1_epi32(0x000000FF);
+        const __m128i oneLane = _mm_set1_epi32(kFixedOneLane << 16);
+        const __m128i uvMin = _mm_set1_epi32(kUVFixedMin);
+        const __m128i uvMax = _mm_set1_epi32(kUVFixedMax);
+        const __m128i uvRound = _mm_set1_epi32(1 << kFixedShift);
+
+        __m128i br = _mm_and_si128(pixels, maskBR);
+        __m128i gOne = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 8), maskG), oneLane);
+
+        __m128i y = MultiplyAdd(br, gOne, c.Y);
+        __m128i u = MultiplyAdd(br, gOne, c.U);
+        __m128i v = MultiplyAdd(br, gOne, c.V);
+
+        y = _mm_srai_epi32(y, kFixedShift);
+        y = _mm_min_epi32(_mm_max_epi32(y, _mm_set1_epi32(16)), _mm_set1_epi32(235));
+        u = _mm_min_epi32(_mm_max_epi32(u, uvMin), uvMax);
+        v = _mm_min_epi32(_mm_max_epi32(v, uvMin), uvMax);
+
+        __m128i yPair = _mm_or_si128(y, _mm_srli_epi64(y, 16));
+        __m128i uPair = _mm_add_epi32(u, _mm_srli_epi64(u, 32));
+        __m128i vPair = _mm_add_epi32(v, _mm_srli_epi64(v, 32));
+        uPair = _mm_srli_epi32(_mm_add_epi32(uPair, uvRound), kFixedShift + 1);
+        vPair = _mm_srli_epi32(_mm_add_epi32(vPair, uvRound), kFixedShift + 1);
+
+        return _mm_or_si128(yPair, _mm_or_si128(_mm_slli_epi32(uPair, 8), _mm_slli_epi32(vPair, 24)));
+    }
+
+    // 合并两组结果中偶数通道的像素对，得到连续的4个YUY2像素对
+    inline __m128i MergePairs(__m128i a, __m128i b)
+    {
+        __m128i mixed = _mm_blend_epi16(a, _mm_slli_epi64(b, 32), 0xCC);
+        return _mm_shuffle_epi32(mixed, _MM_SHUFFLE(3, 1, 2, 0));
+    }
+}
+
+namespace
+{
+    template <bool SolidFastPath>
+    inline UINT ConvertRow(const BYTE* srcRow, BYTE* dstRow, UINT width)
+    {
+        const KernelConstants c = LoadConstants();
+        UINT solidPixels = 0;
+        // 最近一个纯色块的颜色和对应的YUY2字，相邻的纯色块通常颜色相同
+        UINT solidColor = 0;
+        bool solidValid = false;
+        __m128i solidWord = _mm_setzero_si128();
+
+        // 每次迭代处理16个像素（8个像素对）
+        UINT x = 0;
+        for (; x + 16 <= width; x += 16)
+        {
+            const __m128i* src = reinterpret_cast<const __m128i*>(srcRow + x * 4);
+            __m128i* dst = reinterpret_cast<__m128i*>(dstRow + x * 2);
+
+            __m128i p0 = _mm_loadu_si128(src + 0);
+            __m128i p1 = _mm_loadu_si128(src + 1);
+            __m128i p2 = _mm_loadu_si128(src + 2);
+            __m128i p3 = _mm_loadu_si128(src + 3);
+
+            if (SolidFastPath)
+            {
+                __m128i first = _mm_shuffle_epi32(p0, 0);
+                __m128i same = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi32(p0, first), _mm_cmpeq_epi32(p1, first)),
+                                             _mm_and_si128(_mm_cmpeq_epi32(p2, first), _mm_cmpeq_epi32(p3, first)));
+                if (_mm_movemask_epi8(same) == 0xFFFF)
+                {
+                    UINT color = static_cast<UINT>(_mm_cvtsi128_si32(p0));
+                    if (!solidValid || color != solidColor)
+                    {
+                        solidColor = color;
+                        solidValid = true;
+                        solidWord = _mm_set1_epi32(static_cast<int>(ConvertSolidPixelToYUY2(color)));
+                    }
+                    _mm_storeu_si128(dst + 0, solidWord);
+                    _mm_storeu_si128(dst + 1, solidWord);
+                    solidPixels += 16;
+                    continue;
+                }
+            }
+
+            _mm_storeu_si128(dst + 0, MergePairs(ConvertPixels4(p0, c), ConvertPixels4(p1, c)));
+            _mm_storeu_si128(dst + 1, MergePairs(ConvertPixels4(p2, c), ConvertPixels4(p3, c)));
+        }
+
+        BGRAToYUY2RowTail_C(srcRow, dstRow, x, width);
+        return solidPixels;
+    }
+}
+
+UINT BGRAToYUY2Row_SSE41(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    return ConvertRow<false>(srcRow, dstRow, width);
+}
+
+UINT BGRAToYUY2RowSolid_SSE41(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    return ConvertRow<true>(srcRow, dstRow, width);
+}
@@ -0,0 +1,256 @@
+#pragma once
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+
+// CPU端颜色转换公共数学函数
+// 与shaders/BGRAToYUY2.hlsl中的RGBToYUV/PackYUY2保持逐项一致，
+// 作为所有CPU内核（以及GPU输出校验）的参考实现
+
+struct YUVFloat
+{
+    float Y;
+    float U;
+    float V;
+};
+
+// 8位UNORM分量转换为[0,1]浮点，与纹理采样的UNORM->float转换相同
+inline float UnormToFloat(BYTE value)
+{
+    return static_cast<float>(value) / 255.0f;
+}
+
+// HLSL的round()编译为round_ne指令（四舍六入五成双），
+// 使用默认舍入模式下的nearbyint获得相同结果
+inline UINT RoundToUInt(float value)
+{
+    return static_cast<UINT>(std::nearbyint(value));
+}
+
+// BT.601 RGB到YUV转换（限制范围），对应shader中的RGBToYUV
+inline YUVFloat RGBToYUV(float r, float g, float b)
+{
+    // 确保输入RGB在[0,1]范围内
+    r = (std::min)((std::max)(r, 0.0f), 1.0f);
+    g = (std::min)((std::max)(g, 0.0f), 1.0f);
+    b = (std::min)((std::max)(b, 0.0f), 1.0f);
+
+    float y = 0.299f * r + 0.587f * g + 0.114f * b;
+    float u = -0.14713f * r - 0.28886f * g + 0.436f * b;
+    float v = 0.615f * r - 0.51499f * g - 0.10001f * b;
+
+    // 转换到8位范围：Y:[16,235], UV:[16,240]
+    y = y * 219.0f + 16.0f;
+    u = (u + 0.5f) * 224.0f + 16.0f;
+    v = (v + 0.5f) * 224.0f + 16.0f;
+
+    YUVFloat yuv;
+    yuv.Y = (std::min)((std::max)(y, 16.0f), 235.0f);
+    yuv.U = (std::min)((std::max)(u, 16.0f), 240.0f);
+    yuv.V = (std::min)((std::max)(v, 16.0f), 240.0f);
+    return yuv;
+}
+
+// 将4个8位值打包成一个32位整数，内存字节序为 [Y0 U Y1 V]
+inline UINT PackYUY2(UINT y0, UINT u, UINT y1, UINT v)
+{
+    return (v << 24) | (y1 << 16) | (u << 8) | y0;
+}
+
+// 转换一个BGRA像素对（内存字节序B,G,R,A），UV取两个像素的平均值
+inline UINT ConvertPixelPairToYUY2(const BYTE* pixel0, const BYTE* pixel1)
+{
+    YUVFloat yuv0 = RGBToYUV(UnormToFloat(pixel0[2]), UnormToFloat(pixel0[1]), UnormToFloat(pixel0[0]));
+    YUVFloat yuv1 = RGBToYUV(UnormToFloat(pixel1[2]), UnormToFloat(pixel1[1]), UnormToFloat(pixel1[0]));
+
+    float uAvg = (yuv0.U + yuv1.U) * 0.5f;
+    float vAvg = (yuv0.V + yuv1.V) * 0.5f;
+
+    return PackYUY2(RoundToUInt(yuv0.Y), RoundToUInt(uAvg), RoundToUInt(yuv1.Y), RoundToUInt(vAvg));
+}
+
+// ---------------------------------------------------------------------------
+// 定点实现（Q22系数，按16位拆分后用pmaddwd计算），供标量及SIMD内核共享
+//
+// 系数 = shader浮点系数 * (219或224)/255 * 2^22，输入直接使用8位分量值。
+// SIMD内核中每个系数拆成 high*2^11 + low 两个16位部分（low在[0,2047]内），
+// 分别做pmaddwd后合并，结果与标量代码的32位整数运算完全相同。
+// 常数项通过值为256的"常量1"通道与系数相乘得到。
+//
+// 与浮点路径（ConvertPixelPairToYUY2，即shader公式）的偏差：
+//   - 最大偏差为1（8位码值），不会出现更大的偏差；
+//   - Y：穷举全部2^24种RGB输入，仅120种与浮点结果不同；
+//   - 单像素UV（像素对两像素相同）：穷举2^24种输入，U有135种不同，V完全一致；
+//   - 任意像素对的UV：随机抽样约1e-5的像素对不同。
+// 所有不一致都发生在精确结果距离.5舍入边界小于float32舍入误差的位置，
+// 此时浮点结果本身取决于运算顺序（GPU上mad是否融合也会影响），
+// 需要逐位对比GPU输出时请使用ConversionPrecision::FloatReference。
+// 可运行 CpuConversionBench --precision 重新穷举验证。
+// ---------------------------------------------------------------------------
+
+const int kFixedShift = 22;
+const int kCoefSplitShift = 11;
+const int kFixedOneLane = 256;    // 常数项通道的取值
+
+const int kYCoefR = 1077048;      // 0.299  * 219/255 * 2^22
+const int kYCoefG = 2114472;      // 0.587  * 219/255 * 2^22
+const int kYCoefB = 410647;       // 0.114  * 219/255 * 2^22
+const int kYCoefOne = 270336;     // (16 + 0.5) * 2^22 / 256，含取整偏移
+
+const int kUCoefR = -542087;      // -0.14713 * 224/255 * 2^22
+const int kUCoefG = -1064278;     // -0.28886 * 224/255 * 2^22
+const int kUCoefB = 1606402;      //  0.436   * 224/255 * 2^22
+const int kVCoefR = 2265911;      //  0.615   * 224/255 * 2^22
+const int kVCoefG = -1897433;     // -0.51499 * 224/255 * 2^22
+const int kVCoefB = -368478;      // -0.10001 * 224/255 * 2^22
+const int kUVCoefOne = 2097152;   // 128 * 2^22 / 256
+
+// 钳位后的UV最大为240*2^22，两像素之和加取整偏移仍小于2^31
+const int kUVFixedMin = 16 << kFixedShift;
+const int kUVFixedMax = 240 << kFixedShift;
+
+// 系数拆分：coef = CoefficientHigh(coef) * 2^11 + CoefficientLow(coef)
+inline int CoefficientLow(int coef)
+{
+    return coef & ((1 << kCoefSplitShift) - 1);
+}
+
+inline int CoefficientHigh(int coef)
+{
+    return (coef - CoefficientLow(coef)) / (1 << kCoefSplitShift);
+}
+
+// 将两个16位系数打包进一个32位通道（低16位在前），用于pmaddwd的系数向量
+inline int PackCoefficientPair(int low, int high)
+{
+    return static_cast<int>((static_cast<UINT>(high) << 16) | (static_cast<UINT>(low) & 0xFFFF));
+}
+
+// 单个像素的定点UV（保留小数位，用于像素对平均）
+inline int FixedU(int r, int g, int b)
+{
+    int u = kUCoefR * r + kUCoefG * g + kUCoefB * b + kUVCoefOne * kFixedOneLane;
+    return (std::min)((std::max)(u, kUVFixedMin), kUVFixedMax);
+}
+
+inline int FixedV(int r, int g, int b)
+{
+    int v = kVCoefR * r + kVCoefG * g + kVCoefB * b + kUVCoefOne * kFixedOneLane;
+    return (std::min)((std::max)(v, kUVFixedMin), kUVFixedMax);
+}
+
+inline UINT FixedY(int r, int g, int b)
+{
+    int y = (kYCoefR * r + kYCoefG * g + kYCoefB * b + kYCoefOne * kFixedOneLane) >> kFixedShift;
+    return static_cast<UINT>((std::min)((std::max)(y, 16), 235));
+}
+
+// 两个定点UV之和取平均并舍入到8位
+inline UINT FixedAverageUV(int sum)
+{
+    return static_cast<UINT>((sum + (1 << kFixedShift)) >> (kFixedShift + 1));
+}
+
+// 4:2:0时2x2块中四个定点UV之和取平均并舍入到8位。
+// 钳位后的四个值之和最大为960 * 2^22，超出int范围，按无符号数计算（SIMD内核中为回绕加法和逻辑右移）
+inline UINT FixedAverageUV4(UINT sum)
+{
+    return (sum + (1u << (kFixedShift + 1))) >> (kFixedShift + 2);
+}
+
+// 4:4:4时单个像素的定点UV舍入到8位，与两个相同像素取FixedAverageUV的结果相同
+inline UINT FixedRoundUV(int value)
+{
+    return static_cast<UINT>((value + (1 << (kFixedShift - 1))) >> kFixedShift);
+}
+
+// 定点版本的像素对转换，与所有SIMD内核逐位一致
+inline UINT ConvertPixelPairToYUY2Fixed(const BYTE* pixel0, const BYTE* pixel1)
+{
+    int u = FixedU(pixel0[2], pixel0[1], pixel0[0]) + FixedU(pixel1[2], pixel1[1], pixel1[0]);
+    int v = FixedV(pixel0[2], pixel0[1], pixel0[0]) + FixedV(pixel1[2], pixel1[1], pixel1[0]);
+
+    return PackYUY2(FixedY(pixel0[2], pixel0[1], pixel0[0]), FixedAverageUV(u),
+                    FixedY(pixel1[2], pixel1[1], pixel1[0]), FixedAverageUV(v));
+}
+
+// ---------------------------------------------------------------------------
+// NV12到RGBA，对应shaders/NV12ToRGBA.hlsl中的YUVToRGB
+// ---------------------------------------------------------------------------
+
+struct RGBFloat
+{
+    float R;
+    float G;
+    float B;
+};
+
+// BT.601 YUV到RGB转换，返回[0,1]范围的RGB
+inline RGBFloat YUVToRGB(float y, float u, float v)
+{
+    // 将YUV值从[16,235]/[16,240]范围转换到[0,1]范围
+    y = (y - 16.0f) / 219.0f;
+    u = (u - 128.0f) / 224.0f;
+    v = (v - 128.0f) / 224.0f;
+
+    RGBFloat rgb;
+    rgb.R = (std::min)((std::max)(y + 1.402f * v, 0.0f), 1.0f);
+    rgb.G = (std::min)((std::max)(y - 0.344f * u - 0.714f * v, 0.0f), 1.0f);
+    rgb.B = (std::min)((std::max)(y + 1.772f * u, 0.0f), 1.0f);
+    return rgb;
+}
+
+// 写入R8G8B8A8_UNORM时的float到UNORM转换
+inline UINT FloatToUnorm8(float value)
+{
+    return RoundToUInt(value * 255.0f);
+}
+
+// 浮点参考版本：输出内存字节序 [R G B A]，Alpha固定为255
+inline UINT ConvertNV12PixelToRGBA(BYTE y, BYTE u, BYTE v)
+{
+    RGBFloat rgb = YUVToRGB(y, u, v);
+    return FloatToUnorm8(rgb.R) | (FloatToUnorm8(rgb.G) << 8) | (FloatToUnorm8(rgb.B) << 16) | 0xFF000000u;
+}
+
+// 定点版本（Q20，直接输出0~255范围）：
+//   R = cY*(Y-16) + cRV*(V-128)
+//   G = cY*(Y-16) + cGU*(U-128) + cGV*(V-128)
+//   B = cY*(Y-16) + cBU*(U-128)
+// 色度项只与UV有关，SIMD内核对共享同一UV行的两行像素只计算一次。
+// 色度系数按 high*2^10 + low 拆分后用pmaddwd计算（low在[0,1023]内）。
+// 与浮点路径的偏差：穷举全部2^24种YUV输入，最大偏差为1，
+// 共942种输入有分量不同（原因同上，均位于舍入边界附近）。
+const int kNV12FixedShift = 20;
+const int kNV12CoefSplitShift = 10;
+
+const int kNV12CoefY = 1220945;       // 255/219 * 2^20
+const int kNV12CoefRV = 1673555;      //  1.402 * 255/224 * 2^20
+const int kNV12CoefGU = -410630;      // -0.344 * 255/224 * 2^20
+const int kNV12CoefGV = -852296;      // -0.714 * 255/224 * 2^20
+const int kNV12CoefBU = 2115221;      //  1.772 * 255/224 * 2^20
+const int kNV12Round = 1 << (kNV12FixedShift - 1);
+
+inline int NV12CoefficientLow(int coef)
+{
+    return coef & ((1 << kNV12CoefSplitShift) - 1);
+}
+
+inline int NV12CoefficientHigh(int coef)
+{
+    return (coef - NV12CoefficientLow(coef)) / (1 << kNV12CoefSplitShift);
+}
+
+inline UINT ClampFixedToByte(int value)
+{
+    return static_cast<UINT>((std::min)((std::max)(value >> kNV12FixedShift, 0), 255));
+}
+
+inline UINT ConvertNV12PixelToRGBAFixed(BYTE y, BYTE u, BYTE v)
+{
+    int yTerm = kNV12CoefY * (y - 16) + kNV12Round;
+    int r = yTerm + kNV12CoefRV * (v - 128);
+    int g = yTerm + kNV12CoefGU * (u - 128) + kNV12CoefGV * (v - 128);
+    int b = yTerm + kNV12CoefBU * (u - 128);
+    return ClampFixedToByte(r) | (ClampFixedToByte(g) << 8) | (ClampFixedToByte(b) << 16) | 0xFF000000u;
+}
@@ -0,0 +1,201 @@
+#include "CpuBGRAToI420Converter.h"
+#include <algorithm>
+
+namespace
+{
+    // 每个线程分配的行带数量（略多于线程数以平衡负载）以及每个行带的最少行数
+    const UINT kBandsPerThread = 2;
+    const UINT kMinBandHeight = 16;
+}
+
+CpuBGRAToI420Converter::CpuBGRAToI420Converter()
+    : m_rowPairKernel(nullptr)
+    , m_simdLevel(SimdLevel::Scalar)
+    , m_precision(ConversionPrecision::FixedPoint)
+    , m_threadPool(nullptr)
+    , m_initialized(false)
+    , m_lastLogTime(std::chrono::steady_clock::now())
+{
+}
+
+CpuBGRAToI420Converter::~CpuBGRAToI420Converter()
+{
+    Cleanup();
+}
+
+HRESULT CpuBGRAToI420Converter::Initialize(const CpuConversionOptions& options)
+{
+    m_precision = options.Precision;
+    if (m_precision == ConversionPrecision::FloatReference)
+    {
+        // 浮点参考路径只有标量实现
+        m_rowPairKernel = BGRAToI420RowPair_Float;
+        m_simdLevel = SimdLevel::Scalar;
+    }
+    else
+    {
+        m_rowPairKernel = GetBGRAToI420RowPairKernel(options.MaxSimdLevel, &m_simdLevel);
+    }
+
+    if (options.ThreadPool)
+    {
+        m_threadPool = options.ThreadPool;
+    }
+    else if (options.ThreadCount != 1)
+    {
+        m_ownedThreadPool.reset(new WorkerThreadPool());
+        HRESULT hr = m_ownedThreadPool->Initialize(options.ThreadCount, options.PinThreads);
+        if (FAILED(hr))
+        {
+            LogError("Failed to start CPU conversion worker threads");
+            Cleanup();
+            return hr;
+        }
+        m_threadPool = m_ownedThreadPool.get();
+    }
+
+    m_initialized = true;
+    LogMessage(std::string("CPU BGRA to I420 converter initialized successfully (") +
+              GetSimdLevelName(m_simdLevel) +
+              (m_precision == ConversionPrecision::FloatReference ? ", float reference" : "") +
+              ", " + std::to_string(GetThreadCount()) + " threads)");
+    return S_OK;
+}
+
+HRESULT CpuBGRAToI420Converter::CreateOutputBuffer(UINT width, UINT height, std::vector<BYTE>& outBuffer)
+{
+    if (width == 0 || height == 0)
+        return E_INVALIDARG;
+
+    try
+    {
+        outBuffer.resize(GetOutputSize(width, height)); // I420格式大小
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate CPU output buffer");
+        return E_OUTOFMEMORY;
+    }
+}
+
+HRESULT CpuBGRAToI420Converter::CreateOutputBuffer(UINT width, UINT height, UINT pitch, bool yv12,
+                                                   std::vector<BYTE>& outBuffer, ImageView& outView)
+{
+    if (width == 0 || height == 0 || (pitch != 0 && pitch < width))
+        return E_INVALIDARG;
+
+    try
+    {
+        outBuffer.resize(GetOutputSize(width, height, pitch));
+        outView = yv12 ? MakeYV12ImageView(outBuffer.data(), width, height, pitch)
+                       : MakeI420ImageView(outBuffer.data(), width, height, pitch);
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate CPU output buffer");
+        return E_OUTOFMEMORY;
+    }
+}
+
+void CpuBGRAToI420Converter::ConvertBand(void* context, UINT bandIndex)
+{
+    const BandContext* band = static_cast<const BandContext*>(context);
+
+    const ImagePlane& srcPlane = band->Source;
+    const ImagePlane& yPlane = band->YPlane;
+    UINT rowBegin = bandIndex * band->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + band->BandHeight, band->Height);
+
+    // 每次处理共享同一色度行的两行
+    for (UINT y = rowBegin; y < rowEnd; y += 2)
+    {
+        bool hasSecondRow = y + 1 < rowEnd;
+        const BYTE* srcRow0 = srcPlane.Data + (size_t)y * srcPlane.Pitch;
+        BYTE* yRow0 = yPlane.Data + (size_t)y * yPlane.Pitch;
+
+        band->RowPairKernel(srcRow0,
+                            hasSecondRow ? srcRow0 + srcPlane.Pitch : nullptr,
+                            yRow0,
+                            hasSecondRow ? yRow0 + yPlane.Pitch : nullptr,
+                            band->UPlane.Data + (size_t)(y / 2) * band->UPlane.Pitch,
+                            band->VPlane.Data + (size_t)(y / 2) * band->VPlane.Pitch,
+                            band->Width);
+    }
+}
+
+UINT CpuBGRAToI420Converter::GetBandHeight(UINT height) const
+{
+    UINT bandCount = 1;
+    if (m_threadPool)
+    {
+        bandCount = (std::min)(m_threadPool->GetThreadCount() * kBandsPerThread,
+                               (std::max)(1u, height / kMinBandHeight));
+    }
+    UINT bandHeight = (height + bandCount - 1) / bandCount;
+    return (bandHeight + 1) & ~1u;
+}
+
+HRESULT CpuBGRAToI420Converter::Convert(const BYTE* bgraData, BYTE* i420Data, UINT width, UINT height)
+{
+    // 紧凑布局的输入只读取，不会通过视图写入
+    return Convert(MakeBGRAImageView(const_cast<BYTE*>(bgraData), width, height),
+                   MakeI420ImageView(i420Data, width, height));
+}
+
+HRESULT CpuBGRAToI420Converter::Convert(const ImageView& source, const ImageView& destination)
+{
+    UINT width = source.Width;
+    UINT height = source.Height;
+    UINT chromaWidth = (width + 1) / 2;
+    UINT chromaHeight = (height + 1) / 2;
+    if (!m_initialized ||
+        !IsImageViewValid(source, 1, width, height) ||
+        !IsImageViewValid(destination, 3, width, height) ||
+        source.Planes[0].RowBytes < width * 4 ||
+        destination.Planes[0].RowBytes < width ||
+        destination.Planes[1].RowBytes < chromaWidth || destination.Planes[1].Height < chromaHeight ||
+        destination.Planes[2].RowBytes < chromaWidth || destination.Planes[2].Height < chromaHeight)
+        return E_INVALIDARG;
+
+    BandContext band;
+    band.RowPairKernel = m_rowPairKernel;
+    band.Source = source.Planes[0];
+    band.YPlane = destination.Planes[0];
+    band.UPlane = destination.Planes[1];
+    band.VPlane = destination.Planes[2];
+    band.Width = width;
+    band.Height = height;
+
+    band.BandHeight = GetBandHeight(height);
+    UINT bandCount = (height + band.BandHeight - 1) / band.BandHeight;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, ConvertBand, &band);
+    }
+    else
+    {
+        ConvertBand(&band, 0);
+    }
+
+    // 每10秒输出一次成功日志
+    auto currentTime = std::chrono::steady_clock::now();
+    auto timeDiff = std::chrono::duration_cast<std::chrono::seconds>(currentTime - m_lastLogTime);
+    if (timeDiff.count() >= 10)
+    {
+        LogMessage("CPU BGRA to I420 conversion completed successfully");
+        m_lastLogTime = currentTime;
+    }
+
+    return S_OK;
+}
+
+void CpuBGRAToI420Converter::Cleanup()
+{
+    m_ownedThreadPool.reset();
+    m_threadPool = nullptr;
+    m_rowPairKernel = nullptr;
+    m_initialized = false;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "BGRAToYUV420Kernels.h"
+#include "CpuConversionOptions.h"
+#include "ImageView.h"
+#include "Utils.h"
+#include "WorkerThreadPool.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// BGRA到平面4:2:0（I420/YV12）的可移植CPU转换器，供接受三个平面的软件编码器使用。
+// 转换规则与CpuBGRAToNV12Converter相同（同一套行对内核，UV输出逐位一致），
+// 只是U、V写入两个独立的平面。
+// 目标视图的三个平面由调用者给出指针和行步长（MakeI420ImageView），可以直接指向编码器的输入图像；
+// Planes[1]总是U、Planes[2]总是V，YV12只是平面在内存中的顺序不同（MakeYV12ImageView），不需要单独的路径
+class CpuBGRAToI420Converter
+{
+public:
+    CpuBGRAToI420Converter();
+    ~CpuBGRAToI420Converter();
+
+    HRESULT Initialize(const CpuConversionOptions& options = CpuConversionOptions());
+    // 紧凑布局的I420（Y、U、V依次存放）
+    HRESULT Convert(const BYTE* bgraData, BYTE* i420Data, UINT width, UINT height);
+    HRESULT Convert(const ImageView& source, const ImageView& destination);
+    HRESULT CreateOutputBuffer(UINT width, UINT height, std::vector<BYTE>& outBuffer);
+    // 按Y平面行步长pitch（0表示紧凑，色度平面为其一半）分配输出缓冲区，并返回描述它的I420或YV12视图
+    HRESULT CreateOutputBuffer(UINT width, UINT height, UINT pitch, bool yv12,
+                               std::vector<BYTE>& outBuffer, ImageView& outView);
+    void Cleanup();
+
+    SimdLevel GetSimdLevel() const { return m_simdLevel; }
+    ConversionPrecision GetPrecision() const { return m_precision; }
+    UINT GetThreadCount() const { return m_threadPool ? m_threadPool->GetThreadCount() : 1; }
+
+    static UINT GetOutputSize(UINT width, UINT height, UINT pitch = 0)
+    {
+        UINT yPitch = pitch ? pitch : width;
+        return yPitch * height + GetPlanarChromaPitch(width, pitch) * ((height + 1) / 2) * 2;
+    }
+
+private:
+    struct BandContext
+    {
+        BGRAToI420RowPairFunc RowPairKernel;
+        ImagePlane Source;
+        ImagePlane YPlane;
+        ImagePlane UPlane;
+        ImagePlane VPlane;
+        UINT Width;
+        UINT Height;
+        UINT BandHeight;    // 偶数，保证每个行带从色度行边界开始
+    };
+
+    static void ConvertBand(void* context, UINT bandIndex);
+    UINT GetBandHeight(UINT height) const;
+
+    BGRAToI420RowPairFunc m_rowPairKernel;
+    SimdLevel m_simdLevel;
+    ConversionPrecision m_precision;
+    std::unique_ptr<WorkerThreadPool> m_ownedThreadPool;
+    WorkerThreadPool* m_threadPool;
+    bool m_initialized;
+
+    // 用于控制日志输出频率
+    std::chrono::steady_clock::time_point m_lastLogTime;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include "BGRAToYUV420Kernels.h"
+#include "CpuConversionOptions.h"
+#include "ImageView.h"
+#include "Utils.h"
+#include "WorkerThreadPool.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// BGRA到NV12的可移植CPU转换器
+// 转换规则与shaders/BGRAToNV12.hlsl相同：BT.601限制范围、UV取2x2块四个像素的平均值、
+// 奇数宽度/高度时复制最后一列/行。
+// 源图像只读取一遍：行对内核每次读取两行，同时写出两行Y和一行交错的UV（见BGRAToYUV420Kernels.h），
+// 不经过YUY2再降采样。行对内核在Initialize时按CPUID选择（SSE4.1/AVX2/标量）。
+// 多线程时按UV行对齐的水平行带拆分，由常驻线程池执行。
+// 输出为独立的Y平面和UV平面（ImageView的两个平面，行步长可以不同），
+// 可以直接写入编码器的输入表面
+class CpuBGRAToNV12Converter
+{
+public:
+    CpuBGRAToNV12Converter();
+    ~CpuBGRAToNV12Converter();
+
+    HRESULT Initialize(const CpuConversionOptions& options = CpuConversionOptions());
+    // 紧凑布局：UV平面紧跟在Y平面之后，两个平面的行步长都为GetUVPlaneStride(width)
+    HRESULT Convert(const BYTE* bgraData, BYTE* nv12Data, UINT width, UINT height);
+    HRESULT Convert(const ImageView& source, const ImageView& destination);
+    HRESULT CreateOutputBuffer(UINT width, UINT height, std::vector<BYTE>& outBuffer);
+    // 按指定行步长（0表示紧凑，两个平面相同）分配输出缓冲区，并返回描述它的视图
+    HRESULT CreateOutputBuffer(UINT width, UINT height, UINT pitch, std::vector<BYTE>& outBuffer, ImageView& outView);
+    void Cleanup();
+
+    SimdLevel GetSimdLevel() const { return m_simdLevel; }
+    ConversionPrecision GetPrecision() const { return m_precision; }
+    UINT GetThreadCount() const { return m_threadPool ? m_threadPool->GetThreadCount() : 1; }
+
+    static UINT GetUVPlaneStride(UINT width) { return ((width + 1) / 2) * 2; }
+    static UINT GetOutputSize(UINT width, UINT height)
+    {
+        return GetUVPlaneStride(width) * (height + (height + 1) / 2);
+    }
+
+private:
+    struct BandContext
+    {
+        BGRAToNV12RowPairFunc RowPairKernel;
+        ImagePlane Source;
+        ImagePlane YPlane;
+        ImagePlane UVPlane;
+        UINT Width;
+        UINT Height;
+        UINT BandHeight;    // 偶数，保证每个行带从UV行边界开始
+    };
+
+    static void ConvertBand(void* context, UINT bandIndex);
+    UINT GetBandHeight(UINT height) const;
+
+    BGRAToNV12RowPairFunc m_rowPairKernel;
+    SimdLevel m_simdLevel;
+    ConversionPrecision m_precision;
+    std::unique_ptr<WorkerThreadPool> m_ownedThreadPool;
+    WorkerThreadPool* m_threadPool;
+    bool m_initialized;
+
+    // 用于控制日志输出频率
+    std::chrono::steady_clock::time_point m_lastLogTime;
+};
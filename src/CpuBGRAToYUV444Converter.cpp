@@ -0,0 +1,212 @@
+#include "CpuBGRAToYUV444Converter.h"
+#include <algorithm>
+
+namespace
+{
+    // 每个线程分配的行带数量（略多于线程数以平衡负载）以及每个行带的最少行数
+    const UINT kBandsPerThread = 2;
+    const UINT kMinBandHeight = 16;
+}
+
+CpuBGRAToYUV444Converter::CpuBGRAToYUV444Converter()
+    : m_i444Kernel(nullptr)
+    , m_ayuvKernel(nullptr)
+    , m_simdLevel(SimdLevel::Scalar)
+    , m_precision(ConversionPrecision::FixedPoint)
+    , m_threadPool(nullptr)
+    , m_initialized(false)
+    , m_lastLogTime(std::chrono::steady_clock::now())
+{
+}
+
+CpuBGRAToYUV444Converter::~CpuBGRAToYUV444Converter()
+{
+    Cleanup();
+}
+
+HRESULT CpuBGRAToYUV444Converter::Initialize(const CpuConversionOptions& options)
+{
+    m_precision = options.Precision;
+    if (m_precision == ConversionPrecision::FloatReference)
+    {
+        // 浮点参考路径只有标量实现
+        m_i444Kernel = BGRAToI444Row_Float;
+        m_ayuvKernel = BGRAToAYUVRow_Float;
+        m_simdLevel = SimdLevel::Scalar;
+    }
+    else
+    {
+        // 两种布局的内核提供相同的指令集等级
+        m_i444Kernel = GetBGRAToI444RowKernel(options.MaxSimdLevel, &m_simdLevel);
+        m_ayuvKernel = GetBGRAToAYUVRowKernel(options.MaxSimdLevel);
+    }
+
+    if (options.ThreadPool)
+    {
+        m_threadPool = options.ThreadPool;
+    }
+    else if (options.ThreadCount != 1)
+    {
+        m_ownedThreadPool.reset(new WorkerThreadPool());
+        HRESULT hr = m_ownedThreadPool->Initialize(options.ThreadCount, options.PinThreads);
+        if (FAILED(hr))
+        {
+            LogError("Failed to start CPU conversion worker threads");
+            Cleanup();
+            return hr;
+        }
+        m_threadPool = m_ownedThreadPool.get();
+    }
+
+    m_initialized = true;
+    LogMessage(std::string("CPU BGRA to YUV 4:4:4 converter initialized successfully (") +
+              GetSimdLevelName(m_simdLevel) +
+              (m_precision == ConversionPrecision::FloatReference ? ", float reference" : "") +
+              ", " + std::to_string(GetThreadCount()) + " threads)");
+    return S_OK;
+}
+
+HRESULT CpuBGRAToYUV444Converter::CreateOutputBuffer(UINT width, UINT height, UINT pitch, YUV444Layout layout,
+                                                     std::vector<BYTE>& outBuffer, ImageView& outView)
+{
+    UINT rowBytes = layout == YUV444Layout::AYUV ? width * 4 : width;
+    if (width == 0 || height == 0 || (pitch != 0 && pitch < rowBytes))
+        return E_INVALIDARG;
+
+    try
+    {
+        UINT rowPitch = pitch ? pitch : rowBytes;
+        if (layout == YUV444Layout::AYUV)
+        {
+            outBuffer.resize((size_t)rowPitch * height);
+            outView = MakeAYUVImageView(outBuffer.data(), width, height, rowPitch);
+        }
+        else
+        {
+            outBuffer.resize((size_t)rowPitch * height * 3);
+            outView = MakeI444ImageView(outBuffer.data(), width, height, rowPitch);
+        }
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate CPU output buffer");
+        return E_OUTOFMEMORY;
+    }
+}
+
+void CpuBGRAToYUV444Converter::ConvertBand(void* context, UINT bandIndex)
+{
+    const BandContext* band = static_cast<const BandContext*>(context);
+
+    const ImagePlane& srcPlane = band->Source;
+    const ImagePlane* planes = band->Planes;
+    UINT rowBegin = bandIndex * band->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + band->BandHeight, band->Height);
+
+    for (UINT y = rowBegin; y < rowEnd; y++)
+    {
+        const BYTE* srcRow = srcPlane.Data + (size_t)y * srcPlane.Pitch;
+        if (band->AYUVKernel)
+        {
+            band->AYUVKernel(srcRow, planes[0].Data + (size_t)y * planes[0].Pitch, band->Width);
+        }
+        else
+        {
+            band->I444Kernel(srcRow,
+                             planes[0].Data + (size_t)y * planes[0].Pitch,
+                             planes[1].Data + (size_t)y * planes[1].Pitch,
+                             planes[2].Data + (size_t)y * planes[2].Pitch,
+                             band->Width);
+        }
+    }
+}
+
+UINT CpuBGRAToYUV444Converter::GetBandHeight(UINT height) const
+{
+    UINT bandCount = 1;
+    if (m_threadPool)
+    {
+        bandCount = (std::min)(m_threadPool->GetThreadCount() * kBandsPerThread,
+                               (std::max)(1u, height / kMinBandHeight));
+    }
+    return (height + bandCount - 1) / bandCount;
+}
+
+HRESULT CpuBGRAToYUV444Converter::Convert(const BYTE* bgraData, BYTE* outputData, UINT width, UINT height,
+                                          YUV444Layout layout)
+{
+    // 紧凑布局的输入只读取，不会通过视图写入
+    ImageView source = MakeBGRAImageView(const_cast<BYTE*>(bgraData), width, height);
+    if (layout == YUV444Layout::AYUV)
+        return Convert(source, MakeAYUVImageView(outputData, width, height));
+    return Convert(source, MakeI444ImageView(outputData, width, height));
+}
+
+HRESULT CpuBGRAToYUV444Converter::Convert(const ImageView& source, const ImageView& destination)
+{
+    UINT width = source.Width;
+    UINT height = source.Height;
+    if (!m_initialized || !IsImageViewValid(source, 1, width, height) || source.Planes[0].RowBytes < width * 4)
+        return E_INVALIDARG;
+
+    bool ayuv = destination.PlaneCount == 1;
+    if (ayuv)
+    {
+        if (!IsImageViewValid(destination, 1, width, height) || destination.Planes[0].RowBytes < width * 4)
+            return E_INVALIDARG;
+    }
+    else
+    {
+        if (!IsImageViewValid(destination, 3, width, height))
+            return E_INVALIDARG;
+        for (UINT i = 0; i < 3; i++)
+        {
+            if (destination.Planes[i].RowBytes < width || destination.Planes[i].Height < height)
+                return E_INVALIDARG;
+        }
+    }
+
+    BandContext band;
+    band.I444Kernel = m_i444Kernel;
+    band.AYUVKernel = ayuv ? m_ayuvKernel : nullptr;
+    band.Source = source.Planes[0];
+    for (UINT i = 0; i < kMaxImagePlanes; i++)
+    {
+        band.Planes[i] = destination.Planes[i];
+    }
+    band.Width = width;
+    band.Height = height;
+
+    band.BandHeight = GetBandHeight(height);
+    UINT bandCount = (height + band.BandHeight - 1) / band.BandHeight;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, ConvertBand, &band);
+    }
+    else
+    {
+        ConvertBand(&band, 0);
+    }
+
+    // 每10秒输出一次成功日志
+    auto currentTime = std::chrono::steady_clock::now();
+    auto timeDiff = std::chrono::duration_cast<std::chrono::seconds>(currentTime - m_lastLogTime);
+    if (timeDiff.count() >= 10)
+    {
+        LogMessage("CPU BGRA to YUV 4:4:4 conversion completed successfully");
+        m_lastLogTime = currentTime;
+    }
+
+    return S_OK;
+}
+
+void CpuBGRAToYUV444Converter::Cleanup()
+{
+    m_ownedThreadPool.reset();
+    m_threadPool = nullptr;
+    m_i444Kernel = nullptr;
+    m_ayuvKernel = nullptr;
+    m_initialized = false;
+}
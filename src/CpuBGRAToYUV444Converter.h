@@ -0,0 +1,72 @@
+#pragma once
+#include "BGRAToYUV444Kernels.h"
+#include "CpuConversionOptions.h"
+#include "ImageView.h"
+#include "Utils.h"
+#include "WorkerThreadPool.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// 4:4:4输出的布局
+enum class YUV444Layout
+{
+    I444,   // Y、U、V三个平面
+    AYUV    // 打包，每像素4字节[V U Y A]
+};
+
+// BGRA到YUV 4:4:4的可移植CPU转换器，用于文字较多的屏幕内容（4:2:2/4:2:0的色度平均会使彩色文字边缘模糊）。
+// 颜色公式与YUY2/NV12相同（BT.601限制范围、同一套定点系数），只是每个像素保留自己的UV，
+// 客户端协商4:4:4时直接从BGRA一遍转换，不需要额外的全分辨率转换。
+// 输出布局由目标视图决定：三个平面为I444（MakeI444ImageView），单个平面为AYUV（MakeAYUVImageView）。
+// 行内核在Initialize时按CPUID选择（SSE4.1/AVX2/标量），多线程时按水平行带拆分，由常驻线程池执行
+class CpuBGRAToYUV444Converter
+{
+public:
+    CpuBGRAToYUV444Converter();
+    ~CpuBGRAToYUV444Converter();
+
+    HRESULT Initialize(const CpuConversionOptions& options = CpuConversionOptions());
+    // 紧凑布局（I444的三个平面依次存放）
+    HRESULT Convert(const BYTE* bgraData, BYTE* outputData, UINT width, UINT height, YUV444Layout layout);
+    HRESULT Convert(const ImageView& source, const ImageView& destination);
+    // 按行步长pitch（0表示紧凑；I444三个平面相同）分配输出缓冲区，并返回描述它的视图
+    HRESULT CreateOutputBuffer(UINT width, UINT height, UINT pitch, YUV444Layout layout,
+                               std::vector<BYTE>& outBuffer, ImageView& outView);
+    void Cleanup();
+
+    SimdLevel GetSimdLevel() const { return m_simdLevel; }
+    ConversionPrecision GetPrecision() const { return m_precision; }
+    UINT GetThreadCount() const { return m_threadPool ? m_threadPool->GetThreadCount() : 1; }
+
+    static UINT GetOutputSize(UINT width, UINT height, YUV444Layout layout)
+    {
+        return width * height * (layout == YUV444Layout::AYUV ? 4 : 3);
+    }
+
+private:
+    struct BandContext
+    {
+        BGRAToI444RowFunc I444Kernel;
+        BGRAToAYUVRowFunc AYUVKernel;   // 为空时输出I444
+        ImagePlane Source;
+        ImagePlane Planes[3];
+        UINT Width;
+        UINT Height;
+        UINT BandHeight;
+    };
+
+    static void ConvertBand(void* context, UINT bandIndex);
+    UINT GetBandHeight(UINT height) const;
+
+    BGRAToI444RowFunc m_i444Kernel;
+    BGRAToAYUVRowFunc m_ayuvKernel;
+    SimdLevel m_simdLevel;
+    ConversionPrecision m_precision;
+    std::unique_ptr<WorkerThreadPool> m_ownedThreadPool;
+    WorkerThreadPool* m_threadPool;
+    bool m_initialized;
+
+    // 用于控制日志输出频率
+    std::chrono::steady_clock::time_point m_lastLogTime;
+};
@@ -0,0 +1,1035 @@
+#include "CpuBGRAToYUY2Converter.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace
+{
+    // 每个线程分配的行带数量（略多于线程数以平衡负载）以及每个行带的最少行数
+    const UINT kBandsPerThread = 2;
+    const UINT kMinBandHeight = 16;
+    // 增量转换的脏区域小于此像素数时在调用线程上直接转换，唤醒线程池的开销不值得
+    const unsigned long long kMinParallelRegionPixels = 64 * 1024;
+    // 多路输出时每个条带的源行数：4K下约240KB，在生成所有输出的期间留在L2中
+    const UINT kSimulcastStripRows = 16;
+    // 旋转90/270度时每次转置的输出行数：每个源行读取64字节（一个缓存行），暂存区为16个输出行
+    const UINT kOrientationBlockRows = 16;
+
+    // 输出一行缩放转换的结果：源图像的Taps行 -> 中间行 -> 缩放后的BGRA行 -> YUY2，后两步都在缓存中完成
+    UINT ConvertScaledRow(BGRAToYUY2RowFunc rowKernel, const ScaleKernels& kernels, const ImagePlane& source,
+                          UINT sourceWidth, const ScaleFilterTable& horizontal, const ScaleFilterTable& vertical,
+                          UINT width, UINT y, short* intermediate, BYTE* scaledRow, BYTE* dstRow)
+    {
+        kernels.Column(source.Data + (size_t)vertical.Starts[y] * source.Pitch, source.Pitch,
+                       vertical.Weights.data() + (size_t)y * GetScaleWeightStride(vertical.Taps), vertical.Taps,
+                       sourceWidth * 4, intermediate);
+        kernels.Row(intermediate, horizontal.Starts.data(), horizontal.Weights.data(), horizontal.Taps, width,
+                    scaledRow);
+        return rowKernel(scaledRow, dstRow, width);
+    }
+
+    // 中心落在第sourceRow个源行或之后的第一个输出行（缩放到height行时），
+    // 相邻源行区间[a, b)对应的输出行区间互不重叠且覆盖全部输出行
+    UINT MapSimulcastRow(UINT sourceRow, UINT sourceHeight, UINT height)
+    {
+        unsigned long long position = 2ULL * sourceRow * height;
+        if (position <= sourceHeight)
+            return 0;
+        return static_cast<UINT>((position - sourceHeight + 2ULL * sourceHeight - 1) / (2ULL * sourceHeight));
+    }
+
+    // 多路输出中源行sourceRow对应的输出行边界；NV12按行对划分，边界取到偶数行
+    UINT MapSimulcastOutputRow(UINT sourceRow, UINT sourceHeight, const SimulcastOutput& output)
+    {
+        UINT height = output.Destination.Height;
+        UINT row = MapSimulcastRow(sourceRow, sourceHeight, height);
+        if (output.Format == SimulcastFormat::NV12)
+            row = (std::min)((row + 1) & ~1u, height);
+        return row;
+    }
+
+    // 写出一路多路输出的第y行（YUY2）或第y、y + 1行（NV12，y为偶数，row1为空表示奇数高度的最后一行）
+    UINT WriteSimulcastRows(BGRAToYUY2RowFunc rowKernel, BGRAToNV12RowPairFunc nv12Kernel, const SimulcastOutput& output,
+                            UINT y, const BYTE* row0, const BYTE* row1)
+    {
+        const ImageView& destination = output.Destination;
+        const ImagePlane& plane = destination.Planes[0];
+        BYTE* yRow0 = plane.Data + (size_t)y * plane.Pitch;
+        if (output.Format == SimulcastFormat::YUY2)
+            return rowKernel(row0, yRow0, destination.Width);
+
+        const ImagePlane& uvPlane = destination.Planes[1];
+        nv12Kernel(row0, row1, yRow0, row1 ? yRow0 + plane.Pitch : nullptr,
+                   uvPlane.Data + (size_t)(y / 2) * uvPlane.Pitch, destination.Width);
+        return 0;
+    }
+}
+
+CpuBGRAToYUY2Converter::CpuBGRAToYUY2Converter()
+    : m_rowKernel(nullptr)
+    , m_nv12RowPairKernel(nullptr)
+    , m_simdLevel(SimdLevel::Scalar)
+    , m_precision(ConversionPrecision::FixedPoint)
+    , m_solidColorFastPath(false)
+    , m_lastFrameStats()
+    , m_threadPool(nullptr)
+    , m_scaleKernels()
+    , m_scaleSimdLevel(SimdLevel::Scalar)
+    , m_orientationKernels()
+    , m_orientationSimdLevel(SimdLevel::Scalar)
+    , m_initialized(false)
+    , m_lastLogTime(std::chrono::steady_clock::now())
+{
+}
+
+CpuBGRAToYUY2Converter::~CpuBGRAToYUY2Converter()
+{
+    Cleanup();
+}
+
+HRESULT CpuBGRAToYUY2Converter::Initialize(const CpuConversionOptions& options)
+{
+    m_precision = options.Precision;
+    if (m_precision == ConversionPrecision::FloatReference)
+    {
+        // 浮点参考路径只有标量实现
+        m_rowKernel = BGRAToYUY2Row_Float;
+        m_nv12RowPairKernel = BGRAToNV12RowPair_Float;
+        m_simdLevel = SimdLevel::Scalar;
+        m_solidColorFastPath = false;
+    }
+    else
+    {
+        m_rowKernel = GetBGRAToYUY2RowKernel(options.MaxSimdLevel, &m_simdLevel, options.SolidColorFastPath);
+        m_nv12RowPairKernel = GetBGRAToNV12RowPairKernel(options.MaxSimdLevel);
+        // 标量内核没有快速路径
+        m_solidColorFastPath = options.SolidColorFastPath && m_simdLevel != SimdLevel::Scalar;
+    }
+    m_scaleKernels = GetScaleKernels(options.MaxSimdLevel, &m_scaleSimdLevel);
+    m_orientationKernels = GetOrientationKernels(options.MaxSimdLevel, &m_orientationSimdLevel);
+
+    if (options.ThreadPool)
+    {
+        m_threadPool = options.ThreadPool;
+    }
+    else if (options.ThreadCount != 1)
+    {
+        m_ownedThreadPool.reset(new WorkerThreadPool());
+        HRESULT hr = m_ownedThreadPool->Initialize(options.ThreadCount, options.PinThreads);
+        if (FAILED(hr))
+        {
+            LogError("Failed to start CPU conversion worker threads");
+            Cleanup();
+            return hr;
+        }
+        m_threadPool = m_ownedThreadPool.get();
+    }
+
+    m_initialized = true;
+    LogMessage(std::string("CPU BGRA to YUY2 converter initialized successfully (") +
+              GetSimdLevelName(m_simdLevel) +
+              (m_precision == ConversionPrecision::FloatReference ? ", float reference" : "") +
+              (m_solidColorFastPath ? ", solid fast path" : "") +
+              ", " + std::to_string(GetThreadCount()) + " threads)");
+    return S_OK;
+}
+
+HRESULT CpuBGRAToYUY2Converter::CreateOutputBuffer(UINT width, UINT height, std::vector<BYTE>& outBuffer)
+{
+    if (width == 0 || height == 0)
+        return E_INVALIDARG;
+
+    try
+    {
+        outBuffer.resize(GetOutputSize(width, height)); // YUY2格式大小
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate CPU output buffer");
+        return E_OUTOFMEMORY;
+    }
+}
+
+HRESULT CpuBGRAToYUY2Converter::CreateOutputBuffer(UINT width, UINT height, UINT pitch,
+                                                   std::vector<BYTE>& outBuffer, ImageView& outView)
+{
+    if (width == 0 || height == 0 || (pitch != 0 && pitch < ((width + 1) / 2) * 4))
+        return E_INVALIDARG;
+
+    try
+    {
+        outView = MakeYUY2ImageView(nullptr, width, height, pitch);
+        outBuffer.resize(GetImagePlaneSize(outView.Planes[0]));
+        outView.Planes[0].Data = outBuffer.data();
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate CPU output buffer");
+        return E_OUTOFMEMORY;
+    }
+}
+
+void CpuBGRAToYUY2Converter::ConvertBand(void* context, UINT bandIndex)
+{
+    const BandContext* band = static_cast<const BandContext*>(context);
+
+    UINT rowBegin = bandIndex * band->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + band->BandHeight, band->Height);
+
+    unsigned long long solidPixels = 0;
+    for (UINT y = rowBegin; y < rowEnd; y++)
+    {
+        solidPixels += band->RowKernel(band->Source.Data + (size_t)y * band->Source.Pitch,
+                                       band->Destination.Data + (size_t)y * band->Destination.Pitch, band->Width);
+    }
+    band->SolidPixels->fetch_add(solidPixels, std::memory_order_relaxed);
+}
+
+UINT CpuBGRAToYUY2Converter::GetBandCount(UINT height) const
+{
+    if (!m_threadPool)
+        return 1;
+    return (std::min)(m_threadPool->GetThreadCount() * kBandsPerThread, (std::max)(1u, height / kMinBandHeight));
+}
+
+HRESULT CpuBGRAToYUY2Converter::Convert(const BYTE* bgraData, BYTE* yuy2Data, UINT width, UINT height)
+{
+    // 紧凑布局的输入只读取，不会通过视图写入
+    return Convert(MakeBGRAImageView(const_cast<BYTE*>(bgraData), width, height),
+                   MakeYUY2ImageView(yuy2Data, width, height));
+}
+
+bool CpuBGRAToYUY2Converter::IsConvertible(const ImageView& source, const ImageView& destination)
+{
+    UINT width = source.Width;
+    UINT height = source.Height;
+    return IsImageViewValid(source, 1, width, height) &&
+           IsImageViewValid(destination, 1, width, height) &&
+           source.Planes[0].RowBytes >= width * 4 &&
+           destination.Planes[0].RowBytes >= ((width + 1) / 2) * 4;
+}
+
+void CpuBGRAToYUY2Converter::ConvertRegion(void* context, UINT taskIndex)
+{
+    const RegionContext* region = static_cast<const RegionContext*>(context);
+    const ImageRect& rect = region->Tasks[taskIndex];
+
+    // Left为偶数，对应输出中第Left/2个像素对
+    const BYTE* srcRow = region->Source.Data + (size_t)rect.Top * region->Source.Pitch + (size_t)rect.Left * 4;
+    BYTE* dstRow = region->Destination.Data + (size_t)rect.Top * region->Destination.Pitch + (size_t)(rect.Left / 2) * 4;
+    UINT width = rect.Right - rect.Left;
+
+    unsigned long long solidPixels = 0;
+    for (UINT y = rect.Top; y < rect.Bottom; y++)
+    {
+        solidPixels += region->RowKernel(srcRow, dstRow, width);
+        srcRow += region->Source.Pitch;
+        dstRow += region->Destination.Pitch;
+    }
+    region->SolidPixels->fetch_add(solidPixels, std::memory_order_relaxed);
+}
+
+HRESULT CpuBGRAToYUY2Converter::Convert(const ImageView& source, const ImageView& destination)
+{
+    UINT width = source.Width;
+    UINT height = source.Height;
+    if (!m_initialized || !IsConvertible(source, destination))
+        return E_INVALIDARG;
+
+    std::atomic<unsigned long long> solidPixels(0);
+    BandContext band;
+    band.RowKernel = m_rowKernel;
+    band.Source = source.Planes[0];
+    band.Destination = destination.Planes[0];
+    band.Width = width;
+    band.Height = height;
+    band.SolidPixels = &solidPixels;
+
+    UINT bandCount = GetBandCount(height);
+    band.BandHeight = (height + bandCount - 1) / bandCount;
+    bandCount = (height + band.BandHeight - 1) / band.BandHeight;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, ConvertBand, &band);
+    }
+    else
+    {
+        ConvertBand(&band, 0);
+    }
+    m_lastFrameStats.ConvertedPixels = (unsigned long long)width * height;
+    m_lastFrameStats.SolidPixels = solidPixels.load(std::memory_order_relaxed);
+
+    // 每10秒输出一次成功日志
+    auto currentTime = std::chrono::steady_clock::now();
+    auto timeDiff = std::chrono::duration_cast<std::chrono::seconds>(currentTime - m_lastLogTime);
+    if (timeDiff.count() >= 10)
+    {
+        LogMessage("CPU conversion completed successfully");
+        m_lastLogTime = currentTime;
+    }
+
+    return S_OK;
+}
+
+void CpuBGRAToYUY2Converter::ConvertOrientedBand(void* context, UINT bandIndex)
+{
+    const OrientedContext* oriented = static_cast<const OrientedContext*>(context);
+    const ImageOrientationMap& map = oriented->Map;
+    const ImagePlane& source = oriented->Source;
+    const ImagePlane& destination = oriented->Destination;
+    UINT width = oriented->Width;
+    size_t rowBytes = (size_t)width * 4;
+
+    UINT rowBegin = bandIndex * oriented->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + oriented->BandHeight, oriented->Height);
+    BYTE* rows = oriented->Rows + bandIndex * oriented->RowsStride;
+
+    unsigned long long solidPixels = 0;
+    if (map.YStepX == 0)
+    {
+        // 0/180度：输出行对应源图像的一行，水平翻转时先在暂存行中倒序
+        for (UINT y = rowBegin; y < rowEnd; y++)
+        {
+            const BYTE* srcRow = source.Data + (ptrdiff_t)(map.OriginY + (int)y * map.YStepY) * source.Pitch;
+            BYTE* dstRow = destination.Data + (size_t)y * destination.Pitch;
+            if (map.XStepX < 0)
+            {
+                oriented->Kernels.Reverse(srcRow, rows, width);
+                srcRow = rows;
+            }
+            solidPixels += oriented->RowKernel(srcRow, dstRow, width);
+        }
+    }
+    else
+    {
+        // 90/270度：输出行oy对应源列OriginX + oy * YStepX，输出像素ox对应源行OriginY + ox * XStepY。
+        // 每次把kOrientationBlockRows个相邻源列转置成暂存行，再逐行交给行内核
+        const BYTE* srcRow = source.Data + (ptrdiff_t)map.OriginY * source.Pitch;
+        ptrdiff_t srcPitch = map.XStepY * (ptrdiff_t)source.Pitch;
+        for (UINT y0 = rowBegin; y0 < rowEnd; y0 += kOrientationBlockRows)
+        {
+            UINT count = (std::min)(kOrientationBlockRows, rowEnd - y0);
+            int firstColumn = map.OriginX + (int)y0 * map.YStepX;
+            int column = map.YStepX > 0 ? firstColumn : firstColumn - (int)(count - 1);
+
+            // 源列column + i对应暂存行i（YStepX为1）或count - 1 - i（YStepX为-1）
+            BYTE* dst = map.YStepX > 0 ? rows : rows + (count - 1) * rowBytes;
+            ptrdiff_t dstPitch = map.YStepX > 0 ? (ptrdiff_t)rowBytes : -(ptrdiff_t)rowBytes;
+            oriented->Kernels.Transpose(srcRow + (size_t)column * 4, srcPitch, dst, dstPitch, count, width);
+
+            for (UINT i = 0; i < count; i++)
+            {
+                solidPixels += oriented->RowKernel(rows + i * rowBytes,
+                                                   destination.Data + (size_t)(y0 + i) * destination.Pitch, width);
+            }
+        }
+    }
+
+    oriented->SolidPixels->fetch_add(solidPixels, std::memory_order_relaxed);
+}
+
+HRESULT CpuBGRAToYUY2Converter::Convert(const ImageView& source, const ImageView& destination,
+                                        const ImageOrientation& orientation)
+{
+    if (IsIdentityOrientation(orientation))
+        return Convert(source, destination);
+
+    UINT width;
+    UINT height;
+    GetOrientedSize(orientation, source.Width, source.Height, width, height);
+    if (!m_initialized || !IsImageViewValid(source, 1, source.Width, source.Height) ||
+        source.Planes[0].RowBytes < source.Width * 4 || !IsImageViewValid(destination, 1, width, height) ||
+        destination.Planes[0].RowBytes < ((width + 1) / 2) * 4)
+        return E_INVALIDARG;
+
+    UINT bandCount = GetBandCount(height);
+    UINT bandHeight = (height + bandCount - 1) / bandCount;
+    bandCount = (height + bandHeight - 1) / bandHeight;
+
+    size_t rowsStride = (size_t)kOrientationBlockRows * width * 4;
+    try
+    {
+        if (m_orientedRows.size() < rowsStride * bandCount)
+            m_orientedRows.resize(rowsStride * bandCount);
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate oriented conversion rows");
+        return E_OUTOFMEMORY;
+    }
+
+    std::atomic<unsigned long long> solidPixels(0);
+    OrientedContext oriented;
+    oriented.RowKernel = m_rowKernel;
+    oriented.Kernels = m_orientationKernels;
+    oriented.Map = GetImageOrientationMap(orientation, source.Width, source.Height);
+    oriented.Source = source.Planes[0];
+    oriented.Destination = destination.Planes[0];
+    oriented.Width = width;
+    oriented.Height = height;
+    oriented.BandHeight = bandHeight;
+    oriented.Rows = m_orientedRows.data();
+    oriented.RowsStride = rowsStride;
+    oriented.SolidPixels = &solidPixels;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, ConvertOrientedBand, &oriented);
+    }
+    else
+    {
+        ConvertOrientedBand(&oriented, 0);
+    }
+    m_lastFrameStats.ConvertedPixels = (unsigned long long)width * height;
+    m_lastFrameStats.SolidPixels = solidPixels.load(std::memory_order_relaxed);
+    return S_OK;
+}
+
+HRESULT CpuBGRAToYUY2Converter::Convert(const ImageView& source, const ImageView& destination,
+                                        const CursorImage& cursor, int cursorX, int cursorY)
+{
+    HRESULT hr = Convert(source, destination);
+    if (SUCCEEDED(hr))
+    {
+        hr = CompositeCursor(source, destination, cursor, cursorX, cursorY);
+    }
+    return hr;
+}
+
+HRESULT CpuBGRAToYUY2Converter::CompositeCursor(const ImageView& source, const ImageView& destination,
+                                                const CursorImage& cursor, int cursorX, int cursorY)
+{
+    if (!m_initialized || !IsConvertible(source, destination))
+        return E_INVALIDARG;
+
+    ImageRect covered = GetCursorRect(cursor, cursorX, cursorY, source.Width, source.Height);
+    if (IsImageRectEmpty(covered))
+        return S_OK;
+
+    // 扩展到整像素对：指针边缘所在像素对中的另一个像素按原样参与UV平均
+    ImageRect pairs = covered;
+    AlignImageRectToPixelPairs(pairs, source.Width);
+    UINT count = pairs.Right - pairs.Left;
+    try
+    {
+        if (m_cursorRow.size() < (size_t)count * 4)
+            m_cursorRow.resize((size_t)count * 4);
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate cursor row");
+        return E_OUTOFMEMORY;
+    }
+
+    // 指针只有几十行，在调用线程上直接完成
+    const ImagePlane& src = source.Planes[0];
+    const ImagePlane& dst = destination.Planes[0];
+    BYTE* row = m_cursorRow.data();
+    UINT firstColumn = static_cast<UINT>(static_cast<int>(covered.Left) - cursorX);
+    for (UINT y = pairs.Top; y < pairs.Bottom; y++)
+    {
+        memcpy(row, src.Data + (size_t)y * src.Pitch + (size_t)pairs.Left * 4, (size_t)count * 4);
+        CompositeCursorRow(cursor, static_cast<UINT>(static_cast<int>(y) - cursorY), firstColumn,
+                           covered.Right - covered.Left, row + (size_t)(covered.Left - pairs.Left) * 4);
+        m_rowKernel(row, dst.Data + (size_t)y * dst.Pitch + (size_t)(pairs.Left / 2) * 4, count);
+    }
+    return S_OK;
+}
+
+HRESULT CpuBGRAToYUY2Converter::ConvertCrop(const ImageView& source, const ImageRect& sourceRect,
+                                            const ImageView& destination)
+{
+    if (!IsImageViewValid(source, 1, source.Width, source.Height) || source.Planes[0].RowBytes < source.Width * 4 ||
+        IsImageRectEmpty(sourceRect) || sourceRect.Right > source.Width || sourceRect.Bottom > source.Height)
+        return E_INVALIDARG;
+
+    // 子视图直接指向区域的第一个像素，行内核从该像素开始配对
+    return Convert(CropBGRAImageView(source, sourceRect), destination);
+}
+
+HRESULT CpuBGRAToYUY2Converter::Convert(const ImageView& source, const ImageView& destination,
+                                        const ImageRect* dirtyRects, UINT rectCount)
+{
+    if (!m_initialized || !IsConvertible(source, destination) || (rectCount > 0 && !dirtyRects))
+        return E_INVALIDARG;
+
+    UINT width = source.Width;
+    UINT height = source.Height;
+
+    // 先统计需要转换的行数，据此决定每个任务的行数
+    unsigned long long totalRows = 0;
+    unsigned long long totalPixels = 0;
+    for (UINT i = 0; i < rectCount; i++)
+    {
+        ImageRect rect = dirtyRects[i];
+        if (!ClipImageRect(rect, width, height))
+            continue;
+        AlignImageRectToPixelPairs(rect, width);
+        totalRows += rect.Bottom - rect.Top;
+        totalPixels += GetImageRectArea(rect);
+    }
+    m_lastFrameStats.ConvertedPixels = 0;
+    m_lastFrameStats.SolidPixels = 0;
+    if (totalRows == 0)
+        return S_OK;
+
+    UINT taskHeight = (UINT)(std::min)(totalRows, (unsigned long long)height);
+    if (m_threadPool && totalPixels >= kMinParallelRegionPixels)
+    {
+        unsigned long long taskCount = (unsigned long long)m_threadPool->GetThreadCount() * kBandsPerThread;
+        taskHeight = (UINT)(std::max)((unsigned long long)kMinBandHeight, (totalRows + taskCount - 1) / taskCount);
+    }
+
+    // 每个矩形按taskHeight行拆分成任务，避免一个大矩形独占一个线程
+    m_regionTasks.clear();
+    try
+    {
+        for (UINT i = 0; i < rectCount; i++)
+        {
+            ImageRect rect = dirtyRects[i];
+            if (!ClipImageRect(rect, width, height))
+                continue;
+            AlignImageRectToPixelPairs(rect, width);
+            for (UINT top = rect.Top; top < rect.Bottom; top += taskHeight)
+            {
+                m_regionTasks.push_back(MakeImageRect(rect.Left, top, rect.Right,
+                                                      (std::min)(top + taskHeight, rect.Bottom)));
+            }
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate dirty region tasks");
+        return E_OUTOFMEMORY;
+    }
+
+    std::atomic<unsigned long long> solidPixels(0);
+    RegionContext region;
+    region.RowKernel = m_rowKernel;
+    region.Source = source.Planes[0];
+    region.Destination = destination.Planes[0];
+    region.Tasks = m_regionTasks.data();
+    region.SolidPixels = &solidPixels;
+
+    UINT taskCount = (UINT)m_regionTasks.size();
+    if (m_threadPool && taskCount > 1 && totalPixels >= kMinParallelRegionPixels)
+    {
+        m_threadPool->Run(taskCount, ConvertRegion, &region);
+    }
+    else
+    {
+        for (UINT i = 0; i < taskCount; i++)
+        {
+            ConvertRegion(&region, i);
+        }
+    }
+
+    m_lastFrameStats.ConvertedPixels = totalPixels;
+    m_lastFrameStats.SolidPixels = solidPixels.load(std::memory_order_relaxed);
+    return S_OK;
+}
+
+void CpuBGRAToYUY2Converter::ScaleBand(void* context, UINT bandIndex)
+{
+    const ScaleContext* scale = static_cast<const ScaleContext*>(context);
+
+    UINT rowBegin = bandIndex * scale->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + scale->BandHeight, scale->Height);
+    short* intermediate = scale->Intermediate + bandIndex * scale->IntermediateStride;
+    BYTE* scaledRow = scale->ScaledRows + bandIndex * scale->ScaledRowStride;
+
+    unsigned long long solidPixels = 0;
+    if (scale->BoxKernel)
+    {
+        for (UINT y = rowBegin; y < rowEnd; y++)
+        {
+            scale->BoxKernel(scale->Source.Data + (size_t)y * scale->BoxFactor * scale->Source.Pitch, scale->Source.Pitch,
+                             scale->Width, scaledRow);
+            solidPixels += scale->RowKernel(scaledRow, scale->Destination.Data + (size_t)y * scale->Destination.Pitch,
+                                            scale->Width);
+        }
+        scale->SolidPixels->fetch_add(solidPixels, std::memory_order_relaxed);
+        return;
+    }
+
+    for (UINT y = rowBegin; y < rowEnd; y++)
+    {
+        solidPixels += ConvertScaledRow(scale->RowKernel, scale->Kernels, scale->Source, scale->SourceWidth,
+                                        *scale->Horizontal, *scale->Vertical, scale->Width, y, intermediate, scaledRow,
+                                        scale->Destination.Data + (size_t)y * scale->Destination.Pitch);
+    }
+    scale->SolidPixels->fetch_add(solidPixels, std::memory_order_relaxed);
+}
+
+HRESULT CpuBGRAToYUY2Converter::PrepareScaleTables(UINT sourceWidth, UINT sourceHeight, UINT width, UINT height,
+                                                   ScaleFilter filter, ScaleFilterTable& horizontal,
+                                                   ScaleFilterTable& vertical)
+{
+    filter = ResolveScaleFilter(filter, sourceWidth, sourceHeight, width, height);
+    HRESULT hr = S_OK;
+    if (horizontal.SourceSize != sourceWidth || horizontal.DestinationSize != width || horizontal.Filter != filter)
+    {
+        hr = BuildScaleFilterTable(sourceWidth, width, filter, horizontal);
+    }
+    if (SUCCEEDED(hr) && (vertical.SourceSize != sourceHeight || vertical.DestinationSize != height ||
+                          vertical.Filter != filter))
+    {
+        hr = BuildScaleFilterTable(sourceHeight, height, filter, vertical);
+    }
+    if (FAILED(hr))
+    {
+        horizontal.SourceSize = 0;
+        vertical.SourceSize = 0;
+    }
+    return hr;
+}
+
+HRESULT CpuBGRAToYUY2Converter::ReserveScaleRows(size_t intermediateStride, size_t scaledRowStride, UINT bandCount)
+{
+    try
+    {
+        if (m_scaleIntermediate.size() < intermediateStride * bandCount)
+            m_scaleIntermediate.resize(intermediateStride * bandCount);
+        if (m_scaledRows.size() < scaledRowStride * bandCount)
+            m_scaledRows.resize(scaledRowStride * bandCount);
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate scaled conversion rows");
+        return E_OUTOFMEMORY;
+    }
+}
+
+HRESULT CpuBGRAToYUY2Converter::ConvertScaled(const ImageView& source, const ImageView& destination, ScaleFilter filter)
+{
+    UINT sourceWidth = source.Width;
+    UINT sourceHeight = source.Height;
+    UINT width = destination.Width;
+    UINT height = destination.Height;
+    if (!m_initialized || !IsImageViewValid(source, 1, sourceWidth, sourceHeight) ||
+        !IsImageViewValid(destination, 1, width, height) || source.Planes[0].RowBytes < sourceWidth * 4 ||
+        destination.Planes[0].RowBytes < ((width + 1) / 2) * 4)
+        return E_INVALIDARG;
+
+    if (sourceWidth == width && sourceHeight == height)
+        return Convert(source, destination);
+
+    // 2x/4x Box缩小直接对相邻像素求平均，不需要滤波表和中间行
+    UINT boxFactor = 0;
+    ScaleBoxFunc boxKernel = GetScaleBoxKernel(m_scaleKernels,
+                                               ResolveScaleFilter(filter, sourceWidth, sourceHeight, width, height),
+                                               sourceWidth, sourceHeight, width, height, &boxFactor);
+    HRESULT hr = S_OK;
+    if (!boxKernel)
+    {
+        hr = PrepareScaleTables(sourceWidth, sourceHeight, width, height, filter, m_scaleHorizontal, m_scaleVertical);
+        if (FAILED(hr))
+            return hr;
+    }
+
+    UINT bandCount = GetBandCount(height);
+    UINT bandHeight = (height + bandCount - 1) / bandCount;
+    bandCount = (height + bandHeight - 1) / bandHeight;
+
+    // 中间行之后的一个像素是水平滤波成对读取时的填充（系数为0，内容不影响结果）
+    size_t intermediateStride = boxKernel ? 0 : ((size_t)sourceWidth + 1) * 4;
+    size_t scaledRowStride = (size_t)width * 4;
+    hr = ReserveScaleRows(intermediateStride, scaledRowStride, bandCount);
+    if (FAILED(hr))
+        return hr;
+
+    std::atomic<unsigned long long> solidPixels(0);
+    ScaleContext scale;
+    scale.RowKernel = m_rowKernel;
+    scale.Kernels = m_scaleKernels;
+    scale.BoxKernel = boxKernel;
+    scale.BoxFactor = boxFactor;
+    scale.Source = source.Planes[0];
+    scale.Destination = destination.Planes[0];
+    scale.SourceWidth = sourceWidth;
+    scale.Width = width;
+    scale.Height = height;
+    scale.BandHeight = bandHeight;
+    scale.Horizontal = &m_scaleHorizontal;
+    scale.Vertical = &m_scaleVertical;
+    scale.Intermediate = m_scaleIntermediate.data();
+    scale.IntermediateStride = intermediateStride;
+    scale.ScaledRows = m_scaledRows.data();
+    scale.ScaledRowStride = scaledRowStride;
+    scale.SolidPixels = &solidPixels;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, ScaleBand, &scale);
+    }
+    else
+    {
+        ScaleBand(&scale, 0);
+    }
+    m_lastFrameStats.ConvertedPixels = (unsigned long long)width * height;
+    m_lastFrameStats.SolidPixels = solidPixels.load(std::memory_order_relaxed);
+    return S_OK;
+}
+
+unsigned long long CpuBGRAToYUY2Converter::ProduceSimulcastRows(const SimulcastContext* simulcast,
+                                                                SimulcastBandState& state, UINT output, UINT end)
+{
+    const SimulcastOutput& target = simulcast->Outputs[output];
+    const SimulcastPlan& plan = simulcast->Plans[output];
+    const ScaleFilterTable& horizontal = simulcast->Horizontal[output];
+    const ScaleFilterTable& vertical = simulcast->Vertical[output];
+    UINT width = target.Destination.Width;
+    UINT height = target.Destination.Height;
+    bool nv12 = target.Format == SimulcastFormat::NV12;
+    auto getRingRow = [&state](const SimulcastPlan& ring, UINT row)
+    {
+        return state.Scratch + ring.RingOffset + (size_t)(row % ring.RingRows) * ring.RingStride;
+    };
+
+    unsigned long long solidPixels = 0;
+    end = (std::min)(end, height);
+    for (; state.NextRow[output] < end; state.NextRow[output]++)
+    {
+        UINT y = state.NextRow[output];
+
+        // 滤波窗口：来源为另一路输出时先生成窗口中的行，窗口在来源的环形缓冲区中是连续的
+        UINT windowStart = plan.BoxKernel ? y * plan.BoxFactor : static_cast<UINT>(vertical.Starts[y]);
+        UINT windowRows = plan.BoxKernel ? plan.BoxFactor : vertical.Taps;
+        const BYTE* window;
+        size_t pitch;
+        if (plan.Parent < 0)
+        {
+            window = simulcast->Source.Data + (size_t)windowStart * simulcast->Source.Pitch;
+            pitch = simulcast->Source.Pitch;
+        }
+        else
+        {
+            const SimulcastPlan& parent = simulcast->Plans[plan.Parent];
+            solidPixels += ProduceSimulcastRows(simulcast, state, plan.Parent, windowStart + windowRows);
+            window = getRingRow(parent, windowStart);
+            pitch = parent.RingStride;
+        }
+
+        BYTE* row = getRingRow(plan, y);
+        if (plan.BoxKernel)
+        {
+            plan.BoxKernel(window, pitch, width, row);
+        }
+        else
+        {
+            simulcast->Kernels.Column(window, pitch, vertical.Weights.data() + (size_t)y * GetScaleWeightStride(vertical.Taps),
+                                      vertical.Taps, plan.ParentWidth * 4, state.Intermediate);
+            simulcast->Kernels.Row(state.Intermediate, horizontal.Starts.data(), horizontal.Weights.data(),
+                                   horizontal.Taps, width, row);
+        }
+        if (plan.Mirrored)
+        {
+            memcpy(row + (size_t)plan.RingRows * plan.RingStride, row, (size_t)width * 4);
+        }
+
+        // 只写出本任务负责的行，任务边界附近为子输出多生成的行不写出；NV12在一对行的第二行生成后写出
+        UINT first = nv12 ? y & ~1u : y;
+        if (first < state.OwnBegin[output] || first >= state.OwnEnd[output])
+            continue;
+        if (!nv12)
+        {
+            solidPixels += WriteSimulcastRows(simulcast->RowKernel, simulcast->NV12Kernel, target, y, row, nullptr);
+        }
+        else if ((y & 1) || y + 1 == height)
+        {
+            solidPixels += WriteSimulcastRows(simulcast->RowKernel, simulcast->NV12Kernel, target, first,
+                                              getRingRow(plan, first), (y & 1) ? row : nullptr);
+        }
+    }
+    return solidPixels;
+}
+
+void CpuBGRAToYUY2Converter::SimulcastBand(void* context, UINT bandIndex)
+{
+    const SimulcastContext* simulcast = static_cast<const SimulcastContext*>(context);
+
+    UINT rowBegin = bandIndex * simulcast->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + simulcast->BandHeight, simulcast->SourceHeight);
+    const ImagePlane& source = simulcast->Source;
+
+    SimulcastBandState state;
+    state.Scratch = simulcast->ScaledRows + bandIndex * simulcast->ScaledRowStride;
+    state.Intermediate = simulcast->Intermediate + bandIndex * simulcast->IntermediateStride;
+
+    // 本任务负责中心落在[rowBegin, rowEnd)内的输出行。从最小的输出开始确定每路要生成的第一行：
+    // 子输出第一个滤波窗口中的来源行可能在来源本任务负责的行之前，这些行只生成、不写出
+    for (UINT k = simulcast->OutputCount; k-- > 0; )
+    {
+        UINT i = simulcast->Order[k];
+        const SimulcastOutput& output = simulcast->Outputs[i];
+        state.OwnBegin[i] = MapSimulcastOutputRow(rowBegin, simulcast->SourceHeight, output);
+        state.OwnEnd[i] = MapSimulcastOutputRow(rowEnd, simulcast->SourceHeight, output);
+        UINT first = state.OwnBegin[i] < state.OwnEnd[i] ? state.OwnBegin[i] : UINT_MAX;
+        for (UINT c = 0; c < simulcast->OutputCount; c++)
+        {
+            const SimulcastPlan& child = simulcast->Plans[c];
+            if (child.Parent != static_cast<int>(i) || state.NextRow[c] == UINT_MAX)
+                continue;
+            UINT windowStart = child.BoxKernel ? state.NextRow[c] * child.BoxFactor
+                                               : static_cast<UINT>(simulcast->Vertical[c].Starts[state.NextRow[c]]);
+            first = (std::min)(first, windowStart);
+        }
+        state.NextRow[i] = first;
+    }
+
+    // 每个条带的源行读入缓存后，依次生成各路输出中中心落在该条带内的行。
+    // 缩放输出的滤波窗口会越过条带边界，多出的源行是上一个条带刚读过的，仍在缓存中
+    unsigned long long solidPixels = 0;
+    for (UINT stripBegin = rowBegin; stripBegin < rowEnd; stripBegin += kSimulcastStripRows)
+    {
+        UINT stripEnd = (std::min)(stripBegin + kSimulcastStripRows, rowEnd);
+        for (UINT k = 0; k < simulcast->OutputCount; k++)
+        {
+            UINT i = simulcast->Order[k];
+            const SimulcastOutput& output = simulcast->Outputs[i];
+            UINT outputEnd = MapSimulcastOutputRow(stripEnd, simulcast->SourceHeight, output);
+            if (!simulcast->Plans[i].FullSize)
+            {
+                solidPixels += ProduceSimulcastRows(simulcast, state, i, outputEnd);
+                continue;
+            }
+
+            UINT step = output.Format == SimulcastFormat::NV12 ? 2 : 1;
+            for (UINT y = MapSimulcastOutputRow(stripBegin, simulcast->SourceHeight, output); y < outputEnd; y += step)
+            {
+                const BYTE* row0 = source.Data + (size_t)y * source.Pitch;
+                solidPixels += WriteSimulcastRows(simulcast->RowKernel, simulcast->NV12Kernel, output, y, row0,
+                                                  y + 1 < simulcast->SourceHeight ? row0 + source.Pitch : nullptr);
+            }
+        }
+    }
+    simulcast->SolidPixels->fetch_add(solidPixels, std::memory_order_relaxed);
+}
+
+HRESULT CpuBGRAToYUY2Converter::ConvertSimulcast(const ImageView& source, const SimulcastOutput* outputs,
+                                                 UINT outputCount)
+{
+    UINT sourceWidth = source.Width;
+    UINT sourceHeight = source.Height;
+    if (!m_initialized || !outputs || outputCount == 0 || outputCount > kMaxSimulcastOutputs ||
+        !IsImageViewValid(source, 1, sourceWidth, sourceHeight) || source.Planes[0].RowBytes < sourceWidth * 4)
+        return E_INVALIDARG;
+
+    unsigned long long totalPixels = 0;
+    for (UINT i = 0; i < outputCount; i++)
+    {
+        const ImageView& destination = outputs[i].Destination;
+        UINT width = destination.Width;
+        UINT height = destination.Height;
+        bool valid = outputs[i].Format == SimulcastFormat::NV12
+            ? IsImageViewValid(destination, 2, width, height) && destination.Planes[0].RowBytes >= width &&
+              destination.Planes[1].RowBytes >= ((width + 1) / 2) * 2 && destination.Planes[1].Height >= (height + 1) / 2
+            : IsImageViewValid(destination, 1, width, height) && destination.Planes[0].RowBytes >= ((width + 1) / 2) * 4;
+        if (!valid)
+            return E_INVALIDARG;
+        totalPixels += (unsigned long long)width * height;
+    }
+
+    // 按面积从大到小排列，面积相同时保持原顺序
+    SimulcastContext simulcast;
+    for (UINT i = 0; i < outputCount; i++)
+    {
+        simulcast.Order[i] = i;
+    }
+    auto getArea = [outputs](UINT i)
+    {
+        return (unsigned long long)outputs[i].Destination.Width * outputs[i].Destination.Height;
+    };
+    std::stable_sort(simulcast.Order, simulcast.Order + outputCount,
+                     [&getArea](UINT a, UINT b) { return getArea(a) > getArea(b); });
+
+    // 选择每路缩放输出的来源并准备滤波表（大的输出在前，来源的计划总是先确定）
+    UINT maxParentWidth = 0;
+    for (UINT k = 0; k < outputCount; k++)
+    {
+        UINT i = simulcast.Order[k];
+        UINT width = outputs[i].Destination.Width;
+        UINT height = outputs[i].Destination.Height;
+        SimulcastPlan& plan = m_simulcastPlans[i];
+        plan = SimulcastPlan();
+        plan.FullSize = width == sourceWidth && height == sourceHeight;
+        plan.Parent = -1;
+        if (plan.FullSize)
+            continue;
+
+        for (UINT j = 0; j < outputCount; j++)
+        {
+            UINT parentWidth = outputs[j].Destination.Width;
+            UINT parentHeight = outputs[j].Destination.Height;
+            if (getArea(j) <= getArea(i) || parentWidth < width || parentHeight < height ||
+                parentWidth > sourceWidth || parentHeight > sourceHeight ||
+                (parentWidth == sourceWidth && parentHeight == sourceHeight))
+                continue;
+            if (plan.Parent < 0 || getArea(j) < getArea(static_cast<UINT>(plan.Parent)))
+                plan.Parent = static_cast<int>(j);
+        }
+
+        UINT parentWidth = plan.Parent < 0 ? sourceWidth : outputs[plan.Parent].Destination.Width;
+        UINT parentHeight = plan.Parent < 0 ? sourceHeight : outputs[plan.Parent].Destination.Height;
+        plan.ParentWidth = parentWidth;
+        plan.BoxKernel = GetScaleBoxKernel(m_scaleKernels,
+                                           ResolveScaleFilter(outputs[i].Filter, parentWidth, parentHeight, width, height),
+                                           parentWidth, parentHeight, width, height, &plan.BoxFactor);
+        if (plan.BoxKernel)
+            continue;
+
+        HRESULT hr = PrepareScaleTables(parentWidth, parentHeight, width, height, outputs[i].Filter,
+                                        m_simulcastHorizontal[i], m_simulcastVertical[i]);
+        if (FAILED(hr))
+            return hr;
+        maxParentWidth = (std::max)(maxParentWidth, parentWidth);
+    }
+
+    // 环形缓冲区：作为来源的输出需要保留一个条带的行，加上子输出（及其子输出）滤波窗口向前、向后延伸的行；
+    // 其他缩放输出只保留当前行（NV12为一对行）。从小到大计算每路输出的窗口延伸
+    UINT reach[kMaxSimulcastOutputs] = {};
+    size_t scratchStride = 0;
+    for (UINT k = outputCount; k-- > 0; )
+    {
+        UINT i = simulcast.Order[k];
+        SimulcastPlan& plan = m_simulcastPlans[i];
+        if (plan.FullSize)
+            continue;
+
+        UINT height = outputs[i].Destination.Height;
+        bool hasChildren = false;
+        for (UINT c = 0; c < outputCount; c++)
+        {
+            const SimulcastPlan& child = m_simulcastPlans[c];
+            if (child.Parent != static_cast<int>(i))
+                continue;
+            UINT childHeight = outputs[c].Destination.Height;
+            UINT taps = child.BoxKernel ? child.BoxFactor : m_simulcastVertical[c].Taps;
+            reach[i] = (std::max)(reach[i], taps + (reach[c] * height + childHeight - 1) / childHeight);
+            hasChildren = true;
+        }
+
+        UINT stripRows = (kSimulcastStripRows * height + sourceHeight - 1) / sourceHeight + 2;
+        plan.RingRows = hasChildren ? stripRows + 2 * reach[i] + 8 : 2;
+        plan.Mirrored = hasChildren;
+        plan.RingStride = ((size_t)outputs[i].Destination.Width * 4 + 63) & ~(size_t)63;
+        plan.RingOffset = scratchStride;
+        scratchStride += plan.RingStride * plan.RingRows * (plan.Mirrored ? 2 : 1);
+    }
+
+    // 按源行拆分任务（每个任务生成各路输出中对应的行）
+    UINT bandCount = GetBandCount(sourceHeight);
+    UINT bandHeight = (sourceHeight + bandCount - 1) / bandCount;
+    bandCount = (sourceHeight + bandHeight - 1) / bandHeight;
+
+    // 中间行之后的一个像素是水平滤波成对读取时的填充
+    size_t intermediateStride = maxParentWidth > 0 ? ((size_t)maxParentWidth + 1) * 4 : 0;
+    if (scratchStride > 0)
+    {
+        HRESULT hr = ReserveScaleRows(intermediateStride, scratchStride, bandCount);
+        if (FAILED(hr))
+            return hr;
+    }
+
+    std::atomic<unsigned long long> solidPixels(0);
+    simulcast.RowKernel = m_rowKernel;
+    simulcast.NV12Kernel = m_nv12RowPairKernel;
+    simulcast.Kernels = m_scaleKernels;
+    simulcast.Source = source.Planes[0];
+    simulcast.SourceWidth = sourceWidth;
+    simulcast.SourceHeight = sourceHeight;
+    simulcast.BandHeight = bandHeight;
+    simulcast.Outputs = outputs;
+    simulcast.OutputCount = outputCount;
+    simulcast.Plans = m_simulcastPlans;
+    simulcast.Horizontal = m_simulcastHorizontal;
+    simulcast.Vertical = m_simulcastVertical;
+    simulcast.Intermediate = m_scaleIntermediate.data();
+    simulcast.IntermediateStride = intermediateStride;
+    simulcast.ScaledRows = m_scaledRows.data();
+    simulcast.ScaledRowStride = scratchStride;
+    simulcast.SolidPixels = &solidPixels;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, SimulcastBand, &simulcast);
+    }
+    else
+    {
+        SimulcastBand(&simulcast, 0);
+    }
+    m_lastFrameStats.ConvertedPixels = totalPixels;
+    m_lastFrameStats.SolidPixels = solidPixels.load(std::memory_order_relaxed);
+    return S_OK;
+}
+
+HRESULT CpuBGRAToYUY2Converter::MoveRegions(const ImageView& destination, const ImageMove* moves, UINT moveCount)
+{
+    UINT width = destination.Width;
+    UINT height = destination.Height;
+    if (!IsImageViewValid(destination, 1, width, height) ||
+        destination.Planes[0].RowBytes < ((width + 1) / 2) * 4 || (moveCount > 0 && !moves))
+        return E_INVALIDARG;
+
+    for (UINT i = 0; i < moveCount; i++)
+    {
+        const ImageRect& dest = moves[i].Destination;
+        ImageRect source = GetImageMoveSource(moves[i]);
+        if (((dest.Left | dest.Right | source.Left) & 1) != 0 ||
+            IsImageRectEmpty(dest) || dest.Right > width || dest.Bottom > height ||
+            source.Right > width || source.Bottom > height)
+            return E_INVALIDARG;
+    }
+
+    const ImagePlane& plane = destination.Planes[0];
+    for (UINT i = 0; i < moveCount; i++)
+    {
+        const ImageRect& dest = moves[i].Destination;
+        size_t rowBytes = (size_t)(dest.Right - dest.Left) / 2 * 4;
+        BYTE* dstRow = plane.Data + (size_t)dest.Top * plane.Pitch + (size_t)dest.Left / 2 * 4;
+        const BYTE* srcRow = plane.Data + (size_t)moves[i].SourceTop * plane.Pitch + (size_t)moves[i].SourceLeft / 2 * 4;
+        UINT rows = dest.Bottom - dest.Top;
+
+        // 向下移动时从最后一行开始复制，避免覆盖尚未复制的源行；同一行内的重叠由memmove处理
+        if (dest.Top > moves[i].SourceTop)
+        {
+            for (UINT y = rows; y-- > 0;)
+            {
+                memmove(dstRow + (size_t)y * plane.Pitch, srcRow + (size_t)y * plane.Pitch, rowBytes);
+            }
+        }
+        else
+        {
+            for (UINT y = 0; y < rows; y++)
+            {
+                memmove(dstRow + (size_t)y * plane.Pitch, srcRow + (size_t)y * plane.Pitch, rowBytes);
+            }
+        }
+    }
+
+    return S_OK;
+}
+
+void CpuBGRAToYUY2Converter::Cleanup()
+{
+    m_ownedThreadPool.reset();
+    m_threadPool = nullptr;
+    m_rowKernel = nullptr;
+    m_nv12RowPairKernel = nullptr;
+    m_scaleHorizontal = ScaleFilterTable();
+    m_scaleVertical = ScaleFilterTable();
+    m_scaleIntermediate.clear();
+    m_scaledRows.clear();
+    m_orientedRows.clear();
+    m_cursorRow.clear();
+    for (UINT i = 0; i < kMaxSimulcastOutputs; i++)
+    {
+        m_simulcastHorizontal[i] = ScaleFilterTable();
+        m_simulcastVertical[i] = ScaleFilterTable();
+    }
+    m_initialized = false;
+}
@@ -0,0 +1,261 @@
+#pragma once
+#include "BGRAScaleKernels.h"
+#include "BGRAToYUV420Kernels.h"
+#include "BGRAToYUY2Kernels.h"
+#include "CpuConversionOptions.h"
+#include "CursorOverlay.h"
+#include "ImageOrientationKernels.h"
+#include "ImageView.h"
+#include "Utils.h"
+#include "WorkerThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// 最近一次转换（整帧或增量）的统计
+struct CpuConversionFrameStats
+{
+    unsigned long long ConvertedPixels;     // 转换的像素数，增量转换时只计脏区域
+    unsigned long long SolidPixels;         // 其中由纯色快速路径写出的像素数
+};
+
+// ConvertSimulcast一路输出的格式
+enum class SimulcastFormat
+{
+    YUY2,
+    NV12    // Destination为Y平面 + 交错UV平面（见MakeNV12ImageView），UV为2x2块的平均值
+};
+
+// ConvertSimulcast的一路输出：尺寸与源相同时直接转换，否则按Filter缩放转换
+struct SimulcastOutput
+{
+    ImageView Destination;
+    ScaleFilter Filter;
+    SimulcastFormat Format = SimulcastFormat::YUY2;
+};
+
+const UINT kMaxSimulcastOutputs = 4;
+
+// BGRA到YUY2的可移植CPU转换器
+// 转换规则与shaders/BGRAToYUY2.hlsl相同：BT.601限制范围、
+// 水平相邻两像素的UV取平均、奇数宽度时复制最后一个像素。
+// 行内核在Initialize时按CPUID选择（SSE4.1/AVX2/AVX-512BW/标量），
+// 定点路径与浮点公式的偏差见ColorConversionMath.h。
+// 默认使用带纯色快速路径的内核，每次转换统计平坦区域所占的比例（GetLastFrameStats）。
+// 多线程时按水平行带拆分，由常驻线程池执行。
+// ConvertScaled在同一遍中缩放和转换（见BGRAScaleKernels.h），源图像只读取一次，不产生整帧的中间图像。
+// ConvertSimulcast从同一源图像生成多个分辨率的YUY2/NV12输出，源图像按行条带读入缓存后由所有输出共用，
+// 较小的输出从下一个更大的输出缩放后的BGRA行继续缩放（例如4K -> 1080p -> 360p），不再回到源图像。
+// 带方向的Convert在转换的同时旋转/翻转（竖屏显示器），旋转90/270度时每次转置16行的条带，
+// 转置结果留在缓存中直接交给行内核，不需要单独的旋转遍。
+// CompositeCursor只重新转换指针覆盖的像素对（源像素先在暂存行中合成指针），不需要整帧的叠加遍。
+// 输入输出可以带行填充（ImageView的Pitch），直接在原缓冲区上转换
+class CpuBGRAToYUY2Converter
+{
+public:
+    CpuBGRAToYUY2Converter();
+    ~CpuBGRAToYUY2Converter();
+
+    HRESULT Initialize(const CpuConversionOptions& options = CpuConversionOptions());
+    HRESULT Convert(const BYTE* bgraData, BYTE* yuy2Data, UINT width, UINT height);
+    HRESULT Convert(const ImageView& source, const ImageView& destination);
+    // 增量转换：只重新转换dirtyRects覆盖的区域，destination中其余部分保持不变，
+    // 由调用者保证其中是之前转换的结果（见DirtyRegionTracker）。
+    // 矩形被裁剪到图像范围内并扩展到偶数x边界，重叠部分会被转换多次（结果相同）
+    HRESULT Convert(const ImageView& source, const ImageView& destination,
+                    const ImageRect* dirtyRects, UINT rectCount);
+    // 带方向的转换：destination的尺寸为source按orientation变换后的尺寸（GetOrientedSize），
+    // 像素对在变换后的图像中配对，结果与先旋转/翻转BGRA图像再转换相同
+    HRESULT Convert(const ImageView& source, const ImageView& destination, const ImageOrientation& orientation);
+    // 整帧转换并合成鼠标指针（左上角位于源图像中的(cursorX, cursorY)，可以部分在图像外）
+    HRESULT Convert(const ImageView& source, const ImageView& destination,
+                    const CursorImage& cursor, int cursorX, int cursorY);
+    // 指针合成：重新转换指针覆盖的像素对，这些像素先在暂存行中合成指针，destination的其余部分不变。
+    // 在Convert（整帧或增量）之后调用；增量转换时调用者需要把上一帧指针覆盖的区域加入脏矩形（GetCursorRect），
+    // 结果与先把指针合成到BGRA图像上再整帧转换相同
+    HRESULT CompositeCursor(const ImageView& source, const ImageView& destination,
+                            const CursorImage& cursor, int cursorX, int cursorY);
+    // 裁剪转换（窗口/区域采集）：只转换source中的sourceRect，destination的尺寸为sourceRect的尺寸。
+    // Left可以是奇数，像素对从sourceRect.Left开始配对，结果与先复制出该区域再整帧转换相同，
+    // 耗时与区域面积成正比。需要同时缩放时可对CropBGRAImageView的结果调用ConvertScaled
+    HRESULT ConvertCrop(const ImageView& source, const ImageRect& sourceRect, const ImageView& destination);
+    // 在已转换的YUY2输出上按顺序执行区域移动（滚动、拖动窗口），源和目标可以重叠。
+    // 移动的目标区域和源x必须是偶数（整像素对，见DirtyRegionTracker::GetUpdateRects）
+    HRESULT MoveRegions(const ImageView& destination, const ImageMove* moves, UINT moveCount);
+    // 缩放转换：source（BGRA）缩放到destination的尺寸并转换为YUY2（例如4K桌面输出1080p/720p）。
+    // 尺寸相同时等同于Convert(source, destination)。滤波表按尺寸和滤波器缓存，尺寸不变时每帧不再分配
+    HRESULT ConvertScaled(const ImageView& source, const ImageView& destination,
+                          ScaleFilter filter = ScaleFilter::Auto);
+    // 多路输出（例如同一桌面的4K、1080p和360p）：源图像按几十行的条带处理，每个条带读入缓存后
+    // 依次生成所有输出中对应的行，源图像只从内存读取一次。
+    // 缩放输出的来源是下一个更大的缩放输出（两个方向都不小于它、不超过源尺寸的输出中面积最小的一个），
+    // 没有时为源图像；滤波器按来源的尺寸选择。结果与先把来源缩放成BGRA图像、再缩放并转换该图像相同，
+    // 来源为源图像的输出与单独调用Convert/ConvertScaled（YUY2）的结果相同。
+    // 最多kMaxSimulcastOutputs路，各输出的缓冲区不能重叠
+    HRESULT ConvertSimulcast(const ImageView& source, const SimulcastOutput* outputs, UINT outputCount);
+    HRESULT CreateOutputBuffer(UINT width, UINT height, std::vector<BYTE>& outBuffer);
+    // 按指定行步长（0表示紧凑）分配输出缓冲区，并返回描述它的视图
+    HRESULT CreateOutputBuffer(UINT width, UINT height, UINT pitch, std::vector<BYTE>& outBuffer, ImageView& outView);
+    void Cleanup();
+
+    SimdLevel GetSimdLevel() const { return m_simdLevel; }
+    SimdLevel GetScaleSimdLevel() const { return m_scaleSimdLevel; }
+    SimdLevel GetOrientationSimdLevel() const { return m_orientationSimdLevel; }
+    ConversionPrecision GetPrecision() const { return m_precision; }
+    UINT GetThreadCount() const { return m_threadPool ? m_threadPool->GetThreadCount() : 1; }
+    bool IsSolidColorFastPathEnabled() const { return m_solidColorFastPath; }
+    const CpuConversionFrameStats& GetLastFrameStats() const { return m_lastFrameStats; }
+
+    static UINT GetOutputSize(UINT width, UINT height) { return ((width + 1) / 2) * height * 4; }
+
+private:
+    struct BandContext
+    {
+        BGRAToYUY2RowFunc RowKernel;
+        ImagePlane Source;
+        ImagePlane Destination;
+        UINT Width;
+        UINT Height;
+        UINT BandHeight;
+        std::atomic<unsigned long long>* SolidPixels;
+    };
+
+    // 增量转换时线程池的每个任务是某个脏矩形中的若干行
+    struct RegionContext
+    {
+        BGRAToYUY2RowFunc RowKernel;
+        ImagePlane Source;
+        ImagePlane Destination;
+        const ImageRect* Tasks;
+        std::atomic<unsigned long long>* SolidPixels;
+    };
+
+    // 缩放转换时线程池的每个任务是若干输出行，每个任务使用自己的暂存行
+    struct ScaleContext
+    {
+        BGRAToYUY2RowFunc RowKernel;
+        ScaleKernels Kernels;
+        ScaleBoxFunc BoxKernel;     // 2x/4x Box缩小时的专用内核，为空时使用滤波表
+        UINT BoxFactor;
+        ImagePlane Source;
+        ImagePlane Destination;
+        UINT SourceWidth;
+        UINT Width;
+        UINT Height;
+        UINT BandHeight;
+        const ScaleFilterTable* Horizontal;
+        const ScaleFilterTable* Vertical;
+        short* Intermediate;        // 每个任务一行Q7中间行（含一个像素的填充）
+        size_t IntermediateStride;
+        BYTE* ScaledRows;           // 每个任务一行缩放后的BGRA
+        size_t ScaledRowStride;
+        std::atomic<unsigned long long>* SolidPixels;
+    };
+
+    // 带方向的转换时线程池的每个任务是若干输出行，每个任务使用自己的暂存行
+    struct OrientedContext
+    {
+        BGRAToYUY2RowFunc RowKernel;
+        OrientationKernels Kernels;
+        ImageOrientationMap Map;
+        ImagePlane Source;
+        ImagePlane Destination;
+        UINT Width;
+        UINT Height;
+        UINT BandHeight;
+        BYTE* Rows;                 // 每个任务变换后的BGRA暂存行
+        size_t RowsStride;
+        std::atomic<unsigned long long>* SolidPixels;
+    };
+
+    // 多路输出中一路输出的生成方式。作为其他输出来源的缩放输出把缩放后的BGRA行保存在每个任务的环形缓冲区中，
+    // 直到所有子输出不再需要
+    struct SimulcastPlan
+    {
+        bool FullSize;              // 尺寸与源相同，直接转换源行
+        int Parent;                 // 缩放的来源：-1为源图像，否则为另一路输出的索引
+        UINT ParentWidth;
+        ScaleBoxFunc BoxKernel;     // 2x/4x Box缩小时的专用内核，为空时使用滤波表
+        UINT BoxFactor;
+        UINT RingRows;
+        bool Mirrored;              // 每行同时写入第r和第r + RingRows个位置，任意不超过RingRows行的滤波窗口都连续
+        size_t RingOffset;          // 在每个任务暂存区中的偏移
+        size_t RingStride;
+    };
+
+    // 多路输出时线程池的每个任务是若干源行，任务内按条带依次生成各路输出中对应的行
+    struct SimulcastContext
+    {
+        BGRAToYUY2RowFunc RowKernel;
+        BGRAToNV12RowPairFunc NV12Kernel;
+        ScaleKernels Kernels;
+        ImagePlane Source;
+        UINT SourceWidth;
+        UINT SourceHeight;
+        UINT BandHeight;
+        const SimulcastOutput* Outputs;
+        UINT OutputCount;
+        UINT Order[kMaxSimulcastOutputs];       // 按面积从大到小，来源总在子输出之前
+        const SimulcastPlan* Plans;
+        const ScaleFilterTable* Horizontal;     // 每路输出一个，尺寸与源相同的输出和Box专用内核不使用
+        const ScaleFilterTable* Vertical;
+        short* Intermediate;
+        size_t IntermediateStride;
+        BYTE* ScaledRows;                       // 每个任务的暂存区，包含各路缩放输出的环形缓冲区
+        size_t ScaledRowStride;
+        std::atomic<unsigned long long>* SolidPixels;
+    };
+
+    // 一个多路输出任务的进度：各路输出下一个要生成的行，以及本任务负责写出的行[OwnBegin, OwnEnd)
+    struct SimulcastBandState
+    {
+        BYTE* Scratch;
+        short* Intermediate;
+        UINT NextRow[kMaxSimulcastOutputs];
+        UINT OwnBegin[kMaxSimulcastOutputs];
+        UINT OwnEnd[kMaxSimulcastOutputs];
+    };
+
+    static bool IsConvertible(const ImageView& source, const ImageView& destination);
+    static void ConvertBand(void* context, UINT bandIndex);
+    static void ConvertRegion(void* context, UINT taskIndex);
+    static void ScaleBand(void* context, UINT bandIndex);
+    static void SimulcastBand(void* context, UINT bandIndex);
+    // 按顺序生成output缩放后的行直到end（不含），必要时先生成来源中滤波窗口的行；
+    // 本任务负责的行同时转换写出，返回纯色快速路径写出的像素数
+    static unsigned long long ProduceSimulcastRows(const SimulcastContext* simulcast, SimulcastBandState& state,
+                                                   UINT output, UINT end);
+    static void ConvertOrientedBand(void* context, UINT bandIndex);
+    static HRESULT PrepareScaleTables(UINT sourceWidth, UINT sourceHeight, UINT width, UINT height, ScaleFilter filter,
+                                      ScaleFilterTable& horizontal, ScaleFilterTable& vertical);
+    HRESULT ReserveScaleRows(size_t intermediateStride, size_t scaledRowStride, UINT bandCount);
+    UINT GetBandCount(UINT height) const;
+
+    BGRAToYUY2RowFunc m_rowKernel;
+    BGRAToNV12RowPairFunc m_nv12RowPairKernel;  // 多路输出中的NV12输出
+    SimdLevel m_simdLevel;
+    ConversionPrecision m_precision;
+    bool m_solidColorFastPath;
+    CpuConversionFrameStats m_lastFrameStats;
+    std::unique_ptr<WorkerThreadPool> m_ownedThreadPool;
+    WorkerThreadPool* m_threadPool;
+    std::vector<ImageRect> m_regionTasks;   // 每帧复用，稳定后不再分配
+    ScaleKernels m_scaleKernels;
+    SimdLevel m_scaleSimdLevel;
+    ScaleFilterTable m_scaleHorizontal;
+    ScaleFilterTable m_scaleVertical;
+    std::vector<short> m_scaleIntermediate;
+    std::vector<BYTE> m_scaledRows;
+    OrientationKernels m_orientationKernels;
+    SimdLevel m_orientationSimdLevel;
+    std::vector<BYTE> m_orientedRows;
+    std::vector<BYTE> m_cursorRow;
+    ScaleFilterTable m_simulcastHorizontal[kMaxSimulcastOutputs];
+    ScaleFilterTable m_simulcastVertical[kMaxSimulcastOutputs];
+    SimulcastPlan m_simulcastPlans[kMaxSimulcastOutputs];
+    bool m_initialized;
+
+    // 用于控制日志输出频率
+    std::chrono::steady_clock::time_point m_lastLogTime;
+};
@@ -0,0 +1,3280 @@
+#include "CpuBGRAToI420Converter.h"
+#include "CpuBGRAToNV12Converter.h"
+#include "CpuBGRAToYUV444Converter.h"
+#include "CpuBGRAToYUY2Converter.h"
+#include "CpuHDRToYUV10Converter.h"
+#include "CpuNV12ToRGBAConverter.h"
+#include "DirtyRegionTracker.h"
+#include "FramePacer.h"
+#include "FramePipeline.h"
+#include "FramePool.h"
+#include "FrameSources.h"
+#include "TileDamageDetector.h"
+#include "Utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// CPU颜色转换的基准测试工具（无需GPU，可在Linux上运行）
+// 用法: CpuConversionBench [width] [height] [frames] [threads]          BGRA到YUY2
+//       CpuConversionBench --nv12 [width] [height] [frames] [threads]   NV12到RGBA
+//       CpuConversionBench --to-nv12 [width] [height] [frames] [threads]
+//                                         BGRA到NV12（一遍完成2x2色度平均），与浮点参考比较偏差，
+//                                         并对比先转换为YUY2再重新打包为NV12的两遍路径
+//       CpuConversionBench --to-i420 [width] [height] [frames] [threads]
+//                                         BGRA到I420/YV12（三个平面由调用者给出），与NV12输出逐字节比较，
+//                                         并对比先转换为NV12再拆分UV平面的两遍路径
+//       CpuConversionBench --to-yuv444 [width] [height] [frames] [threads]
+//                                         BGRA到I444/AYUV（不降采样色度），各指令集与标量逐字节比较，
+//                                         与浮点参考比较偏差，并与YUY2转换的耗时对比
+//       CpuConversionBench --hdr [width] [height] [frames] [threads]
+//                                         R10G10B10A2和FP16 scRGB到P010/P210（BT.2020、PQ），各指令集与标量逐字节比较，
+//                                         与浮点参考比较偏差，并检查已知亮度的输出码值
+//       CpuConversionBench --precision    穷举验证定点路径与浮点路径的偏差
+//       CpuConversionBench --pool [width] [height] [frames] [threads]
+//                                         验证经帧池的采集→转换循环稳定后每帧零堆分配
+//       CpuConversionBench --pipeline [width] [height] [frames] [threads] [waitMs]
+//                                         比较串行与流水线（采集/转换/输出并行）的吞吐量，
+//                                         waitMs模拟采集和写出阶段的等待（等待垂直同步、磁盘/网络I/O）
+//       CpuConversionBench --pacing [fps] [frames] [workMs]
+//                                         比较固定sleep与绝对期限节拍下的实际帧率和错过的期限
+//       CpuConversionBench --source <bars|checker|noise|desktop|file.bgra> [frames] [fps] [threads] [width] [height]
+//                                         用合成图案或回放文件驱动转换流水线（fps为0表示不限速），
+//                                         输出校验和只取决于帧内容，可用于比较不同机器/帧率下的结果
+//       CpuConversionBench --dirty [width] [height] [frames] [threads]
+//                                         合成桌面（视频、输入、滚动、拖动）只搬移和转换变化的区域，
+//                                         与整帧转换逐帧比较并对比耗时
+//       CpuConversionBench --solid [width] [height] [frames] [threads]
+//                                         合成桌面和渐变测试图上比较各指令集开启/关闭纯色快速路径的耗时，
+//                                         并报告快速路径覆盖的像素比例
+//       CpuConversionBench --scale [width] [height] [frames] [threads]
+//                                         缩放到1/2、1/3、1/4、2/5（Box/Bilinear/Bicubic）的融合缩放转换，
+//                                         与先缩放整帧再转换的耗时对比，并与标量输出逐字节比较
+//       CpuConversionBench --simulcast [width] [height] [frames] [threads]
+//                                         同一源图像输出全分辨率、1/2和1/6三路YUY2，对比一遍读取源图像的多路输出
+//                                         与逐路转换的耗时，并逐字节比较
+//       CpuConversionBench --crop [width] [height] [frames] [threads]
+//                                         在画布上只转换一个窗口/区域（含奇数x偏移），与复制出区域后整帧转换的结果
+//                                         逐字节比较，并对比整个画布的转换耗时
+//       CpuConversionBench --rotate [width] [height] [frames] [threads]
+//                                         BGRA到YUY2和NV12到RGBA在转换时旋转90/180/270度和水平/垂直翻转，
+//                                         与逐像素旋转的参考结果逐字节比较，并对比不旋转和单独旋转一遍的耗时
+//       CpuConversionBench --cursor [width] [height] [frames] [threads]
+//                                         合成彩色、带掩码彩色和单色指针（含部分超出图像边缘），与先合成到BGRA图像
+//                                         再整帧转换的结果逐字节比较，并对比复制整帧后叠加指针再转换的耗时
+//       CpuConversionBench --damage [width] [height] [frames] [threads]
+//                                         同样的合成桌面不提供脏矩形，由分块哈希检测变化的区域，
+//                                         内容未变的帧（每4帧重复1帧）复用上一帧的输出；
+//                                         对比关闭和开启滚动检测（行段哈希找出垂直偏移，搬移上一帧的输出）
+
+// 统计全局堆分配次数（替换operator new，数组和nothrow版本默认都会转发到这里）
+static std::atomic<unsigned long long> g_heapAllocations(0);
+
+void* operator new(size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+// 上面的operator new同样用malloc分配；GCC把两者都内联进调用者后会误报mismatched-new-delete
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+static std::vector<BYTE> CreateTestBGRAData(UINT width, UINT height)
+{
+    std::vector<BYTE> bgraData((size_t)width * height * 4);
+
+    // 创建测试模式：水平/垂直渐变加少量高频纹理
+    for (UINT y = 0; y < height; y++)
+    {
+        for (UINT x = 0; x < width; x++)
+        {
+            BYTE* pixel = bgraData.data() + ((size_t)y * width + x) * 4;
+            pixel[0] = static_cast<BYTE>((x * 255) / width);         // B
+            pixel[1] = static_cast<BYTE>((y * 255) / height);        // G
+            pixel[2] = static_cast<BYTE>((x ^ y) & 0xFF);            // R
+            pixel[3] = 255;                                          // A
+        }
+    }
+    return bgraData;
+}
+
+// 创建NV12测试数据：Y平面渐变，UV平面覆盖完整的色度范围
+static void CreateTestNV12Data(UINT width, UINT height, std::vector<BYTE>& yPlane, std::vector<BYTE>& uvPlane)
+{
+    UINT uvStride = CpuNV12ToRGBAConverter::GetUVPlaneStride(width);
+    UINT uvHeight = (height + 1) / 2;
+    yPlane.resize((size_t)width * height);
+    uvPlane.resize((size_t)uvStride * uvHeight);
+
+    for (UINT y = 0; y < height; y++)
+    {
+        for (UINT x = 0; x < width; x++)
+        {
+            yPlane[(size_t)y * width + x] = static_cast<BYTE>(((x + y) * 255) / (width + height));
+        }
+    }
+    for (UINT y = 0; y < uvHeight; y++)
+    {
+        for (UINT x = 0; x < uvStride; x += 2)
+        {
+            uvPlane[(size_t)y * uvStride + x] = static_cast<BYTE>((x * 255) / uvStride);      // U
+            uvPlane[(size_t)y * uvStride + x + 1] = static_cast<BYTE>((x ^ y) & 0xFF);       // V
+        }
+    }
+}
+
+// 带行填充的测试布局：每行额外填充的字节数（保持4字节对齐）
+static const UINT kTestPitchPadding = 68;
+
+// 将紧凑平面复制到带填充的缓冲区，填充字节写入固定值以便发现越界读写
+static ImagePlane CopyToPaddedPlane(const BYTE* data, UINT rowBytes, UINT height, std::vector<BYTE>& storage)
+{
+    ImagePlane plane = MakeImagePlane(nullptr, rowBytes, height, rowBytes + kTestPitchPadding);
+    storage.assign((size_t)plane.Pitch * height, 0xCD);
+    plane.Data = storage.data();
+    for (UINT y = 0; y < height; y++)
+    {
+        memcpy(plane.Data + (size_t)y * plane.Pitch, data + (size_t)y * rowBytes, rowBytes);
+    }
+    return plane;
+}
+
+// 逐行比较带填充的输出与紧凑输出，并检查填充字节未被改写
+static bool MatchesPaddedPlane(const ImagePlane& plane, const std::vector<BYTE>& tightData)
+{
+    for (UINT y = 0; y < plane.Height; y++)
+    {
+        const BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+        if (memcmp(row, tightData.data() + (size_t)y * plane.RowBytes, plane.RowBytes) != 0)
+            return false;
+        if (y + 1 < plane.Height && row[plane.RowBytes] != 0xCD)
+            return false;
+    }
+    return true;
+}
+
+static bool VerifyPaddedConversion(CpuBGRAToYUY2Converter& converter, const std::vector<BYTE>& bgraData,
+                                   const std::vector<BYTE>& yuy2Data, UINT width, UINT height)
+{
+    std::vector<BYTE> srcStorage;
+    std::vector<BYTE> dstStorage((size_t)(((width + 1) / 2) * 4 + kTestPitchPadding) * height, 0xCD);
+    ImageView source = MakeBGRAImageView(nullptr, width, height);
+    source.Planes[0] = CopyToPaddedPlane(bgraData.data(), width * 4, height, srcStorage);
+    ImageView destination = MakeYUY2ImageView(dstStorage.data(), width, height,
+                                              ((width + 1) / 2) * 4 + kTestPitchPadding);
+
+    return SUCCEEDED(converter.Convert(source, destination)) && MatchesPaddedPlane(destination.Planes[0], yuy2Data);
+}
+
+static bool VerifyPaddedConversion(CpuNV12ToRGBAConverter& converter, const std::vector<BYTE>& yPlane,
+                                   const std::vector<BYTE>& uvPlane, const std::vector<BYTE>& rgbaData,
+                                   UINT width, UINT height)
+{
+    std::vector<BYTE> yStorage;
+    std::vector<BYTE> uvStorage;
+    std::vector<BYTE> dstStorage((size_t)(width * 4 + kTestPitchPadding) * height, 0xCD);
+    ImageView source = MakeNV12ImageView(nullptr, 0, nullptr, 0, width, height);
+    source.Planes[0] = CopyToPaddedPlane(yPlane.data(), width, height, yStorage);
+    source.Planes[1] = CopyToPaddedPlane(uvPlane.data(), CpuNV12ToRGBAConverter::GetUVPlaneStride(width),
+                                         (height + 1) / 2, uvStorage);
+    ImageView destination = MakeRGBAImageView(dstStorage.data(), width, height, width * 4 + kTestPitchPadding);
+
+    return SUCCEEDED(converter.Convert(source, destination)) && MatchesPaddedPlane(destination.Planes[0], rgbaData);
+}
+
+static void PrintBenchResult(SimdLevel level, double frameMs, double inputBytes)
+{
+    double megabytes = inputBytes / (1024.0 * 1024.0);
+    std::cout << "[BENCH] " << std::setw(9) << GetSimdLevelName(level)
+              << " Avg frame time: " << std::fixed << std::setprecision(3) << frameMs << "ms"
+              << ", FPS: " << std::setprecision(1) << 1000.0 / frameMs
+              << ", Input bandwidth: " << std::setprecision(1) << megabytes * 1000.0 / frameMs << " MB/s"
+              << std::endl;
+}
+
+static int RunPrecisionCheck()
+{
+    LogMessage("Measuring fixed-point deviation from the float (shader) path over all 2^24 RGB values...");
+
+    FixedPointDeviation deviation = MeasureFixedPointDeviation();
+    std::cout << "[PRECISION] Samples: " << deviation.SampleCount
+              << ", Y mismatches: " << deviation.MismatchY
+              << ", U mismatches: " << deviation.MismatchU
+              << ", V mismatches: " << deviation.MismatchV
+              << ", Max deviation: " << deviation.MaxDeviation << std::endl;
+
+    LogMessage("Measuring NV12 fixed-point deviation from the float (shader) path over all 2^24 YUV values...");
+
+    NV12FixedPointDeviation nv12Deviation = MeasureNV12FixedPointDeviation();
+    std::cout << "[PRECISION] NV12 samples: " << nv12Deviation.SampleCount
+              << ", R mismatches: " << nv12Deviation.MismatchR
+              << ", G mismatches: " << nv12Deviation.MismatchG
+              << ", B mismatches: " << nv12Deviation.MismatchB
+              << ", Max deviation: " << nv12Deviation.MaxDeviation << std::endl;
+
+    // 文档中承诺的最大偏差为1
+    if (deviation.MaxDeviation > 1 || nv12Deviation.MaxDeviation > 1)
+    {
+        LogError("Fixed-point deviation exceeds the documented bound of 1");
+        return -1;
+    }
+    return 0;
+}
+
+static int RunNV12Benchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("CPU NV12 to RGBA benchmark: " + std::to_string(width) + "x" +
+              std::to_string(height) + ", " + std::to_string(frames) + " frames, " +
+              std::to_string(threads) + " threads");
+
+    std::vector<BYTE> yPlane;
+    std::vector<BYTE> uvPlane;
+    CreateTestNV12Data(width, height, yPlane, uvPlane);
+    std::vector<BYTE> referenceData;
+    SimdLevel bestLevel = GetBestSimdLevel();
+
+    // 依次测试每个可用的指令集等级，并与标量结果逐字节比较
+    for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+    {
+        CpuConversionOptions options;
+        options.MaxSimdLevel = static_cast<SimdLevel>(level);
+        options.ThreadCount = threads;
+
+        CpuNV12ToRGBAConverter converter;
+        if (FAILED(converter.Initialize(options)))
+        {
+            LogError("Failed to initialize CPU converter");
+            return -1;
+        }
+
+        // NV12转换最高只有AVX2内核，更高等级会得到相同的内核
+        if (static_cast<int>(converter.GetSimdLevel()) != level)
+            continue;
+
+        std::vector<BYTE> rgbaData;
+        if (FAILED(converter.CreateOutputBuffer(width, height, rgbaData)))
+        {
+            LogError("Failed to create output buffer");
+            return -1;
+        }
+
+        // 预热一帧
+        converter.Convert(yPlane.data(), uvPlane.data(), rgbaData.data(), width, height);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (UINT i = 0; i < frames; i++)
+        {
+            if (FAILED(converter.Convert(yPlane.data(), uvPlane.data(), rgbaData.data(), width, height)))
+            {
+                LogError("Conversion failed");
+                return -1;
+            }
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        if (referenceData.empty())
+        {
+            referenceData = rgbaData;
+        }
+        else if (rgbaData != referenceData)
+        {
+            LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " output differs from scalar output");
+            return -1;
+        }
+
+        // 带行填充的输入输出必须得到与紧凑布局相同的结果
+        if (!VerifyPaddedConversion(converter, yPlane, uvPlane, rgbaData, width, height))
+        {
+            LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " padded-pitch output differs");
+            return -1;
+        }
+
+        double totalMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        PrintBenchResult(converter.GetSimdLevel(), totalMs / frames, (double)yPlane.size() + uvPlane.size());
+    }
+
+    return 0;
+}
+
+// 现有的两遍路径中的第二遍：YUY2重新打包为NV12，UV取上下两行的平均值
+static void RepackYUY2ToNV12(const ImageView& yuy2, const ImageView& nv12)
+{
+    const ImagePlane& src = yuy2.Planes[0];
+    const ImagePlane& yPlane = nv12.Planes[0];
+    const ImagePlane& uvPlane = nv12.Planes[1];
+    UINT pairs = (yuy2.Width + 1) / 2;
+    for (UINT y = 0; y < yuy2.Height; y += 2)
+    {
+        const BYTE* row0 = src.Data + (size_t)y * src.Pitch;
+        const BYTE* row1 = y + 1 < yuy2.Height ? row0 + src.Pitch : row0;
+        BYTE* yRow0 = yPlane.Data + (size_t)y * yPlane.Pitch;
+        BYTE* yRow1 = yRow0 + yPlane.Pitch;
+        BYTE* uvRow = uvPlane.Data + (size_t)(y / 2) * uvPlane.Pitch;
+        for (UINT i = 0; i < pairs; i++)
+        {
+            yRow0[i * 2] = row0[i * 4];
+            yRow0[i * 2 + 1] = row0[i * 4 + 2];
+            if (y + 1 < yuy2.Height)
+            {
+                yRow1[i * 2] = row1[i * 4];
+                yRow1[i * 2 + 1] = row1[i * 4 + 2];
+            }
+            uvRow[i * 2] = static_cast<BYTE>((row0[i * 4 + 1] + row1[i * 4 + 1] + 1) / 2);
+            uvRow[i * 2 + 1] = static_cast<BYTE>((row0[i * 4 + 3] + row1[i * 4 + 3] + 1) / 2);
+        }
+    }
+}
+
+static bool VerifyPaddedConversion(CpuBGRAToNV12Converter& converter, const std::vector<BYTE>& bgraData,
+                                   const std::vector<BYTE>& nv12Data, UINT width, UINT height)
+{
+    // Y平面和UV平面使用不同的行步长（编码器表面的两个平面可以分别给出）
+    UINT uvStride = CpuBGRAToNV12Converter::GetUVPlaneStride(width);
+    std::vector<BYTE> srcStorage;
+    std::vector<BYTE> yStorage((size_t)(width + kTestPitchPadding) * height, 0xCD);
+    std::vector<BYTE> uvStorage((size_t)(uvStride + kTestPitchPadding * 2) * ((height + 1) / 2), 0xCD);
+    ImageView source = MakeBGRAImageView(nullptr, width, height);
+    source.Planes[0] = CopyToPaddedPlane(bgraData.data(), width * 4, height, srcStorage);
+    ImageView destination = MakeNV12ImageView(yStorage.data(), width + kTestPitchPadding, uvStorage.data(),
+                                              uvStride + kTestPitchPadding * 2, width, height);
+    if (FAILED(converter.Convert(source, destination)))
+        return false;
+
+    // 紧凑输出中两个平面的行步长都为uvStride
+    std::vector<BYTE> tightY((size_t)width * height);
+    std::vector<BYTE> tightUV(nv12Data.begin() + (size_t)uvStride * height, nv12Data.end());
+    for (UINT y = 0; y < height; y++)
+    {
+        memcpy(tightY.data() + (size_t)y * width, nv12Data.data() + (size_t)y * uvStride, width);
+    }
+    return MatchesPaddedPlane(destination.Planes[0], tightY) && MatchesPaddedPlane(destination.Planes[1], tightUV);
+}
+
+static int RunBGRAToNV12Benchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("CPU BGRA to NV12 benchmark: " + std::to_string(width) + "x" +
+              std::to_string(height) + ", " + std::to_string(frames) + " frames, " +
+              std::to_string(threads) + " threads");
+
+    std::vector<BYTE> bgraData = CreateTestBGRAData(width, height);
+    std::vector<BYTE> referenceData;
+    SimdLevel bestLevel = GetBestSimdLevel();
+
+    // 奇数宽度和高度的小图（尾部和最后一行单独处理）也逐字节比较
+    const UINT oddWidth = 67;
+    const UINT oddHeight = 35;
+    std::vector<BYTE> oddData = CreateTestBGRAData(oddWidth, oddHeight);
+    std::vector<BYTE> oddReference;
+
+    // 依次测试每个可用的指令集等级，并与标量结果逐字节比较
+    for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+    {
+        CpuConversionOptions options;
+        options.MaxSimdLevel = static_cast<SimdLevel>(level);
+        options.ThreadCount = threads;
+
+        CpuBGRAToNV12Converter converter;
+        if (FAILED(converter.Initialize(options)))
+        {
+            LogError("Failed to initialize CPU converter");
+            return -1;
+        }
+
+        // 最高只有AVX2内核，更高等级会得到相同的内核
+        if (static_cast<int>(converter.GetSimdLevel()) != level)
+            continue;
+
+        std::vector<BYTE> nv12Data;
+        std::vector<BYTE> oddOutput;
+        if (FAILED(converter.CreateOutputBuffer(width, height, nv12Data)) ||
+            FAILED(converter.CreateOutputBuffer(oddWidth, oddHeight, oddOutput)))
+        {
+            LogError("Failed to create output buffer");
+            return -1;
+        }
+
+        // 预热一帧
+        converter.Convert(bgraData.data(), nv12Data.data(), width, height);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (UINT i = 0; i < frames; i++)
+        {
+            if (FAILED(converter.Convert(bgraData.data(), nv12Data.data(), width, height)))
+            {
+                LogError("Conversion failed");
+                return -1;
+            }
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        if (FAILED(converter.Convert(oddData.data(), oddOutput.data(), oddWidth, oddHeight)))
+        {
+            LogError("Odd-size conversion failed");
+            return -1;
+        }
+        if (referenceData.empty())
+        {
+            referenceData = nv12Data;
+            oddReference = oddOutput;
+        }
+        else if (nv12Data != referenceData || oddOutput != oddReference)
+        {
+            LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " output differs from scalar output");
+            return -1;
+        }
+
+        // 带行填充的输入输出必须得到与紧凑布局相同的结果
+        if (!VerifyPaddedConversion(converter, bgraData, nv12Data, width, height))
+        {
+            LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " padded-pitch output differs");
+            return -1;
+        }
+
+        double totalMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        PrintBenchResult(converter.GetSimdLevel(), totalMs / frames, (double)width * height * 4);
+    }
+
+    // 与浮点参考（shader公式）的偏差
+    CpuConversionOptions floatOptions;
+    floatOptions.Precision = ConversionPrecision::FloatReference;
+    CpuBGRAToNV12Converter floatConverter;
+    std::vector<BYTE> floatData;
+    if (FAILED(floatConverter.Initialize(floatOptions)) ||
+        FAILED(floatConverter.CreateOutputBuffer(width, height, floatData)) ||
+        FAILED(floatConverter.Convert(bgraData.data(), floatData.data(), width, height)))
+    {
+        LogError("Float reference conversion failed");
+        return -1;
+    }
+    unsigned long long mismatches = 0;
+    int maxDeviation = 0;
+    for (size_t i = 0; i < floatData.size(); i++)
+    {
+        int delta = std::abs(static_cast<int>(floatData[i]) - static_cast<int>(referenceData[i]));
+        mismatches += delta != 0;
+        maxDeviation = (std::max)(maxDeviation, delta);
+    }
+    std::cout << "[NV12] Fixed-point vs float reference: " << mismatches << " of " << floatData.size()
+              << " bytes differ, Max deviation: " << maxDeviation << std::endl;
+    if (maxDeviation > 1)
+    {
+        LogError("Fixed-point deviation exceeds the documented bound of 1");
+        return -1;
+    }
+
+    // 对比现有的两遍路径：先整帧转换为YUY2，再重新打包为NV12
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    CpuBGRAToYUY2Converter yuy2Converter;
+    CpuBGRAToNV12Converter nv12Converter;
+    std::vector<BYTE> yuy2Data;
+    std::vector<BYTE> repacked;
+    std::vector<BYTE> direct;
+    ImageView yuy2View;
+    ImageView repackedView;
+    ImageView directView;
+    if (FAILED(yuy2Converter.Initialize(options)) || FAILED(nv12Converter.Initialize(options)) ||
+        FAILED(yuy2Converter.CreateOutputBuffer(width, height, 0, yuy2Data, yuy2View)) ||
+        FAILED(nv12Converter.CreateOutputBuffer(width, height, 0, repacked, repackedView)) ||
+        FAILED(nv12Converter.CreateOutputBuffer(width, height, 0, direct, directView)))
+    {
+        LogError("Failed to initialize CPU converters");
+        return -1;
+    }
+    ImageView source = MakeBGRAImageView(bgraData.data(), width, height);
+
+    long long start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        yuy2Converter.Convert(source, yuy2View);
+        RepackYUY2ToNV12(yuy2View, repackedView);
+    }
+    double twoPassMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+    start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        nv12Converter.Convert(source, directView);
+    }
+    double directMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+    // 两遍路径的UV经过两次舍入，只统计差异
+    unsigned long long repackMismatches = 0;
+    for (size_t i = 0; i < direct.size(); i++)
+    {
+        repackMismatches += direct[i] != repacked[i];
+    }
+    std::cout << "[NV12] " << GetSimdLevelName(nv12Converter.GetSimdLevel()) << ": direct " << std::fixed
+              << std::setprecision(3) << directMs << "ms, YUY2 + repack " << twoPassMs << "ms, Speedup: "
+              << std::setprecision(2) << twoPassMs / directMs << "x (" << repackMismatches
+              << " bytes differ from the double-rounded two-pass output)" << std::endl;
+    return 0;
+}
+
+// 两遍路径中的第二遍：NV12的交错UV平面拆分为U、V两个平面
+static void SplitNV12ToI420(const ImageView& nv12, const ImageView& i420)
+{
+    const ImagePlane& yPlane = nv12.Planes[0];
+    const ImagePlane& uvPlane = nv12.Planes[1];
+    for (UINT y = 0; y < nv12.Height; y++)
+    {
+        memcpy(i420.Planes[0].Data + (size_t)y * i420.Planes[0].Pitch, yPlane.Data + (size_t)y * yPlane.Pitch,
+               nv12.Width);
+    }
+    for (UINT y = 0; y < uvPlane.Height; y++)
+    {
+        const BYTE* uvRow = uvPlane.Data + (size_t)y * uvPlane.Pitch;
+        BYTE* uRow = i420.Planes[1].Data + (size_t)y * i420.Planes[1].Pitch;
+        BYTE* vRow = i420.Planes[2].Data + (size_t)y * i420.Planes[2].Pitch;
+        for (UINT x = 0; x < i420.Planes[1].RowBytes; x++)
+        {
+            uRow[x] = uvRow[x * 2];
+            vRow[x] = uvRow[x * 2 + 1];
+        }
+    }
+}
+
+// 紧凑I420中的一个平面复制为单独的紧凑数据
+static std::vector<BYTE> GetTightPlane(const ImagePlane& plane)
+{
+    std::vector<BYTE> data((size_t)plane.RowBytes * plane.Height);
+    for (UINT y = 0; y < plane.Height; y++)
+    {
+        memcpy(data.data() + (size_t)y * plane.RowBytes, plane.Data + (size_t)y * plane.Pitch, plane.RowBytes);
+    }
+    return data;
+}
+
+static bool VerifyPaddedConversion(CpuBGRAToI420Converter& converter, const std::vector<BYTE>& bgraData,
+                                   std::vector<BYTE>& i420Data, UINT width, UINT height)
+{
+    // 三个平面分别分配，行步长各不相同（编码器输入图像的平面可以分别给出）
+    UINT chromaWidth = (width + 1) / 2;
+    UINT chromaHeight = (height + 1) / 2;
+    std::vector<BYTE> srcStorage;
+    std::vector<BYTE> yStorage((size_t)(width + kTestPitchPadding) * height, 0xCD);
+    std::vector<BYTE> uStorage((size_t)(chromaWidth + kTestPitchPadding * 2) * chromaHeight, 0xCD);
+    std::vector<BYTE> vStorage((size_t)(chromaWidth + kTestPitchPadding * 3) * chromaHeight, 0xCD);
+    ImageView source = MakeBGRAImageView(nullptr, width, height);
+    source.Planes[0] = CopyToPaddedPlane(bgraData.data(), width * 4, height, srcStorage);
+    ImageView destination = MakeI420ImageView(yStorage.data(), width + kTestPitchPadding,
+                                              uStorage.data(), chromaWidth + kTestPitchPadding * 2,
+                                              vStorage.data(), chromaWidth + kTestPitchPadding * 3, width, height);
+    if (FAILED(converter.Convert(source, destination)))
+        return false;
+
+    ImageView tight = MakeI420ImageView(i420Data.data(), width, height);
+    for (UINT i = 0; i < 3; i++)
+    {
+        if (!MatchesPaddedPlane(destination.Planes[i], GetTightPlane(tight.Planes[i])))
+            return false;
+    }
+    return true;
+}
+
+static int RunBGRAToI420Benchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("CPU BGRA to I420 benchmark: " + std::to_string(width) + "x" +
+              std::to_string(height) + ", " + std::to_string(frames) + " frames, " +
+              std::to_string(threads) + " threads");
+
+    std::vector<BYTE> bgraData = CreateTestBGRAData(width, height);
+    std::vector<BYTE> referenceData;
+    SimdLevel bestLevel = GetBestSimdLevel();
+
+    // 奇数宽度和高度的小图（尾部和最后一行单独处理）也逐字节比较
+    const UINT oddWidth = 67;
+    const UINT oddHeight = 35;
+    std::vector<BYTE> oddData = CreateTestBGRAData(oddWidth, oddHeight);
+    std::vector<BYTE> oddReference;
+
+    // 依次测试每个可用的指令集等级，并与标量结果逐字节比较
+    for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+    {
+        CpuConversionOptions options;
+        options.MaxSimdLevel = static_cast<SimdLevel>(level);
+        options.ThreadCount = threads;
+
+        CpuBGRAToI420Converter converter;
+        if (FAILED(converter.Initialize(options)))
+        {
+            LogError("Failed to initialize CPU converter");
+            return -1;
+        }
+
+        // 最高只有AVX2内核，更高等级会得到相同的内核
+        if (static_cast<int>(converter.GetSimdLevel()) != level)
+            continue;
+
+        std::vector<BYTE> i420Data;
+        std::vector<BYTE> oddOutput;
+        if (FAILED(converter.CreateOutputBuffer(width, height, i420Data)) ||
+            FAILED(converter.CreateOutputBuffer(oddWidth, oddHeight, oddOutput)))
+        {
+            LogError("Failed to create output buffer");
+            return -1;
+        }
+
+        // 预热一帧
+        converter.Convert(bgraData.data(), i420Data.data(), width, height);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (UINT i = 0; i < frames; i++)
+        {
+            if (FAILED(converter.Convert(bgraData.data(), i420Data.data(), width, height)))
+            {
+                LogError("Conversion failed");
+                return -1;
+            }
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        if (FAILED(converter.Convert(oddData.data(), oddOutput.data(), oddWidth, oddHeight)))
+        {
+            LogError("Odd-size conversion failed");
+            return -1;
+        }
+        if (referenceData.empty())
+        {
+            referenceData = i420Data;
+            oddReference = oddOutput;
+        }
+        else if (i420Data != referenceData || oddOutput != oddReference)
+        {
+            LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " output differs from scalar output");
+            return -1;
+        }
+
+        // 三个平面各自带行填充时必须得到与紧凑布局相同的结果
+        if (!VerifyPaddedConversion(converter, bgraData, i420Data, width, height))
+        {
+            LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " padded-pitch output differs");
+            return -1;
+        }
+
+        double totalMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        PrintBenchResult(converter.GetSimdLevel(), totalMs / frames, (double)width * height * 4);
+    }
+
+    // 与浮点参考（shader公式）的偏差
+    CpuConversionOptions floatOptions;
+    floatOptions.Precision = ConversionPrecision::FloatReference;
+    CpuBGRAToI420Converter floatConverter;
+    std::vector<BYTE> floatData;
+    if (FAILED(floatConverter.Initialize(floatOptions)) ||
+        FAILED(floatConverter.CreateOutputBuffer(width, height, floatData)) ||
+        FAILED(floatConverter.Convert(bgraData.data(), floatData.data(), width, height)))
+    {
+        LogError("Float reference conversion failed");
+        return -1;
+    }
+    int maxDeviation = 0;
+    for (size_t i = 0; i < floatData.size(); i++)
+    {
+        maxDeviation = (std::max)(maxDeviation,
+                                  std::abs(static_cast<int>(floatData[i]) - static_cast<int>(referenceData[i])));
+    }
+    std::cout << "[I420] Fixed-point vs float reference: Max deviation: " << maxDeviation << std::endl;
+    if (maxDeviation > 1)
+    {
+        LogError("Fixed-point deviation exceeds the documented bound of 1");
+        return -1;
+    }
+
+    // 与NV12转换器逐字节比较，并对比先转换为NV12再拆分UV的两遍路径
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    CpuBGRAToNV12Converter nv12Converter;
+    CpuBGRAToI420Converter i420Converter;
+    std::vector<BYTE> nv12Data;
+    std::vector<BYTE> split;
+    std::vector<BYTE> direct;
+    std::vector<BYTE> yv12;
+    ImageView nv12View;
+    ImageView splitView;
+    ImageView directView;
+    ImageView yv12View;
+    if (FAILED(nv12Converter.Initialize(options)) || FAILED(i420Converter.Initialize(options)) ||
+        FAILED(nv12Converter.CreateOutputBuffer(width, height, 0, nv12Data, nv12View)) ||
+        FAILED(i420Converter.CreateOutputBuffer(width, height, 0, false, split, splitView)) ||
+        FAILED(i420Converter.CreateOutputBuffer(width, height, 0, false, direct, directView)) ||
+        FAILED(i420Converter.CreateOutputBuffer(width, height, 0, true, yv12, yv12View)))
+    {
+        LogError("Failed to initialize CPU converters");
+        return -1;
+    }
+    ImageView source = MakeBGRAImageView(bgraData.data(), width, height);
+
+    long long start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        nv12Converter.Convert(source, nv12View);
+        SplitNV12ToI420(nv12View, splitView);
+    }
+    double twoPassMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+    start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        i420Converter.Convert(source, directView);
+    }
+    double directMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+    // NV12与I420使用同一套定点公式，拆分后必须逐字节一致
+    if (direct != split)
+    {
+        LogError("I420 output differs from the NV12 output split into planes");
+        return -1;
+    }
+
+    // YV12只是U、V平面在内存中的顺序不同
+    i420Converter.Convert(source, yv12View);
+    size_t ySize = (size_t)width * height;
+    size_t chromaSize = (direct.size() - ySize) / 2;
+    if (!std::equal(yv12.begin(), yv12.begin() + ySize, direct.begin()) ||
+        !std::equal(yv12.begin() + ySize, yv12.begin() + ySize + chromaSize, direct.begin() + ySize + chromaSize) ||
+        !std::equal(yv12.begin() + ySize + chromaSize, yv12.end(), direct.begin() + ySize))
+    {
+        LogError("YV12 output is not the I420 output with U and V planes swapped");
+        return -1;
+    }
+
+    std::cout << "[I420] " << GetSimdLevelName(i420Converter.GetSimdLevel()) << ": direct " << std::fixed
+              << std::setprecision(3) << directMs << "ms, NV12 + split " << twoPassMs << "ms, Speedup: "
+              << std::setprecision(2) << twoPassMs / directMs << "x (identical output, YV12 verified)" << std::endl;
+    return 0;
+}
+
+static const char* GetYUV444LayoutName(YUV444Layout layout)
+{
+    return layout == YUV444Layout::AYUV ? "AYUV" : "I444";
+}
+
+static bool VerifyPaddedConversion(CpuBGRAToYUV444Converter& converter, const std::vector<BYTE>& bgraData,
+                                   std::vector<BYTE>& outputData, UINT width, UINT height, YUV444Layout layout)
+{
+    std::vector<BYTE> srcStorage;
+    ImageView source = MakeBGRAImageView(nullptr, width, height);
+    source.Planes[0] = CopyToPaddedPlane(bgraData.data(), width * 4, height, srcStorage);
+
+    ImageView tight;
+    ImageView destination;
+    std::vector<BYTE> storage[3];
+    if (layout == YUV444Layout::AYUV)
+    {
+        tight = MakeAYUVImageView(outputData.data(), width, height);
+        storage[0].assign((size_t)(width * 4 + kTestPitchPadding) * height, 0xCD);
+        destination = MakeAYUVImageView(storage[0].data(), width, height, width * 4 + kTestPitchPadding);
+    }
+    else
+    {
+        // 三个平面分别分配，行步长各不相同
+        tight = MakeI444ImageView(outputData.data(), width, height);
+        for (UINT i = 0; i < 3; i++)
+        {
+            storage[i].assign((size_t)(width + kTestPitchPadding * (i + 1)) * height, 0xCD);
+        }
+        destination = MakeI444ImageView(storage[0].data(), width + kTestPitchPadding,
+                                        storage[1].data(), width + kTestPitchPadding * 2,
+                                        storage[2].data(), width + kTestPitchPadding * 3, width, height);
+    }
+    if (FAILED(converter.Convert(source, destination)))
+        return false;
+
+    for (UINT i = 0; i < destination.PlaneCount; i++)
+    {
+        if (!MatchesPaddedPlane(destination.Planes[i], GetTightPlane(tight.Planes[i])))
+            return false;
+    }
+    return true;
+}
+
+static int RunBGRAToYUV444Benchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("CPU BGRA to YUV 4:4:4 benchmark: " + std::to_string(width) + "x" +
+              std::to_string(height) + ", " + std::to_string(frames) + " frames, " +
+              std::to_string(threads) + " threads");
+
+    std::vector<BYTE> bgraData = CreateTestBGRAData(width, height);
+    SimdLevel bestLevel = GetBestSimdLevel();
+
+    // 奇数宽度和高度的小图（尾部单独处理）也逐字节比较
+    const UINT oddWidth = 67;
+    const UINT oddHeight = 35;
+    std::vector<BYTE> oddData = CreateTestBGRAData(oddWidth, oddHeight);
+
+    const YUV444Layout layouts[] = { YUV444Layout::I444, YUV444Layout::AYUV };
+    std::vector<BYTE> referenceData[2];
+    std::vector<BYTE> oddReference[2];
+    double bestFrameMs[2] = {};
+
+    // 依次测试每个可用的指令集等级，并与标量结果逐字节比较
+    for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+    {
+        CpuConversionOptions options;
+        options.MaxSimdLevel = static_cast<SimdLevel>(level);
+        options.ThreadCount = threads;
+
+        CpuBGRAToYUV444Converter converter;
+        if (FAILED(converter.Initialize(options)))
+        {
+            LogError("Failed to initialize CPU converter");
+            return -1;
+        }
+
+        // 最高只有AVX2内核，更高等级会得到相同的内核
+        if (static_cast<int>(converter.GetSimdLevel()) != level)
+            continue;
+
+        for (int l = 0; l < 2; l++)
+        {
+            YUV444Layout layout = layouts[l];
+            std::vector<BYTE> outputData(CpuBGRAToYUV444Converter::GetOutputSize(width, height, layout));
+            std::vector<BYTE> oddOutput(CpuBGRAToYUV444Converter::GetOutputSize(oddWidth, oddHeight, layout));
+
+            // 预热一帧
+            converter.Convert(bgraData.data(), outputData.data(), width, height, layout);
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            for (UINT i = 0; i < frames; i++)
+            {
+                if (FAILED(converter.Convert(bgraData.data(), outputData.data(), width, height, layout)))
+                {
+                    LogError("Conversion failed");
+                    return -1;
+                }
+            }
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            if (FAILED(converter.Convert(oddData.data(), oddOutput.data(), oddWidth, oddHeight, layout)))
+            {
+                LogError("Odd-size conversion failed");
+                return -1;
+            }
+            if (referenceData[l].empty())
+            {
+                referenceData[l] = outputData;
+                oddReference[l] = oddOutput;
+            }
+            else if (outputData != referenceData[l] || oddOutput != oddReference[l])
+            {
+                LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " " + GetYUV444LayoutName(layout) +
+                         " output differs from scalar output");
+                return -1;
+            }
+
+            if (!VerifyPaddedConversion(converter, bgraData, outputData, width, height, layout))
+            {
+                LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " " + GetYUV444LayoutName(layout) +
+                         " padded-pitch output differs");
+                return -1;
+            }
+
+            double frameMs = std::chrono::duration<double, std::milli>(endTime - startTime).count() / frames;
+            bestFrameMs[l] = frameMs;
+            std::cout << "[" << GetYUV444LayoutName(layout) << "] ";
+            PrintBenchResult(converter.GetSimdLevel(), frameMs, (double)width * height * 4);
+        }
+    }
+
+    // 两种布局是同一组Y、U、V值：AYUV的字节序为[V U Y A]
+    const std::vector<BYTE>& i444 = referenceData[0];
+    const std::vector<BYTE>& ayuv = referenceData[1];
+    size_t planeSize = (size_t)width * height;
+    for (size_t i = 0; i < planeSize; i++)
+    {
+        if (ayuv[i * 4] != i444[planeSize * 2 + i] || ayuv[i * 4 + 1] != i444[planeSize + i] ||
+            ayuv[i * 4 + 2] != i444[i] || ayuv[i * 4 + 3] != bgraData[i * 4 + 3])
+        {
+            LogError("AYUV output does not match the I444 planes");
+            return -1;
+        }
+    }
+
+    // 与浮点参考（shader公式）的偏差
+    CpuConversionOptions floatOptions;
+    floatOptions.Precision = ConversionPrecision::FloatReference;
+    CpuBGRAToYUV444Converter floatConverter;
+    std::vector<BYTE> floatData(CpuBGRAToYUV444Converter::GetOutputSize(width, height, YUV444Layout::I444));
+    if (FAILED(floatConverter.Initialize(floatOptions)) ||
+        FAILED(floatConverter.Convert(bgraData.data(), floatData.data(), width, height, YUV444Layout::I444)))
+    {
+        LogError("Float reference conversion failed");
+        return -1;
+    }
+    unsigned long long mismatches = 0;
+    int maxDeviation = 0;
+    for (size_t i = 0; i < floatData.size(); i++)
+    {
+        int delta = std::abs(static_cast<int>(floatData[i]) - static_cast<int>(i444[i]));
+        mismatches += delta != 0;
+        maxDeviation = (std::max)(maxDeviation, delta);
+    }
+    std::cout << "[YUV444] Fixed-point vs float reference: " << mismatches << " of " << floatData.size()
+              << " bytes differ, Max deviation: " << maxDeviation << std::endl;
+    if (maxDeviation > 1)
+    {
+        LogError("Fixed-point deviation exceeds the documented bound of 1");
+        return -1;
+    }
+
+    // 与现有的4:2:2输出对比耗时（4:4:4不再需要在YUY2之外再做一次全分辨率转换）
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    CpuBGRAToYUY2Converter yuy2Converter;
+    std::vector<BYTE> yuy2Data;
+    if (FAILED(yuy2Converter.Initialize(options)) ||
+        FAILED(yuy2Converter.CreateOutputBuffer(width, height, yuy2Data)))
+    {
+        LogError("Failed to initialize CPU converters");
+        return -1;
+    }
+    yuy2Converter.Convert(bgraData.data(), yuy2Data.data(), width, height);
+    long long start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        yuy2Converter.Convert(bgraData.data(), yuy2Data.data(), width, height);
+    }
+    double yuy2Ms = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+    std::cout << "[YUV444] I444 " << std::fixed << std::setprecision(3) << bestFrameMs[0] << "ms, AYUV "
+              << bestFrameMs[1] << "ms, YUY2 (" << GetSimdLevelName(yuy2Converter.GetSimdLevel()) << ") "
+              << yuy2Ms << "ms" << std::endl;
+    return 0;
+}
+
+// 单精度转换为半精度浮点（舍入到最近，溢出为无穷大），用于生成scRGB测试数据
+static UINT16 FloatToHalf(float value)
+{
+    UINT bits;
+    memcpy(&bits, &value, sizeof(bits));
+    UINT sign = (bits >> 16) & 0x8000;
+    float magnitude = std::fabs(value);
+    if (!(magnitude < 65520.0f))
+        return static_cast<UINT16>(sign | (magnitude != magnitude ? 0x7E00 : 0x7C00));
+    if (magnitude < 6.103515625e-05f)    // 2^-14以下为非规格化数，单位为2^-24
+        return static_cast<UINT16>(sign | static_cast<UINT>(std::nearbyint(magnitude * 16777216.0f)));
+    UINT magnitudeBits = bits & 0x7FFFFFFF;
+    return static_cast<UINT16>(sign | ((magnitudeBits - (112u << 23) + 0x1000) >> 13));
+}
+
+// HDR测试图：scRGB覆盖负值、超出BT.709色域的值和0到125（10000尼特）的亮度，
+// 并包含少量NaN和无穷大；R10G10B10A2为与BGRA测试图相同的渐变加纹理（10位）
+static std::vector<BYTE> CreateTestHDRData(UINT width, UINT height, HDRInputFormat format)
+{
+    UINT bytesPerPixel = GetHDRInputBytesPerPixel(format);
+    std::vector<BYTE> data((size_t)width * height * bytesPerPixel);
+    for (UINT y = 0; y < height; y++)
+    {
+        for (UINT x = 0; x < width; x++)
+        {
+            BYTE* pixel = data.data() + ((size_t)y * width + x) * bytesPerPixel;
+            if (format == HDRInputFormat::R10G10B10A2)
+            {
+                UINT r = (x ^ y) & 0x3FF;
+                UINT g = (y * 1023) / height;
+                UINT b = (x * 1023) / width;
+                UINT value = r | (g << 10) | (b << 20) | (3u << 30);
+                memcpy(pixel, &value, sizeof(value));
+                continue;
+            }
+
+            // 亮度按平方分布，暗部的样本更多
+            float fx = static_cast<float>(x) / width;
+            float fy = static_cast<float>(y) / height;
+            float texture = static_cast<float>((x ^ y) & 0xFF) / 255.0f;
+            float rgba[4] = { fx * fx * 125.0f, fy * fy * 12.5f, texture * 2.0f - 0.25f, 1.0f };
+            if ((x + y * 7) % 61 == 0)
+            {
+                rgba[1] = -0.5f;    // 超出BT.709色域的饱和色
+            }
+            if ((x * 3 + y) % 997 == 0)
+            {
+                rgba[0] = std::numeric_limits<float>::infinity();
+                rgba[2] = std::numeric_limits<float>::quiet_NaN();
+            }
+            UINT16 half[4];
+            for (int i = 0; i < 4; i++)
+            {
+                half[i] = FloatToHalf(rgba[i]);
+            }
+            memcpy(pixel, half, sizeof(half));
+        }
+    }
+    return data;
+}
+
+static const char* GetHDRInputFormatName(HDRInputFormat format)
+{
+    return format == HDRInputFormat::R16G16B16A16Float ? "FP16" : "R10";
+}
+
+static const char* GetYUV10FormatName(YUV10Format format)
+{
+    return format == YUV10Format::P210 ? "P210" : "P010";
+}
+
+static bool VerifyPaddedConversion(CpuHDRToYUV10Converter& converter, const std::vector<BYTE>& sourceData,
+                                   HDRInputFormat inputFormat, const std::vector<BYTE>& outputData,
+                                   UINT width, UINT height, YUV10Format outputFormat)
+{
+    std::vector<BYTE> srcStorage;
+    ImageView source = MakeSinglePlaneImageView(nullptr, width, height, 0, 0);
+    source.Planes[0] = CopyToPaddedPlane(sourceData.data(), width * GetHDRInputBytesPerPixel(inputFormat), height,
+                                         srcStorage);
+
+    // Y平面和UV平面分别分配，行步长不同
+    UINT yPitch = width * 2 + kTestPitchPadding;
+    UINT uvPitch = CpuHDRToYUV10Converter::GetPlaneStride(width) + kTestPitchPadding * 2;
+    UINT chromaHeight = CpuHDRToYUV10Converter::GetChromaHeight(height, outputFormat);
+    std::vector<BYTE> yStorage((size_t)yPitch * height, 0xCD);
+    std::vector<BYTE> uvStorage((size_t)uvPitch * chromaHeight, 0xCD);
+
+    ImageView tight;
+    ImageView destination;
+    if (outputFormat == YUV10Format::P010)
+    {
+        tight = MakeP010ImageView(const_cast<BYTE*>(outputData.data()), width, height);
+        destination = MakeP010ImageView(yStorage.data(), yPitch, uvStorage.data(), uvPitch, width, height);
+    }
+    else
+    {
+        tight = MakeP210ImageView(const_cast<BYTE*>(outputData.data()), width, height);
+        destination = MakeP210ImageView(yStorage.data(), yPitch, uvStorage.data(), uvPitch, width, height);
+    }
+    if (FAILED(converter.Convert(source, inputFormat, destination, outputFormat)))
+        return false;
+
+    for (UINT i = 0; i < 2; i++)
+    {
+        if (!MatchesPaddedPlane(destination.Planes[i], GetTightPlane(tight.Planes[i])))
+            return false;
+    }
+    return true;
+}
+
+// 比较定点输出与浮点参考的10位码值，返回最大偏差
+static int CompareYUV10Samples(const std::vector<BYTE>& a, const std::vector<BYTE>& b, unsigned long long& mismatches)
+{
+    int maxDeviation = 0;
+    mismatches = 0;
+    for (size_t i = 0; i + 1 < a.size(); i += 2)
+    {
+        UINT16 sampleA;
+        UINT16 sampleB;
+        memcpy(&sampleA, &a[i], sizeof(sampleA));
+        memcpy(&sampleB, &b[i], sizeof(sampleB));
+        int delta = std::abs(static_cast<int>(sampleA >> 6) - static_cast<int>(sampleB >> 6));
+        mismatches += delta != 0;
+        maxDeviation = (std::max)(maxDeviation, delta);
+    }
+    return maxDeviation;
+}
+
+// 已知颜色的输出：scRGB黑色、80尼特和100尼特灰色、10000尼特白色，R10黑色和白色
+static bool VerifyKnownHDRColors(CpuHDRToYUV10Converter& converter)
+{
+    struct KnownColor
+    {
+        HDRInputFormat Format;
+        float Value;        // scRGB为线性值，R10为10位码值
+        UINT MinY;
+        UINT MaxY;
+    };
+    const KnownColor colors[] = {
+        { HDRInputFormat::R16G16B16A16Float, 0.0f, 64, 64 },
+        { HDRInputFormat::R16G16B16A16Float, 1.0f, 490, 492 },
+        { HDRInputFormat::R16G16B16A16Float, 1.25f, 508, 510 },
+        { HDRInputFormat::R16G16B16A16Float, 125.0f, 940, 940 },
+        { HDRInputFormat::R10G10B10A2, 0.0f, 64, 64 },
+        { HDRInputFormat::R10G10B10A2, 1023.0f, 940, 940 },
+    };
+
+    for (const KnownColor& color : colors)
+    {
+        BYTE pixels[2][8];
+        for (BYTE* pixel : pixels)
+        {
+            if (color.Format == HDRInputFormat::R10G10B10A2)
+            {
+                UINT v = static_cast<UINT>(color.Value);
+                UINT value = v | (v << 10) | (v << 20) | (3u << 30);
+                memcpy(pixel, &value, sizeof(value));
+            }
+            else
+            {
+                UINT16 half[4] = { FloatToHalf(color.Value), FloatToHalf(color.Value), FloatToHalf(color.Value),
+                                   FloatToHalf(1.0f) };
+                memcpy(pixel, half, sizeof(half));
+            }
+        }
+
+        // 2x1像素，源数据按格式的像素大小紧凑排列
+        BYTE source[16];
+        UINT bytesPerPixel = GetHDRInputBytesPerPixel(color.Format);
+        memcpy(source, pixels[0], bytesPerPixel);
+        memcpy(source + bytesPerPixel, pixels[1], bytesPerPixel);
+        UINT16 output[4];
+        if (FAILED(converter.Convert(source, color.Format, reinterpret_cast<BYTE*>(output), 2, 1, YUV10Format::P210)))
+            return false;
+
+        UINT y = output[0] >> 6;
+        UINT u = output[2] >> 6;
+        UINT v = output[3] >> 6;
+        std::cout << "[HDR] " << GetHDRInputFormatName(color.Format) << " gray " << color.Value << ": Y=" << y
+                  << " U=" << u << " V=" << v << std::endl;
+        if (y < color.MinY || y > color.MaxY || output[1] != output[0] || u != 512 || v != 512)
+            return false;
+    }
+    return true;
+}
+
+static int RunHDRToYUV10Benchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("CPU HDR to P010/P210 benchmark: " + std::to_string(width) + "x" +
+              std::to_string(height) + ", " + std::to_string(frames) + " frames, " +
+              std::to_string(threads) + " threads");
+
+    SimdLevel bestLevel = GetBestSimdLevel();
+    const UINT oddWidth = 67;
+    const UINT oddHeight = 35;
+    const HDRInputFormat inputFormats[] = { HDRInputFormat::R10G10B10A2, HDRInputFormat::R16G16B16A16Float };
+    const YUV10Format outputFormats[] = { YUV10Format::P010, YUV10Format::P210 };
+
+    CpuConversionOptions floatOptions;
+    floatOptions.Precision = ConversionPrecision::FloatReference;
+    CpuHDRToYUV10Converter floatConverter;
+    CpuHDRToYUV10Converter fixedConverter;
+    if (FAILED(floatConverter.Initialize(floatOptions)) || FAILED(fixedConverter.Initialize()))
+    {
+        LogError("Failed to initialize CPU converter");
+        return -1;
+    }
+    if (!VerifyKnownHDRColors(floatConverter) || !VerifyKnownHDRColors(fixedConverter))
+    {
+        LogError("Output for known colors is out of range");
+        return -1;
+    }
+
+    for (HDRInputFormat inputFormat : inputFormats)
+    {
+        std::vector<BYTE> sourceData = CreateTestHDRData(width, height, inputFormat);
+        std::vector<BYTE> oddData = CreateTestHDRData(oddWidth, oddHeight, inputFormat);
+        double inputBytes = (double)width * height * GetHDRInputBytesPerPixel(inputFormat);
+
+        for (YUV10Format outputFormat : outputFormats)
+        {
+            std::string name = std::string(GetHDRInputFormatName(inputFormat)) + " to " +
+                               GetYUV10FormatName(outputFormat);
+            std::vector<BYTE> referenceData;
+            std::vector<BYTE> oddReference;
+
+            // 依次测试每个可用的指令集等级，并与标量结果逐字节比较
+            for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+            {
+                CpuConversionOptions options;
+                options.MaxSimdLevel = static_cast<SimdLevel>(level);
+                options.ThreadCount = threads;
+
+                CpuHDRToYUV10Converter converter;
+                if (FAILED(converter.Initialize(options)))
+                {
+                    LogError("Failed to initialize CPU converter");
+                    return -1;
+                }
+
+                // 最高只有AVX2内核，更高等级会得到相同的内核
+                if (static_cast<int>(converter.GetSimdLevel()) != level)
+                    continue;
+
+                std::vector<BYTE> outputData(CpuHDRToYUV10Converter::GetOutputSize(width, height, outputFormat));
+                std::vector<BYTE> oddOutput(CpuHDRToYUV10Converter::GetOutputSize(oddWidth, oddHeight, outputFormat));
+
+                // 预热一帧
+                converter.Convert(sourceData.data(), inputFormat, outputData.data(), width, height, outputFormat);
+
+                long long start = FramePacer::GetMonotonicNanoseconds();
+                for (UINT i = 0; i < frames; i++)
+                {
+                    if (FAILED(converter.Convert(sourceData.data(), inputFormat, outputData.data(), width, height,
+                                                 outputFormat)))
+                    {
+                        LogError("Conversion failed");
+                        return -1;
+                    }
+                }
+                double frameMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+                if (FAILED(converter.Convert(oddData.data(), inputFormat, oddOutput.data(), oddWidth, oddHeight,
+                                             outputFormat)))
+                {
+                    LogError("Odd-size conversion failed");
+                    return -1;
+                }
+                if (referenceData.empty())
+                {
+                    referenceData = outputData;
+                    oddReference = oddOutput;
+                }
+                else if (outputData != referenceData || oddOutput != oddReference)
+                {
+                    LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " " + name +
+                             " output differs from scalar output");
+                    return -1;
+                }
+
+                if (!VerifyPaddedConversion(converter, sourceData, inputFormat, outputData, width, height,
+                                            outputFormat))
+                {
+                    LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " " + name +
+                             " padded-pitch output differs");
+                    return -1;
+                }
+
+                std::cout << "[" << name << "] ";
+                PrintBenchResult(converter.GetSimdLevel(), frameMs, inputBytes);
+            }
+
+            // 与浮点参考（双精度矩阵、逐像素PQ曲线）的偏差
+            std::vector<BYTE> floatData(referenceData.size());
+            if (FAILED(floatConverter.Convert(sourceData.data(), inputFormat, floatData.data(), width, height,
+                                              outputFormat)))
+            {
+                LogError("Float reference conversion failed");
+                return -1;
+            }
+            unsigned long long mismatches = 0;
+            int maxDeviation = CompareYUV10Samples(floatData, referenceData, mismatches);
+            std::cout << "[" << name << "] Fixed-point vs float reference: " << mismatches << " of "
+                      << floatData.size() / 2 << " samples differ, Max deviation: " << maxDeviation << std::endl;
+            if (maxDeviation > 1)
+            {
+                LogError("Fixed-point deviation exceeds the documented bound of 1");
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+// 模拟采集→转换循环：采集阶段从帧池借用输入帧，通过句柄交给转换阶段，
+// 转换阶段借用输出帧；输出帧保留到下一帧转换完成（模拟下游仍在使用），
+// 因此池中同时存在多个同尺寸的帧。预热后统计每帧的堆分配和帧池分配次数，必须为0
+static int RunFramePoolCheck(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Frame pool allocation check: " + std::to_string(width) + "x" +
+              std::to_string(height) + ", " + std::to_string(frames) + " frames, " +
+              std::to_string(threads) + " threads");
+
+    std::vector<BYTE> bgraData = CreateTestBGRAData(width, height);
+
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    CpuBGRAToYUY2Converter converter;
+    if (FAILED(converter.Initialize(options)))
+    {
+        LogError("Failed to initialize CPU converter");
+        return -1;
+    }
+
+    FramePool framePool;
+    FrameHandle previousOutput;
+    const UINT warmupFrames = 3;
+    unsigned long long heapAllocationsBefore = 0;
+    unsigned long long poolAllocationsBefore = 0;
+
+    for (UINT i = 0; i < warmupFrames + frames; i++)
+    {
+        if (i == warmupFrames)
+        {
+            heapAllocationsBefore = g_heapAllocations.load();
+            poolAllocationsBefore = framePool.GetStats().AllocationCount;
+        }
+
+        // 采集阶段：借用输入帧并写入"采集到"的数据
+        FrameHandle captured;
+        if (FAILED(framePool.AcquireMemory(bgraData.size(), captured)))
+        {
+            LogError("Failed to acquire capture frame");
+            return -1;
+        }
+        memcpy(captured.GetData(), bgraData.data(), bgraData.size());
+
+        // 转换阶段：通过句柄副本共享输入帧，借用输出帧
+        FrameHandle convertInput = captured;
+        captured.Reset();
+
+        FrameHandle output;
+        if (FAILED(framePool.AcquireMemory(CpuBGRAToYUY2Converter::GetOutputSize(width, height), output)) ||
+            FAILED(converter.Convert(MakeBGRAImageView(convertInput.GetData(), width, height),
+                                     MakeYUY2ImageView(output.GetData(), width, height))))
+        {
+            LogError("Conversion failed");
+            return -1;
+        }
+
+        previousOutput = std::move(output);
+    }
+
+    unsigned long long heapAllocations = g_heapAllocations.load() - heapAllocationsBefore;
+    FramePoolStats stats = framePool.GetStats();
+    unsigned long long poolAllocations = stats.AllocationCount - poolAllocationsBefore;
+
+    std::cout << "[POOL] Steady-state frames: " << frames
+              << ", Heap allocations: " << heapAllocations
+              << ", Pool allocations: " << poolAllocations
+              << ", Pool frames: " << stats.FrameCount
+              << ", Reused: " << stats.ReuseCount << "/" << stats.AcquireCount << std::endl;
+
+    if (heapAllocations != 0 || poolAllocations != 0)
+    {
+        LogError("Steady-state capture/convert loop allocated memory");
+        return -1;
+    }
+    return 0;
+}
+
+// 流水线基准的各阶段：帧源复制一帧测试图像（模拟采集的读回），
+// 转换阶段做BGRA到YUY2转换，输出阶段与参考结果逐字节比较（模拟写出）。
+// 帧源和输出可以额外等待waitMs，模拟不占用CPU的采集/写出等待
+class BenchBGRASource : public IFrameSource
+{
+public:
+    BenchBGRASource(FramePool& framePool, const std::vector<BYTE>& bgraData, UINT width, UINT height,
+                    UINT frames, UINT waitMs)
+        : m_framePool(framePool), m_bgraData(bgraData), m_width(width), m_height(height),
+          m_frames(frames), m_waitMs(waitMs), m_readFrames(0) {}
+
+    HRESULT ReadFrame(PipelineFrame& frame) override
+    {
+        if (m_readFrames == m_frames)
+            return kPipelineEndOfStream;
+        if (m_waitMs)
+            std::this_thread::sleep_for(std::chrono::milliseconds(m_waitMs));
+
+        HRESULT hr = m_framePool.AcquireMemory(m_bgraData.size(), frame.Source);
+        if (FAILED(hr))
+            return hr;
+        memcpy(frame.Source.GetData(), m_bgraData.data(), m_bgraData.size());
+        frame.SourceView = MakeBGRAImageView(frame.Source.GetData(), m_width, m_height);
+        frame.Width = m_width;
+        frame.Height = m_height;
+        m_readFrames++;
+        return S_OK;
+    }
+
+private:
+    FramePool& m_framePool;
+    const std::vector<BYTE>& m_bgraData;
+    UINT m_width;
+    UINT m_height;
+    UINT m_frames;
+    UINT m_waitMs;
+    UINT m_readFrames;
+};
+
+class BenchYUY2ConvertStage : public IFrameConverter
+{
+public:
+    BenchYUY2ConvertStage(FramePool& framePool, CpuBGRAToYUY2Converter& converter)
+        : m_framePool(framePool), m_converter(converter) {}
+
+    HRESULT ConvertFrame(PipelineFrame& frame) override
+    {
+        HRESULT hr = m_framePool.AcquireMemory(
+            CpuBGRAToYUY2Converter::GetOutputSize(frame.Width, frame.Height), frame.Output);
+        if (FAILED(hr))
+            return hr;
+        frame.OutputView = MakeYUY2ImageView(frame.Output.GetData(), frame.Width, frame.Height);
+        hr = m_converter.Convert(frame.SourceView, frame.OutputView);
+        // 输出阶段只需要转换结果，尽早归还输入帧
+        frame.Source.Reset();
+        return hr;
+    }
+
+private:
+    FramePool& m_framePool;
+    CpuBGRAToYUY2Converter& m_converter;
+};
+
+class BenchCompareSink : public IFrameSink
+{
+public:
+    BenchCompareSink(const std::vector<BYTE>& referenceData, UINT waitMs)
+        : m_referenceData(referenceData), m_waitMs(waitMs), m_frames(0), m_mismatches(0) {}
+
+    HRESULT WriteFrame(const PipelineFrame& frame) override
+    {
+        if (memcmp(frame.OutputView.Planes[0].Data, m_referenceData.data(), m_referenceData.size()) != 0)
+            m_mismatches++;
+        if (m_waitMs)
+            std::this_thread::sleep_for(std::chrono::milliseconds(m_waitMs));
+        m_frames++;
+        return S_OK;
+    }
+
+    UINT GetFrames() const { return m_frames; }
+    UINT GetMismatches() const { return m_mismatches; }
+
+private:
+    const std::vector<BYTE>& m_referenceData;
+    UINT m_waitMs;
+    UINT m_frames;
+    UINT m_mismatches;
+};
+
+// 对每帧输出计算64位校验和并按帧序组合
+class BenchChecksumSink : public IFrameSink
+{
+public:
+    BenchChecksumSink() : m_frames(0), m_checksum(0) {}
+
+    HRESULT WriteFrame(const PipelineFrame& frame) override
+    {
+        const ImagePlane& plane = frame.OutputView.Planes[0];
+        unsigned long long hash = 0;
+        for (UINT y = 0; y < plane.Height; y++)
+        {
+            const BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+            UINT x = 0;
+            for (; x + 8 <= plane.RowBytes; x += 8)
+            {
+                unsigned long long value;
+                memcpy(&value, row + x, 8);
+                hash = (hash ^ value) * 0x100000001B3ULL;
+            }
+            for (; x < plane.RowBytes; x++)
+            {
+                hash = (hash ^ row[x]) * 0x100000001B3ULL;
+            }
+        }
+        m_checksum = (m_checksum ^ hash) * 0x9E3779B97F4A7C15ULL + 1;
+        m_frames++;
+        return S_OK;
+    }
+
+    UINT GetFrames() const { return m_frames; }
+    unsigned long long GetChecksum() const { return m_checksum; }
+
+private:
+    UINT m_frames;
+    unsigned long long m_checksum;
+};
+
+static double AverageStageMs(const PipelineStageStats& stats)
+{
+    return stats.Frames ? stats.BusyMicroseconds / 1000.0 / stats.Frames : 0.0;
+}
+
+// 同样的三个阶段先在一个线程上串行运行，再交给FramePipeline并行运行。
+// 流水线的帧间隔应接近最慢阶段的耗时，而不是三个阶段耗时之和
+// （各阶段都受CPU限制时，需要有足够的空闲核心才能体现）
+static int RunPipelineBenchmark(UINT width, UINT height, UINT frames, UINT threads, UINT waitMs)
+{
+    LogMessage("Pipeline benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " conversion threads, " +
+              std::to_string(waitMs) + "ms simulated source/sink wait");
+
+    std::vector<BYTE> bgraData = CreateTestBGRAData(width, height);
+
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    CpuBGRAToYUY2Converter converter;
+    std::vector<BYTE> referenceData;
+    if (FAILED(converter.Initialize(options)) ||
+        FAILED(converter.CreateOutputBuffer(width, height, referenceData)) ||
+        FAILED(converter.Convert(bgraData.data(), referenceData.data(), width, height)))
+    {
+        LogError("Failed to initialize CPU converter");
+        return -1;
+    }
+
+    FramePool framePool;
+    BenchYUY2ConvertStage convertStage(framePool, converter);
+
+    // 串行：每帧依次采集、转换、输出
+    double serialMs = 0.0;
+    {
+        BenchBGRASource source(framePool, bgraData, width, height, frames, waitMs);
+        BenchCompareSink sink(referenceData, waitMs);
+        auto startTime = std::chrono::high_resolution_clock::now();
+        PipelineFrame frame;
+        while (source.ReadFrame(frame) == S_OK)
+        {
+            if (FAILED(convertStage.ConvertFrame(frame)) || FAILED(sink.WriteFrame(frame)))
+            {
+                LogError("Serial frame processing failed");
+                return -1;
+            }
+            frame.Output.Reset();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        serialMs = std::chrono::duration<double, std::milli>(endTime - startTime).count() / frames;
+
+        if (sink.GetFrames() != frames || sink.GetMismatches() != 0)
+        {
+            LogError("Serial output mismatch");
+            return -1;
+        }
+    }
+
+    // 流水线：三个阶段各自一个线程
+    BenchBGRASource source(framePool, bgraData, width, height, frames, waitMs);
+    BenchCompareSink sink(referenceData, waitMs);
+    IFrameSink* sinks[] = { &sink };
+    FramePipeline pipeline;
+    if (FAILED(pipeline.Initialize(&source, &convertStage, sinks, 1)))
+    {
+        LogError("Failed to initialize frame pipeline");
+        return -1;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    HRESULT hr = pipeline.Start();
+    if (SUCCEEDED(hr))
+    {
+        hr = pipeline.Wait();
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    double pipelineMs = std::chrono::duration<double, std::milli>(endTime - startTime).count() / frames;
+
+    if (FAILED(hr) || sink.GetFrames() != frames || sink.GetMismatches() != 0)
+    {
+        LogError("Pipeline output mismatch: " + std::to_string(sink.GetFrames()) + " frames received, " +
+                 std::to_string(sink.GetMismatches()) + " differ");
+        return -1;
+    }
+
+    FramePipelineStats stats = pipeline.GetStats();
+    double sourceMs = AverageStageMs(stats.Source);
+    double convertMs = AverageStageMs(stats.Convert);
+    double sinkMs = AverageStageMs(stats.Sinks[0]);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "[PIPELINE] Stage times: source " << sourceMs << "ms, convert " << convertMs
+              << "ms, sink " << sinkMs << "ms (slowest " << (std::max)((std::max)(sourceMs, convertMs), sinkMs)
+              << "ms, sum " << sourceMs + convertMs + sinkMs << "ms)" << std::endl;
+    std::cout << "[PIPELINE] Serial frame time: " << serialMs << "ms"
+              << ", Pipelined frame time: " << pipelineMs << "ms"
+              << ", Speedup: " << std::setprecision(2) << serialMs / pipelineMs << "x"
+              << ", Avg latency: " << std::setprecision(3)
+              << stats.Sinks[0].LatencyMicroseconds / 1000.0 / stats.Sinks[0].Frames << "ms"
+              << ", Pool frames: " << framePool.GetStats().FrameCount << std::endl;
+    return 0;
+}
+
+// 合成图案或文件回放 → CPU转换 → 校验和，在目标帧率下运行流水线
+static int RunSourceBenchmark(const std::string& sourceName, UINT frames, double targetFps, UINT threads,
+                              UINT width, UINT height)
+{
+    FramePool framePool;
+    SyntheticFrameSource syntheticSource;
+    FileReplaySource replaySource;
+    IFrameSource* source = nullptr;
+
+    SyntheticSourceOptions syntheticOptions;
+    syntheticOptions.FrameCount = frames;
+    if (width && height)
+    {
+        syntheticOptions.Width = width;
+        syntheticOptions.Height = height;
+    }
+
+    if (SyntheticFrameSource::ParsePattern(sourceName, syntheticOptions.Pattern))
+    {
+        if (FAILED(syntheticSource.Initialize(&framePool, syntheticOptions)))
+        {
+            LogError("Failed to initialize synthetic source");
+            return -1;
+        }
+        width = syntheticOptions.Width;
+        height = syntheticOptions.Height;
+        source = &syntheticSource;
+    }
+    else
+    {
+        FileReplayOptions replayOptions;
+        replayOptions.Width = width;
+        replayOptions.Height = height;
+        replayOptions.FrameCount = frames;
+        if (FAILED(replaySource.Initialize(sourceName, &framePool, replayOptions)))
+        {
+            LogError("Failed to open replay source");
+            return -1;
+        }
+        width = replaySource.GetWidth();
+        height = replaySource.GetHeight();
+        source = &replaySource;
+    }
+
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    CpuBGRAToYUY2Converter converter;
+    if (FAILED(converter.Initialize(options)))
+    {
+        LogError("Failed to initialize CPU converter");
+        return -1;
+    }
+
+    BenchYUY2ConvertStage convertStage(framePool, converter);
+    BenchChecksumSink sink;
+    IFrameSink* sinks[] = { &sink };
+
+    FramePipelineOptions pipelineOptions;
+    pipelineOptions.TargetFrameRate = targetFps;
+    FramePipeline pipeline;
+    if (FAILED(pipeline.Initialize(source, &convertStage, sinks, 1, pipelineOptions)))
+    {
+        LogError("Failed to initialize frame pipeline");
+        return -1;
+    }
+
+    long long start = FramePacer::GetMonotonicNanoseconds();
+    HRESULT hr = pipeline.Start();
+    if (SUCCEEDED(hr))
+    {
+        hr = pipeline.Wait();
+    }
+    double seconds = (FramePacer::GetMonotonicNanoseconds() - start) / 1e9;
+
+    if (FAILED(hr) || sink.GetFrames() != frames)
+    {
+        LogError("Pipeline delivered " + std::to_string(sink.GetFrames()) + " of " + std::to_string(frames) + " frames");
+        return -1;
+    }
+
+    FramePipelineStats stats = pipeline.GetStats();
+    std::cout << std::fixed << std::setprecision(1)
+              << "[SOURCE] " << width << "x" << height << " frames: " << frames
+              << ", FPS: " << frames / seconds
+              << ", Stage times: source " << std::setprecision(3) << AverageStageMs(stats.Source)
+              << "ms, convert " << AverageStageMs(stats.Convert)
+              << "ms, sink " << AverageStageMs(stats.Sinks[0]) << "ms"
+              << ", Avg latency: " << stats.Sinks[0].LatencyMicroseconds / 1000.0 / frames << "ms"
+              << ", Missed deadlines: " << stats.Pacing.MissedDeadlines << std::endl;
+    std::cout << "[SOURCE] Output checksum: " << std::hex << std::setw(16) << std::setfill('0')
+              << sink.GetChecksum() << std::dec << std::setfill(' ') << std::endl;
+    return 0;
+}
+
+// 合成桌面帧源的脏矩形和移动驱动增量转换（滚动、拖动的区域在输出上搬移，其余脏区域重新转换）：
+// 输出缓冲区像帧池一样轮换使用，并周期性地丢弃一帧，
+// 每帧与整帧转换的结果逐字节比较，统计两种方式的转换耗时和实际转换的像素比例
+static int RunDirtyRegionBenchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Dirty region benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " threads");
+
+    const UINT outputCount = 3;     // 轮换的输出缓冲区数量（流水线中同时存在的输出帧）
+    const UINT dropInterval = 50;   // 每隔多少帧丢弃一帧（转换队列满）
+
+    FramePool framePool;
+    SyntheticSourceOptions sourceOptions;
+    sourceOptions.Width = width;
+    sourceOptions.Height = height;
+    sourceOptions.Pattern = SyntheticPattern::Desktop;
+    SyntheticFrameSource source;
+
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    CpuBGRAToYUY2Converter converter;
+    DirtyRegionTracker tracker;
+    if (FAILED(source.Initialize(&framePool, sourceOptions)) || FAILED(converter.Initialize(options)) ||
+        FAILED(tracker.Initialize(width, height)))
+    {
+        LogError("Failed to initialize dirty region benchmark");
+        return -1;
+    }
+
+    std::vector<BYTE> outputs[outputCount];
+    std::vector<BYTE> reference;
+    ImageView outputViews[outputCount];
+    ImageView referenceView;
+    for (UINT i = 0; i < outputCount; i++)
+    {
+        if (FAILED(converter.CreateOutputBuffer(width, height, 0, outputs[i], outputViews[i])))
+        {
+            LogError("Failed to create output buffer");
+            return -1;
+        }
+    }
+    if (FAILED(converter.CreateOutputBuffer(width, height, 0, reference, referenceView)))
+    {
+        LogError("Failed to create output buffer");
+        return -1;
+    }
+
+    std::vector<ImageMove> updateMoves;
+    std::vector<ImageRect> updateRects;
+    updateMoves.reserve(kDirtyHistoryFrames * kMaxDirtyMovesPerFrame);
+    updateRects.reserve(kMaxDirtyUpdateRects);
+
+    double incrementalMs = 0.0;
+    double fullMs = 0.0;
+    unsigned long long convertedPixels = 0;
+    unsigned long long movedPixels = 0;
+    UINT convertedFrames = 0;
+    UINT fullUpdates = 0;
+    UINT nextOutput = 0;
+
+    PipelineFrame frame;
+    for (UINT i = 0; i < frames; i++)
+    {
+        if (FAILED(source.ReadFrame(frame)))
+        {
+            LogError("Failed to read synthetic frame");
+            return -1;
+        }
+        frame.FrameIndex = i;
+        if (i % dropInterval == dropInterval - 1)
+        {
+            // 丢弃的帧不经过转换阶段，它的脏矩形也随之丢失
+            continue;
+        }
+
+        tracker.AddFrame(frame.FrameIndex, frame.DirtyRects, frame.DirtyRectCount, frame.Moves, frame.MoveCount,
+                         !frame.DirtyRectsValid);
+        const ImageView& output = outputViews[nextOutput];
+        nextOutput = (nextOutput + 1) % outputCount;
+
+        long long start = FramePacer::GetMonotonicNanoseconds();
+        HRESULT hr;
+        if (tracker.GetUpdateRects(output.Planes[0].Data, updateMoves, updateRects))
+        {
+            hr = converter.MoveRegions(output, updateMoves.data(), (UINT)updateMoves.size());
+            if (SUCCEEDED(hr))
+            {
+                hr = converter.Convert(frame.SourceView, output, updateRects.data(), (UINT)updateRects.size());
+            }
+        }
+        else
+        {
+            hr = converter.Convert(frame.SourceView, output);
+            updateMoves.clear();
+            updateRects.assign(1, MakeImageRect(0, 0, width, height));
+            fullUpdates++;
+        }
+        incrementalMs += (FramePacer::GetMonotonicNanoseconds() - start) / 1e6;
+        if (FAILED(hr))
+        {
+            LogError("Incremental conversion failed");
+            return -1;
+        }
+        tracker.MarkUpdated(output.Planes[0].Data);
+
+        for (const ImageRect& rect : updateRects)
+        {
+            ImageRect aligned = rect;
+            AlignImageRectToPixelPairs(aligned, width);
+            convertedPixels += GetImageRectArea(aligned);
+        }
+        for (const ImageMove& move : updateMoves)
+        {
+            movedPixels += GetImageRectArea(move.Destination);
+        }
+
+        start = FramePacer::GetMonotonicNanoseconds();
+        hr = converter.Convert(frame.SourceView, referenceView);
+        fullMs += (FramePacer::GetMonotonicNanoseconds() - start) / 1e6;
+        if (FAILED(hr))
+        {
+            LogError("Full conversion failed");
+            return -1;
+        }
+
+        if (memcmp(output.Planes[0].Data, referenceView.Planes[0].Data, reference.size()) != 0)
+        {
+            LogError("Incremental output differs from full conversion at frame " + std::to_string(i));
+            return -1;
+        }
+        convertedFrames++;
+    }
+
+    double framePixels = (double)width * height;
+    std::cout << std::fixed << std::setprecision(3)
+              << "[DIRTY] Frames: " << convertedFrames << " (" << fullUpdates << " full updates)"
+              << ", Full convert: " << fullMs / convertedFrames << "ms"
+              << ", Incremental: " << incrementalMs / convertedFrames << "ms"
+              << ", Speedup: " << std::setprecision(1) << fullMs / incrementalMs << "x"
+              << ", Converted pixels: " << std::setprecision(2)
+              << 100.0 * convertedPixels / (framePixels * convertedFrames) << "%"
+              << ", Moved pixels: " << 100.0 * movedPixels / (framePixels * convertedFrames) << "%"
+              << ", Output matches full conversion" << std::endl;
+    return 0;
+}
+
+// 每个指令集等级分别关闭和开启纯色快速路径转换同一帧，输出与标量结果逐字节比较。
+// 合成桌面以平坦区域为主，渐变测试图没有纯色块（只有检测的开销）
+static int RunSolidColorBenchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Solid color fast path benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " threads");
+
+    std::vector<BYTE> desktopData((size_t)width * height * 4);
+    ImageView desktopView = MakeBGRAImageView(desktopData.data(), width, height);
+    if (FAILED(SyntheticFrameSource::RenderFrame(SyntheticPattern::Desktop, 100, desktopView)))
+    {
+        LogError("Failed to render synthetic frame");
+        return -1;
+    }
+    std::vector<BYTE> gradientData = CreateTestBGRAData(width, height);
+
+    struct TestImage
+    {
+        const char* Name;
+        const std::vector<BYTE>* Data;
+        std::vector<BYTE> Reference;
+    };
+    TestImage images[] = { { "desktop", &desktopData, {} }, { "gradient", &gradientData, {} } };
+
+    SimdLevel bestLevel = GetBestSimdLevel();
+    for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+    {
+        for (TestImage& image : images)
+        {
+            double frameMs[2] = {};
+            double solidRatio = 0.0;
+            for (int fastPath = 0; fastPath < 2; fastPath++)
+            {
+                CpuConversionOptions options;
+                options.MaxSimdLevel = static_cast<SimdLevel>(level);
+                options.ThreadCount = threads;
+                options.SolidColorFastPath = fastPath != 0;
+                CpuBGRAToYUY2Converter converter;
+                std::vector<BYTE> yuy2Data;
+                if (FAILED(converter.Initialize(options)) ||
+                    FAILED(converter.CreateOutputBuffer(width, height, yuy2Data)))
+                {
+                    LogError("Failed to initialize CPU converter");
+                    return -1;
+                }
+
+                // 预热一帧
+                converter.Convert(image.Data->data(), yuy2Data.data(), width, height);
+
+                long long start = FramePacer::GetMonotonicNanoseconds();
+                for (UINT i = 0; i < frames; i++)
+                {
+                    if (FAILED(converter.Convert(image.Data->data(), yuy2Data.data(), width, height)))
+                    {
+                        LogError("Conversion failed");
+                        return -1;
+                    }
+                }
+                frameMs[fastPath] = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+                const CpuConversionFrameStats& stats = converter.GetLastFrameStats();
+                if (fastPath)
+                    solidRatio = stats.ConvertedPixels ? (double)stats.SolidPixels / stats.ConvertedPixels : 0.0;
+
+                if (image.Reference.empty())
+                {
+                    image.Reference = yuy2Data;
+                }
+                else if (yuy2Data != image.Reference)
+                {
+                    LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " output on " + image.Name +
+                             (fastPath ? " with" : " without") + " solid fast path differs from scalar output");
+                    return -1;
+                }
+            }
+
+            std::cout << "[SOLID] " << std::setw(9) << GetSimdLevelName(static_cast<SimdLevel>(level))
+                      << " " << std::setw(8) << image.Name << std::fixed << std::setprecision(3)
+                      << ": fast path off " << frameMs[0] << "ms, on " << frameMs[1] << "ms"
+                      << ", Speedup: " << std::setprecision(2) << frameMs[0] / frameMs[1] << "x"
+                      << ", Solid pixels: " << std::setprecision(1) << 100.0 * solidRatio << "%" << std::endl;
+        }
+    }
+    return 0;
+}
+
+// 分块哈希检测合成桌面的变化区域（不使用帧源报告的脏矩形）并增量转换：
+// 每4帧中有1帧与上一帧相同（视频暂停），这样的帧直接复用上一帧的输出。
+// 分别在关闭和开启滚动检测时运行一遍：开启时滚动的文档区域在上一帧的输出上搬移，只转换新露出的行。
+// 每帧与整帧转换的结果逐字节比较，检测结果与标量哈希内核的结果比较
+static int RunTileDamageBenchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Tile damage benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " threads");
+
+    const UINT outputCount = 3;     // 轮换的输出缓冲区数量（流水线中同时存在的输出帧）
+
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    CpuConversionOptions scalarOptions;
+    scalarOptions.MaxSimdLevel = SimdLevel::Scalar;
+    CpuBGRAToYUY2Converter converter;
+    TileDamageDetector detector;
+    TileDamageDetector scalarDetector;
+    DirtyRegionTracker tracker;
+    if (FAILED(converter.Initialize(options)) || FAILED(detector.Initialize(options)) ||
+        FAILED(scalarDetector.Initialize(scalarOptions)) || FAILED(tracker.Initialize(width, height)))
+    {
+        LogError("Failed to initialize tile damage benchmark");
+        return -1;
+    }
+
+    std::vector<BYTE> sourceData((size_t)width * height * 4);
+    ImageView sourceView = MakeBGRAImageView(sourceData.data(), width, height);
+    std::vector<BYTE> outputs[outputCount];
+    std::vector<BYTE> reference;
+    ImageView outputViews[outputCount];
+    ImageView referenceView;
+    for (UINT i = 0; i < outputCount; i++)
+    {
+        if (FAILED(converter.CreateOutputBuffer(width, height, 0, outputs[i], outputViews[i])))
+        {
+            LogError("Failed to create output buffer");
+            return -1;
+        }
+    }
+    if (FAILED(converter.CreateOutputBuffer(width, height, 0, reference, referenceView)))
+    {
+        LogError("Failed to create output buffer");
+        return -1;
+    }
+
+    std::vector<ImageMove> damageMoves;
+    std::vector<ImageRect> damageRects;
+    std::vector<ImageMove> scalarMoves;
+    std::vector<ImageRect> scalarRects;
+    std::vector<ImageMove> updateMoves;
+    std::vector<ImageRect> updateRects;
+    damageMoves.reserve(kMaxDirtyUpdateRects);
+    damageRects.reserve(kMaxDirtyUpdateRects);
+    scalarMoves.reserve(kMaxDirtyUpdateRects);
+    scalarRects.reserve(kMaxDirtyUpdateRects);
+    updateMoves.reserve(kDirtyHistoryFrames * kMaxDirtyMovesPerFrame);
+    updateRects.reserve(kMaxDirtyUpdateRects);
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        bool detectScrolling = pass == 1;
+        detector.Reset();
+        scalarDetector.Reset();
+        tracker.Initialize(width, height);
+
+        double hashMs = 0.0;
+        double incrementalMs = 0.0;
+        double fullMs = 0.0;
+        unsigned long long changedTiles = 0;
+        unsigned long long totalTiles = 0;
+        unsigned long long convertedPixels = 0;
+        unsigned long long movedPixels = 0;
+        UINT unchangedFrames = 0;
+        UINT scrolledFrames = 0;
+        UINT fullUpdates = 0;
+        UINT nextOutput = 0;
+        const ImageView* lastOutput = nullptr;
+
+        for (UINT i = 0; i < frames; i++)
+        {
+            // 内容序号：第4k+3帧重复第4k+2帧
+            unsigned long long content = i - (i + 1) / 4;
+            if (FAILED(SyntheticFrameSource::RenderFrame(SyntheticPattern::Desktop, content, sourceView)))
+            {
+                LogError("Failed to render synthetic frame");
+                return -1;
+            }
+
+            bool fullFrame = true;
+            bool scalarFullFrame = true;
+            long long start = FramePacer::GetMonotonicNanoseconds();
+            HRESULT hr = detectScrolling ? detector.DetectDamage(sourceView, damageMoves, damageRects, fullFrame)
+                                         : detector.DetectDamage(sourceView, damageRects, fullFrame);
+            hashMs += (FramePacer::GetMonotonicNanoseconds() - start) / 1e6;
+            if (!detectScrolling)
+                damageMoves.clear();
+
+            if (SUCCEEDED(hr))
+            {
+                hr = detectScrolling ? scalarDetector.DetectDamage(sourceView, scalarMoves, scalarRects, scalarFullFrame)
+                                     : scalarDetector.DetectDamage(sourceView, scalarRects, scalarFullFrame);
+                if (!detectScrolling)
+                    scalarMoves.clear();
+            }
+            if (FAILED(hr))
+            {
+                LogError("Tile damage detection failed");
+                return -1;
+            }
+            if (fullFrame != scalarFullFrame || damageRects.size() != scalarRects.size() ||
+                damageMoves.size() != scalarMoves.size() ||
+                (!damageRects.empty() &&
+                 memcmp(damageRects.data(), scalarRects.data(), damageRects.size() * sizeof(ImageRect)) != 0) ||
+                (!damageMoves.empty() &&
+                 memcmp(damageMoves.data(), scalarMoves.data(), damageMoves.size() * sizeof(ImageMove)) != 0))
+            {
+                LogError(std::string(GetSimdLevelName(detector.GetSimdLevel())) +
+                         " tile damage differs from scalar result at frame " + std::to_string(i));
+                return -1;
+            }
+            if (!fullFrame)
+            {
+                changedTiles += detector.GetChangedTileCount();
+                totalTiles += detector.GetTileCount();
+                scrolledFrames += damageMoves.empty() ? 0 : 1;
+            }
+
+            tracker.AddFrame(i, damageRects.data(), (UINT)damageRects.size(),
+                             damageMoves.data(), (UINT)damageMoves.size(), fullFrame);
+
+            start = FramePacer::GetMonotonicNanoseconds();
+            const ImageView* output = nullptr;
+            if (lastOutput && tracker.GetUpdateRects(lastOutput->Planes[0].Data, updateMoves, updateRects) &&
+                updateMoves.empty() && updateRects.empty())
+            {
+                // 内容未变：整帧跳过转换，输出阶段再次使用上一帧的输出
+                output = lastOutput;
+                unchangedFrames++;
+            }
+            else
+            {
+                output = &outputViews[nextOutput];
+                nextOutput = (nextOutput + 1) % outputCount;
+                if (tracker.GetUpdateRects(output->Planes[0].Data, updateMoves, updateRects))
+                {
+                    hr = converter.MoveRegions(*output, updateMoves.data(), (UINT)updateMoves.size());
+                    if (SUCCEEDED(hr))
+                    {
+                        hr = converter.Convert(sourceView, *output, updateRects.data(), (UINT)updateRects.size());
+                    }
+                }
+                else
+                {
+                    hr = converter.Convert(sourceView, *output);
+                    updateMoves.clear();
+                    updateRects.assign(1, MakeImageRect(0, 0, width, height));
+                    fullUpdates++;
+                }
+            }
+            incrementalMs += (FramePacer::GetMonotonicNanoseconds() - start) / 1e6;
+            if (FAILED(hr))
+            {
+                LogError("Incremental conversion failed");
+                return -1;
+            }
+            tracker.MarkUpdated(output->Planes[0].Data);
+            lastOutput = output;
+
+            for (const ImageRect& rect : updateRects)
+            {
+                ImageRect aligned = rect;
+                AlignImageRectToPixelPairs(aligned, width);
+                convertedPixels += GetImageRectArea(aligned);
+            }
+            for (const ImageMove& move : updateMoves)
+            {
+                movedPixels += GetImageRectArea(move.Destination);
+            }
+
+            start = FramePacer::GetMonotonicNanoseconds();
+            hr = converter.Convert(sourceView, referenceView);
+            fullMs += (FramePacer::GetMonotonicNanoseconds() - start) / 1e6;
+            if (FAILED(hr))
+            {
+                LogError("Full conversion failed");
+                return -1;
+            }
+
+            if (memcmp(output->Planes[0].Data, referenceView.Planes[0].Data, reference.size()) != 0)
+            {
+                LogError("Incremental output differs from full conversion at frame " + std::to_string(i) +
+                         (detectScrolling ? " with" : " without") + " scroll detection");
+                return -1;
+            }
+        }
+
+        double framePixels = (double)width * height;
+        const char* label = detectScrolling ? "[DAMAGE] Scroll detection on: " : "[DAMAGE] Scroll detection off: ";
+        std::cout << std::fixed << std::setprecision(3)
+                  << label << "Frames: " << frames << " (" << unchangedFrames << " unchanged, "
+                  << scrolledFrames << " scrolled, " << fullUpdates << " full updates)"
+                  << ", Hash (" << GetSimdLevelName(detector.GetSimdLevel()) << "): " << hashMs / frames << "ms ("
+                  << std::setprecision(1) << framePixels * 4 * frames / (hashMs * 1e6) << " GB/s)"
+                  << ", Changed tiles: " << std::setprecision(2)
+                  << (totalTiles ? 100.0 * changedTiles / totalTiles : 0.0) << "%" << std::endl;
+        std::cout << std::fixed << std::setprecision(3)
+                  << label << "Full convert: " << fullMs / frames << "ms"
+                  << ", Hash + incremental: " << (hashMs + incrementalMs) / frames << "ms"
+                  << ", Speedup: " << std::setprecision(1) << fullMs / (hashMs + incrementalMs) << "x"
+                  << ", Converted pixels: " << std::setprecision(2) << 100.0 * convertedPixels / (framePixels * frames) << "%"
+                  << ", Moved pixels: " << 100.0 * movedPixels / (framePixels * frames) << "%"
+                  << ", Output matches full conversion" << std::endl;
+    }
+    return 0;
+}
+
+// 分开缩放：先把整帧缩放到destination（BGRA），再单独转换，用于与融合路径对比（在调用线程上执行）
+static HRESULT ScaleBGRAFrame(const ScaleKernels& kernels, const ScaleFilterTable& horizontal,
+                              const ScaleFilterTable& vertical, const ImageView& source, const ImageView& destination,
+                              std::vector<short>& intermediate)
+{
+    intermediate.resize(((size_t)source.Width + 1) * 4);
+    UINT verticalStride = GetScaleWeightStride(vertical.Taps);
+    for (UINT y = 0; y < destination.Height; y++)
+    {
+        kernels.Column(source.Planes[0].Data + (size_t)vertical.Starts[y] * source.Planes[0].Pitch,
+                       source.Planes[0].Pitch, vertical.Weights.data() + (size_t)y * verticalStride, vertical.Taps,
+                       source.Width * 4, intermediate.data());
+        kernels.Row(intermediate.data(), horizontal.Starts.data(), horizontal.Weights.data(), horizontal.Taps,
+                    destination.Width, destination.Planes[0].Data + (size_t)y * destination.Planes[0].Pitch);
+    }
+    return S_OK;
+}
+
+// 融合缩放转换：4K桌面输出1080p/720p等较小的YUY2。
+// 每个目标尺寸和滤波器：各指令集的输出与标量输出逐字节比较；最优指令集下对比
+// 融合路径（一遍读取源图像）、分开缩放再转换（整帧BGRA中间图像）的耗时，以及全分辨率转换的耗时
+static int RunScaleBenchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Scaled conversion benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " threads");
+
+    std::vector<BYTE> desktopData((size_t)width * height * 4);
+    ImageView desktopView = MakeBGRAImageView(desktopData.data(), width, height);
+    if (FAILED(SyntheticFrameSource::RenderFrame(SyntheticPattern::Desktop, 100, desktopView)))
+    {
+        LogError("Failed to render synthetic frame");
+        return -1;
+    }
+    std::vector<BYTE> gradientData = CreateTestBGRAData(width, height);
+
+    struct TestImage
+    {
+        const char* Name;
+        ImageView View;
+    };
+    TestImage images[] = { { "desktop", desktopView },
+                           { "gradient", MakeBGRAImageView(gradientData.data(), width, height) } };
+
+    // 目标尺寸为源尺寸乘以Numerator/Denominator
+    struct ScaleCase
+    {
+        UINT Numerator;
+        UINT Denominator;
+        ScaleFilter Filter;
+    };
+    const ScaleCase cases[] =
+    {
+        { 1, 2, ScaleFilter::Auto },
+        { 1, 4, ScaleFilter::Auto },
+        { 1, 3, ScaleFilter::Auto },
+        { 1, 2, ScaleFilter::Bilinear },
+        { 1, 2, ScaleFilter::Bicubic },
+        { 2, 5, ScaleFilter::Auto },
+    };
+
+    CpuBGRAToYUY2Converter fullConverter;
+    CpuConversionOptions fullOptions;
+    fullOptions.ThreadCount = threads;
+    std::vector<BYTE> fullOutput;
+    if (FAILED(fullConverter.Initialize(fullOptions)) || FAILED(fullConverter.CreateOutputBuffer(width, height, fullOutput)))
+    {
+        LogError("Failed to initialize CPU converter");
+        return -1;
+    }
+
+    SimdLevel bestLevel = GetBestSimdLevel();
+    for (TestImage& image : images)
+    {
+        // 全分辨率转换：目前缩放前必须付出的代价
+        long long start = FramePacer::GetMonotonicNanoseconds();
+        for (UINT i = 0; i < frames; i++)
+        {
+            fullConverter.Convert(image.View, MakeYUY2ImageView(fullOutput.data(), width, height));
+        }
+        double fullMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+        for (const ScaleCase& scaleCase : cases)
+        {
+            UINT scaledWidth = (std::max)(1u, width * scaleCase.Numerator / scaleCase.Denominator);
+            UINT scaledHeight = (std::max)(1u, height * scaleCase.Numerator / scaleCase.Denominator);
+            ScaleFilter filter = ResolveScaleFilter(scaleCase.Filter, width, height, scaledWidth, scaledHeight);
+
+            std::vector<BYTE> reference;
+            std::vector<BYTE> output;
+            ImageView outputView;
+            double fusedMs = 0.0;
+            double separateMs = 0.0;
+            SimdLevel scaleLevel = SimdLevel::Scalar;
+            for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+            {
+                CpuConversionOptions options;
+                options.MaxSimdLevel = static_cast<SimdLevel>(level);
+                options.ThreadCount = threads;
+                CpuBGRAToYUY2Converter converter;
+                if (FAILED(converter.Initialize(options)) ||
+                    FAILED(converter.CreateOutputBuffer(scaledWidth, scaledHeight, 0, output, outputView)))
+                {
+                    LogError("Failed to initialize CPU converter");
+                    return -1;
+                }
+                if (FAILED(converter.ConvertScaled(image.View, outputView, filter)))
+                {
+                    LogError("Scaled conversion failed");
+                    return -1;
+                }
+                if (level == static_cast<int>(SimdLevel::Scalar))
+                {
+                    reference = output;
+                }
+                else if (output != reference)
+                {
+                    LogError(std::string(GetSimdLevelName(converter.GetScaleSimdLevel())) + " scaled output on " +
+                             image.Name + " differs from scalar output (" + GetScaleFilterName(filter) + ")");
+                    return -1;
+                }
+                if (level != static_cast<int>(bestLevel))
+                    continue;
+
+                scaleLevel = converter.GetScaleSimdLevel();
+                start = FramePacer::GetMonotonicNanoseconds();
+                for (UINT i = 0; i < frames; i++)
+                {
+                    converter.ConvertScaled(image.View, outputView, filter);
+                }
+                fusedMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+                // 分开缩放和转换，结果必须与融合路径相同
+                ScaleKernels kernels = GetScaleKernels(options.MaxSimdLevel);
+                ScaleFilterTable horizontal;
+                ScaleFilterTable vertical;
+                std::vector<BYTE> scaledData((size_t)scaledWidth * scaledHeight * 4);
+                ImageView scaledView = MakeBGRAImageView(scaledData.data(), scaledWidth, scaledHeight);
+                std::vector<BYTE> separateOutput;
+                ImageView separateView;
+                std::vector<short> intermediate;
+                if (FAILED(BuildScaleFilterTable(width, scaledWidth, filter, horizontal)) ||
+                    FAILED(BuildScaleFilterTable(height, scaledHeight, filter, vertical)) ||
+                    FAILED(converter.CreateOutputBuffer(scaledWidth, scaledHeight, 0, separateOutput, separateView)))
+                {
+                    LogError("Failed to prepare separate scaling");
+                    return -1;
+                }
+                start = FramePacer::GetMonotonicNanoseconds();
+                for (UINT i = 0; i < frames; i++)
+                {
+                    ScaleBGRAFrame(kernels, horizontal, vertical, image.View, scaledView, intermediate);
+                    converter.Convert(scaledView, separateView);
+                }
+                separateMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+                if (separateOutput != output)
+                {
+                    LogError(std::string("Fused scaled output on ") + image.Name +
+                             " differs from separate scaling and conversion");
+                    return -1;
+                }
+            }
+
+            std::cout << "[SCALE] " << std::setw(8) << image.Name << " " << width << "x" << height << " -> "
+                      << scaledWidth << "x" << scaledHeight << " " << std::setw(8) << GetScaleFilterName(filter)
+                      << " (" << GetSimdLevelName(scaleLevel) << ")" << std::fixed << std::setprecision(3)
+                      << ": fused " << fusedMs << "ms, scale + convert " << separateMs << "ms"
+                      << ", Speedup: " << std::setprecision(2) << separateMs / fusedMs << "x"
+                      << ", full-resolution convert " << std::setprecision(3) << fullMs << "ms"
+                      << ", Output matches scalar and separate paths" << std::endl;
+        }
+    }
+    return 0;
+}
+
+// 多路输出：同一源图像生成全分辨率、1/2和1/6（4K下为4K、1080p和360p）三路输出，全部YUY2和全部NV12各测一遍，
+// 1/6的输出由1/2的输出继续缩放。每路输出与参考结果逐字节比较：先把来源缩放成BGRA图像
+// （1/6从1/2的BGRA图像缩放），再整帧转换。对比ConvertSimulcast（源图像按条带只读取一次）
+// 与每路各自从源图像缩放并转换（每路各读一遍源图像）的耗时
+static int RunSimulcastBenchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Simulcast conversion benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " threads");
+
+    std::vector<BYTE> desktopData((size_t)width * height * 4);
+    ImageView desktopView = MakeBGRAImageView(desktopData.data(), width, height);
+    if (FAILED(SyntheticFrameSource::RenderFrame(SyntheticPattern::Desktop, 100, desktopView)))
+    {
+        LogError("Failed to render synthetic frame");
+        return -1;
+    }
+    std::vector<BYTE> gradientData = CreateTestBGRAData(width, height);
+
+    struct TestImage
+    {
+        const char* Name;
+        ImageView View;
+    };
+    TestImage images[] = { { "desktop", desktopView },
+                           { "gradient", MakeBGRAImageView(gradientData.data(), width, height) } };
+
+    const UINT outputCount = 3;
+    const UINT divisors[outputCount] = { 1, 2, 6 };
+    const int parents[outputCount] = { -1, -1, 1 };     // ConvertSimulcast选择的来源，-1为源图像
+
+    CpuBGRAToYUY2Converter converter;
+    CpuBGRAToNV12Converter nv12Converter;
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    if (FAILED(converter.Initialize(options)) || FAILED(nv12Converter.Initialize(options)))
+    {
+        LogError("Failed to initialize CPU converter");
+        return -1;
+    }
+
+    // 参考和分开转换使用的BGRA缩放：chainTables从各自的来源缩放，sourceTables都从源图像缩放
+    ScaleKernels kernels = GetScaleKernels(options.MaxSimdLevel);
+    UINT outputWidths[outputCount];
+    UINT outputHeights[outputCount];
+    ScaleFilterTable chainTables[outputCount][2];
+    ScaleFilterTable sourceTables[outputCount][2];
+    std::vector<BYTE> scaledData[outputCount];
+    ImageView scaledViews[outputCount];
+    std::vector<BYTE> separateScaledData[outputCount];
+    ImageView separateScaledViews[outputCount];
+    std::vector<short> intermediate;
+    for (UINT i = 0; i < outputCount; i++)
+    {
+        outputWidths[i] = (std::max)(1u, width / divisors[i]);
+        outputHeights[i] = (std::max)(1u, height / divisors[i]);
+        if (divisors[i] == 1)
+            continue;
+
+        UINT parentWidth = parents[i] < 0 ? width : outputWidths[parents[i]];
+        UINT parentHeight = parents[i] < 0 ? height : outputHeights[parents[i]];
+        ScaleFilter chainFilter = ResolveScaleFilter(ScaleFilter::Auto, parentWidth, parentHeight,
+                                                     outputWidths[i], outputHeights[i]);
+        ScaleFilter sourceFilter = ResolveScaleFilter(ScaleFilter::Auto, width, height, outputWidths[i], outputHeights[i]);
+        scaledData[i].resize((size_t)outputWidths[i] * outputHeights[i] * 4);
+        scaledViews[i] = MakeBGRAImageView(scaledData[i].data(), outputWidths[i], outputHeights[i]);
+        separateScaledData[i].resize(scaledData[i].size());
+        separateScaledViews[i] = MakeBGRAImageView(separateScaledData[i].data(), outputWidths[i], outputHeights[i]);
+        if (FAILED(BuildScaleFilterTable(parentWidth, outputWidths[i], chainFilter, chainTables[i][0])) ||
+            FAILED(BuildScaleFilterTable(parentHeight, outputHeights[i], chainFilter, chainTables[i][1])) ||
+            FAILED(BuildScaleFilterTable(width, outputWidths[i], sourceFilter, sourceTables[i][0])) ||
+            FAILED(BuildScaleFilterTable(height, outputHeights[i], sourceFilter, sourceTables[i][1])))
+        {
+            LogError("Failed to prepare simulcast reference scaling");
+            return -1;
+        }
+    }
+
+    const SimulcastFormat formats[] = { SimulcastFormat::YUY2, SimulcastFormat::NV12 };
+    for (SimulcastFormat format : formats)
+    {
+        bool nv12 = format == SimulcastFormat::NV12;
+        std::vector<BYTE> simulcastBuffers[outputCount];
+        std::vector<BYTE> referenceBuffers[outputCount];
+        std::vector<BYTE> separateBuffers[outputCount];
+        SimulcastOutput simulcastOutputs[outputCount];
+        ImageView referenceViews[outputCount];
+        ImageView separateViews[outputCount];
+        for (UINT i = 0; i < outputCount; i++)
+        {
+            simulcastOutputs[i].Filter = ScaleFilter::Auto;
+            simulcastOutputs[i].Format = format;
+            HRESULT hr = S_OK;
+            if (nv12)
+            {
+                hr = nv12Converter.CreateOutputBuffer(outputWidths[i], outputHeights[i], 0, simulcastBuffers[i],
+                                                      simulcastOutputs[i].Destination);
+                if (SUCCEEDED(hr))
+                    hr = nv12Converter.CreateOutputBuffer(outputWidths[i], outputHeights[i], 0, referenceBuffers[i],
+                                                          referenceViews[i]);
+                if (SUCCEEDED(hr))
+                    hr = nv12Converter.CreateOutputBuffer(outputWidths[i], outputHeights[i], 0, separateBuffers[i],
+                                                          separateViews[i]);
+            }
+            else
+            {
+                hr = converter.CreateOutputBuffer(outputWidths[i], outputHeights[i], 0, simulcastBuffers[i],
+                                                  simulcastOutputs[i].Destination);
+                if (SUCCEEDED(hr))
+                    hr = converter.CreateOutputBuffer(outputWidths[i], outputHeights[i], 0, referenceBuffers[i],
+                                                      referenceViews[i]);
+                if (SUCCEEDED(hr))
+                    hr = converter.CreateOutputBuffer(outputWidths[i], outputHeights[i], 0, separateBuffers[i],
+                                                      separateViews[i]);
+            }
+            if (FAILED(hr))
+            {
+                LogError("Failed to allocate simulcast outputs");
+                return -1;
+            }
+        }
+
+        for (TestImage& image : images)
+        {
+            // 参考结果：按ConvertSimulcast的来源逐级缩放成BGRA图像，再整帧转换
+            for (UINT i = 0; i < outputCount; i++)
+            {
+                const ImageView* bgra = &image.View;
+                if (divisors[i] != 1)
+                {
+                    const ImageView& parentView = parents[i] < 0 ? image.View : scaledViews[parents[i]];
+                    ScaleBGRAFrame(kernels, chainTables[i][0], chainTables[i][1], parentView, scaledViews[i],
+                                   intermediate);
+                    bgra = &scaledViews[i];
+                }
+                HRESULT hr = nv12 ? nv12Converter.Convert(*bgra, referenceViews[i]) : converter.Convert(*bgra, referenceViews[i]);
+                if (FAILED(hr))
+                {
+                    LogError("Simulcast reference conversion failed");
+                    return -1;
+                }
+            }
+
+            // 每路输出单独从源图像缩放并转换，源图像读取outputCount遍
+            long long start = FramePacer::GetMonotonicNanoseconds();
+            for (UINT f = 0; f < frames; f++)
+            {
+                for (UINT i = 0; i < outputCount; i++)
+                {
+                    if (!nv12)
+                    {
+                        converter.ConvertScaled(image.View, separateViews[i]);
+                    }
+                    else if (divisors[i] == 1)
+                    {
+                        nv12Converter.Convert(image.View, separateViews[i]);
+                    }
+                    else
+                    {
+                        ScaleBGRAFrame(kernels, sourceTables[i][0], sourceTables[i][1], image.View,
+                                       separateScaledViews[i], intermediate);
+                        nv12Converter.Convert(separateScaledViews[i], separateViews[i]);
+                    }
+                }
+            }
+            double separateMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+            start = FramePacer::GetMonotonicNanoseconds();
+            for (UINT f = 0; f < frames; f++)
+            {
+                if (FAILED(converter.ConvertSimulcast(image.View, simulcastOutputs, outputCount)))
+                {
+                    LogError("Simulcast conversion failed");
+                    return -1;
+                }
+            }
+            double simulcastMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+            std::string sizes;
+            for (UINT i = 0; i < outputCount; i++)
+            {
+                if (simulcastBuffers[i] != referenceBuffers[i])
+                {
+                    LogError(std::string("Simulcast ") + (nv12 ? "NV12" : "YUY2") + " output " + std::to_string(i) +
+                             " on " + image.Name + " differs from reference conversion");
+                    return -1;
+                }
+                const ImageView& view = simulcastOutputs[i].Destination;
+                sizes += (i ? " + " : "") + std::to_string(view.Width) + "x" + std::to_string(view.Height);
+            }
+
+            std::cout << "[SIMULCAST] " << std::setw(8) << image.Name << " " << (nv12 ? "NV12" : "YUY2") << " "
+                      << width << "x" << height << " -> " << sizes
+                      << " (" << GetSimdLevelName(converter.GetSimdLevel()) << "/"
+                      << GetSimdLevelName(converter.GetScaleSimdLevel()) << ")" << std::fixed << std::setprecision(3)
+                      << ": simulcast " << simulcastMs << "ms, separate " << separateMs << "ms"
+                      << ", Speedup: " << std::setprecision(2) << separateMs / simulcastMs << "x"
+                      << ", Output matches reference conversion" << std::endl;
+        }
+    }
+    return 0;
+}
+
+// 裁剪转换：在width x height的画布（例如8K多显示器桌面）上只转换一个窗口或区域。
+// 每个区域（含奇数x偏移和奇数宽度）与先复制出该区域再整帧转换的结果逐字节比较，
+// 并对比整个画布的转换耗时
+static int RunCropBenchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Crop conversion benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " threads");
+
+    std::vector<BYTE> canvasData((size_t)width * height * 4);
+    ImageView canvasView = MakeBGRAImageView(canvasData.data(), width, height);
+    if (FAILED(SyntheticFrameSource::RenderFrame(SyntheticPattern::Desktop, 100, canvasView)))
+    {
+        LogError("Failed to render synthetic frame");
+        return -1;
+    }
+
+    CpuBGRAToYUY2Converter converter;
+    CpuConversionOptions options;
+    options.ThreadCount = threads;
+    std::vector<BYTE> canvasOutput;
+    ImageView canvasOutputView;
+    if (FAILED(converter.Initialize(options)) ||
+        FAILED(converter.CreateOutputBuffer(width, height, 0, canvasOutput, canvasOutputView)))
+    {
+        LogError("Failed to initialize CPU converter");
+        return -1;
+    }
+
+    long long start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        converter.Convert(canvasView, canvasOutputView);
+    }
+    double fullMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+    const ImageRect rects[] =
+    {
+        MakeImageRect(1001, 333, 1001 + 1280, 333 + 720),   // 奇数x偏移的720p窗口
+        MakeImageRect(3, 7, 3 + 641, 7 + 479),              // 奇数偏移、奇数宽度
+        MakeImageRect(width - 1, 0, width, height),         // 最右侧的一列
+        MakeImageRect(0, 0, width, height),                 // 整个画布
+    };
+
+    for (ImageRect rect : rects)
+    {
+        if (!ClipImageRect(rect, width, height))
+            continue;
+        UINT cropWidth = rect.Right - rect.Left;
+        UINT cropHeight = rect.Bottom - rect.Top;
+
+        // 参考结果：先把区域复制成紧凑的BGRA图像再整帧转换
+        std::vector<BYTE> compactData((size_t)cropWidth * cropHeight * 4);
+        for (UINT y = 0; y < cropHeight; y++)
+        {
+            memcpy(compactData.data() + (size_t)y * cropWidth * 4,
+                   canvasData.data() + ((size_t)(rect.Top + y) * width + rect.Left) * 4, (size_t)cropWidth * 4);
+        }
+        std::vector<BYTE> reference;
+        std::vector<BYTE> output;
+        ImageView outputView;
+        if (FAILED(converter.CreateOutputBuffer(cropWidth, cropHeight, reference)) ||
+            FAILED(converter.CreateOutputBuffer(cropWidth, cropHeight, 0, output, outputView)) ||
+            FAILED(converter.Convert(compactData.data(), reference.data(), cropWidth, cropHeight)))
+        {
+            LogError("Failed to prepare crop reference");
+            return -1;
+        }
+
+        start = FramePacer::GetMonotonicNanoseconds();
+        for (UINT i = 0; i < frames; i++)
+        {
+            if (FAILED(converter.ConvertCrop(canvasView, rect, outputView)))
+            {
+                LogError("Crop conversion failed");
+                return -1;
+            }
+        }
+        double cropMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+        if (output != reference)
+        {
+            LogError("Crop output for " + std::to_string(cropWidth) + "x" + std::to_string(cropHeight) + " at (" +
+                     std::to_string(rect.Left) + ", " + std::to_string(rect.Top) + ") differs from compact conversion");
+            return -1;
+        }
+
+        std::cout << "[CROP] " << cropWidth << "x" << cropHeight << " at (" << rect.Left << ", " << rect.Top
+                  << ") of " << width << "x" << height << std::fixed << std::setprecision(3) << ": crop " << cropMs
+                  << "ms, full canvas " << fullMs << "ms, Cost: 1/" << std::setprecision(1) << fullMs / cropMs
+                  << " (area 1/" << (double)width * height / ((double)cropWidth * cropHeight) << ")"
+                  << ", Output matches compact conversion" << std::endl;
+    }
+    return 0;
+}
+
+// 逐像素旋转/翻转BGRA或RGBA图像（紧凑布局），按旋转的定义直接计算，作为方向变换的参考结果
+static void OrientPixels(const std::vector<BYTE>& source, UINT width, UINT height, const ImageOrientation& orientation,
+                         std::vector<BYTE>& output)
+{
+    UINT outputWidth;
+    UINT outputHeight;
+    GetOrientedSize(orientation, width, height, outputWidth, outputHeight);
+    output.resize((size_t)outputWidth * outputHeight * 4);
+    for (UINT sy = 0; sy < height; sy++)
+    {
+        for (UINT sx = 0; sx < width; sx++)
+        {
+            UINT ox = sx;
+            UINT oy = sy;
+            switch (orientation.Rotation)
+            {
+            case ImageRotation::Rotate90:  ox = height - 1 - sy; oy = sx; break;
+            case ImageRotation::Rotate180: ox = width - 1 - sx; oy = height - 1 - sy; break;
+            case ImageRotation::Rotate270: ox = sy; oy = width - 1 - sx; break;
+            default: break;
+            }
+            if (orientation.FlipHorizontal)
+                ox = outputWidth - 1 - ox;
+            if (orientation.FlipVertical)
+                oy = outputHeight - 1 - oy;
+            memcpy(&output[((size_t)oy * outputWidth + ox) * 4], &source[((size_t)sy * width + sx) * 4], 4);
+        }
+    }
+}
+
+static std::string GetOrientationName(const ImageOrientation& orientation)
+{
+    static const char* const rotations[] = { "0", "90", "180", "270" };
+    return std::string(rotations[static_cast<int>(orientation.Rotation)]) +
+           (orientation.FlipHorizontal ? "+H" : "") + (orientation.FlipVertical ? "+V" : "");
+}
+
+// 旋转和翻转：BGRA到YUY2和NV12到RGBA的每种方向（4种旋转 x 水平/垂直翻转），
+// 各指令集的输出与先逐像素旋转再转换（NV12为先转换再旋转）的结果逐字节比较；
+// 最优指令集下对比融合方向变换、不旋转的转换以及单独旋转一遍再转换的耗时
+static int RunOrientationBenchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Orientation benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " threads");
+
+    std::vector<BYTE> bgraData((size_t)width * height * 4);
+    ImageView bgraView = MakeBGRAImageView(bgraData.data(), width, height);
+    if (FAILED(SyntheticFrameSource::RenderFrame(SyntheticPattern::Desktop, 100, bgraView)))
+    {
+        LogError("Failed to render synthetic frame");
+        return -1;
+    }
+    std::vector<BYTE> yPlane;
+    std::vector<BYTE> uvPlane;
+    CreateTestNV12Data(width, height, yPlane, uvPlane);
+    ImageView nv12View = MakeNV12ImageView(yPlane.data(), width, uvPlane.data(),
+                                           CpuNV12ToRGBAConverter::GetUVPlaneStride(width), width, height);
+
+    CpuConversionOptions bestOptions;
+    bestOptions.ThreadCount = threads;
+    CpuBGRAToYUY2Converter yuy2Converter;
+    CpuNV12ToRGBAConverter rgbaConverter;
+    std::vector<BYTE> unrotatedYUY2;
+    std::vector<BYTE> unrotatedRGBA;
+    if (FAILED(yuy2Converter.Initialize(bestOptions)) || FAILED(rgbaConverter.Initialize(bestOptions)) ||
+        FAILED(yuy2Converter.CreateOutputBuffer(width, height, unrotatedYUY2)) ||
+        FAILED(rgbaConverter.CreateOutputBuffer(width, height, unrotatedRGBA)))
+    {
+        LogError("Failed to initialize CPU converters");
+        return -1;
+    }
+
+    // 不旋转的转换：方向变换的目标耗时
+    long long start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        yuy2Converter.Convert(bgraData.data(), unrotatedYUY2.data(), width, height);
+    }
+    double yuy2Ms = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+    start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        rgbaConverter.Convert(yPlane.data(), uvPlane.data(), unrotatedRGBA.data(), width, height);
+    }
+    double rgbaMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+    SimdLevel bestLevel = GetBestSimdLevel();
+    for (int rotation = 0; rotation < 4; rotation++)
+    {
+        for (int flips = 0; flips < 4; flips++)
+        {
+            ImageOrientation orientation = MakeImageOrientation(static_cast<ImageRotation>(rotation),
+                                                                (flips & 1) != 0, (flips & 2) != 0);
+            UINT outputWidth;
+            UINT outputHeight;
+            GetOrientedSize(orientation, width, height, outputWidth, outputHeight);
+
+            // 参考结果：BGRA先旋转再转换，NV12先转换再旋转
+            std::vector<BYTE> orientedBGRA;
+            std::vector<BYTE> yuy2Reference;
+            std::vector<BYTE> rgbaReference;
+            OrientPixels(bgraData, width, height, orientation, orientedBGRA);
+            OrientPixels(unrotatedRGBA, width, height, orientation, rgbaReference);
+            if (FAILED(yuy2Converter.CreateOutputBuffer(outputWidth, outputHeight, yuy2Reference)) ||
+                FAILED(yuy2Converter.Convert(orientedBGRA.data(), yuy2Reference.data(), outputWidth, outputHeight)))
+            {
+                LogError("Failed to prepare orientation reference");
+                return -1;
+            }
+
+            for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+            {
+                CpuConversionOptions options;
+                options.MaxSimdLevel = static_cast<SimdLevel>(level);
+                options.ThreadCount = threads;
+                CpuBGRAToYUY2Converter levelYUY2;
+                CpuNV12ToRGBAConverter levelRGBA;
+                std::vector<BYTE> yuy2Output;
+                std::vector<BYTE> rgbaOutput;
+                ImageView yuy2View;
+                ImageView rgbaView;
+                if (FAILED(levelYUY2.Initialize(options)) || FAILED(levelRGBA.Initialize(options)) ||
+                    FAILED(levelYUY2.CreateOutputBuffer(outputWidth, outputHeight, 0, yuy2Output, yuy2View)) ||
+                    FAILED(levelRGBA.CreateOutputBuffer(outputWidth, outputHeight, 0, rgbaOutput, rgbaView)))
+                {
+                    LogError("Failed to initialize CPU converters");
+                    return -1;
+                }
+                if (FAILED(levelYUY2.Convert(bgraView, yuy2View, orientation)) ||
+                    FAILED(levelRGBA.Convert(nv12View, rgbaView, orientation)))
+                {
+                    LogError("Oriented conversion failed");
+                    return -1;
+                }
+                if (yuy2Output != yuy2Reference || rgbaOutput != rgbaReference)
+                {
+                    LogError(std::string(GetSimdLevelName(levelYUY2.GetOrientationSimdLevel())) + " " +
+                             (yuy2Output != yuy2Reference ? "BGRA to YUY2" : "NV12 to RGBA") + " output for " +
+                             GetOrientationName(orientation) + " differs from the rotated reference");
+                    return -1;
+                }
+            }
+
+            std::vector<BYTE> yuy2Output;
+            std::vector<BYTE> rgbaOutput;
+            ImageView yuy2View;
+            ImageView rgbaView;
+            if (FAILED(yuy2Converter.CreateOutputBuffer(outputWidth, outputHeight, 0, yuy2Output, yuy2View)) ||
+                FAILED(rgbaConverter.CreateOutputBuffer(outputWidth, outputHeight, 0, rgbaOutput, rgbaView)))
+            {
+                LogError("Failed to create output buffers");
+                return -1;
+            }
+            start = FramePacer::GetMonotonicNanoseconds();
+            for (UINT i = 0; i < frames; i++)
+            {
+                yuy2Converter.Convert(bgraView, yuy2View, orientation);
+            }
+            double orientedYUY2Ms = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+            start = FramePacer::GetMonotonicNanoseconds();
+            for (UINT i = 0; i < frames; i++)
+            {
+                rgbaConverter.Convert(nv12View, rgbaView, orientation);
+            }
+            double orientedRGBAMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+            // 单独旋转一遍BGRA再转换（只测一次，逐像素旋转没有分块，代表单独的旋转遍）
+            start = FramePacer::GetMonotonicNanoseconds();
+            OrientPixels(bgraData, width, height, orientation, orientedBGRA);
+            yuy2Converter.Convert(orientedBGRA.data(), yuy2Reference.data(), outputWidth, outputHeight);
+            double separateMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6;
+
+            std::cout << "[ROTATE] " << std::setw(8) << GetOrientationName(orientation) << " -> " << outputWidth
+                      << "x" << outputHeight << " (" << GetSimdLevelName(yuy2Converter.GetOrientationSimdLevel())
+                      << ")" << std::fixed << std::setprecision(3) << ": YUY2 " << orientedYUY2Ms << "ms (unrotated "
+                      << yuy2Ms << "ms, rotate pass + convert " << separateMs << "ms), RGBA " << orientedRGBAMs
+                      << "ms (unrotated " << rgbaMs << "ms), Output matches rotated reference" << std::endl;
+        }
+    }
+    return 0;
+}
+
+// 合成测试用的指针形状（原始数据的布局与DXGI_OUTDUPL_POINTER_SHAPE_INFO相同）
+struct SyntheticCursor
+{
+    const char* Name;
+    CursorShapeView Shape;
+    std::vector<BYTE> Data;
+};
+
+static void CreateSyntheticCursors(std::vector<SyntheticCursor>& cursors)
+{
+    cursors.resize(3);
+
+    // 彩色：32x32的箭头，alpha从透明渐变到不透明
+    SyntheticCursor& color = cursors[0];
+    color.Name = "color";
+    color.Shape = { CursorShapeType::Color, 32, 32, 32 * 4, nullptr };
+    color.Data.assign((size_t)color.Shape.Pitch * color.Shape.Height, 0);
+    for (UINT y = 0; y < 32; y++)
+    {
+        for (UINT x = 0; x <= y; x++)
+        {
+            BYTE* pixel = color.Data.data() + (size_t)y * color.Shape.Pitch + x * 4;
+            pixel[0] = static_cast<BYTE>(x * 8);
+            pixel[1] = static_cast<BYTE>(y * 8);
+            pixel[2] = 200;
+            pixel[3] = static_cast<BYTE>(x == y ? 255 : (x * 7 + y * 13) & 0xFF);
+        }
+    }
+
+    // 带掩码的彩色：23x19（奇数尺寸，行尾带填充），左半替换、右半异或
+    SyntheticCursor& masked = cursors[1];
+    masked.Name = "masked color";
+    masked.Shape = { CursorShapeType::MaskedColor, 23, 19, 23 * 4 + 12, nullptr };
+    masked.Data.assign((size_t)masked.Shape.Pitch * masked.Shape.Height, 0);
+    for (UINT y = 0; y < 19; y++)
+    {
+        for (UINT x = 0; x < 23; x++)
+        {
+            BYTE* pixel = masked.Data.data() + (size_t)y * masked.Shape.Pitch + x * 4;
+            pixel[0] = static_cast<BYTE>(x * 11);
+            pixel[1] = static_cast<BYTE>(255 - y * 13);
+            pixel[2] = static_cast<BYTE>((x ^ y) * 9);
+            pixel[3] = x < 12 ? 0x00 : 0xFF;
+        }
+    }
+
+    // 单色：32x32（Height为AND和XOR两个掩码的总行数），包含透明、黑、白、反色四种组合
+    SyntheticCursor& mono = cursors[2];
+    mono.Name = "monochrome";
+    mono.Shape = { CursorShapeType::Monochrome, 32, 64, 4, nullptr };
+    mono.Data.assign((size_t)mono.Shape.Pitch * mono.Shape.Height, 0);
+    for (UINT y = 0; y < 32; y++)
+    {
+        for (UINT x = 0; x < 32; x++)
+        {
+            BYTE bit = static_cast<BYTE>(0x80 >> (x & 7));
+            if ((x + y) % 3 != 0)
+                mono.Data[(size_t)y * mono.Shape.Pitch + x / 8] |= bit;
+            if ((x * y) % 5 == 0)
+                mono.Data[(size_t)(y + 32) * mono.Shape.Pitch + x / 8] |= bit;
+        }
+    }
+
+    for (SyntheticCursor& cursor : cursors)
+    {
+        cursor.Shape.Data = cursor.Data.data();
+    }
+}
+
+// 按DXGI的定义直接从原始形状合成指针（紧凑BGRA图像），作为指针合成的参考结果
+static void CompositeCursorPixels(const CursorShapeView& shape, int cursorX, int cursorY, std::vector<BYTE>& image,
+                                  UINT width, UINT height)
+{
+    bool monochrome = shape.Type == CursorShapeType::Monochrome;
+    UINT shapeHeight = monochrome ? shape.Height / 2 : shape.Height;
+    for (UINT cy = 0; cy < shapeHeight; cy++)
+    {
+        for (UINT cx = 0; cx < shape.Width; cx++)
+        {
+            int x = cursorX + static_cast<int>(cx);
+            int y = cursorY + static_cast<int>(cy);
+            if (x < 0 || y < 0 || x >= static_cast<int>(width) || y >= static_cast<int>(height))
+                continue;
+
+            BYTE* pixel = image.data() + ((size_t)y * width + x) * 4;
+            if (monochrome)
+            {
+                bool andBit = (shape.Data[(size_t)cy * shape.Pitch + cx / 8] >> (7 - cx % 8)) & 1;
+                bool xorBit = (shape.Data[(size_t)(cy + shapeHeight) * shape.Pitch + cx / 8] >> (7 - cx % 8)) & 1;
+                for (UINT c = 0; c < 3; c++)
+                {
+                    pixel[c] = static_cast<BYTE>((andBit ? pixel[c] : 0) ^ (xorBit ? 0xFF : 0));
+                }
+                continue;
+            }
+
+            const BYTE* cursorPixel = shape.Data + (size_t)cy * shape.Pitch + cx * 4;
+            for (UINT c = 0; c < 3; c++)
+            {
+                if (shape.Type == CursorShapeType::Color)
+                    pixel[c] = static_cast<BYTE>((cursorPixel[c] * cursorPixel[3] + pixel[c] * (255 - cursorPixel[3]) + 127) / 255);
+                else
+                    pixel[c] = static_cast<BYTE>(cursorPixel[3] ? pixel[c] ^ cursorPixel[c] : cursorPixel[c]);
+            }
+        }
+    }
+}
+
+static int RunCursorBenchmark(UINT width, UINT height, UINT frames, UINT threads)
+{
+    LogMessage("Cursor compositing benchmark: " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(frames) + " frames, " + std::to_string(threads) + " threads");
+
+    std::vector<BYTE> sourceData((size_t)width * height * 4);
+    ImageView sourceView = MakeBGRAImageView(sourceData.data(), width, height);
+    if (FAILED(SyntheticFrameSource::RenderFrame(SyntheticPattern::Desktop, 100, sourceView)))
+    {
+        LogError("Failed to render synthetic frame");
+        return -1;
+    }
+
+    std::vector<SyntheticCursor> cursors;
+    CreateSyntheticCursors(cursors);
+
+    // 奇数x、部分超出左上/右下边缘、完全在图像外
+    const int positions[][2] =
+    {
+        { 101, 77 },
+        { -9, -5 },
+        { static_cast<int>(width) - 7, static_cast<int>(height) - 9 },
+        { static_cast<int>(width) + 5, 0 },
+    };
+
+    std::vector<BYTE> composited;
+    std::vector<BYTE> reference;
+    std::vector<BYTE> output;
+    ImageView outputView;
+    SimdLevel bestLevel = GetBestSimdLevel();
+    for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+    {
+        CpuConversionOptions options;
+        options.MaxSimdLevel = static_cast<SimdLevel>(level);
+        options.ThreadCount = threads;
+
+        CpuBGRAToYUY2Converter converter;
+        if (FAILED(converter.Initialize(options)) ||
+            FAILED(converter.CreateOutputBuffer(width, height, reference)) ||
+            FAILED(converter.CreateOutputBuffer(width, height, 0, output, outputView)))
+        {
+            LogError("Failed to initialize CPU converter");
+            return -1;
+        }
+        if (converter.GetSimdLevel() != static_cast<SimdLevel>(level))
+            continue;
+
+        for (const SyntheticCursor& cursor : cursors)
+        {
+            CursorImage image;
+            if (FAILED(BuildCursorImage(cursor.Shape, image)))
+            {
+                LogError(std::string("Failed to build ") + cursor.Name + " cursor");
+                return -1;
+            }
+
+            for (const int* position : positions)
+            {
+                // 参考结果：先把指针合成到整帧BGRA图像上再整帧转换
+                composited = sourceData;
+                CompositeCursorPixels(cursor.Shape, position[0], position[1], composited, width, height);
+                if (FAILED(converter.Convert(composited.data(), reference.data(), width, height)) ||
+                    FAILED(converter.Convert(sourceView, outputView, image, position[0], position[1])))
+                {
+                    LogError("Cursor conversion failed");
+                    return -1;
+                }
+                if (output != reference)
+                {
+                    LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + ": " + cursor.Name +
+                             " cursor at (" + std::to_string(position[0]) + ", " + std::to_string(position[1]) +
+                             ") differs from composite-then-convert reference");
+                    return -1;
+                }
+            }
+        }
+
+        if (level != static_cast<int>(bestLevel))
+            continue;
+
+        for (const SyntheticCursor& cursor : cursors)
+        {
+            CursorImage image;
+            BuildCursorImage(cursor.Shape, image);
+            int x = positions[0][0];
+            int y = positions[0][1];
+            ImageRect covered = GetCursorRect(image, x, y, width, height);
+
+            long long start = FramePacer::GetMonotonicNanoseconds();
+            for (UINT i = 0; i < frames; i++)
+            {
+                converter.Convert(sourceView, outputView);
+            }
+            double plainMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+            start = FramePacer::GetMonotonicNanoseconds();
+            for (UINT i = 0; i < frames; i++)
+            {
+                converter.Convert(sourceView, outputView, image, x, y);
+            }
+            double cursorMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+            start = FramePacer::GetMonotonicNanoseconds();
+            for (UINT i = 0; i < frames; i++)
+            {
+                converter.CompositeCursor(sourceView, outputView, image, x, y);
+            }
+            double compositeUs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e3 / frames;
+
+            // 单独的叠加遍：采集的帧不能修改，先复制整帧再合成指针，然后转换
+            start = FramePacer::GetMonotonicNanoseconds();
+            for (UINT i = 0; i < frames; i++)
+            {
+                memcpy(composited.data(), sourceData.data(), sourceData.size());
+                for (UINT row = covered.Top; row < covered.Bottom; row++)
+                {
+                    CompositeCursorRow(image, row - y, covered.Left - x, covered.Right - covered.Left,
+                                       composited.data() + ((size_t)row * width + covered.Left) * 4);
+                }
+                converter.Convert(composited.data(), reference.data(), width, height);
+            }
+            double overlayMs = (FramePacer::GetMonotonicNanoseconds() - start) / 1e6 / frames;
+
+            std::cout << "[CURSOR] " << std::setw(12) << cursor.Name << " " << image.Width << "x" << image.Height
+                      << " (" << GetSimdLevelName(converter.GetSimdLevel()) << "): " << std::fixed
+                      << std::setprecision(3) << "convert + cursor " << cursorMs << "ms (convert only " << plainMs
+                      << "ms, cursor pairs " << std::setprecision(1) << compositeUs << "us, copy + overlay + convert "
+                      << std::setprecision(3) << overlayMs << "ms), Output matches composite-then-convert reference"
+                      << std::endl;
+        }
+    }
+    return 0;
+}
+
+// 模拟每帧的处理耗时（占用CPU）
+static void SimulateFrameWork(double workMs)
+{
+    long long end = FramePacer::GetMonotonicNanoseconds() + static_cast<long long>(workMs * 1000000.0);
+    while (FramePacer::GetMonotonicNanoseconds() < end)
+    {
+    }
+}
+
+// 每帧处理workMs后分别用"sleep一个帧周期"和FramePacer限速，比较实际帧率。
+// 前者的帧间隔是处理耗时加sleep时长（再加定时器唤醒延迟），实际帧率必然低于目标；
+// 后者按绝对期限等待，只要处理耗时小于帧周期就能保持目标帧率
+static int RunPacingBenchmark(double targetFps, UINT frames, double workMs)
+{
+    LogMessage("Frame pacing benchmark: target " + std::to_string(targetFps) + " fps, " +
+              std::to_string(frames) + " frames, " + std::to_string(workMs) + "ms work per frame");
+
+    const double periodMs = 1000.0 / targetFps;
+
+    // 固定sleep：处理完再睡一个帧周期
+    long long start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        SimulateFrameWork(workMs);
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long long>(periodMs * 1000.0)));
+    }
+    double sleepSeconds = (FramePacer::GetMonotonicNanoseconds() - start) / 1e9;
+
+    // 绝对期限节拍
+    FramePacer pacer;
+    if (FAILED(pacer.Initialize(targetFps)))
+    {
+        LogError("Failed to initialize frame pacer");
+        return -1;
+    }
+    start = FramePacer::GetMonotonicNanoseconds();
+    for (UINT i = 0; i < frames; i++)
+    {
+        pacer.WaitForNextFrame();
+        SimulateFrameWork(workMs);
+    }
+    // 等到最后一帧的期限，使两种方式都统计frames个完整帧周期
+    pacer.WaitForNextFrame();
+    double pacedSeconds = (FramePacer::GetMonotonicNanoseconds() - start) / 1e9;
+
+    FramePacerStats stats = pacer.GetStats();
+    unsigned long long onTimeFrames = stats.Frames - stats.MissedDeadlines;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "[PACING] Fixed sleep: " << frames / sleepSeconds << " fps"
+              << ", Deadline pacer: " << frames / pacedSeconds << " fps (target " << targetFps << ")"
+              << ", Missed deadlines: " << stats.MissedDeadlines
+              << ", Skipped periods: " << stats.SkippedPeriods
+              << ", Wake-up lateness avg/max: " << std::setprecision(1)
+              << (onTimeFrames ? static_cast<double>(stats.TotalLatenessMicroseconds) / onTimeFrames : 0.0)
+              << "/" << stats.MaxLatenessMicroseconds << "us" << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 2 && std::string(argv[1]) == "--source")
+    {
+        UINT frames = argc > 3 ? static_cast<UINT>(std::atoi(argv[3])) : 300;
+        double targetFps = argc > 4 ? std::atof(argv[4]) : 60.0;
+        UINT threads = argc > 5 ? static_cast<UINT>(std::atoi(argv[5])) : 1;
+        UINT width = argc > 6 ? static_cast<UINT>(std::atoi(argv[6])) : 0;
+        UINT height = argc > 7 ? static_cast<UINT>(std::atoi(argv[7])) : 0;
+        if (frames == 0 || targetFps < 0.0)
+        {
+            LogError("Usage: CpuConversionBench --source <bars|checker|noise|desktop|file.bgra> [frames] [fps] [threads] [width] [height]");
+            return -1;
+        }
+        return RunSourceBenchmark(argv[2], frames, targetFps, threads, width, height);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--pacing")
+    {
+        double targetFps = argc > 2 ? std::atof(argv[2]) : 144.0;
+        UINT frames = argc > 3 ? static_cast<UINT>(std::atoi(argv[3])) : 288;
+        double workMs = argc > 4 ? std::atof(argv[4]) : 2.0;
+        if (!(targetFps > 0.0) || frames == 0 || workMs < 0.0)
+        {
+            LogError("Usage: CpuConversionBench --pacing [fps] [frames] [workMs]");
+            return -1;
+        }
+        return RunPacingBenchmark(targetFps, frames, workMs);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--precision")
+    {
+        return RunPrecisionCheck();
+    }
+
+    bool nv12 = argc > 1 && std::string(argv[1]) == "--nv12";
+    bool toNV12 = argc > 1 && std::string(argv[1]) == "--to-nv12";
+    bool toI420 = argc > 1 && std::string(argv[1]) == "--to-i420";
+    bool toYUV444 = argc > 1 && std::string(argv[1]) == "--to-yuv444";
+    bool hdr = argc > 1 && std::string(argv[1]) == "--hdr";
+    bool pool = argc > 1 && std::string(argv[1]) == "--pool";
+    bool pipeline = argc > 1 && std::string(argv[1]) == "--pipeline";
+    bool dirty = argc > 1 && std::string(argv[1]) == "--dirty";
+    bool damage = argc > 1 && std::string(argv[1]) == "--damage";
+    bool solid = argc > 1 && std::string(argv[1]) == "--solid";
+    bool scale = argc > 1 && std::string(argv[1]) == "--scale";
+    bool simulcast = argc > 1 && std::string(argv[1]) == "--simulcast";
+    bool crop = argc > 1 && std::string(argv[1]) == "--crop";
+    bool rotate = argc > 1 && std::string(argv[1]) == "--rotate";
+    bool cursor = argc > 1 && std::string(argv[1]) == "--cursor";
+    int firstArg = (nv12 || toNV12 || toI420 || toYUV444 || hdr || pool || pipeline || dirty || damage || solid ||
+                    scale || simulcast || crop || rotate || cursor) ? 2 : 1;
+
+    UINT width = argc > firstArg ? static_cast<UINT>(std::atoi(argv[firstArg])) : 3840;
+    UINT height = argc > firstArg + 1 ? static_cast<UINT>(std::atoi(argv[firstArg + 1])) : 2160;
+    UINT frames = argc > firstArg + 2 ? static_cast<UINT>(std::atoi(argv[firstArg + 2])) : 60;
+    UINT threads = argc > firstArg + 3 ? static_cast<UINT>(std::atoi(argv[firstArg + 3])) : 1;
+
+    if (width == 0 || height == 0 || frames == 0)
+    {
+        LogError("Usage: CpuConversionBench [--nv12|--to-nv12|--to-i420|--to-yuv444|--hdr|--pool|--pipeline|--dirty|--damage|--solid|--scale|--simulcast|--crop|--rotate|--cursor] [width] [height] [frames] [threads]");
+        return -1;
+    }
+
+    if (nv12)
+    {
+        return RunNV12Benchmark(width, height, frames, threads);
+    }
+    if (toNV12)
+    {
+        return RunBGRAToNV12Benchmark(width, height, frames, threads);
+    }
+    if (toI420)
+    {
+        return RunBGRAToI420Benchmark(width, height, frames, threads);
+    }
+    if (toYUV444)
+    {
+        return RunBGRAToYUV444Benchmark(width, height, frames, threads);
+    }
+    if (hdr)
+    {
+        return RunHDRToYUV10Benchmark(width, height, frames, threads);
+    }
+    if (pool)
+    {
+        return RunFramePoolCheck(width, height, frames, threads);
+    }
+    if (dirty)
+    {
+        return RunDirtyRegionBenchmark(width, height, frames, threads);
+    }
+    if (damage)
+    {
+        return RunTileDamageBenchmark(width, height, frames, threads);
+    }
+    if (solid)
+    {
+        return RunSolidColorBenchmark(width, height, frames, threads);
+    }
+    if (scale)
+    {
+        return RunScaleBenchmark(width, height, frames, threads);
+    }
+    if (simulcast)
+    {
+        return RunSimulcastBenchmark(width, height, frames, threads);
+    }
+    if (crop)
+    {
+        return RunCropBenchmark(width, height, frames, threads);
+    }
+    if (rotate)
+    {
+        return RunOrientationBenchmark(width, height, frames, threads);
+    }
+    if (cursor)
+    {
+        return RunCursorBenchmark(width, height, frames, threads);
+    }
+    if (pipeline)
+    {
+        UINT waitMs = argc > firstArg + 4 ? static_cast<UINT>(std::atoi(argv[firstArg + 4])) : 0;
+        return RunPipelineBenchmark(width, height, frames, threads, waitMs);
+    }
+
+    LogMessage("CPU BGRA to YUY2 benchmark: " + std::to_string(width) + "x" +
+              std::to_string(height) + ", " + std::to_string(frames) + " frames, " +
+              std::to_string(threads) + " threads");
+
+    std::vector<BYTE> bgraData = CreateTestBGRAData(width, height);
+    std::vector<BYTE> referenceData;
+    SimdLevel bestLevel = GetBestSimdLevel();
+
+    // 依次测试每个可用的指令集等级，并与标量结果逐字节比较
+    for (int level = static_cast<int>(SimdLevel::Scalar); level <= static_cast<int>(bestLevel); level++)
+    {
+        CpuConversionOptions options;
+        options.MaxSimdLevel = static_cast<SimdLevel>(level);
+        options.ThreadCount = threads;
+
+        CpuBGRAToYUY2Converter converter;
+        if (FAILED(converter.Initialize(options)))
+        {
+            LogError("Failed to initialize CPU converter");
+            return -1;
+        }
+
+        std::vector<BYTE> yuy2Data;
+        if (FAILED(converter.CreateOutputBuffer(width, height, yuy2Data)))
+        {
+            LogError("Failed to create output buffer");
+            return -1;
+        }
+
+        // 预热一帧
+        converter.Convert(bgraData.data(), yuy2Data.data(), width, height);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (UINT i = 0; i < frames; i++)
+        {
+            if (FAILED(converter.Convert(bgraData.data(), yuy2Data.data(), width, height)))
+            {
+                LogError("Conversion failed");
+                return -1;
+            }
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        if (referenceData.empty())
+        {
+            referenceData = yuy2Data;
+        }
+        else if (yuy2Data != referenceData)
+        {
+            LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " output differs from scalar output");
+            return -1;
+        }
+
+        // 带行填充的输入输出必须得到与紧凑布局相同的结果
+        if (!VerifyPaddedConversion(converter, bgraData, yuy2Data, width, height))
+        {
+            LogError(std::string(GetSimdLevelName(converter.GetSimdLevel())) + " padded-pitch output differs");
+            return -1;
+        }
+
+        double totalMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        PrintBenchResult(converter.GetSimdLevel(), totalMs / frames, (double)width * height * 4);
+    }
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+
+class WorkerThreadPool;
+
+// 转换精度：FixedPoint为默认的定点SIMD路径；
+// FloatReference逐项复现shader的浮点公式（仅标量实现），用于与GPU输出逐字节对比
+enum class ConversionPrecision
+{
+    FixedPoint,
+    FloatReference
+};
+
+// CPU转换器的初始化选项
+struct CpuConversionOptions
+{
+    SimdLevel MaxSimdLevel = SimdLevel::AVX512BW;
+    ConversionPrecision Precision = ConversionPrecision::FixedPoint;
+    // BGRA到YUY2的SIMD内核检测纯色像素块，整块直接写出预先打包的YUY2字（见BGRAToYUY2Kernels.h）
+    bool SolidColorFastPath = true;
+    // 分块损坏检测同时检测垂直滚动并报告为移动（见TileDamageDetector）。
+    // 需要额外保存上一帧的像素并比较移动的行，没有滚动内容时只增加开销，默认关闭
+    bool ScrollDetection = false;
+
+    // 多线程按行分带转换：ThreadCount为参与线程总数，0表示全部逻辑核心
+    UINT ThreadCount = 1;
+    bool PinThreads = true;
+
+    // 可选的外部共享线程池；为空且ThreadCount != 1时转换器创建自己的线程池
+    WorkerThreadPool* ThreadPool = nullptr;
+};
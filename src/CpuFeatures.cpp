@@ -0,0 +1,104 @@
+#include "CpuFeatures.h"
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    void QueryCpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+        for (int i = 0; i < 4; i++)
+            regs[i] = static_cast<unsigned int>(info[i]);
+#else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    unsigned long long QueryXCR0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    }
+#endif
+
+    CpuFeatures DetectCpuFeatures()
+    {
+        CpuFeatures features = {};
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+        unsigned int regs[4] = {};
+        QueryCpuid(0, 0, regs);
+        unsigned int maxLeaf = regs[0];
+        if (maxLeaf < 1)
+            return features;
+
+        QueryCpuid(1, 0, regs);
+        unsigned int ecx1 = regs[2];
+        features.SSE41 = (ecx1 & (1u << 19)) != 0;
+
+        // AVX系列需要操作系统通过XSAVE保存YMM/ZMM寄存器状态
+        bool osxsave = (ecx1 & (1u << 27)) != 0;
+        bool avx = (ecx1 & (1u << 28)) != 0;
+        if (!osxsave || !avx || maxLeaf < 7)
+            return features;
+
+        unsigned long long xcr0 = QueryXCR0();
+        bool osYmm = (xcr0 & 0x6) == 0x6;
+        bool osZmm = (xcr0 & 0xE6) == 0xE6;
+
+        QueryCpuid(7, 0, regs);
+        unsigned int ebx7 = regs[1];
+        features.AVX2 = osYmm && (ebx7 & (1u << 5)) != 0;
+        features.AVX512BW = osZmm && (ebx7 & (1u << 16)) != 0 && (ebx7 & (1u << 30)) != 0;
+#endif
+
+        return features;
+    }
+}
+
+const CpuFeatures& GetCpuFeatures()
+{
+    static const CpuFeatures features = DetectCpuFeatures();
+    return features;
+}
+
+SimdLevel GetBestSimdLevel()
+{
+    const CpuFeatures& features = GetCpuFeatures();
+    if (features.AVX512BW)
+        return SimdLevel::AVX512BW;
+    if (features.AVX2)
+        return SimdLevel::AVX2;
+    if (features.SSE41)
+        return SimdLevel::SSE41;
+    return SimdLevel::Scalar;
+}
+
+const char* GetSimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::SSE41:
+        return "SSE4.1";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::AVX512BW:
+        return "AVX-512BW";
+    default:
+        return "Scalar";
+    }
+}
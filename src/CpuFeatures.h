@@ -0,0 +1,25 @@
+#pragma once
+
+// CPU指令集等级，按能力从低到高排列
+enum class SimdLevel
+{
+    Scalar = 0,
+    SSE41,
+    AVX2,
+    AVX512BW
+};
+
+struct CpuFeatures
+{
+    bool SSE41;
+    bool AVX2;
+    bool AVX512BW;
+};
+
+// 通过CPUID/XGETBV检测当前CPU及操作系统支持的指令集（结果在首次调用时缓存）
+const CpuFeatures& GetCpuFeatures();
+
+// 返回当前CPU可用的最高SIMD等级
+SimdLevel GetBestSimdLevel();
+
+const char* GetSimdLevelName(SimdLevel level);
@@ -0,0 +1,222 @@
+#include "CpuHDRToYUV10Converter.h"
+#include "HDRConversionMath.h"
+#include <algorithm>
+
+namespace
+{
+    // 每个线程分配的行带数量（略多于线程数以平衡负载）以及每个行带的最少行数
+    const UINT kBandsPerThread = 2;
+    const UINT kMinBandHeight = 16;
+
+    const HDRInputFormat kInputFormats[2] = { HDRInputFormat::R10G10B10A2, HDRInputFormat::R16G16B16A16Float };
+}
+
+CpuHDRToYUV10Converter::CpuHDRToYUV10Converter()
+    : m_rowPairKernels()
+    , m_rowKernels()
+    , m_simdLevel(SimdLevel::Scalar)
+    , m_precision(ConversionPrecision::FixedPoint)
+    , m_threadPool(nullptr)
+    , m_initialized(false)
+    , m_lastLogTime(std::chrono::steady_clock::now())
+{
+}
+
+CpuHDRToYUV10Converter::~CpuHDRToYUV10Converter()
+{
+    Cleanup();
+}
+
+HRESULT CpuHDRToYUV10Converter::Initialize(const CpuConversionOptions& options)
+{
+    m_precision = options.Precision;
+    for (UINT i = 0; i < 2; i++)
+    {
+        HDRInputFormat format = kInputFormats[i];
+        if (m_precision == ConversionPrecision::FloatReference)
+        {
+            // 浮点参考路径只有标量实现
+            m_rowPairKernels[i] = GetHDRToP010RowPairFloatKernel(format);
+            m_rowKernels[i] = GetHDRToP210RowFloatKernel(format);
+            m_simdLevel = SimdLevel::Scalar;
+        }
+        else
+        {
+            // 所有输入、输出格式的内核提供相同的指令集等级
+            m_rowPairKernels[i] = GetHDRToP010RowPairKernel(format, options.MaxSimdLevel, &m_simdLevel);
+            m_rowKernels[i] = GetHDRToP210RowKernel(format, options.MaxSimdLevel);
+        }
+    }
+
+    if (options.ThreadPool)
+    {
+        m_threadPool = options.ThreadPool;
+    }
+    else if (options.ThreadCount != 1)
+    {
+        m_ownedThreadPool.reset(new WorkerThreadPool());
+        HRESULT hr = m_ownedThreadPool->Initialize(options.ThreadCount, options.PinThreads);
+        if (FAILED(hr))
+        {
+            LogError("Failed to start CPU conversion worker threads");
+            Cleanup();
+            return hr;
+        }
+        m_threadPool = m_ownedThreadPool.get();
+    }
+
+    // 第一次转换之前生成PQ编码表，避免第一帧额外的延迟
+    GetPQEncodeTable();
+
+    m_initialized = true;
+    LogMessage(std::string("CPU HDR to 10-bit YUV converter initialized successfully (") +
+              GetSimdLevelName(m_simdLevel) +
+              (m_precision == ConversionPrecision::FloatReference ? ", float reference" : "") +
+              ", " + std::to_string(GetThreadCount()) + " threads)");
+    return S_OK;
+}
+
+HRESULT CpuHDRToYUV10Converter::CreateOutputBuffer(UINT width, UINT height, UINT pitch, YUV10Format format,
+                                                   std::vector<BYTE>& outBuffer, ImageView& outView)
+{
+    if (width == 0 || height == 0 || (pitch != 0 && pitch < GetPlaneStride(width)))
+        return E_INVALIDARG;
+
+    try
+    {
+        UINT rowPitch = pitch ? pitch : GetPlaneStride(width);
+        outBuffer.resize((size_t)rowPitch * (height + GetChromaHeight(height, format)));
+        if (format == YUV10Format::P010)
+            outView = MakeP010ImageView(outBuffer.data(), width, height, rowPitch);
+        else
+            outView = MakeP210ImageView(outBuffer.data(), width, height, rowPitch);
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate CPU output buffer");
+        return E_OUTOFMEMORY;
+    }
+}
+
+void CpuHDRToYUV10Converter::ConvertBand(void* context, UINT bandIndex)
+{
+    const BandContext* band = static_cast<const BandContext*>(context);
+
+    const ImagePlane& srcPlane = band->Source;
+    const ImagePlane& yPlane = band->YPlane;
+    const ImagePlane& uvPlane = band->UVPlane;
+    UINT rowBegin = bandIndex * band->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + band->BandHeight, band->Height);
+
+    if (!band->RowPairKernel)
+    {
+        for (UINT y = rowBegin; y < rowEnd; y++)
+        {
+            band->RowKernel(srcPlane.Data + (size_t)y * srcPlane.Pitch,
+                            reinterpret_cast<UINT16*>(yPlane.Data + (size_t)y * yPlane.Pitch),
+                            reinterpret_cast<UINT16*>(uvPlane.Data + (size_t)y * uvPlane.Pitch),
+                            band->Width);
+        }
+        return;
+    }
+
+    // 每次处理共享同一UV行的两行
+    for (UINT y = rowBegin; y < rowEnd; y += 2)
+    {
+        bool hasSecondRow = y + 1 < rowEnd;
+        const BYTE* srcRow0 = srcPlane.Data + (size_t)y * srcPlane.Pitch;
+        BYTE* yRow0 = yPlane.Data + (size_t)y * yPlane.Pitch;
+
+        band->RowPairKernel(srcRow0,
+                            hasSecondRow ? srcRow0 + srcPlane.Pitch : nullptr,
+                            reinterpret_cast<UINT16*>(yRow0),
+                            hasSecondRow ? reinterpret_cast<UINT16*>(yRow0 + yPlane.Pitch) : nullptr,
+                            reinterpret_cast<UINT16*>(uvPlane.Data + (size_t)(y / 2) * uvPlane.Pitch),
+                            band->Width);
+    }
+}
+
+UINT CpuHDRToYUV10Converter::GetBandHeight(UINT height) const
+{
+    UINT bandCount = 1;
+    if (m_threadPool)
+    {
+        bandCount = (std::min)(m_threadPool->GetThreadCount() * kBandsPerThread,
+                               (std::max)(1u, height / kMinBandHeight));
+    }
+    UINT bandHeight = (height + bandCount - 1) / bandCount;
+    return (bandHeight + 1) & ~1u;
+}
+
+HRESULT CpuHDRToYUV10Converter::Convert(const BYTE* sourceData, HDRInputFormat inputFormat, BYTE* outputData,
+                                        UINT width, UINT height, YUV10Format outputFormat)
+{
+    // 紧凑布局的输入只读取，不会通过视图写入
+    ImageView source = MakeSinglePlaneImageView(const_cast<BYTE*>(sourceData), width, height,
+                                                width * GetHDRInputBytesPerPixel(inputFormat), 0);
+    if (outputFormat == YUV10Format::P010)
+        return Convert(source, inputFormat, MakeP010ImageView(outputData, width, height), outputFormat);
+    return Convert(source, inputFormat, MakeP210ImageView(outputData, width, height), outputFormat);
+}
+
+HRESULT CpuHDRToYUV10Converter::Convert(const ImageView& source, HDRInputFormat inputFormat,
+                                        const ImageView& destination, YUV10Format outputFormat)
+{
+    UINT width = source.Width;
+    UINT height = source.Height;
+    if (!m_initialized ||
+        !IsImageViewValid(source, 1, width, height) ||
+        !IsImageViewValid(destination, 2, width, height) ||
+        source.Planes[0].RowBytes < width * GetHDRInputBytesPerPixel(inputFormat) ||
+        destination.Planes[0].RowBytes < width * 2 ||
+        destination.Planes[1].RowBytes < GetPlaneStride(width) ||
+        destination.Planes[1].Height < GetChromaHeight(height, outputFormat))
+        return E_INVALIDARG;
+
+    UINT formatIndex = inputFormat == HDRInputFormat::R16G16B16A16Float ? 1 : 0;
+
+    BandContext band;
+    band.RowPairKernel = outputFormat == YUV10Format::P010 ? m_rowPairKernels[formatIndex] : nullptr;
+    band.RowKernel = m_rowKernels[formatIndex];
+    band.Source = source.Planes[0];
+    band.YPlane = destination.Planes[0];
+    band.UVPlane = destination.Planes[1];
+    band.Width = width;
+    band.Height = height;
+
+    band.BandHeight = GetBandHeight(height);
+    UINT bandCount = (height + band.BandHeight - 1) / band.BandHeight;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, ConvertBand, &band);
+    }
+    else
+    {
+        ConvertBand(&band, 0);
+    }
+
+    // 每10秒输出一次成功日志
+    auto currentTime = std::chrono::steady_clock::now();
+    auto timeDiff = std::chrono::duration_cast<std::chrono::seconds>(currentTime - m_lastLogTime);
+    if (timeDiff.count() >= 10)
+    {
+        LogMessage("CPU HDR to 10-bit YUV conversion completed successfully");
+        m_lastLogTime = currentTime;
+    }
+
+    return S_OK;
+}
+
+void CpuHDRToYUV10Converter::Cleanup()
+{
+    m_ownedThreadPool.reset();
+    m_threadPool = nullptr;
+    for (UINT i = 0; i < 2; i++)
+    {
+        m_rowPairKernels[i] = nullptr;
+        m_rowKernels[i] = nullptr;
+    }
+    m_initialized = false;
+}
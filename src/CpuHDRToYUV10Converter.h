@@ -0,0 +1,81 @@
+#pragma once
+#include "CpuConversionOptions.h"
+#include "HDRToYUV10Kernels.h"
+#include "ImageView.h"
+#include "Utils.h"
+#include "WorkerThreadPool.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// 10位输出格式：16位样本、10位码值在高位，Y平面 + 交错UV平面（U在前）
+enum class YUV10Format
+{
+    P010,   // 4:2:0，UV平面(height + 1) / 2行
+    P210    // 4:2:2，UV平面height行
+};
+
+// HDR桌面格式（R10G10B10A2_UNORM、R16G16B16A16_FLOAT scRGB）到P010/P210的可移植CPU转换器。
+// 输出为BT.2020矩阵、PQ编码、10位限制范围（见HDRConversionMath.h），供HEVC/AV1 Main10编码器使用；
+// 8位转换器只接受B8G8R8A8，HDR桌面的捕获帧直接交给这里，不需要先降为8位SDR。
+// 每种输入格式和输出格式的内核在Initialize时按CPUID选择（SSE4.1/AVX2/标量），
+// 多线程时按水平行带拆分（P010的行带高度为偶数），由常驻线程池执行
+class CpuHDRToYUV10Converter
+{
+public:
+    CpuHDRToYUV10Converter();
+    ~CpuHDRToYUV10Converter();
+
+    HRESULT Initialize(const CpuConversionOptions& options = CpuConversionOptions());
+    // 紧凑布局：UV平面紧跟在Y平面之后，两个平面的行步长都为GetPlaneStride(width)
+    HRESULT Convert(const BYTE* sourceData, HDRInputFormat inputFormat, BYTE* outputData, UINT width, UINT height,
+                    YUV10Format outputFormat);
+    HRESULT Convert(const ImageView& source, HDRInputFormat inputFormat, const ImageView& destination,
+                    YUV10Format outputFormat);
+    // 按行步长pitch（0表示紧凑，两个平面相同）分配输出缓冲区，并返回描述它的视图
+    HRESULT CreateOutputBuffer(UINT width, UINT height, UINT pitch, YUV10Format format,
+                               std::vector<BYTE>& outBuffer, ImageView& outView);
+    void Cleanup();
+
+    SimdLevel GetSimdLevel() const { return m_simdLevel; }
+    ConversionPrecision GetPrecision() const { return m_precision; }
+    UINT GetThreadCount() const { return m_threadPool ? m_threadPool->GetThreadCount() : 1; }
+
+    static UINT GetPlaneStride(UINT width) { return ((width + 1) / 2) * 4; }
+    static UINT GetChromaHeight(UINT height, YUV10Format format)
+    {
+        return format == YUV10Format::P010 ? (height + 1) / 2 : height;
+    }
+    static UINT GetOutputSize(UINT width, UINT height, YUV10Format format)
+    {
+        return GetPlaneStride(width) * (height + GetChromaHeight(height, format));
+    }
+
+private:
+    struct BandContext
+    {
+        HDRToP010RowPairFunc RowPairKernel;     // 为空时输出P210
+        HDRToP210RowFunc RowKernel;
+        ImagePlane Source;
+        ImagePlane YPlane;
+        ImagePlane UVPlane;
+        UINT Width;
+        UINT Height;
+        UINT BandHeight;
+    };
+
+    static void ConvertBand(void* context, UINT bandIndex);
+    UINT GetBandHeight(UINT height) const;
+
+    // 按HDRInputFormat索引
+    HDRToP010RowPairFunc m_rowPairKernels[2];
+    HDRToP210RowFunc m_rowKernels[2];
+    SimdLevel m_simdLevel;
+    ConversionPrecision m_precision;
+    std::unique_ptr<WorkerThreadPool> m_ownedThreadPool;
+    WorkerThreadPool* m_threadPool;
+    bool m_initialized;
+
+    // 用于控制日志输出频率
+    std::chrono::steady_clock::time_point m_lastLogTime;
+};
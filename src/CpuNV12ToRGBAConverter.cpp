@@ -0,0 +1,334 @@
+#include "CpuNV12ToRGBAConverter.h"
+#include <algorithm>
+
+namespace
+{
+    // 每个线程分配的行带数量（略多于线程数以平衡负载）以及每个行带的最少行数
+    const UINT kBandsPerThread = 2;
+    const UINT kMinBandHeight = 16;
+    // 旋转90/270度时每次转置的源行数（偶数）：输出的每行写入64字节（一个缓存行）
+    const UINT kOrientationBlockRows = 16;
+}
+
+CpuNV12ToRGBAConverter::CpuNV12ToRGBAConverter()
+    : m_rowPairKernel(nullptr)
+    , m_simdLevel(SimdLevel::Scalar)
+    , m_orientationKernels()
+    , m_orientationSimdLevel(SimdLevel::Scalar)
+    , m_precision(ConversionPrecision::FixedPoint)
+    , m_threadPool(nullptr)
+    , m_initialized(false)
+    , m_lastLogTime(std::chrono::steady_clock::now())
+{
+}
+
+CpuNV12ToRGBAConverter::~CpuNV12ToRGBAConverter()
+{
+    Cleanup();
+}
+
+HRESULT CpuNV12ToRGBAConverter::Initialize(const CpuConversionOptions& options)
+{
+    m_precision = options.Precision;
+    if (m_precision == ConversionPrecision::FloatReference)
+    {
+        // 浮点参考路径只有标量实现
+        m_rowPairKernel = NV12ToRGBARowPair_Float;
+        m_simdLevel = SimdLevel::Scalar;
+    }
+    else
+    {
+        m_rowPairKernel = GetNV12ToRGBARowPairKernel(options.MaxSimdLevel, &m_simdLevel);
+    }
+    m_orientationKernels = GetOrientationKernels(options.MaxSimdLevel, &m_orientationSimdLevel);
+
+    if (options.ThreadPool)
+    {
+        m_threadPool = options.ThreadPool;
+    }
+    else if (options.ThreadCount != 1)
+    {
+        m_ownedThreadPool.reset(new WorkerThreadPool());
+        HRESULT hr = m_ownedThreadPool->Initialize(options.ThreadCount, options.PinThreads);
+        if (FAILED(hr))
+        {
+            LogError("Failed to start CPU conversion worker threads");
+            Cleanup();
+            return hr;
+        }
+        m_threadPool = m_ownedThreadPool.get();
+    }
+
+    m_initialized = true;
+    LogMessage(std::string("CPU NV12 to RGBA converter initialized successfully (") +
+              GetSimdLevelName(m_simdLevel) +
+              (m_precision == ConversionPrecision::FloatReference ? ", float reference" : "") +
+              ", " + std::to_string(GetThreadCount()) + " threads)");
+    return S_OK;
+}
+
+HRESULT CpuNV12ToRGBAConverter::CreateOutputBuffer(UINT width, UINT height, std::vector<BYTE>& outBuffer)
+{
+    if (width == 0 || height == 0)
+        return E_INVALIDARG;
+
+    try
+    {
+        outBuffer.resize(GetOutputSize(width, height)); // RGBA格式大小
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate CPU output buffer");
+        return E_OUTOFMEMORY;
+    }
+}
+
+HRESULT CpuNV12ToRGBAConverter::CreateOutputBuffer(UINT width, UINT height, UINT pitch,
+                                                   std::vector<BYTE>& outBuffer, ImageView& outView)
+{
+    if (width == 0 || height == 0 || (pitch != 0 && pitch < width * 4))
+        return E_INVALIDARG;
+
+    try
+    {
+        outView = MakeRGBAImageView(nullptr, width, height, pitch);
+        outBuffer.resize(GetImagePlaneSize(outView.Planes[0]));
+        outView.Planes[0].Data = outBuffer.data();
+        return S_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate CPU output buffer");
+        return E_OUTOFMEMORY;
+    }
+}
+
+void CpuNV12ToRGBAConverter::ConvertBand(void* context, UINT bandIndex)
+{
+    const BandContext* band = static_cast<const BandContext*>(context);
+
+    const ImagePlane& yPlane = band->YPlane;
+    const ImagePlane& dstPlane = band->Destination;
+    UINT rowBegin = bandIndex * band->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + band->BandHeight, band->Height);
+
+    // 每次处理共享同一UV行的两行
+    for (UINT y = rowBegin; y < rowEnd; y += 2)
+    {
+        bool hasSecondRow = y + 1 < rowEnd;
+        const BYTE* yRow0 = yPlane.Data + (size_t)y * yPlane.Pitch;
+        BYTE* rgbaRow0 = dstPlane.Data + (size_t)y * dstPlane.Pitch;
+
+        band->RowPairKernel(yRow0,
+                            hasSecondRow ? yRow0 + yPlane.Pitch : nullptr,
+                            band->UVPlane.Data + (size_t)(y / 2) * band->UVPlane.Pitch,
+                            rgbaRow0,
+                            hasSecondRow ? rgbaRow0 + dstPlane.Pitch : nullptr,
+                            band->Width);
+    }
+}
+
+UINT CpuNV12ToRGBAConverter::GetBandHeight(UINT height) const
+{
+    UINT bandCount = 1;
+    if (m_threadPool)
+    {
+        bandCount = (std::min)(m_threadPool->GetThreadCount() * kBandsPerThread,
+                               (std::max)(1u, height / kMinBandHeight));
+    }
+    UINT bandHeight = (height + bandCount - 1) / bandCount;
+    return (bandHeight + 1) & ~1u;
+}
+
+void CpuNV12ToRGBAConverter::ConvertOrientedBand(void* context, UINT bandIndex)
+{
+    const OrientedContext* oriented = static_cast<const OrientedContext*>(context);
+    const ImageOrientationMap& map = oriented->Map;
+    const ImagePlane& yPlane = oriented->YPlane;
+    const ImagePlane& dstPlane = oriented->Destination;
+    UINT width = oriented->Width;
+    size_t rowBytes = (size_t)width * 4;
+
+    UINT rowBegin = bandIndex * oriented->BandHeight;
+    UINT rowEnd = (std::min)(rowBegin + oriented->BandHeight, oriented->Height);
+    BYTE* rows = oriented->Rows + bandIndex * oriented->RowsStride;
+
+    // 源图像的(sx, sy)写到输出的(ox, oy)：映射矩阵是置换矩阵，逆映射为其转置
+    if (map.YStepX == 0 && map.XStepX > 0)
+    {
+        // 只有垂直翻转：源行直接转换到输出中对应的行
+        ptrdiff_t dstPitch = map.YStepY * (ptrdiff_t)dstPlane.Pitch;
+        for (UINT y = rowBegin; y < rowEnd; y += 2)
+        {
+            bool hasSecondRow = y + 1 < rowEnd;
+            const BYTE* yRow0 = yPlane.Data + (size_t)y * yPlane.Pitch;
+            BYTE* rgbaRow0 = dstPlane.Data + (ptrdiff_t)((int)y - map.OriginY) * dstPitch;
+            oriented->RowPairKernel(yRow0, hasSecondRow ? yRow0 + yPlane.Pitch : nullptr,
+                                    oriented->UVPlane.Data + (size_t)(y / 2) * oriented->UVPlane.Pitch, rgbaRow0,
+                                    hasSecondRow ? rgbaRow0 + dstPitch : nullptr, width);
+        }
+        return;
+    }
+
+    for (UINT y0 = rowBegin; y0 < rowEnd; y0 += kOrientationBlockRows)
+    {
+        UINT count = (std::min)(kOrientationBlockRows, rowEnd - y0);
+        for (UINT i = 0; i < count; i += 2)
+        {
+            UINT y = y0 + i;
+            bool hasSecondRow = i + 1 < count;
+            const BYTE* yRow0 = yPlane.Data + (size_t)y * yPlane.Pitch;
+            oriented->RowPairKernel(yRow0, hasSecondRow ? yRow0 + yPlane.Pitch : nullptr,
+                                    oriented->UVPlane.Data + (size_t)(y / 2) * oriented->UVPlane.Pitch,
+                                    rows + i * rowBytes, hasSecondRow ? rows + (i + 1) * rowBytes : nullptr, width);
+        }
+
+        int dy = (int)y0 - map.OriginY;
+        if (map.YStepX == 0)
+        {
+            // 0/180度且水平翻转：源行倒序写入输出中对应的行
+            for (UINT i = 0; i < count; i++)
+            {
+                int outputRow = (dy + (int)i) * map.YStepY;
+                oriented->Kernels.Reverse(rows + i * rowBytes, dstPlane.Data + (size_t)outputRow * dstPlane.Pitch,
+                                          width);
+            }
+        }
+        else
+        {
+            // 90/270度：源行y对应输出列dy * XStepY，源列sx对应输出行(sx - OriginX) * YStepX。
+            // XStepY为-1时倒序读取暂存行，使写入的列从左到右排列
+            int firstColumn = dy * map.XStepY;
+            int column = map.XStepY > 0 ? firstColumn : firstColumn - (int)(count - 1);
+            const BYTE* src = map.XStepY > 0 ? rows : rows + (count - 1) * rowBytes;
+            ptrdiff_t srcPitch = map.XStepY > 0 ? (ptrdiff_t)rowBytes : -(ptrdiff_t)rowBytes;
+            int firstRow = -map.OriginX * map.YStepX;
+            BYTE* dst = dstPlane.Data + (ptrdiff_t)firstRow * dstPlane.Pitch + (size_t)column * 4;
+            oriented->Kernels.Transpose(src, srcPitch, dst, map.YStepX * (ptrdiff_t)dstPlane.Pitch, width, count);
+        }
+    }
+}
+
+HRESULT CpuNV12ToRGBAConverter::Convert(const ImageView& source, const ImageView& destination,
+                                        const ImageOrientation& orientation)
+{
+    if (IsIdentityOrientation(orientation))
+        return Convert(source, destination);
+
+    UINT width = source.Width;
+    UINT height = source.Height;
+    UINT outputWidth;
+    UINT outputHeight;
+    GetOrientedSize(orientation, width, height, outputWidth, outputHeight);
+    if (!m_initialized ||
+        !IsImageViewValid(source, 2, width, height) ||
+        !IsImageViewValid(destination, 1, outputWidth, outputHeight) ||
+        source.Planes[0].RowBytes < width ||
+        source.Planes[1].RowBytes < GetUVPlaneStride(width) ||
+        source.Planes[1].Height < (height + 1) / 2 ||
+        destination.Planes[0].RowBytes < outputWidth * 4)
+        return E_INVALIDARG;
+
+    // 按源行拆分任务，行带从UV行边界开始
+    UINT bandHeight = GetBandHeight(height);
+    UINT bandCount = (height + bandHeight - 1) / bandHeight;
+
+    size_t rowsStride = (size_t)kOrientationBlockRows * width * 4;
+    try
+    {
+        if (m_orientedRows.size() < rowsStride * bandCount)
+            m_orientedRows.resize(rowsStride * bandCount);
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate oriented conversion rows");
+        return E_OUTOFMEMORY;
+    }
+
+    OrientedContext oriented;
+    oriented.RowPairKernel = m_rowPairKernel;
+    oriented.Kernels = m_orientationKernels;
+    oriented.Map = GetImageOrientationMap(orientation, width, height);
+    oriented.YPlane = source.Planes[0];
+    oriented.UVPlane = source.Planes[1];
+    oriented.Destination = destination.Planes[0];
+    oriented.Width = width;
+    oriented.Height = height;
+    oriented.BandHeight = bandHeight;
+    oriented.Rows = m_orientedRows.data();
+    oriented.RowsStride = rowsStride;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, ConvertOrientedBand, &oriented);
+    }
+    else
+    {
+        ConvertOrientedBand(&oriented, 0);
+    }
+    return S_OK;
+}
+
+HRESULT CpuNV12ToRGBAConverter::Convert(const BYTE* yPlaneData, const BYTE* uvPlaneData, BYTE* rgbaData,
+                                        UINT width, UINT height)
+{
+    // 紧凑布局的输入只读取，不会通过视图写入
+    return Convert(MakeNV12ImageView(const_cast<BYTE*>(yPlaneData), width,
+                                     const_cast<BYTE*>(uvPlaneData), GetUVPlaneStride(width), width, height),
+                   MakeRGBAImageView(rgbaData, width, height));
+}
+
+HRESULT CpuNV12ToRGBAConverter::Convert(const ImageView& source, const ImageView& destination)
+{
+    UINT width = source.Width;
+    UINT height = source.Height;
+    if (!m_initialized ||
+        !IsImageViewValid(source, 2, width, height) ||
+        !IsImageViewValid(destination, 1, width, height) ||
+        source.Planes[0].RowBytes < width ||
+        source.Planes[1].RowBytes < GetUVPlaneStride(width) ||
+        source.Planes[1].Height < (height + 1) / 2 ||
+        destination.Planes[0].RowBytes < width * 4)
+        return E_INVALIDARG;
+
+    BandContext band;
+    band.RowPairKernel = m_rowPairKernel;
+    band.YPlane = source.Planes[0];
+    band.UVPlane = source.Planes[1];
+    band.Destination = destination.Planes[0];
+    band.Width = width;
+    band.Height = height;
+
+    band.BandHeight = GetBandHeight(height);
+    UINT bandCount = (height + band.BandHeight - 1) / band.BandHeight;
+
+    if (bandCount > 1)
+    {
+        m_threadPool->Run(bandCount, ConvertBand, &band);
+    }
+    else
+    {
+        ConvertBand(&band, 0);
+    }
+
+    // 每10秒输出一次成功日志
+    auto currentTime = std::chrono::steady_clock::now();
+    auto timeDiff = std::chrono::duration_cast<std::chrono::seconds>(currentTime - m_lastLogTime);
+    if (timeDiff.count() >= 10)
+    {
+        LogMessage("CPU NV12 conversion completed successfully");
+        m_lastLogTime = currentTime;
+    }
+
+    return S_OK;
+}
+
+void CpuNV12ToRGBAConverter::Cleanup()
+{
+    m_ownedThreadPool.reset();
+    m_threadPool = nullptr;
+    m_rowPairKernel = nullptr;
+    m_orientedRows.clear();
+    m_initialized = false;
+}
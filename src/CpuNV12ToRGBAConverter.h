@@ -0,0 +1,90 @@
+#pragma once
+#include "CpuConversionOptions.h"
+#include "ImageOrientationKernels.h"
+#include "ImageView.h"
+#include "NV12ToRGBAKernels.h"
+#include "Utils.h"
+#include "WorkerThreadPool.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// NV12到RGBA的可移植CPU转换器
+// 转换规则与shaders/NV12ToRGBA.hlsl相同：BT.601限制范围、UV按2x2共享、Alpha = 255。
+// 输入为独立的Y平面（每行width字节）和交错UV平面（每行GetUVPlaneStride字节，
+// 共(height + 1) / 2行），输出为R8G8B8A8（内存字节序R,G,B,A）。
+// 行对内核在Initialize时按CPUID选择（SSE4.1/AVX2/标量），定点公式见ColorConversionMath.h。
+// 多线程时按UV行对齐的水平行带拆分，由常驻线程池执行。
+// ImageView版本的Convert支持任意行步长的Y/UV平面（如解码器表面），直接在原缓冲区上转换。
+// 带方向的Convert在转换的同时旋转/翻转：转换出的RGBA行留在暂存缓冲区中，
+// 旋转90/270度时每次转置16行的条带写入输出，不需要单独的旋转遍
+class CpuNV12ToRGBAConverter
+{
+public:
+    CpuNV12ToRGBAConverter();
+    ~CpuNV12ToRGBAConverter();
+
+    HRESULT Initialize(const CpuConversionOptions& options = CpuConversionOptions());
+    HRESULT Convert(const BYTE* yPlaneData, const BYTE* uvPlaneData, BYTE* rgbaData, UINT width, UINT height);
+    HRESULT Convert(const ImageView& source, const ImageView& destination);
+    // 带方向的转换：destination的尺寸为source按orientation变换后的尺寸（GetOrientedSize），
+    // 结果与先转换再旋转/翻转RGBA图像相同
+    HRESULT Convert(const ImageView& source, const ImageView& destination, const ImageOrientation& orientation);
+    HRESULT CreateOutputBuffer(UINT width, UINT height, std::vector<BYTE>& outBuffer);
+    // 按指定行步长（0表示紧凑）分配输出缓冲区，并返回描述它的视图
+    HRESULT CreateOutputBuffer(UINT width, UINT height, UINT pitch, std::vector<BYTE>& outBuffer, ImageView& outView);
+    void Cleanup();
+
+    SimdLevel GetSimdLevel() const { return m_simdLevel; }
+    SimdLevel GetOrientationSimdLevel() const { return m_orientationSimdLevel; }
+    ConversionPrecision GetPrecision() const { return m_precision; }
+    UINT GetThreadCount() const { return m_threadPool ? m_threadPool->GetThreadCount() : 1; }
+
+    static UINT GetUVPlaneStride(UINT width) { return ((width + 1) / 2) * 2; }
+    static UINT GetOutputSize(UINT width, UINT height) { return width * height * 4; }
+
+private:
+    struct BandContext
+    {
+        NV12ToRGBARowPairFunc RowPairKernel;
+        ImagePlane YPlane;
+        ImagePlane UVPlane;
+        ImagePlane Destination;
+        UINT Width;
+        UINT Height;
+        UINT BandHeight;    // 偶数，保证每个行带从UV行边界开始
+    };
+
+    // 带方向的转换时每个任务是若干源行（偶数），每个任务使用自己的暂存行
+    struct OrientedContext
+    {
+        NV12ToRGBARowPairFunc RowPairKernel;
+        OrientationKernels Kernels;
+        ImageOrientationMap Map;
+        ImagePlane YPlane;
+        ImagePlane UVPlane;
+        ImagePlane Destination;
+        UINT Width;         // 源图像尺寸
+        UINT Height;
+        UINT BandHeight;
+        BYTE* Rows;         // 每个任务kOrientationBlockRows行转换后的RGBA
+        size_t RowsStride;
+    };
+
+    static void ConvertBand(void* context, UINT bandIndex);
+    static void ConvertOrientedBand(void* context, UINT bandIndex);
+    UINT GetBandHeight(UINT height) const;
+
+    NV12ToRGBARowPairFunc m_rowPairKernel;
+    SimdLevel m_simdLevel;
+    OrientationKernels m_orientationKernels;
+    SimdLevel m_orientationSimdLevel;
+    std::vector<BYTE> m_orientedRows;
+    ConversionPrecision m_precision;
+    std::unique_ptr<WorkerThreadPool> m_ownedThreadPool;
+    WorkerThreadPool* m_threadPool;
+    bool m_initialized;
+
+    // 用于控制日志输出频率
+    std::chrono::steady_clock::time_point m_lastLogTime;
+};
@@ -0,0 +1,129 @@
+#include "CursorOverlay.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const UINT kCursorColorMask = 0x00FFFFFF;
+
+    inline UINT LoadPixel(const BYTE* pixel)
+    {
+        UINT value;
+        memcpy(&value, pixel, sizeof(value));
+        return value;
+    }
+
+    inline BYTE BlendComponent(UINT source, UINT destination, UINT alpha)
+    {
+        return static_cast<BYTE>((source * alpha + destination * (255 - alpha) + 127) / 255);
+    }
+}
+
+HRESULT BuildCursorImage(const CursorShapeView& shape, CursorImage& image)
+{
+    bool monochrome = shape.Type == CursorShapeType::Monochrome;
+    UINT height = monochrome ? shape.Height / 2 : shape.Height;
+    UINT minPitch = monochrome ? (shape.Width + 7) / 8 : shape.Width * 4;
+    if (!shape.Data || shape.Width == 0 || height == 0 || shape.Pitch < minPitch)
+        return E_INVALIDARG;
+    if (shape.Type != CursorShapeType::Monochrome && shape.Type != CursorShapeType::Color &&
+        shape.Type != CursorShapeType::MaskedColor)
+        return E_INVALIDARG;
+
+    size_t pixelCount = (size_t)shape.Width * height;
+    try
+    {
+        image.Colors.resize(pixelCount);
+        if (shape.Type == CursorShapeType::Color)
+            image.Masks.clear();
+        else
+            image.Masks.resize(pixelCount);
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate cursor image");
+        image.Width = image.Height = 0;
+        return E_OUTOFMEMORY;
+    }
+    image.Width = shape.Width;
+    image.Height = height;
+    image.AlphaBlend = shape.Type == CursorShapeType::Color;
+
+    for (UINT y = 0; y < height; y++)
+    {
+        UINT* colors = image.Colors.data() + (size_t)y * shape.Width;
+        UINT* masks = image.AlphaBlend ? nullptr : image.Masks.data() + (size_t)y * shape.Width;
+        if (monochrome)
+        {
+            // 最高位对应最左边的像素；AND为1时保留原像素，XOR为1时反色
+            const BYTE* andRow = shape.Data + (size_t)y * shape.Pitch;
+            const BYTE* xorRow = shape.Data + (size_t)(y + height) * shape.Pitch;
+            for (UINT x = 0; x < shape.Width; x++)
+            {
+                BYTE bit = static_cast<BYTE>(0x80 >> (x & 7));
+                masks[x] = (andRow[x / 8] & bit) ? kCursorColorMask : 0;
+                colors[x] = (xorRow[x / 8] & bit) ? kCursorColorMask : 0;
+            }
+            continue;
+        }
+
+        const BYTE* row = shape.Data + (size_t)y * shape.Pitch;
+        for (UINT x = 0; x < shape.Width; x++)
+        {
+            UINT pixel = LoadPixel(row + (size_t)x * 4);
+            if (image.AlphaBlend)
+            {
+                colors[x] = pixel;
+            }
+            else
+            {
+                // 带掩码的彩色指针：alpha为0时替换，非0时异或
+                masks[x] = (pixel >> 24) ? kCursorColorMask : 0;
+                colors[x] = pixel & kCursorColorMask;
+            }
+        }
+    }
+    return S_OK;
+}
+
+ImageRect GetCursorRect(const CursorImage& image, int x, int y, UINT width, UINT height)
+{
+    long long left = (std::max)((long long)x, 0LL);
+    long long top = (std::max)((long long)y, 0LL);
+    long long right = (std::min)((long long)x + image.Width, (long long)width);
+    long long bottom = (std::min)((long long)y + image.Height, (long long)height);
+    if (left >= right || top >= bottom)
+        return MakeImageRect(0, 0, 0, 0);
+    return MakeImageRect(static_cast<UINT>(left), static_cast<UINT>(top),
+                         static_cast<UINT>(right), static_cast<UINT>(bottom));
+}
+
+void CompositeCursorRow(const CursorImage& image, UINT cursorRow, UINT firstColumn, UINT count, BYTE* bgraRow)
+{
+    const UINT* colors = image.Colors.data() + (size_t)cursorRow * image.Width + firstColumn;
+    if (image.AlphaBlend)
+    {
+        for (UINT i = 0; i < count; i++)
+        {
+            UINT color = colors[i];
+            UINT alpha = color >> 24;
+            BYTE* pixel = bgraRow + (size_t)i * 4;
+            if (alpha == 0)
+                continue;
+            for (UINT c = 0; c < 3; c++)
+            {
+                pixel[c] = BlendComponent((color >> (c * 8)) & 0xFF, pixel[c], alpha);
+            }
+        }
+        return;
+    }
+
+    const UINT* masks = image.Masks.data() + (size_t)cursorRow * image.Width + firstColumn;
+    for (UINT i = 0; i < count; i++)
+    {
+        BYTE* pixel = bgraRow + (size_t)i * 4;
+        UINT value = LoadPixel(pixel);
+        value = (value & (masks[i] | ~kCursorColorMask)) ^ colors[i];
+        memcpy(pixel, &value, sizeof(value));
+    }
+}
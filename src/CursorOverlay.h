@@ -0,0 +1,50 @@
+#pragma once
+#include "ImageView.h"
+#include "Utils.h"
+#include <vector>
+
+// 鼠标指针合成（CpuBGRAToYUY2Converter::CompositeCursor、BGRAToYUY2Converter::SetCursorShape使用）
+// 桌面复制得到的图像不含指针，指针形状和位置单独提供（IDXGIOutputDuplication::GetFramePointerShape）。
+// 三种形状先归一化为CursorImage，每个像素只剩两种操作之一：
+//   按alpha混合：dst = (src * a + dst * (255 - a) + 127) / 255（彩色指针）
+//   掩码异或：dst = (dst & Mask) ^ Color（带掩码的彩色指针、单色指针，只作用于BGR，反色光标即Mask为全1、Color为白色）
+// 转换时只重新生成指针覆盖的像素对，不产生整帧的叠加遍。
+
+// 与DXGI_OUTDUPL_POINTER_SHAPE_TYPE的取值相同
+enum class CursorShapeType
+{
+    Monochrome = 1,     // 每像素1位：前Height / 2行为AND掩码，后Height / 2行为XOR掩码
+    Color = 2,          // 每像素32位BGRA，按alpha混合
+    MaskedColor = 4     // 每像素32位BGRA，alpha为0时替换为BGR，为0xFF时与BGR异或
+};
+
+// 指针形状的原始数据，布局与DXGI_OUTDUPL_POINTER_SHAPE_INFO相同（Monochrome时Height为两个掩码的总行数）
+struct CursorShapeView
+{
+    CursorShapeType Type;
+    UINT Width;
+    UINT Height;
+    UINT Pitch;
+    const BYTE* Data;
+};
+
+// 归一化后的指针图像，像素为0xAARRGGBB（与BGRA内存布局的小端32位值相同）
+struct CursorImage
+{
+    UINT Width = 0;
+    UINT Height = 0;
+    bool AlphaBlend = false;        // true：Colors按alpha混合；false：dst = (dst & Masks) ^ Colors
+    std::vector<UINT> Colors;
+    std::vector<UINT> Masks;        // AlphaBlend为true时为空
+};
+
+// 归一化指针形状，image的缓冲区被复用
+HRESULT BuildCursorImage(const CursorShapeView& shape, CursorImage& image);
+
+// 左上角位于(x, y)的指针在width x height的图像中覆盖的区域（x、y可以为负，指针部分在图像外），
+// 不在图像内时返回空矩形
+ImageRect GetCursorRect(const CursorImage& image, int x, int y, UINT width, UINT height);
+
+// 在一行BGRA像素上合成指针第cursorRow行的第firstColumn .. firstColumn + count - 1列，
+// bgraRow指向与第firstColumn列重叠的像素
+void CompositeCursorRow(const CursorImage& image, UINT cursorRow, UINT firstColumn, UINT count, BYTE* bgraRow);
@@ -1,5 +1,7 @@
 #include "DXGICapture.h"
-#include <dxgi1_2.h>
+#include <algorithm>
+#include <d3d10.h>
+#include <dxgi1_5.h>
 
 DXGICapture::DXGICapture()
     : m_device(nullptr)
@@ -8,7 +10,15 @@ DXGICapture::DXGICapture()
     , m_stagingTexture(nullptr)
     , m_outputWidth(0)
     , m_outputHeight(0)
+    , m_rotation(DXGI_MODE_ROTATION_IDENTITY)
+    , m_format(DXGI_FORMAT_B8G8R8A8_UNORM)
+    , m_allowHDRFormats(false)
     , m_initialized(false)
+    , m_dirtyRectsValid(false)
+    , m_metadataContinuous(false)
+    , m_cursorX(0)
+    , m_cursorY(0)
+    , m_cursorVisible(false)
 {
 }
 
@@ -17,8 +27,9 @@ DXGICapture::~DXGICapture()
     Cleanup();
 }
 
-HRESULT DXGICapture::Initialize()
+HRESULT DXGICapture::Initialize(bool allowHDRFormats)
 {
+    m_allowHDRFormats = allowHDRFormats;
     try
     {
         ThrowIfFailed(CreateD3DDevice(), "Failed to create D3D device");
@@ -79,8 +90,18 @@ HRESULT DXGICapture::CreateD3DDevice()
             &m_context
         );
     }
+    if (FAILED(hr))
+        return hr;
 
-    return hr;
+    // 流水线中采集和转换在不同线程上使用同一个即时上下文，开启多线程保护串行化上下文调用
+    ID3D10Multithread* multithread = nullptr;
+    if (SUCCEEDED(m_device->QueryInterface(__uuidof(ID3D10Multithread), (void**)&multithread)))
+    {
+        multithread->SetMultithreadProtected(TRUE);
+        multithread->Release();
+    }
+
+    return S_OK;
 }
 
 HRESULT DXGICapture::SetupDuplication()
@@ -102,21 +123,45 @@ HRESULT DXGICapture::SetupDuplication()
     adapter->Release();
     if (FAILED(hr)) return hr;
 
-    // 获取输出描述
-    DXGI_OUTPUT_DESC outputDesc;
-    output->GetDesc(&outputDesc);
-    m_outputWidth = outputDesc.DesktopCoordinates.right - outputDesc.DesktopCoordinates.left;
-    m_outputHeight = outputDesc.DesktopCoordinates.bottom - outputDesc.DesktopCoordinates.top;
+    // 开启HDR格式时按优先顺序列出支持的格式，系统选择与桌面格式一致的一种（SDR桌面仍为BGRA）
+    bool duplicateOutput1 = false;
+    if (m_allowHDRFormats)
+    {
+        IDXGIOutput5* output5 = nullptr;
+        if (SUCCEEDED(output->QueryInterface(__uuidof(IDXGIOutput5), (void**)&output5)))
+        {
+            const DXGI_FORMAT formats[] = {
+                DXGI_FORMAT_R16G16B16A16_FLOAT,
+                DXGI_FORMAT_R10G10B10A2_UNORM,
+                DXGI_FORMAT_B8G8R8A8_UNORM,
+            };
+            hr = output5->DuplicateOutput1(m_device, 0, ARRAYSIZE(formats), formats, &m_duplication);
+            output5->Release();
+            duplicateOutput1 = SUCCEEDED(hr);
+            if (!duplicateOutput1)
+            {
+                LogMessage("DuplicateOutput1 failed, falling back to BGRA capture. HRESULT: 0x" + std::to_string(hr));
+            }
+        }
+        else
+        {
+            LogMessage("IDXGIOutput5 is not available, falling back to BGRA capture");
+        }
+    }
 
-    // 获取输出1接口
-    IDXGIOutput1* output1 = nullptr;
-    hr = output->QueryInterface(__uuidof(IDXGIOutput1), (void**)&output1);
+    if (!duplicateOutput1)
+    {
+        // 获取输出1接口
+        IDXGIOutput1* output1 = nullptr;
+        hr = output->QueryInterface(__uuidof(IDXGIOutput1), (void**)&output1);
+        if (SUCCEEDED(hr))
+        {
+            // 创建桌面复制
+            hr = output1->DuplicateOutput(m_device, &m_duplication);
+            output1->Release();
+        }
+    }
     output->Release();
-    if (FAILED(hr)) return hr;
-
-    // 创建桌面复制
-    hr = output1->DuplicateOutput(m_device, &m_duplication);
-    output1->Release();
     if (FAILED(hr)) 
     {
         LogError("Failed to create desktop duplication. HRESULT: 0x" + std::to_string(hr));
@@ -135,8 +180,26 @@ HRESULT DXGICapture::SetupDuplication()
         return hr;
     }
     
+    // 旋转的显示器上DesktopCoordinates是旋转后的尺寸，而复制得到的图像保持未旋转的方向，
+    // staging纹理按复制图像的实际尺寸（ModeDesc）创建
+    DXGI_OUTDUPL_DESC duplicationDesc;
+    m_duplication->GetDesc(&duplicationDesc);
+    m_outputWidth = duplicationDesc.ModeDesc.Width;
+    m_outputHeight = duplicationDesc.ModeDesc.Height;
+    m_rotation = duplicationDesc.Rotation;
+
+    // DuplicateOutput总是返回BGRA；DuplicateOutput1返回的格式见ModeDesc，不是HDR格式的都按BGRA处理
+    m_format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    if (duplicateOutput1 && (duplicationDesc.ModeDesc.Format == DXGI_FORMAT_R16G16B16A16_FLOAT ||
+                             duplicationDesc.ModeDesc.Format == DXGI_FORMAT_R10G10B10A2_UNORM))
+    {
+        m_format = duplicationDesc.ModeDesc.Format;
+    }
+
     LogMessage("Desktop duplication created successfully. Resolution: " + 
-              std::to_string(m_outputWidth) + "x" + std::to_string(m_outputHeight));
+              std::to_string(m_outputWidth) + "x" + std::to_string(m_outputHeight) +
+              ", rotation: " + std::to_string(static_cast<int>(m_rotation)) +
+              ", format: " + std::to_string(static_cast<int>(m_format)));
 
     // 创建staging纹理用于CPU访问
     D3D11_TEXTURE2D_DESC desc = {};
@@ -144,7 +207,7 @@ HRESULT DXGICapture::SetupDuplication()
     desc.Height = m_outputHeight;
     desc.MipLevels = 1;
     desc.ArraySize = 1;
-    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    desc.Format = m_format;
     desc.SampleDesc.Count = 1;
     desc.SampleDesc.Quality = 0;
     desc.Usage = D3D11_USAGE_STAGING;
@@ -159,13 +222,175 @@ HRESULT DXGICapture::SetupDuplication()
     return hr;
 }
 
-HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UINT& height)
+bool DXGICapture::GetHDRInputFormat(HDRInputFormat& format) const
+{
+    switch (m_format)
+    {
+    case DXGI_FORMAT_R16G16B16A16_FLOAT: format = HDRInputFormat::R16G16B16A16Float; return true;
+    case DXGI_FORMAT_R10G10B10A2_UNORM:  format = HDRInputFormat::R10G10B10A2; return true;
+    default:                             return false;
+    }
+}
+
+ImageOrientation DXGICapture::GetOrientation() const
+{
+    // DXGI_MODE_ROTATION为显示器相对桌面的顺时针旋转，把采集图像恢复为用户看到的画面需要反方向旋转
+    switch (m_rotation)
+    {
+    case DXGI_MODE_ROTATION_ROTATE90:  return MakeImageOrientation(ImageRotation::Rotate270);
+    case DXGI_MODE_ROTATION_ROTATE180: return MakeImageOrientation(ImageRotation::Rotate180);
+    case DXGI_MODE_ROTATION_ROTATE270: return MakeImageOrientation(ImageRotation::Rotate90);
+    default:                           return MakeImageOrientation(ImageRotation::None);
+    }
+}
+
+void DXGICapture::ReadPointer(const DXGI_OUTDUPL_FRAME_INFO& frameInfo)
+{
+    // LastMouseUpdateTime为0表示指针的位置和可见性都没有变化
+    if (frameInfo.LastMouseUpdateTime.QuadPart != 0)
+    {
+        m_cursorVisible = frameInfo.PointerPosition.Visible != FALSE;
+        m_cursorX = frameInfo.PointerPosition.Position.x;
+        m_cursorY = frameInfo.PointerPosition.Position.y;
+    }
+
+    // 形状只在变化时提供
+    if (frameInfo.PointerShapeBufferSize == 0)
+        return;
+
+    try
+    {
+        if (m_pointerShapeBuffer.size() < frameInfo.PointerShapeBufferSize)
+        {
+            m_pointerShapeBuffer.resize(frameInfo.PointerShapeBufferSize);
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate pointer shape buffer");
+        return;
+    }
+
+    DXGI_OUTDUPL_POINTER_SHAPE_INFO shapeInfo = {};
+    UINT requiredSize = 0;
+    HRESULT hr = m_duplication->GetFramePointerShape((UINT)m_pointerShapeBuffer.size(), m_pointerShapeBuffer.data(),
+                                                     &requiredSize, &shapeInfo);
+    if (FAILED(hr))
+    {
+        LogError("Failed to get pointer shape. HRESULT: 0x" + std::to_string(hr));
+        return;
+    }
+
+    // 新形状放在新的对象中，流水线中还在使用旧形状的帧不受影响
+    CursorShapeView shape;
+    shape.Type = static_cast<CursorShapeType>(shapeInfo.Type);
+    shape.Width = shapeInfo.Width;
+    shape.Height = shapeInfo.Height;
+    shape.Pitch = shapeInfo.Pitch;
+    shape.Data = m_pointerShapeBuffer.data();
+    std::shared_ptr<CursorImage> cursor = std::make_shared<CursorImage>();
+    if (SUCCEEDED(BuildCursorImage(shape, *cursor)))
+    {
+        m_cursor = cursor;
+    }
+}
+
+bool DXGICapture::GetCursor(std::shared_ptr<const CursorImage>& cursor, int& x, int& y) const
+{
+    if (!m_cursorVisible || !m_cursor)
+        return false;
+    cursor = m_cursor;
+    x = m_cursorX;
+    y = m_cursorY;
+    return true;
+}
+
+void DXGICapture::ReadFrameMetadata(const DXGI_OUTDUPL_FRAME_INFO& frameInfo)
+{
+    m_dirtyRects.clear();
+    m_moves.clear();
+    m_dirtyRectsValid = false;
+
+    if (frameInfo.TotalMetadataBufferSize == 0)
+    {
+        // 只有鼠标更新时桌面图像不变；否则没有元数据可用，按整帧变化处理
+        m_dirtyRectsValid = frameInfo.LastPresentTime.QuadPart == 0;
+        return;
+    }
+
+    try
+    {
+        if (m_metadataBuffer.size() < frameInfo.TotalMetadataBufferSize)
+        {
+            m_metadataBuffer.resize(frameInfo.TotalMetadataBufferSize);
+        }
+
+        // 移动矩形：目标区域的内容来自上一帧的源区域（滚动、拖动窗口），由转换阶段在已转换的输出上搬移
+        UINT bufferSize = 0;
+        HRESULT hr = m_duplication->GetFrameMoveRects((UINT)m_metadataBuffer.size(),
+            reinterpret_cast<DXGI_OUTDUPL_MOVE_RECT*>(m_metadataBuffer.data()), &bufferSize);
+        if (FAILED(hr))
+            return;
+
+        UINT moveCount = bufferSize / sizeof(DXGI_OUTDUPL_MOVE_RECT);
+        const DXGI_OUTDUPL_MOVE_RECT* moveRects = reinterpret_cast<const DXGI_OUTDUPL_MOVE_RECT*>(m_metadataBuffer.data());
+        for (UINT i = 0; i < moveCount; i++)
+        {
+            const RECT& rect = moveRects[i].DestinationRect;
+            const POINT& source = moveRects[i].SourcePoint;
+            if (rect.left < 0 || rect.top < 0 || source.x < 0 || source.y < 0)
+            {
+                // 超出桌面的移动不会出现，保险起见按目标区域变脏处理
+                m_dirtyRects.push_back(MakeImageRect((UINT)(std::max)(rect.left, 0L), (UINT)(std::max)(rect.top, 0L),
+                                                     (UINT)(std::max)(rect.right, 0L), (UINT)(std::max)(rect.bottom, 0L)));
+                continue;
+            }
+            m_moves.push_back(MakeImageMove(MakeImageRect((UINT)rect.left, (UINT)rect.top, (UINT)rect.right, (UINT)rect.bottom),
+                                            (UINT)source.x, (UINT)source.y));
+        }
+
+        hr = m_duplication->GetFrameDirtyRects((UINT)m_metadataBuffer.size(),
+            reinterpret_cast<RECT*>(m_metadataBuffer.data()), &bufferSize);
+        if (FAILED(hr))
+            return;
+
+        UINT dirtyCount = bufferSize / sizeof(RECT);
+        const RECT* dirtyRects = reinterpret_cast<const RECT*>(m_metadataBuffer.data());
+        for (UINT i = 0; i < dirtyCount; i++)
+        {
+            const RECT& rect = dirtyRects[i];
+            m_dirtyRects.push_back(MakeImageRect((UINT)(std::max)(rect.left, 0L), (UINT)(std::max)(rect.top, 0L),
+                                                 (UINT)(std::max)(rect.right, 0L), (UINT)(std::max)(rect.bottom, 0L)));
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        LogError("Failed to allocate frame metadata buffer");
+        m_dirtyRects.clear();
+        m_moves.clear();
+        return;
+    }
+
+    m_dirtyRectsValid = true;
+}
+
+bool DXGICapture::GetDirtyRects(const ImageMove*& moves, UINT& moveCount, const ImageRect*& rects, UINT& rectCount) const
+{
+    moves = m_moves.data();
+    moveCount = m_dirtyRectsValid ? (UINT)m_moves.size() : 0;
+    rects = m_dirtyRects.data();
+    rectCount = m_dirtyRectsValid ? (UINT)m_dirtyRects.size() : 0;
+    return m_dirtyRectsValid;
+}
+
+HRESULT DXGICapture::CaptureFrame(FramePool& framePool, FrameHandle& outFrame, UINT& width, UINT& height)
 {
     if (!m_initialized || !m_duplication)
         return E_FAIL;
 
     IDXGIResource* desktopResource = nullptr;
     DXGI_OUTDUPL_FRAME_INFO frameInfo;
+    m_dirtyRectsValid = false;
 
     // 获取下一帧
     HRESULT hr = m_duplication->AcquireNextFrame(1000, &frameInfo, &desktopResource);
@@ -182,7 +407,7 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
         {
             LogError("Desktop duplication access lost. Trying to reinitialize...");
             Cleanup();
-            if (SUCCEEDED(Initialize()))
+            if (SUCCEEDED(Initialize(m_allowHDRFormats)))
             {
                 LogMessage("Desktop duplication reinitialized successfully");
                 return DXGI_ERROR_WAIT_TIMEOUT; // 返回超时，让调用者重试
@@ -193,6 +418,17 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
     
     // 帧信息已移除以减少日志噪音
 
+    // 超时时DXGI会把脏矩形累积到下一帧；获取到帧之后如果本次采集失败，这一帧的元数据就丢失了，
+    // 下一帧不能只依赖脏矩形
+    bool metadataContinuous = m_metadataContinuous;
+    m_metadataContinuous = false;
+    ReadFrameMetadata(frameInfo);
+    ReadPointer(frameInfo);
+    if (!metadataContinuous)
+    {
+        m_dirtyRectsValid = false;
+    }
+
     // 查询纹理接口
     ID3D11Texture2D* acquiredTexture = nullptr;
     hr = desktopResource->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&acquiredTexture);
@@ -213,11 +449,14 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
     desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
     desc.CPUAccessFlags = 0;
     
-    // 强制使用BGRA格式，确保与转换器兼容
-    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    // 未开启HDR格式时强制使用BGRA格式，确保与转换器兼容；
+    // HDR格式保留采集格式（由CpuHDRToYUV10Converter转换），不截断为8位
+    desc.Format = m_format;
 
-    ID3D11Texture2D* outputTexture = nullptr;
-    hr = m_device->CreateTexture2D(&desc, nullptr, &outputTexture);
+    // 输出纹理和下面的各个staging/中间纹理都从帧池借用，稳定后不再每帧创建
+    FrameHandle outputFrame;
+    hr = framePool.AcquireTexture(desc, outputFrame);
+    ID3D11Texture2D* outputTexture = outputFrame.GetTexture();
     
     if (SUCCEEDED(hr))
     {
@@ -236,8 +475,9 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
         stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
         stagingDesc.MiscFlags = 0;
         
-        ID3D11Texture2D* tempStagingTexture = nullptr;
-        HRESULT stagingResult = m_device->CreateTexture2D(&stagingDesc, nullptr, &tempStagingTexture);
+        FrameHandle tempStagingFrame;
+        HRESULT stagingResult = framePool.AcquireTexture(stagingDesc, tempStagingFrame);
+        ID3D11Texture2D* tempStagingTexture = tempStagingFrame.GetTexture();
         // Staging texture creation log removed
         
         if (SUCCEEDED(stagingResult))
@@ -283,9 +523,11 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
                     intermediateDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
                     intermediateDesc.CPUAccessFlags = 0;
                     
-                    ID3D11Texture2D* intermediateTexture = nullptr;
-                    if (SUCCEEDED(m_device->CreateTexture2D(&intermediateDesc, nullptr, &intermediateTexture)))
+                    FrameHandle intermediateFrame;
+                    if (SUCCEEDED(framePool.AcquireTexture(intermediateDesc, intermediateFrame)))
                     {
+                        ID3D11Texture2D* intermediateTexture = intermediateFrame.GetTexture();
+
                         // 从staging复制到中间纹理
                         m_context->CopyResource(intermediateTexture, tempStagingTexture);
                         m_context->Flush();
@@ -293,9 +535,10 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
                         // 验证中间纹理是否有数据
                         int verifyNonZero = 0;
                         D3D11_TEXTURE2D_DESC verifyDesc = stagingDesc;
-                        ID3D11Texture2D* verifyTexture = nullptr;
-                        if (SUCCEEDED(m_device->CreateTexture2D(&verifyDesc, nullptr, &verifyTexture)))
+                        FrameHandle verifyFrame;
+                        if (SUCCEEDED(framePool.AcquireTexture(verifyDesc, verifyFrame)))
                         {
+                            ID3D11Texture2D* verifyTexture = verifyFrame.GetTexture();
                             m_context->CopyResource(verifyTexture, intermediateTexture);
                             m_context->Flush();
                             
@@ -314,7 +557,6 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
                                 // 中间纹理验证已移除
                                 m_context->Unmap(verifyTexture, 0);
                             }
-                            verifyTexture->Release();
                         }
                         
                         // 再从中间纹理复制到输出纹理
@@ -323,9 +565,10 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
                         
                         // 检查最终输出纹理
                         D3D11_TEXTURE2D_DESC finalVerifyDesc = stagingDesc;
-                        ID3D11Texture2D* finalVerifyTexture = nullptr;
-                        if (SUCCEEDED(m_device->CreateTexture2D(&finalVerifyDesc, nullptr, &finalVerifyTexture)))
+                        FrameHandle finalVerifyFrame;
+                        if (SUCCEEDED(framePool.AcquireTexture(finalVerifyDesc, finalVerifyFrame)))
                         {
+                            ID3D11Texture2D* finalVerifyTexture = finalVerifyFrame.GetTexture();
                             m_context->CopyResource(finalVerifyTexture, outputTexture);
                             m_context->Flush();
                             
@@ -347,18 +590,11 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
                                 if (finalNonZero == 0 && verifyNonZero > 0)
                                 {
                                     LogMessage("[BGRA] Texture replacement applied for AMD GPU");
-                                    outputTexture->Release();
+                                    outputFrame = intermediateFrame;
                                     outputTexture = intermediateTexture;
-                                    intermediateTexture->AddRef();
-                                    
-                                    *outTexture = outputTexture;
-                                    outputTexture->AddRef();
                                 }
                             }
-                            finalVerifyTexture->Release();
                         }
-                        
-                        intermediateTexture->Release();
                     }
                     else
                     {
@@ -402,14 +638,14 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
                             retryIntermediateDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
                             retryIntermediateDesc.CPUAccessFlags = 0;
                             
-                            ID3D11Texture2D* retryIntermediateTexture = nullptr;
-                            if (SUCCEEDED(m_device->CreateTexture2D(&retryIntermediateDesc, nullptr, &retryIntermediateTexture)))
+                            FrameHandle retryIntermediateFrame;
+                            if (SUCCEEDED(framePool.AcquireTexture(retryIntermediateDesc, retryIntermediateFrame)))
                             {
+                                ID3D11Texture2D* retryIntermediateTexture = retryIntermediateFrame.GetTexture();
                                 m_context->CopyResource(retryIntermediateTexture, tempStagingTexture);
                                 m_context->Flush();
                                 m_context->CopyResource(outputTexture, retryIntermediateTexture);
                                 m_context->Flush();
-                                retryIntermediateTexture->Release();
                                 LogMessage("AMD GPU workaround: Retry successful (via intermediate)!");
                             }
                             else
@@ -437,8 +673,6 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
                 m_context->CopyResource(outputTexture, acquiredTexture);
                 LogMessage("AMD GPU: Map failed, using direct copy");
             }
-            
-            tempStagingTexture->Release();
         }
         else
         {
@@ -461,8 +695,9 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
             originalStagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
             originalStagingDesc.MiscFlags = 0;
             
-            ID3D11Texture2D* originalStagingTexture = nullptr;
-            HRESULT originalStagingResult = m_device->CreateTexture2D(&originalStagingDesc, nullptr, &originalStagingTexture);
+            FrameHandle originalStagingFrame;
+            HRESULT originalStagingResult = framePool.AcquireTexture(originalStagingDesc, originalStagingFrame);
+            ID3D11Texture2D* originalStagingTexture = originalStagingFrame.GetTexture();
             LogMessage("Creating original format staging texture result: 0x" + std::to_string(originalStagingResult));
             
             if (SUCCEEDED(originalStagingResult))
@@ -507,8 +742,6 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
                     m_context->CopyResource(outputTexture, acquiredTexture);
                     LogMessage("AMD GPU: Original format staging map failed, using direct copy");
                 }
-                
-                originalStagingTexture->Release();
             }
             else
             {
@@ -521,9 +754,14 @@ HRESULT DXGICapture::CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UIN
         // 强制刷新GPU命令
         m_context->Flush();
         
-        *outTexture = outputTexture;
+        outFrame = outputFrame;
         width = desc.Width;
         height = desc.Height;
+        m_metadataContinuous = true;
+    }
+    else
+    {
+        m_dirtyRectsValid = false;
     }
 
     acquiredTexture->Release();
@@ -538,5 +776,11 @@ void DXGICapture::Cleanup()
     SAFE_RELEASE(m_duplication);
     SAFE_RELEASE(m_context);
     SAFE_RELEASE(m_device);
+    m_dirtyRects.clear();
+    m_moves.clear();
+    m_dirtyRectsValid = false;
+    m_metadataContinuous = false;
+    m_cursor.reset();
+    m_cursorVisible = false;
     m_initialized = false;
 }
\ No newline at end of file
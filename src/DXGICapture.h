@@ -1,7 +1,12 @@
 #pragma once
+#include "CursorOverlay.h"
+#include "FramePool.h"
+#include "HDRToYUV10Kernels.h"
+#include "ImageView.h"
 #include "Utils.h"
 #include <dxgi1_2.h>
 #include <memory>
+#include <vector>
 
 class DXGICapture
 {
@@ -9,16 +14,42 @@ public:
     DXGICapture();
     ~DXGICapture();
 
-    HRESULT Initialize();
-    HRESULT CaptureFrame(ID3D11Texture2D** outTexture, UINT& width, UINT& height);
+    // allowHDRFormats为true时通过IDXGIOutput5::DuplicateOutput1按显示器的实际格式采集：
+    // HDR桌面得到R16G16B16A16_FLOAT（scRGB）或R10G10B10A2_UNORM，不再由系统转换为8位BGRA；
+    // 系统不支持DuplicateOutput1时回退到BGRA。默认false，GPU转换器只接受BGRA
+    HRESULT Initialize(bool allowHDRFormats = false);
+    // 输出纹理及内部使用的临时纹理从framePool借用，outFrame.GetTexture()为采集结果
+    HRESULT CaptureFrame(FramePool& framePool, FrameHandle& outFrame, UINT& width, UINT& height);
     void Cleanup();
 
+    // 最近一次CaptureFrame成功返回的帧相对上一次返回的帧的移动和脏矩形（来自DXGI_OUTDUPL_FRAME_INFO的元数据，
+    // 先执行移动再更新脏矩形），在下一次CaptureFrame之前有效。
+    // 返回false表示没有可用的元数据（第一帧、重新初始化之后、上一帧采集失败），整帧都可能变化
+    bool GetDirtyRects(const ImageMove*& moves, UINT& moveCount, const ImageRect*& rects, UINT& rectCount) const;
+    // 采集到的桌面图像是显示器未旋转时的方向（DXGI_OUTDUPL_DESC::Rotation不为IDENTITY时与用户看到的画面不同），
+    // 返回把采集图像变换成用户看到的画面所需的方向，转换时直接按此旋转（见GetOrientedSize）。
+    // CaptureFrame返回的尺寸、GetDirtyRects的坐标都是采集图像中的
+    ImageOrientation GetOrientation() const;
+    // 最近一次CaptureFrame之后的鼠标指针（桌面复制的图像不含指针）：形状只在变化时重新读取并归一化，
+    // 之前返回的形状对象保持不变；(x, y)为形状左上角在采集图像中的位置。
+    // 指针不可见或还没有收到形状时返回false
+    bool GetCursor(std::shared_ptr<const CursorImage>& cursor, int& x, int& y) const;
+
+    // CaptureFrame返回的纹理格式：未开启HDR格式时总是B8G8R8A8_UNORM
+    DXGI_FORMAT GetFormat() const { return m_format; }
+    // 采集格式为HDR格式时返回true，并给出CpuHDRToYUV10Converter的输入格式
+    bool GetHDRInputFormat(HDRInputFormat& format) const;
+
     ID3D11Device* GetDevice() const { return m_device; }
     ID3D11DeviceContext* GetContext() const { return m_context; }
 
 private:
     HRESULT CreateD3DDevice();
     HRESULT SetupDuplication();
+    // 从当前获取的帧中读取脏矩形和移动矩形，必须在ReleaseFrame之前调用
+    void ReadFrameMetadata(const DXGI_OUTDUPL_FRAME_INFO& frameInfo);
+    // 读取指针位置和（变化时的）形状，必须在ReleaseFrame之前调用
+    void ReadPointer(const DXGI_OUTDUPL_FRAME_INFO& frameInfo);
 
     ID3D11Device* m_device;
     ID3D11DeviceContext* m_context;
@@ -27,5 +58,20 @@ private:
     
     UINT m_outputWidth;
     UINT m_outputHeight;
+    DXGI_MODE_ROTATION m_rotation;
+    DXGI_FORMAT m_format;
+    bool m_allowHDRFormats;     // Cleanup后保留，访问丢失重新初始化时沿用
     bool m_initialized;
+
+    std::vector<BYTE> m_metadataBuffer;     // GetFrameDirtyRects/GetFrameMoveRects的缓冲区，只在不够时增长
+    std::vector<ImageRect> m_dirtyRects;
+    std::vector<ImageMove> m_moves;
+    bool m_dirtyRectsValid;
+    bool m_metadataContinuous;              // 上一次返回的帧之后没有丢失过元数据
+
+    std::vector<BYTE> m_pointerShapeBuffer; // GetFramePointerShape的缓冲区，只在不够时增长
+    std::shared_ptr<const CursorImage> m_cursor;
+    int m_cursorX;
+    int m_cursorY;
+    bool m_cursorVisible;
 };
\ No newline at end of file
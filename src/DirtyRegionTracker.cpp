@@ -0,0 +1,274 @@
+#include "DirtyRegionTracker.h"
+#include <algorithm>
+
+DirtyRegionTracker::DirtyRegionTracker()
+    : m_history()
+    , m_targets()
+    , m_width(0)
+    , m_height(0)
+    , m_latestFrame(0)
+    , m_historyStart(0)
+    , m_useCounter(0)
+    , m_hasFrames(false)
+{
+}
+
+HRESULT DirtyRegionTracker::Initialize(UINT width, UINT height)
+{
+    if (width == 0 || height == 0)
+        return E_INVALIDARG;
+
+    m_width = width;
+    m_height = height;
+    m_hasFrames = false;
+    Invalidate();
+    return S_OK;
+}
+
+void DirtyRegionTracker::AddRect(FrameDamage& damage, const ImageRect& rect)
+{
+    if (damage.RectCount < kMaxDirtyRectsPerFrame)
+    {
+        damage.Rects[damage.RectCount++] = rect;
+    }
+    else
+    {
+        // 矩形太多时并入最后一个矩形，结果是脏区域的超集，只会多转换
+        damage.Rects[kMaxDirtyRectsPerFrame - 1] = UnionImageRect(damage.Rects[kMaxDirtyRectsPerFrame - 1], rect);
+    }
+}
+
+bool DirtyRegionTracker::ClipMove(ImageMove& move) const
+{
+    // 目标相对源的偏移，目标区域同时受图像范围和“源区域在图像内”约束
+    long long dx = (long long)move.Destination.Left - move.SourceLeft;
+    long long dy = (long long)move.Destination.Top - move.SourceTop;
+
+    long long left = (std::max)((long long)move.Destination.Left, (std::max)(0LL, dx));
+    long long top = (std::max)((long long)move.Destination.Top, (std::max)(0LL, dy));
+    long long right = (std::min)((long long)move.Destination.Right, (std::min)((long long)m_width, m_width + dx));
+    long long bottom = (std::min)((long long)move.Destination.Bottom, (std::min)((long long)m_height, m_height + dy));
+    if (left >= right || top >= bottom)
+        return false;
+
+    move.Destination = MakeImageRect((UINT)left, (UINT)top, (UINT)right, (UINT)bottom);
+    move.SourceLeft = (UINT)(left - dx);
+    move.SourceTop = (UINT)(top - dy);
+    return true;
+}
+
+void DirtyRegionTracker::AddFrame(unsigned long long frameIndex, const ImageRect* rects, UINT rectCount,
+                                  const ImageMove* moves, UINT moveCount, bool fullFrame)
+{
+    if (!m_hasFrames || frameIndex != m_latestFrame + 1)
+    {
+        // 第一帧或者中间有帧丢失：之前保存的内容都无法只靠脏矩形更新
+        fullFrame = true;
+    }
+
+    m_latestFrame = frameIndex;
+    m_hasFrames = true;
+
+    FrameDamage& damage = m_history[frameIndex % kDirtyHistoryFrames];
+    damage.FrameIndex = frameIndex;
+    damage.RectCount = 0;
+    damage.MoveCount = 0;
+
+    if (fullFrame)
+    {
+        // 只有已经保存了这一帧的缓冲区（之后MarkUpdated）才能增量更新
+        m_historyStart = frameIndex + 1;
+        return;
+    }
+
+    for (UINT i = 0; i < moveCount; i++)
+    {
+        ImageMove move = moves[i];
+        if (!ClipMove(move))
+            continue;
+
+        if (damage.MoveCount < kMaxDirtyMovesPerFrame)
+        {
+            damage.Moves[damage.MoveCount++] = move;
+        }
+        else
+        {
+            AddRect(damage, move.Destination);
+        }
+    }
+
+    for (UINT i = 0; i < rectCount; i++)
+    {
+        ImageRect rect = rects[i];
+        if (ClipImageRect(rect, m_width, m_height))
+        {
+            AddRect(damage, rect);
+        }
+    }
+}
+
+const DirtyRegionTracker::TargetState* DirtyRegionTracker::FindTarget(const void* target) const
+{
+    for (UINT i = 0; i < kMaxDirtyTargets; i++)
+    {
+        if (m_targets[i].Target == target)
+            return &m_targets[i];
+    }
+    return nullptr;
+}
+
+namespace
+{
+    // 加入一个待转换的矩形，已被包含的矩形跳过；超出面积或数量上限时返回false
+    bool AddUpdateRect(std::vector<ImageRect>& rects, const ImageRect& rect,
+                       unsigned long long& area, unsigned long long areaLimit)
+    {
+        if (IsImageRectEmpty(rect))
+            return true;
+
+        // 连续多帧变化的同一区域（视频窗口等）只转换一次
+        for (const ImageRect& added : rects)
+        {
+            if (added.Left <= rect.Left && added.Top <= rect.Top &&
+                added.Right >= rect.Right && added.Bottom >= rect.Bottom)
+            {
+                return true;
+            }
+        }
+
+        area += GetImageRectArea(rect);
+        if (area > areaLimit || rects.size() >= kMaxDirtyUpdateRects)
+            return false;
+        rects.push_back(rect);
+        return true;
+    }
+}
+
+bool DirtyRegionTracker::GetUpdateRects(const void* target, std::vector<ImageMove>& outMoves,
+                                        std::vector<ImageRect>& outRects) const
+{
+    outMoves.clear();
+    outRects.clear();
+    if (!target || !m_hasFrames)
+        return false;
+
+    const TargetState* state = FindTarget(target);
+    if (!state || state->FrameIndex > m_latestFrame)
+        return false;
+
+    // 需要第FrameIndex+1帧到最新帧的变化，它们必须都还在历史中
+    unsigned long long firstFrame = state->FrameIndex + 1;
+    if (firstFrame < m_historyStart || m_latestFrame - state->FrameIndex > kDirtyHistoryFrames)
+        return false;
+
+    // 按帧顺序重放：outRects是输出中内容不可信、最后要从最新帧重新转换的区域，
+    // 其余区域在重放的每一步都与对应帧一致。
+    // 大面积变化时整帧转换更快（连续内存、没有逐矩形的开销）
+    unsigned long long area = 0;
+    unsigned long long limit = (unsigned long long)m_width * m_height / 2;
+    bool ok = true;
+    for (unsigned long long frame = firstFrame; ok && frame <= m_latestFrame; frame++)
+    {
+        const FrameDamage& damage = m_history[frame % kDirtyHistoryFrames];
+        for (UINT i = 0; ok && i < damage.MoveCount; i++)
+        {
+            const ImageMove& move = damage.Moves[i];
+            const ImageRect& dest = move.Destination;
+            ImageRect source = GetImageMoveSource(move);
+            long long dx = (long long)dest.Left - move.SourceLeft;
+            long long dy = (long long)dest.Top - move.SourceTop;
+
+            // 同一帧的移动都相对上一帧，源区域被本帧之前的移动覆盖时顺序搬移的结果不同；
+            // 奇数x偏移会拆开YUY2像素对。这两种情况都重新转换目标区域
+            bool convert = (dx & 1) != 0;
+            for (UINT j = 0; !convert && j < i; j++)
+            {
+                convert = !IsImageRectEmpty(IntersectImageRect(source, damage.Moves[j].Destination));
+            }
+
+            // 目标区域内完整的像素对可以整块搬移，左右边界上不完整的像素对重新转换
+            ImageRect inner = dest;
+            inner.Left = (inner.Left + 1) & ~1u;
+            inner.Right &= ~1u;
+            if (convert || inner.Left >= inner.Right)
+            {
+                ok = AddUpdateRect(outRects, dest, area, limit);
+                continue;
+            }
+
+            // 源区域中待转换的部分随移动带到目标区域
+            size_t staleCount = outRects.size();
+            for (size_t k = 0; ok && k < staleCount; k++)
+            {
+                ImageRect stale = IntersectImageRect(outRects[k], source);
+                if (IsImageRectEmpty(stale))
+                    continue;
+                ok = AddUpdateRect(outRects, MakeImageRect((UINT)(stale.Left + dx), (UINT)(stale.Top + dy),
+                                                           (UINT)(stale.Right + dx), (UINT)(stale.Bottom + dy)),
+                                   area, limit);
+            }
+            if (ok && dest.Left < inner.Left)
+                ok = AddUpdateRect(outRects, MakeImageRect(dest.Left, dest.Top, inner.Left, dest.Bottom), area, limit);
+            if (ok && inner.Right < dest.Right)
+                ok = AddUpdateRect(outRects, MakeImageRect(inner.Right, dest.Top, dest.Right, dest.Bottom), area, limit);
+
+            outMoves.push_back(MakeImageMove(inner, (UINT)(inner.Left - dx), move.SourceTop));
+        }
+
+        for (UINT i = 0; ok && i < damage.RectCount; i++)
+        {
+            ok = AddUpdateRect(outRects, damage.Rects[i], area, limit);
+        }
+    }
+
+    if (!ok)
+    {
+        outMoves.clear();
+        outRects.clear();
+        return false;
+    }
+    return true;
+}
+
+void DirtyRegionTracker::MarkUpdated(const void* target)
+{
+    if (!target || !m_hasFrames)
+        return;
+
+    // 已跟踪的缓冲区直接更新，否则替换最久未使用的槽位
+    TargetState* slot = const_cast<TargetState*>(FindTarget(target));
+    if (!slot)
+    {
+        slot = &m_targets[0];
+        for (UINT i = 1; i < kMaxDirtyTargets; i++)
+        {
+            if (m_targets[i].LastUse < slot->LastUse)
+                slot = &m_targets[i];
+        }
+    }
+
+    slot->Target = target;
+    slot->FrameIndex = m_latestFrame;
+    slot->LastUse = ++m_useCounter;
+}
+
+void DirtyRegionTracker::Invalidate()
+{
+    for (UINT i = 0; i < kMaxDirtyTargets; i++)
+    {
+        m_targets[i].Target = nullptr;
+        m_targets[i].FrameIndex = 0;
+        m_targets[i].LastUse = 0;
+    }
+    m_useCounter = 0;
+}
+
+void DirtyRegionTracker::Cleanup()
+{
+    Invalidate();
+    m_width = 0;
+    m_height = 0;
+    m_latestFrame = 0;
+    m_historyStart = 0;
+    m_hasFrames = false;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "ImageView.h"
+#include "Utils.h"
+#include <vector>
+
+// 增量转换的脏区域历史
+// 帧源报告每帧相对上一帧的脏矩形（DXGI的帧元数据、合成帧源等）。流水线中输出缓冲区来自帧池并轮换使用，
+// 同一个缓冲区上一次写入的可能是几帧之前的内容，因此不能只转换当前帧的脏矩形：
+// 这里记录最近若干帧的脏矩形以及每个输出缓冲区保存的是哪一帧，
+// 把缓冲区更新到最新帧时转换这期间所有帧的脏矩形（即缓冲区“年龄”内的损坏区域）。
+// 移动矩形（滚动、拖动窗口）按帧顺序直接在已转换的输出上搬移，只有新露出的区域需要重新转换。
+// 只在转换线程上使用，不需要加锁。
+
+const UINT kDirtyHistoryFrames = 8;         // 保留的历史帧数，更旧的缓冲区整帧转换
+const UINT kMaxDirtyRectsPerFrame = 64;     // 每帧保存的矩形数，超出时合并为外接矩形
+const UINT kMaxDirtyMovesPerFrame = 16;     // 每帧保存的移动数，超出的移动按目标区域变脏处理
+const UINT kMaxDirtyUpdateRects = 1024;     // 一次更新最多转换的矩形数，超出时整帧转换
+const UINT kMaxDirtyTargets = 8;            // 跟踪的输出缓冲区数量（帧池中同时存在的输出）
+
+class DirtyRegionTracker
+{
+public:
+    DirtyRegionTracker();
+
+    HRESULT Initialize(UINT width, UINT height);
+    // 记录第frameIndex帧相对上一帧的变化：先执行的移动和之后的脏矩形（与DXGI元数据的顺序相同）。
+    // fullFrame表示整帧可能都变化了（帧源不提供脏矩形）；
+    // 帧序号不连续（中间的帧被丢弃，它们的脏矩形丢失）时同样按整帧变化处理
+    void AddFrame(unsigned long long frameIndex, const ImageRect* rects, UINT rectCount,
+                  const ImageMove* moves, UINT moveCount, bool fullFrame);
+    // 计算把target（输出缓冲区）从它保存的帧更新到最新帧的操作：先按顺序在输出上执行outMoves
+    // （目标区域和源x都是偶数，可以按YUY2像素对整块搬移），再转换outRects。
+    // 移动到奇数x偏移、源区域含有待转换像素的部分都并入outRects。
+    // 返回false表示需要整帧转换：target内容未知、历史不足、或者需要转换的区域超过整帧的一半
+    bool GetUpdateRects(const void* target, std::vector<ImageMove>& outMoves, std::vector<ImageRect>& outRects) const;
+    // target已经更新到最新帧
+    void MarkUpdated(const void* target);
+    // 所有缓冲区的内容都视为未知（分辨率变化、帧池释放了缓冲区之后调用，
+    // 避免新分配的缓冲区恰好复用了旧地址）
+    void Invalidate();
+    void Cleanup();
+
+    UINT GetWidth() const { return m_width; }
+    UINT GetHeight() const { return m_height; }
+
+private:
+    struct FrameDamage
+    {
+        unsigned long long FrameIndex;
+        UINT RectCount;
+        UINT MoveCount;
+        ImageRect Rects[kMaxDirtyRectsPerFrame];
+        ImageMove Moves[kMaxDirtyMovesPerFrame];
+    };
+
+    struct TargetState
+    {
+        const void* Target;
+        unsigned long long FrameIndex;  // 缓冲区中保存的帧
+        unsigned long long LastUse;
+    };
+
+    const TargetState* FindTarget(const void* target) const;
+    static void AddRect(FrameDamage& damage, const ImageRect& rect);
+    // 裁剪移动使源和目标区域都在图像内，返回裁剪后是否非空
+    bool ClipMove(ImageMove& move) const;
+
+    FrameDamage m_history[kDirtyHistoryFrames];     // 按帧序号取模存放
+    TargetState m_targets[kMaxDirtyTargets];
+    UINT m_width;
+    UINT m_height;
+    unsigned long long m_latestFrame;
+    unsigned long long m_historyStart;  // 从这一帧开始（含）的脏矩形是连续已知的
+    unsigned long long m_useCounter;
+    bool m_hasFrames;
+};
@@ -0,0 +1,202 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+#if !defined(_WIN32) && defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+#if defined(_WIN32) && !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace
+{
+    const long long kNanosecondsPerSecond = 1000000000LL;
+
+    inline void SpinPause()
+    {
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+        _mm_pause();
+#endif
+    }
+}
+
+FramePacer::FramePacer()
+    : m_targetFrameRate(0.0)
+    , m_periodNanoseconds(0)
+    , m_spinNanoseconds(0)
+    , m_nextDeadline(0)
+    , m_initialized(false)
+    , m_frames(0)
+    , m_missedDeadlines(0)
+    , m_skippedPeriods(0)
+    , m_totalLateness(0)
+    , m_maxLateness(0)
+#ifdef _WIN32
+    , m_timer(nullptr)
+#endif
+{
+}
+
+FramePacer::~FramePacer()
+{
+    Cleanup();
+}
+
+long long FramePacer::GetMonotonicNanoseconds()
+{
+#if !defined(_WIN32) && defined(__linux__)
+    // 与clock_nanosleep使用同一个时钟
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<long long>(now.tv_sec) * kNanosecondsPerSecond + now.tv_nsec;
+#else
+    // Windows上steady_clock基于QueryPerformanceCounter
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+HRESULT FramePacer::Initialize(double targetFrameRate, UINT spinMicroseconds)
+{
+    if (!(targetFrameRate > 0.0) || targetFrameRate > 1000.0)
+        return E_INVALIDARG;
+
+    Cleanup();
+
+#ifdef _WIN32
+    m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!m_timer)
+    {
+        // 旧版本Windows不支持高精度定时器，自旋时间需要覆盖默认的定时器粒度
+        m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        if (!m_timer)
+        {
+            LogError("Failed to create frame pacing timer");
+            return E_FAIL;
+        }
+        LogMessage("High resolution timer unavailable, frame pacing falls back to a standard waitable timer");
+    }
+#endif
+
+    m_targetFrameRate = targetFrameRate;
+    m_periodNanoseconds = static_cast<long long>(kNanosecondsPerSecond / targetFrameRate + 0.5);
+    m_spinNanoseconds = (std::min)(static_cast<long long>(spinMicroseconds) * 1000, m_periodNanoseconds);
+    m_initialized = true;
+    Reset();
+    return S_OK;
+}
+
+void FramePacer::Reset()
+{
+    m_nextDeadline = 0;
+    m_frames.store(0);
+    m_missedDeadlines.store(0);
+    m_skippedPeriods.store(0);
+    m_totalLateness.store(0);
+    m_maxLateness.store(0);
+}
+
+HRESULT FramePacer::WaitForNextFrame()
+{
+    if (!m_initialized)
+        return E_FAIL;
+
+    long long now = GetMonotonicNanoseconds();
+    if (m_nextDeadline == 0)
+    {
+        // 第一帧立即开始，之后的期限都相对于这个起点
+        m_nextDeadline = now + m_periodNanoseconds;
+        return S_OK;
+    }
+
+    long long deadline = m_nextDeadline;
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+
+    if (now >= deadline)
+    {
+        // 上一帧超时：立即开始本帧，并跳过已经完整错过的周期，保持原有的节拍相位
+        long long periodsLate = (now - deadline) / m_periodNanoseconds;
+        m_missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+        m_skippedPeriods.fetch_add(static_cast<unsigned long long>(periodsLate), std::memory_order_relaxed);
+        m_nextDeadline = deadline + (periodsLate + 1) * m_periodNanoseconds;
+        return S_FALSE;
+    }
+
+    SleepUntil(deadline);
+
+    unsigned long long lateness = static_cast<unsigned long long>(
+        (std::max)(GetMonotonicNanoseconds() - deadline, 0LL) / 1000);
+    m_totalLateness.fetch_add(lateness, std::memory_order_relaxed);
+    if (lateness > m_maxLateness.load(std::memory_order_relaxed))
+        m_maxLateness.store(lateness, std::memory_order_relaxed);
+
+    m_nextDeadline = deadline + m_periodNanoseconds;
+    return S_OK;
+}
+
+void FramePacer::SleepUntil(long long deadline)
+{
+    long long wakeTime = deadline - m_spinNanoseconds;
+    long long now = GetMonotonicNanoseconds();
+
+    if (now < wakeTime)
+    {
+#if defined(_WIN32)
+        // 可等待定时器按100ns为单位，负值表示相对时间；剩余误差由下面的自旋吸收
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -((wakeTime - now) / 100);
+        if (SetWaitableTimer(m_timer, &dueTime, 0, nullptr, nullptr, FALSE))
+        {
+            WaitForSingleObject(m_timer, INFINITE);
+        }
+#elif defined(__linux__)
+        timespec wake;
+        wake.tv_sec = static_cast<time_t>(wakeTime / kNanosecondsPerSecond);
+        wake.tv_nsec = static_cast<long>(wakeTime % kNanosecondsPerSecond);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr) == EINTR)
+        {
+        }
+#else
+        std::this_thread::sleep_for(std::chrono::nanoseconds(wakeTime - now));
+#endif
+    }
+
+    while (GetMonotonicNanoseconds() < deadline)
+    {
+        SpinPause();
+    }
+}
+
+void FramePacer::Cleanup()
+{
+#ifdef _WIN32
+    if (m_timer)
+    {
+        CloseHandle(m_timer);
+        m_timer = nullptr;
+    }
+#endif
+    m_initialized = false;
+    m_targetFrameRate = 0.0;
+    m_periodNanoseconds = 0;
+    m_nextDeadline = 0;
+}
+
+FramePacerStats FramePacer::GetStats() const
+{
+    FramePacerStats stats;
+    stats.Frames = m_frames.load(std::memory_order_relaxed);
+    stats.MissedDeadlines = m_missedDeadlines.load(std::memory_order_relaxed);
+    stats.SkippedPeriods = m_skippedPeriods.load(std::memory_order_relaxed);
+    stats.TotalLatenessMicroseconds = m_totalLateness.load(std::memory_order_relaxed);
+    stats.MaxLatenessMicroseconds = m_maxLateness.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Utils.h"
+#include <atomic>
+
+// 基于绝对期限的帧节拍调度
+// 第k帧的期限为 起点 + k * 帧周期（单调时钟，纳秒），与每帧实际耗时无关，
+// 因此不会像"处理完再sleep固定时长"那样让实际帧率逐渐低于目标，也能达到120/144Hz。
+// 等待分两段：先用系统定时器睡到期限前spinMicroseconds，再自旋到期限，
+// 避免定时器唤醒延迟（Windows默认约1~15ms，Linux约50us）造成的抖动：
+//   Linux：   clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)，直接按绝对时间睡眠
+//   Windows： 高精度可等待定时器（Windows 10 1803+，不支持时退回普通定时器）
+// 调用时已经错过期限则立即返回S_FALSE并计入统计；落后超过一个周期时跳过错过的周期，
+// 不会连续突发多帧来"追赶"。
+// WaitForNextFrame只能由一个线程调用，GetStats可以在任意线程调用
+
+const UINT kDefaultPacerSpinMicroseconds = 300;
+
+struct FramePacerStats
+{
+    unsigned long long Frames;                  // 等待过的帧期限数
+    unsigned long long MissedDeadlines;         // 调用时已错过期限的次数
+    unsigned long long SkippedPeriods;          // 落后过多而跳过的帧周期数
+    unsigned long long TotalLatenessMicroseconds; // 按时等待的帧，唤醒时刻晚于期限的累计值
+    unsigned long long MaxLatenessMicroseconds;
+};
+
+class FramePacer
+{
+public:
+    FramePacer();
+    ~FramePacer();
+
+    // targetFrameRate为每秒帧数（可以是小数，如59.94）
+    HRESULT Initialize(double targetFrameRate, UINT spinMicroseconds = kDefaultPacerSpinMicroseconds);
+    // 重新开始计时：下一次WaitForNextFrame立即返回并作为新的起点
+    void Reset();
+    // S_OK：已等到本帧期限；S_FALSE：调用时已错过期限（立即返回）
+    HRESULT WaitForNextFrame();
+    void Cleanup();
+
+    bool IsInitialized() const { return m_initialized; }
+    double GetTargetFrameRate() const { return m_targetFrameRate; }
+    long long GetFramePeriodNanoseconds() const { return m_periodNanoseconds; }
+    FramePacerStats GetStats() const;
+
+    static long long GetMonotonicNanoseconds();
+
+private:
+    void SleepUntil(long long deadline);
+
+    double m_targetFrameRate;
+    long long m_periodNanoseconds;
+    long long m_spinNanoseconds;
+    long long m_nextDeadline;   // 0表示尚未开始
+    bool m_initialized;
+
+    std::atomic<unsigned long long> m_frames;
+    std::atomic<unsigned long long> m_missedDeadlines;
+    std::atomic<unsigned long long> m_skippedPeriods;
+    std::atomic<unsigned long long> m_totalLateness;
+    std::atomic<unsigned long long> m_maxLateness;
+
+#ifdef _WIN32
+    HANDLE m_timer;
+#endif
+};
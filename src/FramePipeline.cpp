@@ -0,0 +1,510 @@
+#include "FramePipeline.h"
+#include <new>
+#include <system_error>
+
+namespace
+{
+    // 等待的上限只作为兜底，正常情况下由相邻阶段的通知唤醒
+    const std::chrono::microseconds kStageWaitTimeout(10000);
+
+    void ReleaseFrame(PipelineFrame& frame)
+    {
+        frame.Source.Reset();
+        frame.Output.Reset();
+        frame.Orientation = MakeImageOrientation(ImageRotation::None);
+        frame.Cursor.reset();
+        frame.DirtyRectsValid = false;
+        frame.DirtyRectCount = 0;
+        frame.MoveCount = 0;
+    }
+
+    unsigned long long ElapsedMicroseconds(std::chrono::steady_clock::time_point start,
+                                           std::chrono::steady_clock::time_point end)
+    {
+        if (end <= start)
+            return 0;
+        return static_cast<unsigned long long>(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+}
+
+void AddPipelineDirtyRect(PipelineFrame& frame, const ImageRect& rect)
+{
+    if (IsImageRectEmpty(rect))
+        return;
+
+    if (frame.DirtyRectCount < kMaxPipelineDirtyRects)
+    {
+        frame.DirtyRects[frame.DirtyRectCount++] = rect;
+    }
+    else
+    {
+        // 超出容量时并入最后一个矩形，结果是脏区域的超集
+        frame.DirtyRects[kMaxPipelineDirtyRects - 1] = UnionImageRect(frame.DirtyRects[kMaxPipelineDirtyRects - 1], rect);
+    }
+}
+
+void AddPipelineMove(PipelineFrame& frame, const ImageMove& move)
+{
+    if (IsImageRectEmpty(move.Destination))
+        return;
+
+    if (frame.MoveCount < kMaxPipelineMoves)
+    {
+        frame.Moves[frame.MoveCount++] = move;
+    }
+    else
+    {
+        AddPipelineDirtyRect(frame, move.Destination);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// StageSignal
+// ---------------------------------------------------------------------------
+
+FramePipeline::StageSignal::StageSignal()
+    : m_signaled(false)
+    , m_waiters(0)
+{
+}
+
+void FramePipeline::StageSignal::Notify()
+{
+    // 先置位再检查等待者：等待者要么看到置位，要么已登记并会被唤醒
+    m_signaled.store(true);
+    if (m_waiters.load() != 0)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_condition.notify_one();
+    }
+}
+
+void FramePipeline::StageSignal::Wait(std::chrono::microseconds timeout)
+{
+    m_waiters.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait_for(lock, timeout, [this]() { return m_signaled.exchange(false); });
+    }
+    m_waiters.fetch_sub(1);
+}
+
+// ---------------------------------------------------------------------------
+// StageCounters
+// ---------------------------------------------------------------------------
+
+void FramePipeline::StageCounters::Record(std::chrono::steady_clock::time_point start,
+                                          std::chrono::steady_clock::time_point end,
+                                          std::chrono::steady_clock::time_point captureTime)
+{
+    Frames.fetch_add(1, std::memory_order_relaxed);
+    BusyMicroseconds.fetch_add(ElapsedMicroseconds(start, end), std::memory_order_relaxed);
+    LatencyMicroseconds.fetch_add(ElapsedMicroseconds(captureTime, end), std::memory_order_relaxed);
+}
+
+PipelineStageStats FramePipeline::StageCounters::Read() const
+{
+    PipelineStageStats stats;
+    stats.Frames = Frames.load(std::memory_order_relaxed);
+    stats.BusyMicroseconds = BusyMicroseconds.load(std::memory_order_relaxed);
+    stats.LatencyMicroseconds = LatencyMicroseconds.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+// FramePipeline
+// ---------------------------------------------------------------------------
+
+FramePipeline::FramePipeline()
+    : m_source(nullptr)
+    , m_converter(nullptr)
+    , m_droppedFrames(0)
+    , m_skippedFrames(0)
+    , m_running(false)
+    , m_stopping(false)
+    , m_sourceFinished(false)
+    , m_convertFinished(false)
+    , m_result(S_OK)
+    , m_initialized(false)
+{
+}
+
+FramePipeline::~FramePipeline()
+{
+    Cleanup();
+}
+
+HRESULT FramePipeline::Initialize(IFrameSource* source, IFrameConverter* converter,
+                                  IFrameSink* const* sinks, UINT sinkCount,
+                                  const FramePipelineOptions& options)
+{
+    if (!source || !converter || sinkCount > kMaxPipelineSinks || (sinkCount > 0 && !sinks) ||
+        options.QueueDepth == 0)
+    {
+        return E_INVALIDARG;
+    }
+    for (UINT i = 0; i < sinkCount; i++)
+    {
+        if (!sinks[i])
+            return E_INVALIDARG;
+    }
+
+    Cleanup();
+
+    HRESULT hr = m_convertQueue.Initialize(options.QueueDepth);
+    if (FAILED(hr))
+        return hr;
+
+    if (options.TargetFrameRate > 0.0)
+    {
+        hr = m_pacer.Initialize(options.TargetFrameRate);
+        if (FAILED(hr))
+            return hr;
+    }
+
+    try
+    {
+        for (UINT i = 0; i < sinkCount; i++)
+        {
+            std::unique_ptr<SinkStage> stage(new SinkStage());
+            stage->Sink = sinks[i];
+            hr = stage->Queue.Initialize(options.QueueDepth);
+            if (FAILED(hr))
+            {
+                m_sinks.clear();
+                return hr;
+            }
+            m_sinks.push_back(std::move(stage));
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        m_sinks.clear();
+        return E_OUTOFMEMORY;
+    }
+
+    m_source = source;
+    m_converter = converter;
+    m_options = options;
+    m_initialized = true;
+
+    LogMessage("Frame pipeline initialized: " + std::to_string(sinkCount) + " sinks, queue depth " +
+              std::to_string(m_convertQueue.GetCapacity()) +
+              (options.DropFramesWhenFull ? ", dropping frames when full" : "") +
+              (m_pacer.IsInitialized() ? ", paced at " + std::to_string(options.TargetFrameRate) + " fps" : ""));
+    return S_OK;
+}
+
+HRESULT FramePipeline::Start()
+{
+    if (!m_initialized)
+        return E_FAIL;
+    if (m_running.load())
+        return S_FALSE;
+
+    m_stopping.store(false);
+    m_sourceFinished.store(false);
+    m_convertFinished.store(false);
+    m_result.store(S_OK);
+    m_droppedFrames.store(0);
+    m_skippedFrames.store(0);
+    for (StageCounters* counters : { &m_sourceCounters, &m_convertCounters })
+    {
+        counters->Frames.store(0);
+        counters->BusyMicroseconds.store(0);
+        counters->LatencyMicroseconds.store(0);
+    }
+    for (auto& stage : m_sinks)
+    {
+        stage->Counters.Frames.store(0);
+        stage->Counters.BusyMicroseconds.store(0);
+        stage->Counters.LatencyMicroseconds.store(0);
+    }
+    m_pacer.Reset();
+
+    m_running.store(true);
+    try
+    {
+        // 先启动下游，帧源最后启动
+        for (auto& stage : m_sinks)
+        {
+            stage->Thread = std::thread(&FramePipeline::SinkMain, this, stage.get());
+        }
+        m_convertThread = std::thread(&FramePipeline::ConvertMain, this);
+        m_sourceThread = std::thread(&FramePipeline::SourceMain, this);
+    }
+    catch (const std::system_error&)
+    {
+        LogError("Failed to create frame pipeline threads");
+        Stop();
+        return E_FAIL;
+    }
+    return S_OK;
+}
+
+void FramePipeline::Stop()
+{
+    m_stopping.store(true);
+    m_convertDataSignal.Notify();
+    m_convertSpaceSignal.Notify();
+    m_sinkSpaceSignal.Notify();
+    for (auto& stage : m_sinks)
+    {
+        stage->DataSignal.Notify();
+    }
+    Join();
+}
+
+HRESULT FramePipeline::Wait()
+{
+    Join();
+    return m_result.load();
+}
+
+void FramePipeline::Join()
+{
+    if (m_sourceThread.joinable())
+        m_sourceThread.join();
+    if (m_convertThread.joinable())
+        m_convertThread.join();
+    for (auto& stage : m_sinks)
+    {
+        if (stage->Thread.joinable())
+            stage->Thread.join();
+    }
+
+    // 所有阶段线程已退出，丢弃停止时仍在队列中的帧，使其回到帧池
+    PipelineFrame frame;
+    while (m_convertQueue.TryPop(frame))
+    {
+        ReleaseFrame(frame);
+    }
+    for (auto& stage : m_sinks)
+    {
+        while (stage->Queue.TryPop(frame))
+        {
+            ReleaseFrame(frame);
+        }
+    }
+    m_running.store(false);
+}
+
+void FramePipeline::Cleanup()
+{
+    Stop();
+    m_sinks.clear();
+    m_pacer.Cleanup();
+    m_source = nullptr;
+    m_converter = nullptr;
+    m_initialized = false;
+}
+
+void FramePipeline::Fail(HRESULT hr, const char* stage)
+{
+    HRESULT expected = S_OK;
+    if (m_result.compare_exchange_strong(expected, hr))
+    {
+        LogError(std::string("Frame pipeline ") + stage + " stage failed, stopping pipeline");
+    }
+
+    m_stopping.store(true);
+    m_convertDataSignal.Notify();
+    m_convertSpaceSignal.Notify();
+    m_sinkSpaceSignal.Notify();
+    for (auto& sinkStage : m_sinks)
+    {
+        sinkStage->DataSignal.Notify();
+    }
+}
+
+bool FramePipeline::PushBlocking(SpscRingQueue<PipelineFrame>& queue, PipelineFrame& frame,
+                                 StageSignal& spaceSignal, StageSignal& dataSignal)
+{
+    while (!queue.TryPush(frame))
+    {
+        if (m_stopping.load())
+            return false;
+        spaceSignal.Wait(kStageWaitTimeout);
+    }
+    dataSignal.Notify();
+    return true;
+}
+
+void FramePipeline::SourceMain()
+{
+    PipelineFrame frame;
+    unsigned long long frameIndex = 0;
+
+    while (!m_stopping.load())
+    {
+        // 按绝对期限限速，期限之间的等待不计入帧源耗时
+        if (m_pacer.IsInitialized())
+        {
+            m_pacer.WaitForNextFrame();
+            if (m_stopping.load())
+                break;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        HRESULT hr = m_source->ReadFrame(frame);
+        if (hr == kPipelineEndOfStream)
+            break;
+        if (FAILED(hr))
+        {
+            Fail(hr, "source");
+            break;
+        }
+        if (hr == S_FALSE)
+        {
+            ReleaseFrame(frame);
+            continue;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        frame.FrameIndex = frameIndex++;
+        frame.CaptureTime = end;
+        m_sourceCounters.Record(start, end, end);
+
+        if (m_options.DropFramesWhenFull)
+        {
+            // 实时采集：转换跟不上时丢弃最新帧，而不是让延迟累积
+            if (m_convertQueue.TryPush(frame))
+            {
+                m_convertDataSignal.Notify();
+            }
+            else
+            {
+                m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else if (!PushBlocking(m_convertQueue, frame, m_convertSpaceSignal, m_convertDataSignal))
+        {
+            break;
+        }
+        ReleaseFrame(frame);
+    }
+
+    ReleaseFrame(frame);
+    m_sourceFinished.store(true, std::memory_order_release);
+    m_convertDataSignal.Notify();
+}
+
+void FramePipeline::ConvertMain()
+{
+    PipelineFrame frame;
+
+    while (!m_stopping.load())
+    {
+        if (!m_convertQueue.TryPop(frame))
+        {
+            // 帧源结束后再检查一次队列，保证结束前入队的帧都被处理
+            if (m_sourceFinished.load(std::memory_order_acquire))
+            {
+                if (!m_convertQueue.TryPop(frame))
+                    break;
+            }
+            else
+            {
+                m_convertDataSignal.Wait(kStageWaitTimeout);
+                continue;
+            }
+        }
+        m_convertSpaceSignal.Notify();
+
+        auto start = std::chrono::steady_clock::now();
+        HRESULT hr = m_converter->ConvertFrame(frame);
+        auto end = std::chrono::steady_clock::now();
+        if (FAILED(hr))
+        {
+            Fail(hr, "convert");
+            break;
+        }
+        if (hr == S_FALSE)
+        {
+            m_skippedFrames.fetch_add(1, std::memory_order_relaxed);
+            ReleaseFrame(frame);
+            continue;
+        }
+        m_convertCounters.Record(start, end, frame.CaptureTime);
+
+        // 每个输出得到一份帧副本（只复制句柄），最后一个输出直接移入
+        for (size_t i = 0; i < m_sinks.size(); i++)
+        {
+            SinkStage& stage = *m_sinks[i];
+            bool pushed;
+            if (i + 1 == m_sinks.size())
+            {
+                pushed = PushBlocking(stage.Queue, frame, m_sinkSpaceSignal, stage.DataSignal);
+            }
+            else
+            {
+                PipelineFrame sinkFrame = frame;
+                pushed = PushBlocking(stage.Queue, sinkFrame, m_sinkSpaceSignal, stage.DataSignal);
+                ReleaseFrame(sinkFrame);
+            }
+            if (!pushed)
+                break;
+        }
+        ReleaseFrame(frame);
+    }
+
+    ReleaseFrame(frame);
+    m_convertFinished.store(true, std::memory_order_release);
+    for (auto& stage : m_sinks)
+    {
+        stage->DataSignal.Notify();
+    }
+}
+
+void FramePipeline::SinkMain(SinkStage* stage)
+{
+    PipelineFrame frame;
+
+    while (!m_stopping.load())
+    {
+        if (!stage->Queue.TryPop(frame))
+        {
+            if (m_convertFinished.load(std::memory_order_acquire))
+            {
+                if (!stage->Queue.TryPop(frame))
+                    break;
+            }
+            else
+            {
+                stage->DataSignal.Wait(kStageWaitTimeout);
+                continue;
+            }
+        }
+        m_sinkSpaceSignal.Notify();
+
+        auto start = std::chrono::steady_clock::now();
+        HRESULT hr = stage->Sink->WriteFrame(frame);
+        auto end = std::chrono::steady_clock::now();
+        ReleaseFrame(frame);
+        if (FAILED(hr))
+        {
+            Fail(hr, "sink");
+            break;
+        }
+        stage->Counters.Record(start, end, frame.CaptureTime);
+    }
+
+    ReleaseFrame(frame);
+}
+
+FramePipelineStats FramePipeline::GetStats() const
+{
+    FramePipelineStats stats = {};
+    stats.Source = m_sourceCounters.Read();
+    stats.Convert = m_convertCounters.Read();
+    stats.SinkCount = static_cast<UINT>(m_sinks.size());
+    for (UINT i = 0; i < stats.SinkCount; i++)
+    {
+        stats.Sinks[i] = m_sinks[i]->Counters.Read();
+    }
+    stats.DroppedFrames = m_droppedFrames.load(std::memory_order_relaxed);
+    stats.SkippedFrames = m_skippedFrames.load(std::memory_order_relaxed);
+    stats.Pacing = m_pacer.GetStats();
+    return stats;
+}
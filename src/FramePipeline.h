@@ -0,0 +1,230 @@
+#pragma once
+#include "CursorOverlay.h"
+#include "FramePacer.h"
+#include "FramePool.h"
+#include "ImageView.h"
+#include "SpscRingQueue.h"
+#include "Utils.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 采集→转换→输出的流水线引擎
+// 帧源、转换阶段和每个输出各自运行在独立线程上，阶段之间通过有界SPSC环形队列传递帧，
+// 第N+1帧采集的同时转换第N帧、输出第N-1帧，吞吐量由最慢的阶段决定，而不是各阶段之和。
+// 帧数据通过FramePool的句柄传递：多个输出共享同一转换结果时只复制句柄（增加引用计数），
+// 队列槽位预先分配，稳定运行后各阶段之间传递帧不产生堆分配。
+
+// 帧源返回此值表示没有更多帧（文件回放结束等），流水线处理完已入队的帧后结束
+const HRESULT kPipelineEndOfStream = static_cast<HRESULT>(2);
+
+const UINT kMaxPipelineSinks = 4;
+const UINT kMaxPipelineDirtyRects = 64;
+const UINT kMaxPipelineMoves = 16;
+
+// 在阶段之间传递的帧
+struct PipelineFrame
+{
+    FrameHandle Source;         // 帧源产生的帧（CPU内存、GPU纹理等）
+    FrameHandle Output;         // 转换阶段的输出
+    ImageView SourceView;       // CPU内存帧的视图，GPU帧时不使用
+    ImageView OutputView;
+    UINT Width;                 // Source的尺寸，脏矩形和移动也是Source中的坐标
+    UINT Height;
+    // 转换阶段的输出相对Source的方向（旋转的显示器），输出尺寸见GetOrientedSize
+    ImageOrientation Orientation;
+    // 转换时合成的鼠标指针，形状在变化之前由各帧共享；为空表示不合成。(CursorX, CursorY)为Source中的位置
+    std::shared_ptr<const CursorImage> Cursor;
+    int CursorX;
+    int CursorY;
+    unsigned long long FrameIndex;
+    std::chrono::steady_clock::time_point CaptureTime;
+    // 相对帧源上一次返回的帧（FrameIndex - 1）的变化，转换阶段据此增量转换：
+    // 先执行Moves（滚动、拖动窗口），再更新DirtyRects。
+    // DirtyRectsValid为false表示帧源不提供脏矩形，整帧都可能变化；为true且没有矩形和移动表示内容未变
+    bool DirtyRectsValid;
+    UINT DirtyRectCount;
+    UINT MoveCount;
+    ImageRect DirtyRects[kMaxPipelineDirtyRects];
+    ImageMove Moves[kMaxPipelineMoves];
+
+    PipelineFrame()
+        : SourceView()
+        , OutputView()
+        , Width(0)
+        , Height(0)
+        , Orientation(MakeImageOrientation(ImageRotation::None))
+        , CursorX(0)
+        , CursorY(0)
+        , FrameIndex(0)
+        , DirtyRectsValid(false)
+        , DirtyRectCount(0)
+        , MoveCount(0)
+    {
+    }
+};
+
+// 帧源添加一个脏矩形，超出kMaxPipelineDirtyRects时合并为外接矩形
+void AddPipelineDirtyRect(PipelineFrame& frame, const ImageRect& rect);
+// 帧源添加一个移动，超出kMaxPipelineMoves时目标区域按脏矩形处理
+void AddPipelineMove(PipelineFrame& frame, const ImageMove& move);
+
+// 帧源：在源线程上调用
+class IFrameSource
+{
+public:
+    virtual ~IFrameSource() {}
+
+    // S_OK：frame中填入了新帧（Source、视图和尺寸）；
+    // S_FALSE：暂时没有新帧（实现应在内部带超时等待，不要立即返回以免空转）；
+    // kPipelineEndOfStream：没有更多帧；失败：停止流水线
+    virtual HRESULT ReadFrame(PipelineFrame& frame) = 0;
+};
+
+// 转换阶段：在转换线程上调用，填写frame.Output/OutputView
+// S_FALSE表示跳过这一帧（例如分辨率切换期间的临时错误），失败则停止流水线
+class IFrameConverter
+{
+public:
+    virtual ~IFrameConverter() {}
+    virtual HRESULT ConvertFrame(PipelineFrame& frame) = 0;
+};
+
+// 输出：每个输出在自己的线程上调用，多个输出看到同一帧的只读副本
+class IFrameSink
+{
+public:
+    virtual ~IFrameSink() {}
+    virtual HRESULT WriteFrame(const PipelineFrame& frame) = 0;
+};
+
+struct FramePipelineOptions
+{
+    UINT QueueDepth;            // 每个阶段间队列的容量（向上取整到2的幂）
+    bool DropFramesWhenFull;    // 转换跟不上时丢弃新采集的帧（实时采集），否则帧源等待
+    double TargetFrameRate;     // 帧源按此帧率的绝对期限读取帧，0表示不限速
+
+    FramePipelineOptions()
+        : QueueDepth(2)
+        , DropFramesWhenFull(false)
+        , TargetFrameRate(0.0)
+    {
+    }
+};
+
+struct PipelineStageStats
+{
+    unsigned long long Frames;              // 完成的帧数
+    unsigned long long BusyMicroseconds;    // 阶段调用内累计耗时
+    unsigned long long LatencyMicroseconds; // 从采集完成到本阶段完成的累计延迟
+};
+
+struct FramePipelineStats
+{
+    PipelineStageStats Source;
+    PipelineStageStats Convert;
+    PipelineStageStats Sinks[kMaxPipelineSinks];
+    UINT SinkCount;
+    unsigned long long DroppedFrames;       // 转换队列已满时丢弃的帧
+    unsigned long long SkippedFrames;       // 转换阶段跳过的帧
+    FramePacerStats Pacing;                 // 帧源节拍统计（未限速时全为0）
+};
+
+class FramePipeline
+{
+public:
+    FramePipeline();
+    ~FramePipeline();
+
+    // 各阶段对象由调用者持有，生命周期必须覆盖Start到Stop/Wait
+    HRESULT Initialize(IFrameSource* source, IFrameConverter* converter,
+                       IFrameSink* const* sinks, UINT sinkCount,
+                       const FramePipelineOptions& options = FramePipelineOptions());
+    HRESULT Start();
+    // 请求停止并等待所有阶段线程退出，已入队但未输出的帧被丢弃
+    void Stop();
+    // 等待帧源结束且所有帧输出完毕（或某个阶段失败），返回第一个失败的HRESULT
+    HRESULT Wait();
+    void Cleanup();
+
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+    FramePipelineStats GetStats() const;
+
+private:
+    // 阶段线程的唤醒信号：生产者只在有线程等待时才加锁通知
+    class StageSignal
+    {
+    public:
+        StageSignal();
+        void Notify();
+        void Wait(std::chrono::microseconds timeout);
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::atomic<bool> m_signaled;
+        std::atomic<UINT> m_waiters;
+    };
+
+    struct StageCounters
+    {
+        std::atomic<unsigned long long> Frames;
+        std::atomic<unsigned long long> BusyMicroseconds;
+        std::atomic<unsigned long long> LatencyMicroseconds;
+
+        StageCounters() : Frames(0), BusyMicroseconds(0), LatencyMicroseconds(0) {}
+        void Record(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end,
+                    std::chrono::steady_clock::time_point captureTime);
+        PipelineStageStats Read() const;
+    };
+
+    struct SinkStage
+    {
+        IFrameSink* Sink;
+        SpscRingQueue<PipelineFrame> Queue;
+        StageSignal DataSignal;     // 转换线程 → 输出线程：有新帧
+        StageCounters Counters;
+        std::thread Thread;
+    };
+
+    void SourceMain();
+    void ConvertMain();
+    void SinkMain(SinkStage* stage);
+
+    // 阻塞入队，直到成功或流水线停止；返回false表示已停止
+    bool PushBlocking(SpscRingQueue<PipelineFrame>& queue, PipelineFrame& frame,
+                      StageSignal& spaceSignal, StageSignal& dataSignal);
+    void Fail(HRESULT hr, const char* stage);
+    void Join();
+
+    IFrameSource* m_source;
+    IFrameConverter* m_converter;
+    std::vector<std::unique_ptr<SinkStage>> m_sinks;
+    FramePipelineOptions m_options;
+
+    SpscRingQueue<PipelineFrame> m_convertQueue;
+    StageSignal m_convertDataSignal;    // 源线程 → 转换线程：有新帧
+    StageSignal m_convertSpaceSignal;   // 转换线程 → 源线程：转换队列有空位
+    StageSignal m_sinkSpaceSignal;      // 输出线程 → 转换线程：输出队列有空位
+
+    FramePacer m_pacer;                 // 只在源线程上等待
+
+    std::thread m_sourceThread;
+    std::thread m_convertThread;
+
+    StageCounters m_sourceCounters;
+    StageCounters m_convertCounters;
+    std::atomic<unsigned long long> m_droppedFrames;
+    std::atomic<unsigned long long> m_skippedFrames;
+
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_stopping;
+    std::atomic<bool> m_sourceFinished;
+    std::atomic<bool> m_convertFinished;
+    std::atomic<HRESULT> m_result;
+    bool m_initialized;
+};
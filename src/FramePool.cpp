@@ -0,0 +1,394 @@
+#include "FramePool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace
+{
+    const size_t kMinSizeClass = 4096;
+    const size_t kFrameAlignment = 64;
+
+    enum class FrameResourceType
+    {
+        Memory,
+#ifdef _WIN32
+        Buffer,
+        Texture,
+#endif
+    };
+}
+
+struct PooledFrame
+{
+    std::atomic<UINT> RefCount;
+    FramePool* Pool;            // 为空表示已与帧池解除关联，最后一个引用释放时直接销毁
+    FrameResourceType Type;
+    size_t Capacity;
+    BYTE* Allocation;           // CPU内存帧的原始分配
+    BYTE* Data;                 // 对齐后的数据指针
+#ifdef _WIN32
+    D3D11_BUFFER_DESC BufferDesc;
+    D3D11_TEXTURE2D_DESC TextureDesc;
+    ID3D11Buffer* Buffer;
+    ID3D11Texture2D* Texture;
+#endif
+
+    PooledFrame()
+        : RefCount(0)
+        , Pool(nullptr)
+        , Type(FrameResourceType::Memory)
+        , Capacity(0)
+        , Allocation(nullptr)
+        , Data(nullptr)
+#ifdef _WIN32
+        , BufferDesc()
+        , TextureDesc()
+        , Buffer(nullptr)
+        , Texture(nullptr)
+#endif
+    {
+    }
+};
+
+// ---------------------------------------------------------------------------
+// FrameHandle
+// ---------------------------------------------------------------------------
+
+FrameHandle::FrameHandle()
+    : m_frame(nullptr)
+{
+}
+
+FrameHandle::FrameHandle(PooledFrame* frame)
+    : m_frame(frame)
+{
+}
+
+FrameHandle::~FrameHandle()
+{
+    Reset();
+}
+
+FrameHandle::FrameHandle(const FrameHandle& other)
+    : m_frame(other.m_frame)
+{
+    if (m_frame)
+        m_frame->RefCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+FrameHandle::FrameHandle(FrameHandle&& other) noexcept
+    : m_frame(other.m_frame)
+{
+    other.m_frame = nullptr;
+}
+
+FrameHandle& FrameHandle::operator=(const FrameHandle& other)
+{
+    if (other.m_frame)
+        other.m_frame->RefCount.fetch_add(1, std::memory_order_relaxed);
+    Reset();
+    m_frame = other.m_frame;
+    return *this;
+}
+
+FrameHandle& FrameHandle::operator=(FrameHandle&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        m_frame = other.m_frame;
+        other.m_frame = nullptr;
+    }
+    return *this;
+}
+
+void FrameHandle::Reset()
+{
+    PooledFrame* frame = m_frame;
+    m_frame = nullptr;
+    if (!frame || frame->RefCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if (frame->Pool)
+    {
+        frame->Pool->Recycle(frame);
+    }
+    else
+    {
+        FramePool::DestroyFrame(frame);
+    }
+}
+
+BYTE* FrameHandle::GetData() const
+{
+    return m_frame ? m_frame->Data : nullptr;
+}
+
+size_t FrameHandle::GetCapacity() const
+{
+    return m_frame ? m_frame->Capacity : 0;
+}
+
+#ifdef _WIN32
+ID3D11Buffer* FrameHandle::GetBuffer() const
+{
+    return m_frame ? m_frame->Buffer : nullptr;
+}
+
+ID3D11Texture2D* FrameHandle::GetTexture() const
+{
+    return m_frame ? m_frame->Texture : nullptr;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// FramePool
+// ---------------------------------------------------------------------------
+
+FramePool::FramePool()
+    : m_stats()
+#ifdef _WIN32
+    , m_device(nullptr)
+#endif
+{
+}
+
+FramePool::~FramePool()
+{
+    Cleanup();
+}
+
+size_t FramePool::GetSizeClass(size_t size)
+{
+    if (size <= kMinSizeClass)
+        return kMinSizeClass;
+
+    // 每个2的幂区间 [2^n, 2^(n+1)) 分成4档
+    size_t power = kMinSizeClass;
+    while (power <= size / 2)
+        power *= 2;
+    size_t step = power / 4;
+    return (size + step - 1) / step * step;
+}
+
+#ifdef _WIN32
+HRESULT FramePool::Initialize(ID3D11Device* device)
+{
+    if (!device)
+        return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_device != device)
+    {
+        SAFE_RELEASE(m_device);
+        m_device = device;
+        m_device->AddRef();
+    }
+    return S_OK;
+}
+
+HRESULT FramePool::AcquireBuffer(const D3D11_BUFFER_DESC& desc, FrameHandle& outFrame)
+{
+    PooledFrame key;
+    key.Type = FrameResourceType::Buffer;
+    key.BufferDesc = desc;
+    key.BufferDesc.ByteWidth = static_cast<UINT>(GetSizeClass(desc.ByteWidth));
+    key.Capacity = key.BufferDesc.ByteWidth;
+    return Acquire(key, outFrame);
+}
+
+HRESULT FramePool::AcquireTexture(const D3D11_TEXTURE2D_DESC& desc, FrameHandle& outFrame)
+{
+    PooledFrame key;
+    key.Type = FrameResourceType::Texture;
+    key.TextureDesc = desc;
+    return Acquire(key, outFrame);
+}
+#endif
+
+HRESULT FramePool::AcquireMemory(size_t size, FrameHandle& outFrame)
+{
+    if (size == 0)
+        return E_INVALIDARG;
+
+    PooledFrame key;
+    key.Type = FrameResourceType::Memory;
+    key.Capacity = GetSizeClass(size);
+    return Acquire(key, outFrame);
+}
+
+bool FramePool::Matches(const PooledFrame& frame, const PooledFrame& key)
+{
+    if (frame.Type != key.Type)
+        return false;
+
+    switch (frame.Type)
+    {
+#ifdef _WIN32
+    case FrameResourceType::Buffer:
+        return memcmp(&frame.BufferDesc, &key.BufferDesc, sizeof(key.BufferDesc)) == 0;
+    case FrameResourceType::Texture:
+        return memcmp(&frame.TextureDesc, &key.TextureDesc, sizeof(key.TextureDesc)) == 0;
+#endif
+    default:
+        return frame.Capacity == key.Capacity;
+    }
+}
+
+HRESULT FramePool::Acquire(const PooledFrame& key, FrameHandle& outFrame)
+{
+    outFrame.Reset();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.AcquireCount++;
+
+        // 优先复用最近归还的帧（缓存中更可能仍然是热的）
+        for (size_t i = m_freeFrames.size(); i-- > 0;)
+        {
+            PooledFrame* frame = m_freeFrames[i];
+            if (Matches(*frame, key))
+            {
+                m_freeFrames.erase(m_freeFrames.begin() + i);
+                frame->RefCount.store(1, std::memory_order_relaxed);
+                m_stats.ReuseCount++;
+                m_stats.OutstandingCount++;
+                outFrame = FrameHandle(frame);
+                return S_OK;
+            }
+        }
+    }
+
+    // 没有可用的空闲帧，在锁外创建新帧
+    PooledFrame* frame = nullptr;
+    HRESULT hr = CreateFrame(key, &frame);
+    if (FAILED(hr))
+        return hr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    try
+    {
+        // 预留空闲列表容量，保证归还时不会分配
+        m_freeFrames.reserve(m_frames.size() + 1);
+        m_frames.push_back(frame);
+    }
+    catch (const std::bad_alloc&)
+    {
+        DestroyFrame(frame);
+        return E_OUTOFMEMORY;
+    }
+
+    frame->Pool = this;
+    frame->RefCount.store(1, std::memory_order_relaxed);
+    m_stats.AllocationCount++;
+    m_stats.FrameCount = static_cast<UINT>(m_frames.size());
+    m_stats.OutstandingCount++;
+    outFrame = FrameHandle(frame);
+    return S_OK;
+}
+
+HRESULT FramePool::CreateFrame(const PooledFrame& key, PooledFrame** outFrame)
+{
+    PooledFrame* frame = new (std::nothrow) PooledFrame();
+    if (!frame)
+        return E_OUTOFMEMORY;
+
+    frame->Type = key.Type;
+    frame->Capacity = key.Capacity;
+
+    HRESULT hr = S_OK;
+    switch (key.Type)
+    {
+#ifdef _WIN32
+    case FrameResourceType::Buffer:
+        frame->BufferDesc = key.BufferDesc;
+        hr = m_device ? m_device->CreateBuffer(&frame->BufferDesc, nullptr, &frame->Buffer) : E_FAIL;
+        break;
+    case FrameResourceType::Texture:
+        frame->TextureDesc = key.TextureDesc;
+        hr = m_device ? m_device->CreateTexture2D(&frame->TextureDesc, nullptr, &frame->Texture) : E_FAIL;
+        break;
+#endif
+    default:
+        frame->Allocation = new (std::nothrow) BYTE[key.Capacity + kFrameAlignment - 1];
+        if (frame->Allocation)
+        {
+            size_t address = reinterpret_cast<size_t>(frame->Allocation);
+            frame->Data = frame->Allocation + ((kFrameAlignment - address % kFrameAlignment) % kFrameAlignment);
+        }
+        else
+        {
+            hr = E_OUTOFMEMORY;
+        }
+        break;
+    }
+
+    if (FAILED(hr))
+    {
+        LogError("Failed to create pooled frame");
+        DestroyFrame(frame);
+        return hr;
+    }
+
+    *outFrame = frame;
+    return S_OK;
+}
+
+void FramePool::Recycle(PooledFrame* frame)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_freeFrames.push_back(frame);
+    m_stats.OutstandingCount--;
+}
+
+void FramePool::RemoveFrame(PooledFrame* frame)
+{
+    m_frames.erase(std::find(m_frames.begin(), m_frames.end(), frame));
+}
+
+void FramePool::DestroyFrame(PooledFrame* frame)
+{
+#ifdef _WIN32
+    SAFE_RELEASE(frame->Buffer);
+    SAFE_RELEASE(frame->Texture);
+#endif
+    delete[] frame->Allocation;
+    delete frame;
+}
+
+void FramePool::Trim()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (PooledFrame* frame : m_freeFrames)
+    {
+        RemoveFrame(frame);
+        DestroyFrame(frame);
+    }
+    m_freeFrames.clear();
+    m_stats.FrameCount = static_cast<UINT>(m_frames.size());
+}
+
+void FramePool::Cleanup()
+{
+    Trim();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 仍被借出的帧解除关联，由最后一个句柄负责销毁
+    for (PooledFrame* frame : m_frames)
+    {
+        frame->Pool = nullptr;
+    }
+    m_frames.clear();
+    m_stats.FrameCount = 0;
+    m_stats.OutstandingCount = 0;
+#ifdef _WIN32
+    SAFE_RELEASE(m_device);
+#endif
+}
+
+FramePoolStats FramePool::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "Utils.h"
+#include <mutex>
+#include <vector>
+
+// 可回收的帧缓冲池
+// 采集和转换阶段从池中借用帧（CPU内存，或Windows上的D3D11缓冲区/纹理），
+// 通过引用计数的FrameHandle共享，最后一个句柄释放时帧回到池中而不是被销毁。
+// 帧数量达到稳定后，每帧的借用/归还不再产生任何堆分配或资源创建。
+//
+// CPU内存按尺寸类别取整（每个2的幂区间分4档，浪费不超过25%），
+// 分辨率小幅变化时仍可复用；GPU缓冲区按尺寸类别和用途匹配，纹理要求描述完全一致。
+// 帧池必须比所有借出的句柄存活更久，或在Cleanup前停止使用它的线程
+
+struct PooledFrame;
+
+class FrameHandle
+{
+public:
+    FrameHandle();
+    ~FrameHandle();
+    FrameHandle(const FrameHandle& other);
+    FrameHandle(FrameHandle&& other) noexcept;
+    FrameHandle& operator=(const FrameHandle& other);
+    FrameHandle& operator=(FrameHandle&& other) noexcept;
+
+    // 释放当前引用，最后一个引用释放时帧回到池中
+    void Reset();
+    bool IsValid() const { return m_frame != nullptr; }
+
+    // CPU内存帧的数据（64字节对齐）和容量
+    BYTE* GetData() const;
+    size_t GetCapacity() const;
+
+#ifdef _WIN32
+    // GPU资源帧（不增加引用计数，生命周期由句柄管理）
+    ID3D11Buffer* GetBuffer() const;
+    ID3D11Texture2D* GetTexture() const;
+#endif
+
+private:
+    friend class FramePool;
+    explicit FrameHandle(PooledFrame* frame);
+
+    PooledFrame* m_frame;
+};
+
+struct FramePoolStats
+{
+    unsigned long long AcquireCount;    // 借用次数
+    unsigned long long ReuseCount;      // 由空闲帧满足的借用次数
+    unsigned long long AllocationCount; // 新建帧（堆分配或资源创建）次数
+    UINT FrameCount;                    // 池中帧总数
+    UINT OutstandingCount;              // 当前借出的帧数
+};
+
+class FramePool
+{
+public:
+    FramePool();
+    ~FramePool();
+
+#ifdef _WIN32
+    // 只有借用GPU资源时才需要设备
+    HRESULT Initialize(ID3D11Device* device);
+    HRESULT AcquireBuffer(const D3D11_BUFFER_DESC& desc, FrameHandle& outFrame);
+    HRESULT AcquireTexture(const D3D11_TEXTURE2D_DESC& desc, FrameHandle& outFrame);
+#endif
+    HRESULT AcquireMemory(size_t size, FrameHandle& outFrame);
+
+    // 释放所有空闲帧（例如分辨率变化后），借出的帧不受影响
+    void Trim();
+    // 释放所有空闲帧并解除与借出帧的关联，借出帧在最后一个句柄释放时直接销毁
+    void Cleanup();
+
+    FramePoolStats GetStats() const;
+
+    static size_t GetSizeClass(size_t size);
+
+private:
+    friend class FrameHandle;
+
+    HRESULT Acquire(const PooledFrame& key, FrameHandle& outFrame);
+    HRESULT CreateFrame(const PooledFrame& key, PooledFrame** outFrame);
+    void Recycle(PooledFrame* frame);
+    void RemoveFrame(PooledFrame* frame);
+    static bool Matches(const PooledFrame& frame, const PooledFrame& key);
+    static void DestroyFrame(PooledFrame* frame);
+
+    mutable std::mutex m_mutex;
+    std::vector<PooledFrame*> m_frames;      // 池中所有帧
+    std::vector<PooledFrame*> m_freeFrames;  // 空闲帧，容量始终不小于m_frames.size()，归还时不会分配
+    FramePoolStats m_stats;
+
+#ifdef _WIN32
+    ID3D11Device* m_device;
+#endif
+};
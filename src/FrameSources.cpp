@@ -0,0 +1,858 @@
+#include "FrameSources.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const UINT kBarCount = 8;
+    const UINT kScrollPixelsPerFrame = 4;
+    const UINT kCheckerSize = 64;
+    const UINT kGlyphWidth = 8;
+    const UINT kGlyphHeight = 16;
+    const UINT kDocumentScrollRows = 3;
+    const UINT kDocumentLineHeight = 12;
+
+    // 75%彩条（内存字节序B,G,R,A）
+    const BYTE kBarColors[kBarCount][4] = {
+        { 191, 191, 191, 255 },     // 白
+        {   0, 191, 191, 255 },     // 黄
+        { 191, 191,   0, 255 },     // 青
+        {   0, 191,   0, 255 },     // 绿
+        { 191,   0, 191, 255 },     // 品红
+        {   0,   0, 191, 255 },     // 红
+        { 191,   0,   0, 255 },     // 蓝
+        {   0,   0,   0, 255 },     // 黑
+    };
+
+    const BYTE kCheckerColors[2][4] = {
+        { 220, 180,  60, 255 },
+        {  30,  60, 120, 255 },
+    };
+
+    inline void StorePixel(BYTE* pixel, BYTE b, BYTE g, BYTE r)
+    {
+        pixel[0] = b;
+        pixel[1] = g;
+        pixel[2] = r;
+        pixel[3] = 255;
+    }
+
+    inline unsigned long long MixBits(unsigned long long value)
+    {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+    // 桌面图案的布局：静态渐变背景上一个播放中的视频窗口、一个逐字输入（写满后上滚一行）的文本区域、
+    // 一个持续滚动的文档窗口和一个来回拖动的小窗口
+    struct DesktopLayout
+    {
+        ImageRect Video;
+        ImageRect Text;
+        UINT Columns;       // 文本区域的字符列数和行数，0表示图像太小没有文本区域
+        UINT Rows;
+        ImageRect Document;
+        ImageRect DragBand; // 拖动窗口水平移动的范围
+        UINT DragWidth;     // 拖动窗口的宽度，0表示没有拖动窗口
+    };
+
+    DesktopLayout GetDesktopLayout(UINT width, UINT height)
+    {
+        DesktopLayout layout;
+        layout.Video = MakeImageRect(width / 16, height / 8, width / 16 + width / 6, height / 8 + height / 6);
+
+        // 文本区域和文档窗口故意从奇数x开始，脏矩形和移动都不对齐YUY2像素对
+        UINT textLeft = width / 2 + 3;
+        layout.Columns = width > textLeft + 16 ? (width - 16 - textLeft) / kGlyphWidth : 0;
+        layout.Rows = (height / 2) / kGlyphHeight;
+        if (layout.Columns == 0 || layout.Rows == 0)
+        {
+            layout.Columns = 0;
+            layout.Rows = 0;
+        }
+        layout.Text = MakeImageRect(textLeft, height / 4, textLeft + layout.Columns * kGlyphWidth,
+                                    height / 4 + layout.Rows * kGlyphHeight);
+
+        layout.Document = MakeImageRect(width / 16 + 1, height / 2, width / 2 > 16 ? width / 2 - 16 : 0,
+                                        height - height / 16);
+        if (IsImageRectEmpty(layout.Document) || layout.Document.Bottom - layout.Document.Top <= kDocumentScrollRows)
+            layout.Document = MakeImageRect(0, 0, 0, 0);
+
+        layout.DragBand = MakeImageRect(width / 2, height / 32, width > 8 ? width - 8 : 0, height / 32 + height / 12);
+        layout.DragWidth = width / 24;
+        if (IsImageRectEmpty(layout.DragBand) || layout.DragWidth == 0 ||
+            layout.DragBand.Right - layout.DragBand.Left <= layout.DragWidth)
+        {
+            layout.DragWidth = 0;
+        }
+        return layout;
+    }
+
+    // 第frameIndex帧时文本区域第一行显示的是第几行文字（已输入frameIndex个字符，光标所在行始终可见）
+    unsigned long long GetFirstTextLine(const DesktopLayout& layout, unsigned long long frameIndex)
+    {
+        unsigned long long caretLine = frameIndex / layout.Columns;
+        return caretLine >= layout.Rows ? caretLine - layout.Rows + 1 : 0;
+    }
+
+    ImageRect GetGlyphRect(const DesktopLayout& layout, unsigned long long firstLine, unsigned long long index)
+    {
+        UINT left = layout.Text.Left + static_cast<UINT>(index % layout.Columns) * kGlyphWidth;
+        UINT top = layout.Text.Top + static_cast<UINT>(index / layout.Columns - firstLine) * kGlyphHeight;
+        return MakeImageRect(left, top, left + kGlyphWidth, top + kGlyphHeight);
+    }
+
+    ImageRect GetDragRect(const DesktopLayout& layout, unsigned long long frameIndex)
+    {
+        // 每帧交替移动2或3个像素（偶数和奇数偏移），到达右端后回到左端
+        UINT travel = layout.DragBand.Right - layout.DragBand.Left - layout.DragWidth;
+        UINT left = layout.DragBand.Left + static_cast<UINT>((frameIndex * 5 / 2) % travel);
+        return MakeImageRect(left, layout.DragBand.Top, left + layout.DragWidth, layout.DragBand.Bottom);
+    }
+
+    void FillRect(const ImagePlane& plane, const ImageRect& rect, BYTE b, BYTE g, BYTE r)
+    {
+        for (UINT y = rect.Top; y < rect.Bottom; y++)
+        {
+            BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+            for (UINT x = rect.Left; x < rect.Right; x++)
+            {
+                StorePixel(row + (size_t)x * 4, b, g, r);
+            }
+        }
+    }
+
+    // 文档窗口：内容随文档坐标固定，每帧上滚kDocumentScrollRows行
+    void RenderDocument(const ImagePlane& plane, const ImageRect& document, unsigned long long frameIndex)
+    {
+        for (UINT y = document.Top; y < document.Bottom; y++)
+        {
+            BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+            unsigned long long docY = (y - document.Top) + frameIndex * kDocumentScrollRows;
+            unsigned long long line = docY / kDocumentLineHeight;
+            UINT lineRow = static_cast<UINT>(docY % kDocumentLineHeight);
+            for (UINT x = document.Left; x < document.Right; x += 6)
+            {
+                // 每6个像素一个字符，字符的点阵由行号和列号决定，行尾和行间留白
+                unsigned long long bits = MixBits(line * 977 + (x - document.Left) / 6 + 1);
+                bool ink = lineRow >= 1 && lineRow <= 8 && (bits & 7) != 0;
+                for (UINT gx = 0; gx < 6 && x + gx < document.Right; gx++)
+                {
+                    bool on = ink && gx < 5 && ((bits >> (8 + (lineRow - 1) * 5 + gx)) & 1) != 0;
+                    BYTE value = on ? 30 : 250;
+                    StorePixel(row + (size_t)(x + gx) * 4, value, value, value);
+                }
+            }
+        }
+    }
+
+    void RenderDesktop(const ImagePlane& plane, UINT width, UINT height, unsigned long long frameIndex)
+    {
+        // 背景：只随行变化的蓝色渐变，每行按像素填充
+        for (UINT y = 0; y < height; y++)
+        {
+            BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+            BYTE shade = static_cast<BYTE>(60 + y * 100 / height);
+            for (UINT x = 0; x < width; x++)
+            {
+                StorePixel(row + (size_t)x * 4, static_cast<BYTE>(shade + 40), shade, 30);
+            }
+        }
+
+        DesktopLayout layout = GetDesktopLayout(width, height);
+
+        if (!IsImageRectEmpty(layout.Document))
+        {
+            RenderDocument(plane, layout.Document, frameIndex);
+        }
+
+        // 视频窗口：每帧移动并变色的棋盘格
+        const ImageRect& video = layout.Video;
+        unsigned long long offset = frameIndex * 3;
+        BYTE tint = static_cast<BYTE>(frameIndex * 5);
+        for (UINT y = video.Top; y < video.Bottom; y++)
+        {
+            BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+            for (UINT x = video.Left; x < video.Right; x++)
+            {
+                bool light = (((x + offset) / 16 + (y + offset / 2) / 16) & 1) != 0;
+                StorePixel(row + (size_t)x * 4, light ? tint : 40, light ? 200 : 60, light ? 255 - tint : 90);
+            }
+        }
+
+        if (layout.Columns != 0)
+        {
+            // 文本区域：可见行中已输入的字符和光标
+            FillRect(plane, layout.Text, 240, 240, 240);
+            unsigned long long firstLine = GetFirstTextLine(layout, frameIndex);
+            for (unsigned long long i = firstLine * layout.Columns; i < frameIndex; i++)
+            {
+                ImageRect cell = GetGlyphRect(layout, firstLine, i);
+                unsigned long long bits = MixBits(i + 1);
+                // 字形：单元内部6x10的点阵，由字符序号决定
+                for (UINT gy = 0; gy < 10; gy++)
+                {
+                    BYTE* row = plane.Data + (size_t)(cell.Top + 3 + gy) * plane.Pitch;
+                    for (UINT gx = 0; gx < 6; gx++)
+                    {
+                        if ((bits >> (gy * 6 + gx)) & 1)
+                            StorePixel(row + (size_t)(cell.Left + 1 + gx) * 4, 20, 20, 20);
+                    }
+                }
+            }
+            ImageRect caret = GetGlyphRect(layout, firstLine, frameIndex);
+            FillRect(plane, MakeImageRect(caret.Left, caret.Top + 2, caret.Left + 2, caret.Bottom - 2), 0, 0, 0);
+        }
+
+        if (layout.DragWidth != 0)
+        {
+            // 拖动窗口：标题栏加窗口内容，内容相对窗口固定
+            ImageRect window = GetDragRect(layout, frameIndex);
+            for (UINT y = window.Top; y < window.Bottom; y++)
+            {
+                BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+                UINT localY = y - window.Top;
+                for (UINT x = window.Left; x < window.Right; x++)
+                {
+                    UINT localX = x - window.Left;
+                    if (localY < 6)
+                        StorePixel(row + (size_t)x * 4, 160, 90, 40);
+                    else
+                        StorePixel(row + (size_t)x * 4, static_cast<BYTE>(200 + localX % 32),
+                                   static_cast<BYTE>(180 + localY % 48), 220);
+                }
+            }
+        }
+    }
+
+    // 彩条行：整体向左滚动
+    void RenderBarsRow(BYTE* row, UINT width, unsigned long long frameIndex)
+    {
+        UINT barWidth = (std::max)(width / kBarCount, 1U);
+        unsigned long long offset = frameIndex * kScrollPixelsPerFrame;
+        for (UINT x = 0; x < width; x++)
+        {
+            memcpy(row + (size_t)x * 4, kBarColors[((x + offset) / barWidth) % kBarCount], 4);
+        }
+    }
+
+    // 横带行：随滚动移动的灰度渐变
+    void RenderBandRow(BYTE* row, UINT width, unsigned long long frameIndex)
+    {
+        unsigned long long offset = frameIndex * kScrollPixelsPerFrame;
+        for (UINT x = 0; x < width; x++)
+        {
+            BYTE gray = static_cast<BYTE>(((x + offset) % width) * 255 / width);
+            StorePixel(row + (size_t)x * 4, gray, gray, gray);
+        }
+    }
+
+    void RenderCheckerRow(BYTE* row, UINT width, UINT phase, unsigned long long offset)
+    {
+        for (UINT x = 0; x < width; x++)
+        {
+            memcpy(row + (size_t)x * 4, kCheckerColors[(((x + offset) / kCheckerSize) + phase) & 1], 4);
+        }
+    }
+
+    void RenderNoiseRow(BYTE* row, UINT width, unsigned long long frameIndex, UINT y)
+    {
+        // 每行独立播种，结果只取决于帧序号和行号
+        unsigned long long state = ((frameIndex + 1) * 0x9E3779B97F4A7C15ULL ^ ((unsigned long long)y << 32 | y)) | 1;
+        for (UINT x = 0; x < width; x += 2)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            StorePixel(row + (size_t)x * 4, static_cast<BYTE>(state), static_cast<BYTE>(state >> 8),
+                       static_cast<BYTE>(state >> 16));
+            if (x + 1 < width)
+            {
+                StorePixel(row + (size_t)(x + 1) * 4, static_cast<BYTE>(state >> 24),
+                           static_cast<BYTE>(state >> 32), static_cast<BYTE>(state >> 40));
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SyntheticFrameSource
+// ---------------------------------------------------------------------------
+
+SyntheticFrameSource::SyntheticFrameSource()
+    : m_framePool(nullptr)
+    , m_readFrames(0)
+    , m_initialized(false)
+{
+}
+
+SyntheticFrameSource::~SyntheticFrameSource()
+{
+    Cleanup();
+}
+
+const char* SyntheticFrameSource::GetPatternName(SyntheticPattern pattern)
+{
+    switch (pattern)
+    {
+    case SyntheticPattern::ColorBars:    return "ColorBars";
+    case SyntheticPattern::Checkerboard: return "Checkerboard";
+    case SyntheticPattern::Noise:        return "Noise";
+    case SyntheticPattern::Desktop:      return "Desktop";
+    default:                             return "Unknown";
+    }
+}
+
+bool SyntheticFrameSource::ParsePattern(const std::string& name, SyntheticPattern& pattern)
+{
+    if (name == "bars")
+        pattern = SyntheticPattern::ColorBars;
+    else if (name == "checker")
+        pattern = SyntheticPattern::Checkerboard;
+    else if (name == "noise")
+        pattern = SyntheticPattern::Noise;
+    else if (name == "desktop")
+        pattern = SyntheticPattern::Desktop;
+    else
+        return false;
+    return true;
+}
+
+HRESULT SyntheticFrameSource::Initialize(FramePool* framePool, const SyntheticSourceOptions& options)
+{
+    if (!framePool || options.Width == 0 || options.Height == 0 ||
+        (options.Pitch != 0 && options.Pitch < options.Width * 4))
+    {
+        return E_INVALIDARG;
+    }
+
+    m_framePool = framePool;
+    m_options = options;
+    m_readFrames = 0;
+    m_initialized = true;
+
+    LogMessage("Synthetic frame source: " + std::to_string(options.Width) + "x" + std::to_string(options.Height) +
+              " " + GetPatternName(options.Pattern));
+    return S_OK;
+}
+
+HRESULT SyntheticFrameSource::ReadFrame(PipelineFrame& frame)
+{
+    if (!m_initialized)
+        return E_FAIL;
+    if (m_options.FrameCount != 0 && m_readFrames >= m_options.FrameCount)
+        return kPipelineEndOfStream;
+
+    UINT pitch = m_options.Pitch ? m_options.Pitch : m_options.Width * 4;
+    HRESULT hr = m_framePool->AcquireMemory((size_t)pitch * m_options.Height, frame.Source);
+    if (FAILED(hr))
+        return hr;
+
+    frame.SourceView = MakeBGRAImageView(frame.Source.GetData(), m_options.Width, m_options.Height, pitch);
+    frame.Width = m_options.Width;
+    frame.Height = m_options.Height;
+
+    hr = RenderFrame(m_options.Pattern, m_readFrames, frame.SourceView);
+    if (FAILED(hr))
+        return hr;
+
+    ImageRect rects[kMaxSyntheticDirtyRects];
+    ImageMove moves[kMaxSyntheticMoves];
+    UINT rectCount = 0;
+    UINT moveCount = 0;
+    frame.DirtyRectCount = 0;
+    frame.MoveCount = 0;
+    frame.DirtyRectsValid = GetDirtyRects(m_options.Pattern, m_readFrames, m_options.Width, m_options.Height,
+                                          rects, rectCount, moves, moveCount);
+    for (UINT i = 0; i < moveCount; i++)
+    {
+        AddPipelineMove(frame, moves[i]);
+    }
+    for (UINT i = 0; i < rectCount; i++)
+    {
+        AddPipelineDirtyRect(frame, rects[i]);
+    }
+
+    m_readFrames++;
+    return S_OK;
+}
+
+HRESULT SyntheticFrameSource::RenderFrame(SyntheticPattern pattern, unsigned long long frameIndex,
+                                          const ImageView& destination)
+{
+    if (!IsImageViewValid(destination, 1, destination.Width, destination.Height) ||
+        destination.Planes[0].RowBytes < destination.Width * 4)
+    {
+        return E_INVALIDARG;
+    }
+
+    const ImagePlane& plane = destination.Planes[0];
+    UINT width = destination.Width;
+    UINT height = destination.Height;
+    size_t rowBytes = (size_t)width * 4;
+
+    // 图案按行重复：每种行只绘制一次，其余行直接复制
+    const BYTE* templates[2] = { nullptr, nullptr };
+
+    switch (pattern)
+    {
+    case SyntheticPattern::ColorBars:
+    {
+        UINT bandHeight = (std::max)(height / 16, 2U);
+        UINT bandTop = static_cast<UINT>((frameIndex * 2) % height);
+        for (UINT y = 0; y < height; y++)
+        {
+            BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+            UINT kind = ((y + height - bandTop) % height) < bandHeight ? 1 : 0;
+            if (templates[kind])
+            {
+                memcpy(row, templates[kind], rowBytes);
+                continue;
+            }
+            if (kind)
+                RenderBandRow(row, width, frameIndex);
+            else
+                RenderBarsRow(row, width, frameIndex);
+            templates[kind] = row;
+        }
+        break;
+    }
+    case SyntheticPattern::Checkerboard:
+    {
+        unsigned long long offset = frameIndex * 2;
+        for (UINT y = 0; y < height; y++)
+        {
+            BYTE* row = plane.Data + (size_t)y * plane.Pitch;
+            UINT phase = static_cast<UINT>(((y + offset) / kCheckerSize) & 1);
+            if (templates[phase])
+            {
+                memcpy(row, templates[phase], rowBytes);
+                continue;
+            }
+            RenderCheckerRow(row, width, phase, offset);
+            templates[phase] = row;
+        }
+        break;
+    }
+    case SyntheticPattern::Noise:
+        for (UINT y = 0; y < height; y++)
+        {
+            RenderNoiseRow(plane.Data + (size_t)y * plane.Pitch, width, frameIndex, y);
+        }
+        break;
+    case SyntheticPattern::Desktop:
+        RenderDesktop(plane, width, height, frameIndex);
+        break;
+    default:
+        return E_INVALIDARG;
+    }
+
+    return S_OK;
+}
+
+bool SyntheticFrameSource::GetDirtyRects(SyntheticPattern pattern, unsigned long long frameIndex,
+                                         UINT width, UINT height, ImageRect* rects, UINT& rectCount,
+                                         ImageMove* moves, UINT& moveCount)
+{
+    rectCount = 0;
+    moveCount = 0;
+    if (pattern != SyntheticPattern::Desktop || frameIndex == 0)
+        return false;
+
+    DesktopLayout layout = GetDesktopLayout(width, height);
+    if (!IsImageRectEmpty(layout.Video))
+        rects[rectCount++] = layout.Video;
+
+    if (layout.Columns != 0)
+    {
+        unsigned long long firstLine = GetFirstTextLine(layout, frameIndex);
+        const ImageRect& text = layout.Text;
+        if (firstLine != GetFirstTextLine(layout, frameIndex - 1))
+        {
+            // 光标换到新行时文本上滚一行：新的最后一行露出，上一行末尾的光标换成了字符
+            if (layout.Rows > 1)
+            {
+                moves[moveCount++] = MakeImageMove(MakeImageRect(text.Left, text.Top, text.Right, text.Bottom - kGlyphHeight),
+                                                   text.Left, text.Top + kGlyphHeight);
+            }
+            rects[rectCount++] = MakeImageRect(text.Left, text.Bottom - kGlyphHeight, text.Right, text.Bottom);
+            if (layout.Rows > 1)
+                rects[rectCount++] = GetGlyphRect(layout, firstLine, frameIndex - 1);
+        }
+        else
+        {
+            // 光标原来所在的单元写入了新字符，光标移到下一个单元
+            rects[rectCount++] = GetGlyphRect(layout, firstLine, frameIndex - 1);
+            rects[rectCount++] = GetGlyphRect(layout, firstLine, frameIndex);
+        }
+    }
+
+    if (!IsImageRectEmpty(layout.Document))
+    {
+        // 文档上滚，底部露出新的几行
+        const ImageRect& document = layout.Document;
+        moves[moveCount++] = MakeImageMove(MakeImageRect(document.Left, document.Top, document.Right,
+                                                         document.Bottom - kDocumentScrollRows),
+                                           document.Left, document.Top + kDocumentScrollRows);
+        rects[rectCount++] = MakeImageRect(document.Left, document.Bottom - kDocumentScrollRows,
+                                           document.Right, document.Bottom);
+    }
+
+    if (layout.DragWidth != 0)
+    {
+        ImageRect previous = GetDragRect(layout, frameIndex - 1);
+        ImageRect current = GetDragRect(layout, frameIndex);
+        if (current.Left > previous.Left)
+        {
+            // 窗口向右拖动：内容整体移动，左侧露出背景
+            moves[moveCount++] = MakeImageMove(current, previous.Left, previous.Top);
+            rects[rectCount++] = MakeImageRect(previous.Left, previous.Top, (std::min)(current.Left, previous.Right),
+                                               previous.Bottom);
+        }
+        else if (current.Left < previous.Left)
+        {
+            // 回到左端：旧位置露出背景，新位置重新绘制
+            rects[rectCount++] = previous;
+            rects[rectCount++] = current;
+        }
+    }
+    return true;
+}
+
+void SyntheticFrameSource::Cleanup()
+{
+    m_framePool = nullptr;
+    m_readFrames = 0;
+    m_initialized = false;
+}
+
+// ---------------------------------------------------------------------------
+// FileReplaySource
+// ---------------------------------------------------------------------------
+
+FileReplaySource::FileReplaySource()
+    : m_framePool(nullptr)
+    , m_mappedData(nullptr)
+    , m_mappedSize(0)
+    , m_width(0)
+    , m_height(0)
+    , m_fileFrameCount(0)
+    , m_readFrames(0)
+#ifdef _WIN32
+    , m_file(INVALID_HANDLE_VALUE)
+    , m_mapping(nullptr)
+#else
+    , m_file(-1)
+#endif
+{
+}
+
+FileReplaySource::~FileReplaySource()
+{
+    Cleanup();
+}
+
+bool FileReplaySource::ParseFrameSize(const std::string& path, UINT& width, UINT& height)
+{
+    // 取最后一个'_'与扩展名之间的"WxH"
+    size_t nameStart = path.find_last_of("/\\");
+    std::string name = nameStart == std::string::npos ? path : path.substr(nameStart + 1);
+    size_t sizeStart = name.find_last_of('_');
+    size_t sizeEnd = name.find_last_of('.');
+    if (sizeStart == std::string::npos || sizeEnd == std::string::npos || sizeEnd <= sizeStart)
+        return false;
+
+    // 只允许一个'x'，两边各1到5位数字（上限65536），避免stoul溢出抛出异常
+    std::string size = name.substr(sizeStart + 1, sizeEnd - sizeStart - 1);
+    size_t separator = size.find('x');
+    if (separator == std::string::npos || separator == 0 || separator > 5 || separator + 1 == size.size() ||
+        size.size() - separator - 1 > 5 || size.find('x', separator + 1) != std::string::npos ||
+        size.find_first_not_of("0123456789x") != std::string::npos)
+    {
+        return false;
+    }
+
+    unsigned long parsedWidth = std::stoul(size.substr(0, separator));
+    unsigned long parsedHeight = std::stoul(size.substr(separator + 1));
+    if (parsedWidth == 0 || parsedHeight == 0 || parsedWidth > 65536 || parsedHeight > 65536)
+        return false;
+
+    width = static_cast<UINT>(parsedWidth);
+    height = static_cast<UINT>(parsedHeight);
+    return true;
+}
+
+HRESULT FileReplaySource::Initialize(const std::string& path, FramePool* framePool,
+                                     const FileReplayOptions& options)
+{
+    Cleanup();
+
+    UINT width = options.Width;
+    UINT height = options.Height;
+    if ((width == 0 || height == 0) && !ParseFrameSize(path, width, height))
+    {
+        LogError("Cannot determine frame size from file name: " + path);
+        return E_INVALIDARG;
+    }
+    if (options.CopyFrames && !framePool)
+        return E_INVALIDARG;
+
+    HRESULT hr = MapFile(path);
+    if (FAILED(hr))
+        return hr;
+
+    size_t frameSize = (size_t)width * height * 4;
+    if (m_mappedSize < frameSize || m_mappedSize % frameSize != 0)
+    {
+        LogError("Replay file size " + std::to_string(m_mappedSize) + " is not a multiple of the " +
+                 std::to_string(width) + "x" + std::to_string(height) + " BGRA frame size");
+        UnmapFile();
+        return E_INVALIDARG;
+    }
+
+    m_framePool = framePool;
+    m_options = options;
+    m_width = width;
+    m_height = height;
+    m_fileFrameCount = static_cast<UINT>(m_mappedSize / frameSize);
+    m_readFrames = 0;
+
+    LogMessage("Replaying " + path + ": " + std::to_string(width) + "x" + std::to_string(height) + ", " +
+              std::to_string(m_fileFrameCount) + " frames" + (options.CopyFrames ? " (copied)" : " (mapped)"));
+    return S_OK;
+}
+
+HRESULT FileReplaySource::MapFile(const std::string& path)
+{
+#ifdef _WIN32
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                         FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        LogError("Failed to open replay file: " + path);
+        return E_FAIL;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        LogError("Replay file is empty: " + path);
+        UnmapFile();
+        return E_FAIL;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_mappedData = m_mapping ? static_cast<const BYTE*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    if (!m_mappedData)
+    {
+        LogError("Failed to map replay file: " + path);
+        UnmapFile();
+        return E_FAIL;
+    }
+    m_mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    m_file = open(path.c_str(), O_RDONLY);
+    if (m_file < 0)
+    {
+        LogError("Failed to open replay file: " + path);
+        return E_FAIL;
+    }
+
+    struct stat fileStat;
+    if (fstat(m_file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        LogError("Replay file is empty: " + path);
+        UnmapFile();
+        return E_FAIL;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, m_file, 0);
+    if (mapped == MAP_FAILED)
+    {
+        LogError("Failed to map replay file: " + path);
+        UnmapFile();
+        return E_FAIL;
+    }
+    m_mappedData = static_cast<const BYTE*>(mapped);
+    m_mappedSize = static_cast<size_t>(fileStat.st_size);
+
+    // 循环回放会反复读取全部页面，提前读入避免首轮回放时缺页
+    madvise(mapped, m_mappedSize, MADV_WILLNEED);
+#endif
+    return S_OK;
+}
+
+void FileReplaySource::UnmapFile()
+{
+#ifdef _WIN32
+    if (m_mappedData)
+        UnmapViewOfFile(m_mappedData);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE)
+        CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = INVALID_HANDLE_VALUE;
+#else
+    if (m_mappedData)
+        munmap(const_cast<BYTE*>(m_mappedData), m_mappedSize);
+    if (m_file >= 0)
+        close(m_file);
+    m_file = -1;
+#endif
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+}
+
+HRESULT FileReplaySource::ReadFrame(PipelineFrame& frame)
+{
+    if (!m_mappedData)
+        return E_FAIL;
+    if (m_options.FrameCount != 0 && m_readFrames >= m_options.FrameCount)
+        return kPipelineEndOfStream;
+
+    size_t frameSize = (size_t)m_width * m_height * 4;
+    const BYTE* data = m_mappedData + frameSize * (m_readFrames % m_fileFrameCount);
+
+    if (m_options.CopyFrames)
+    {
+        HRESULT hr = m_framePool->AcquireMemory(frameSize, frame.Source);
+        if (FAILED(hr))
+            return hr;
+        memcpy(frame.Source.GetData(), data, frameSize);
+        frame.SourceView = MakeBGRAImageView(frame.Source.GetData(), m_width, m_height);
+    }
+    else
+    {
+        // 直接引用映射的文件（只读）
+        frame.SourceView = MakeBGRAImageView(const_cast<BYTE*>(data), m_width, m_height);
+    }
+
+    frame.Width = m_width;
+    frame.Height = m_height;
+    // 单帧文件循环播放时内容不变，转换阶段可以跳过整帧转换
+    frame.DirtyRectCount = 0;
+    frame.MoveCount = 0;
+    frame.DirtyRectsValid = m_fileFrameCount == 1 && m_readFrames > 0;
+    m_readFrames++;
+    return S_OK;
+}
+
+void FileReplaySource::Cleanup()
+{
+    UnmapFile();
+    m_framePool = nullptr;
+    m_width = 0;
+    m_height = 0;
+    m_fileFrameCount = 0;
+    m_readFrames = 0;
+}
+
+// ---------------------------------------------------------------------------
+// TileDamageSource
+// ---------------------------------------------------------------------------
+
+TileDamageSource::TileDamageSource()
+    : m_source(nullptr)
+    , m_detectedFrames(0)
+    , m_unchangedFrames(0)
+    , m_scrolledFrames(0)
+    , m_changedTiles(0)
+    , m_totalTiles(0)
+    , m_scrollDetection(false)
+{
+}
+
+TileDamageSource::~TileDamageSource()
+{
+    Cleanup();
+}
+
+HRESULT TileDamageSource::Initialize(IFrameSource* source, const CpuConversionOptions& options)
+{
+    if (!source)
+        return E_INVALIDARG;
+
+    HRESULT hr = m_detector.Initialize(options);
+    if (FAILED(hr))
+        return hr;
+
+    m_source = source;
+    m_scrollDetection = options.ScrollDetection;
+    m_rects.reserve(kMaxPipelineDirtyRects);
+    m_moves.reserve(kMaxPipelineMoves);
+    m_detectedFrames = 0;
+    m_unchangedFrames = 0;
+    m_scrolledFrames = 0;
+    m_changedTiles = 0;
+    m_totalTiles = 0;
+    return S_OK;
+}
+
+HRESULT TileDamageSource::ReadFrame(PipelineFrame& frame)
+{
+    if (!m_source)
+        return E_FAIL;
+
+    HRESULT hr = m_source->ReadFrame(frame);
+    if (hr != S_OK)
+        return hr;
+
+    if (frame.DirtyRectsValid || !frame.SourceView.Planes[0].Data)
+    {
+        // 这一帧的变化不经过检测器，之后的帧不能再与检测器保存的更早的帧比较
+        m_detector.Reset();
+        return S_OK;
+    }
+
+    bool fullFrame = true;
+    m_moves.clear();
+    hr = m_scrollDetection ? m_detector.DetectDamage(frame.SourceView, m_moves, m_rects, fullFrame)
+                           : m_detector.DetectDamage(frame.SourceView, m_rects, fullFrame);
+    if (FAILED(hr) || fullFrame)
+    {
+        // 检测失败或没有可比较的上一帧：保持整帧变化
+        return S_OK;
+    }
+
+    frame.DirtyRectsValid = true;
+    frame.DirtyRectCount = 0;
+    frame.MoveCount = 0;
+    for (const ImageMove& move : m_moves)
+    {
+        AddPipelineMove(frame, move);
+    }
+    for (const ImageRect& rect : m_rects)
+    {
+        AddPipelineDirtyRect(frame, rect);
+    }
+
+    m_detectedFrames++;
+    m_unchangedFrames += (m_rects.empty() && m_moves.empty()) ? 1 : 0;
+    m_scrolledFrames += m_moves.empty() ? 0 : 1;
+    m_changedTiles += m_detector.GetChangedTileCount();
+    m_totalTiles += m_detector.GetTileCount();
+    return S_OK;
+}
+
+double TileDamageSource::GetChangedTileRatio() const
+{
+    return m_totalTiles ? static_cast<double>(m_changedTiles) / m_totalTiles : 0.0;
+}
+
+void TileDamageSource::Cleanup()
+{
+    m_detector.Cleanup();
+    m_source = nullptr;
+    m_rects.clear();
+    m_moves.clear();
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "FramePipeline.h"
+#include "FramePool.h"
+#include "ImageView.h"
+#include "TileDamageDetector.h"
+#include "Utils.h"
+#include <string>
+#include <vector>
+
+// DXGICapture之外的帧源，用于在没有Windows桌面的环境（Linux CI、性能测试机）上
+// 以可控、可复现的帧率压测转换流水线。两者都产生CPU内存中的BGRA帧（frame.SourceView），
+// 帧率由FramePipelineOptions::TargetFrameRate控制，帧内容只取决于帧序号，多次运行结果一致。
+
+enum class SyntheticPattern
+{
+    ColorBars,      // 水平滚动的彩条，叠加一条向下移动的白色横带
+    Checkerboard,   // 沿对角线移动的64x64棋盘格
+    Noise,          // 逐像素伪随机噪声（每帧完全不同，最坏情况）
+    Desktop         // 静态桌面上的视频窗口、逐字输入的文本、滚动的文档和拖动的窗口，
+                    // 报告每帧的脏矩形和移动
+};
+
+// GetDirtyRects最多返回的矩形数和移动数
+const UINT kMaxSyntheticDirtyRects = 6;
+const UINT kMaxSyntheticMoves = 3;
+
+struct SyntheticSourceOptions
+{
+    UINT Width = 1920;
+    UINT Height = 1080;
+    UINT Pitch = 0;             // 输出帧的行步长，0表示紧凑
+    SyntheticPattern Pattern = SyntheticPattern::ColorBars;
+    UINT FrameCount = 0;        // 产生的帧数，0表示不限
+};
+
+// 动画测试图案帧源，帧从帧池借用
+class SyntheticFrameSource : public IFrameSource
+{
+public:
+    SyntheticFrameSource();
+    ~SyntheticFrameSource();
+
+    HRESULT Initialize(FramePool* framePool, const SyntheticSourceOptions& options = SyntheticSourceOptions());
+    HRESULT ReadFrame(PipelineFrame& frame) override;
+    void Cleanup();
+
+    // 将第frameIndex帧的图案绘制到任意BGRA视图（也可用于生成参考结果）
+    static HRESULT RenderFrame(SyntheticPattern pattern, unsigned long long frameIndex, const ImageView& destination);
+    // 第frameIndex帧相对上一帧的移动和脏矩形（rects、moves至少容纳kMaxSyntheticDirtyRects、
+    // kMaxSyntheticMoves个），返回false表示整帧都变化了（不提供脏矩形的图案或第一帧）
+    static bool GetDirtyRects(SyntheticPattern pattern, unsigned long long frameIndex,
+                              UINT width, UINT height, ImageRect* rects, UINT& rectCount,
+                              ImageMove* moves, UINT& moveCount);
+    static const char* GetPatternName(SyntheticPattern pattern);
+    // 命令行名称：bars、checker、noise、desktop
+    static bool ParsePattern(const std::string& name, SyntheticPattern& pattern);
+
+private:
+    FramePool* m_framePool;
+    SyntheticSourceOptions m_options;
+    unsigned long long m_readFrames;
+    bool m_initialized;
+};
+
+struct FileReplayOptions
+{
+    UINT Width = 0;             // 0表示从文件名（captured_frame_WxH.bgra）解析
+    UINT Height = 0;
+    UINT FrameCount = 0;        // 产生的帧数，0表示不限（文件中的帧循环播放）
+    bool CopyFrames = false;    // 每帧复制到帧池中的内存（模拟采集的读回），否则直接引用映射的文件
+};
+
+// 回放SaveBGRAToFile保存的原始BGRA文件（紧凑布局，可以是多帧首尾相接）
+// 文件以只读方式映射到内存并循环播放。不复制时SourceView直接指向映射区域，
+// 只能读取，在Cleanup之前有效
+class FileReplaySource : public IFrameSource
+{
+public:
+    FileReplaySource();
+    ~FileReplaySource();
+
+    // 不复制帧时framePool可以为空
+    HRESULT Initialize(const std::string& path, FramePool* framePool,
+                       const FileReplayOptions& options = FileReplayOptions());
+    HRESULT ReadFrame(PipelineFrame& frame) override;
+    void Cleanup();
+
+    UINT GetWidth() const { return m_width; }
+    UINT GetHeight() const { return m_height; }
+    UINT GetFileFrameCount() const { return m_fileFrameCount; }
+
+    // 从"..._WxH.bgra"形式的文件名中解析尺寸
+    static bool ParseFrameSize(const std::string& path, UINT& width, UINT& height);
+
+private:
+    HRESULT MapFile(const std::string& path);
+    void UnmapFile();
+
+    FramePool* m_framePool;
+    FileReplayOptions m_options;
+    const BYTE* m_mappedData;
+    size_t m_mappedSize;
+    UINT m_width;
+    UINT m_height;
+    UINT m_fileFrameCount;
+    unsigned long long m_readFrames;
+
+#ifdef _WIN32
+    HANDLE m_file;
+    HANDLE m_mapping;
+#else
+    int m_file;
+#endif
+};
+
+// 为不提供脏矩形的CPU帧源补上脏矩形：包装另一个帧源，用TileDamageDetector比较相邻两帧的分块哈希。
+// 内容完全未变的帧报告为没有脏矩形和移动（DirtyRectsValid为true），转换阶段可以直接复用上一帧的输出；
+// 启用CpuConversionOptions::ScrollDetection时，检测到的垂直滚动报告为移动，转换阶段在上一帧的输出上搬移，只转换新露出的行；
+// 检测到的矩形随帧一直传到输出阶段，下游编码器可以据此只编码变化的区域。
+// 内层帧源自己提供脏矩形的帧原样传递（之后的帧重新与完整的上一帧比较），GPU帧（没有SourceView）同样原样传递
+class TileDamageSource : public IFrameSource
+{
+public:
+    TileDamageSource();
+    ~TileDamageSource();
+
+    HRESULT Initialize(IFrameSource* source, const CpuConversionOptions& options = CpuConversionOptions());
+    HRESULT ReadFrame(PipelineFrame& frame) override;
+    void Cleanup();
+
+    // 检测过的帧数、其中内容未变的帧数、检测到滚动的帧数，以及检测到变化的分块占全部分块的比例
+    unsigned long long GetDetectedFrames() const { return m_detectedFrames; }
+    unsigned long long GetUnchangedFrames() const { return m_unchangedFrames; }
+    unsigned long long GetScrolledFrames() const { return m_scrolledFrames; }
+    double GetChangedTileRatio() const;
+
+private:
+    IFrameSource* m_source;
+    TileDamageDetector m_detector;
+    std::vector<ImageRect> m_rects;     // 每帧复用
+    std::vector<ImageMove> m_moves;
+    unsigned long long m_detectedFrames;
+    unsigned long long m_unchangedFrames;
+    unsigned long long m_scrolledFrames;
+    unsigned long long m_changedTiles;
+    unsigned long long m_totalTiles;
+    bool m_scrollDetection;
+};
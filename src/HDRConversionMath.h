@@ -0,0 +1,153 @@
+#pragma once
+#include "Utils.h"
+#include <algorithm>
+#include <cstring>
+
+// HDR输入（R10G10B10A2_UNORM、R16G16B16A16_FLOAT）到10位YUV（P010/P210）的公共数学函数，
+// 供标量及SIMD内核共享（见HDRToYUV10Kernels.h）。
+//
+// 输出为BT.2020非恒定亮度矩阵、PQ（SMPTE ST 2084）编码、10位限制范围（Y:[64,940]，UV:[64,960]）。
+//   - R10G10B10A2：HDR桌面的10位格式已经是PQ编码的BT.2020 RGB（DXGI_COLOR_SPACE_RGB_FULL_G2084_NONE_P2020），
+//     只需要矩阵运算；
+//   - R16G16B16A16_FLOAT：scRGB线性光（BT.709基色，1.0 = 80尼特，可以为负或大于1），
+//     先用浮点矩阵转换到BT.2020基色并归一化到10000尼特，再查表完成PQ编码。
+//
+// PQ编码查表：按浮点数的位模式取指数和最高10位尾数（舍入）作为下标，覆盖[2^-40, 1]，
+// 下标误差相当于半精度浮点的精度（输入本身就是半精度），对应的10位码值误差小于0.1；
+// 不需要逐像素计算pow，SIMD内核可以用gather或逐通道读取同一张表，结果与标量代码逐位一致。
+// 表中的值为Q14定点（[0, 16384]），R10G10B10A2的10位值也扩展到Q14，之后两种输入共用定点矩阵。
+//
+// 定点矩阵与8位路径相同：Q14分量两两打包后用pmaddwd计算，常数项通过值为16384的"常量1"通道得到，
+// 系数为BT.2020系数 * (876或896) * 2^19 / 2^14，结果右移19位得到10位码值。
+
+const int kPQFixedBits = 14;
+const int kPQFixedOne = 1 << kPQFixedBits;      // Q14的1.0，同时也是常数项通道的取值
+const int kYUV10Shift = 19;
+
+const int kY10CoefR = 7364;       // 0.2627 * 876 * 2^5
+const int kY10CoefG = 19006;      // 0.6780 * 876 * 2^5
+const int kY10CoefB = 1662;       // 0.0593 * 876 * 2^5
+const int kY10CoefOne = 2064;     // (64 + 0.5) * 2^19 / 16384，含取整偏移
+
+const int kU10CoefR = -4003;      // -0.13963 * 896 * 2^5
+const int kU10CoefG = -10333;     // -0.36037 * 896 * 2^5
+const int kU10CoefB = 14336;      //  0.5     * 896 * 2^5
+const int kV10CoefR = 14336;      //  0.5     * 896 * 2^5
+const int kV10CoefG = -13183;     // -0.45979 * 896 * 2^5
+const int kV10CoefB = -1153;      // -0.04021 * 896 * 2^5
+const int kUV10CoefOne = 16384;   // 512 * 2^19 / 16384
+
+// 钳位后的UV最大为960*2^19，2x2块四个值之和仍小于2^31
+const int kUV10FixedMin = 64 << kYUV10Shift;
+const int kUV10FixedMax = 960 << kYUV10Shift;
+
+// scRGB（BT.709基色，1.0 = 80尼特）到BT.2020基色、按10000尼特归一化的线性光矩阵（已乘以80/10000）
+const float kScRGBToBT2020[3][3] = {
+    { 0.627403896f * 0.008f, 0.329283038f * 0.008f, 0.043313066f * 0.008f },
+    { 0.069097289f * 0.008f, 0.919540395f * 0.008f, 0.011362316f * 0.008f },
+    { 0.016391439f * 0.008f, 0.088013308f * 0.008f, 0.895595253f * 0.008f },
+};
+
+// PQ编码表的范围：下标 = ((浮点位模式 + 2^12) >> 13) - kPQTableBase
+const int kPQTableMinExponent = -40;
+const UINT kPQTableBase = (UINT)(127 + kPQTableMinExponent) << 10;
+const UINT kPQTableSize = (127u << 10) - kPQTableBase + 1;
+const float kPQTableMinValue = 9.094947017729282e-13f;    // 2^-40
+
+// 返回PQ编码表（kPQTableSize项Q14值，末尾多一项填充，供按32位读取的gather使用），第一次调用时生成
+const UINT16* GetPQEncodeTable();
+
+// SMPTE ST 2084逆EOTF：归一化线性光（1.0 = 10000尼特）到PQ信号值，浮点参考路径和生成查表使用
+double PQEncode(double linear);
+
+// 半精度浮点（位模式）转换为单精度：指数和尾数左移13位后乘以2^112重新偏置（非规格化数同样正确），
+// 无穷大和NaN得到大于1的有限值，后续钳位为1
+inline float HalfToFloat(UINT half)
+{
+    UINT magnitude = (half & 0x7FFF) << 13;
+    float value;
+    memcpy(&value, &magnitude, sizeof(value));
+    value *= 5.192296858534828e33f;    // 2^112
+    UINT bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits |= (half & 0x8000) << 16;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 归一化线性光查表得到Q14 PQ值（NaN、负值和过小的值按黑色处理，大于1的值按10000尼特处理）
+inline int PQEncodeFixed(const UINT16* table, float linear)
+{
+    linear = linear > kPQTableMinValue ? linear : kPQTableMinValue;
+    linear = linear < 1.0f ? linear : 1.0f;
+    UINT bits;
+    memcpy(&bits, &linear, sizeof(bits));
+    return table[((bits + (1u << 12)) >> 13) - kPQTableBase];
+}
+
+// scRGB半精度像素（内存顺序R,G,B,A）转换为Q14 PQ编码的BT.2020 RGB
+inline void DecodeScRGBPixel(const UINT16* table, const BYTE* pixel, int& r, int& g, int& b)
+{
+    UINT16 half[3];
+    memcpy(half, pixel, sizeof(half));
+    float r709 = HalfToFloat(half[0]);
+    float g709 = HalfToFloat(half[1]);
+    float b709 = HalfToFloat(half[2]);
+
+    const float (*m)[3] = kScRGBToBT2020;
+    r = PQEncodeFixed(table, m[0][0] * r709 + m[0][1] * g709 + m[0][2] * b709);
+    g = PQEncodeFixed(table, m[1][0] * r709 + m[1][1] * g709 + m[1][2] * b709);
+    b = PQEncodeFixed(table, m[2][0] * r709 + m[2][1] * g709 + m[2][2] * b709);
+}
+
+// 10位分量扩展到Q14：v * 16 + v / 64（1023对应16383）
+inline int Expand10BitToFixed(UINT value)
+{
+    return static_cast<int>((value << 4) | (value >> 6));
+}
+
+// R10G10B10A2像素（R在低位）转换为Q14 PQ编码的BT.2020 RGB
+inline void DecodeR10G10B10A2Pixel(const BYTE* pixel, int& r, int& g, int& b)
+{
+    UINT value;
+    memcpy(&value, pixel, sizeof(value));
+    r = Expand10BitToFixed(value & 0x3FF);
+    g = Expand10BitToFixed((value >> 10) & 0x3FF);
+    b = Expand10BitToFixed((value >> 20) & 0x3FF);
+}
+
+inline UINT FixedY10(int r, int g, int b)
+{
+    int y = (kY10CoefR * r + kY10CoefG * g + kY10CoefB * b + kY10CoefOne * kPQFixedOne) >> kYUV10Shift;
+    return static_cast<UINT>((std::min)((std::max)(y, 64), 940));
+}
+
+// 单个像素的定点UV（保留小数位，用于块平均）
+inline int FixedU10(int r, int g, int b)
+{
+    int u = kU10CoefR * r + kU10CoefG * g + kU10CoefB * b + kUV10CoefOne * kPQFixedOne;
+    return (std::min)((std::max)(u, kUV10FixedMin), kUV10FixedMax);
+}
+
+inline int FixedV10(int r, int g, int b)
+{
+    int v = kV10CoefR * r + kV10CoefG * g + kV10CoefB * b + kUV10CoefOne * kPQFixedOne;
+    return (std::min)((std::max)(v, kUV10FixedMin), kUV10FixedMax);
+}
+
+// 4:2:2两个像素、4:2:0四个像素的定点UV之和取平均并舍入到10位
+inline UINT FixedAverageUV10x2(int sum)
+{
+    return static_cast<UINT>((sum + (1 << kYUV10Shift)) >> (kYUV10Shift + 1));
+}
+
+inline UINT FixedAverageUV10x4(int sum)
+{
+    return static_cast<UINT>((sum + (1 << (kYUV10Shift + 1))) >> (kYUV10Shift + 2));
+}
+
+// P010/P210的16位样本：10位码值在高位
+inline UINT16 ToP010Sample(UINT value)
+{
+    return static_cast<UINT16>(value << 6);
+}
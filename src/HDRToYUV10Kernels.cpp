@@ -0,0 +1,365 @@
+#include "HDRToYUV10Kernels.h"
+#include "HDRConversionMath.h"
+#include <cmath>
+
+namespace
+{
+    // PQ编码表：第i项为位模式(i + kPQTableBase) << 13的浮点数的Q14 PQ值
+    struct PQEncodeTable
+    {
+        UINT16 Values[kPQTableSize + 1];
+
+        PQEncodeTable()
+        {
+            for (UINT i = 0; i < kPQTableSize; i++)
+            {
+                UINT bits = (i + kPQTableBase) << 13;
+                float linear;
+                memcpy(&linear, &bits, sizeof(linear));
+                Values[i] = static_cast<UINT16>(std::floor(PQEncode(linear) * kPQFixedOne + 0.5));
+            }
+            Values[kPQTableSize] = Values[kPQTableSize - 1];
+        }
+    };
+
+    template <HDRInputFormat Format>
+    inline void DecodePixelFixed(const UINT16* table, const BYTE* row, UINT x, int& r, int& g, int& b)
+    {
+        if constexpr (Format == HDRInputFormat::R16G16B16A16Float)
+            DecodeScRGBPixel(table, row + x * 8, r, g, b);
+        else
+            DecodeR10G10B10A2Pixel(row + x * 4, r, g, b);
+    }
+
+    // 转换x处的2x2块（奇数宽度时x1 == x），写出Y以及块平均后的一个UV对
+    template <HDRInputFormat Format>
+    inline void ConvertBlockFixed(const UINT16* table, const BYTE* srcRow0, const BYTE* row1,
+                                  UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT x, UINT width)
+    {
+        UINT x1 = (x + 1 < width) ? x + 1 : x;
+        int r[4];
+        int g[4];
+        int b[4];
+        DecodePixelFixed<Format>(table, srcRow0, x, r[0], g[0], b[0]);
+        DecodePixelFixed<Format>(table, srcRow0, x1, r[1], g[1], b[1]);
+        DecodePixelFixed<Format>(table, row1, x, r[2], g[2], b[2]);
+        DecodePixelFixed<Format>(table, row1, x1, r[3], g[3], b[3]);
+
+        int u = 0;
+        int v = 0;
+        for (UINT i = 0; i < 4; i++)
+        {
+            u += FixedU10(r[i], g[i], b[i]);
+            v += FixedV10(r[i], g[i], b[i]);
+        }
+
+        yRow0[x] = ToP010Sample(FixedY10(r[0], g[0], b[0]));
+        if (x + 1 < width)
+            yRow0[x + 1] = ToP010Sample(FixedY10(r[1], g[1], b[1]));
+        if (yRow1)
+        {
+            yRow1[x] = ToP010Sample(FixedY10(r[2], g[2], b[2]));
+            if (x + 1 < width)
+                yRow1[x + 1] = ToP010Sample(FixedY10(r[3], g[3], b[3]));
+        }
+        uvRow[x] = ToP010Sample(FixedAverageUV10x4(u));
+        uvRow[x + 1] = ToP010Sample(FixedAverageUV10x4(v));
+    }
+
+    template <HDRInputFormat Format>
+    inline void ConvertPairFixed(const UINT16* table, const BYTE* srcRow, UINT16* yRow, UINT16* uvRow,
+                                 UINT x, UINT width)
+    {
+        UINT x1 = (x + 1 < width) ? x + 1 : x;
+        int r[2];
+        int g[2];
+        int b[2];
+        DecodePixelFixed<Format>(table, srcRow, x, r[0], g[0], b[0]);
+        DecodePixelFixed<Format>(table, srcRow, x1, r[1], g[1], b[1]);
+
+        yRow[x] = ToP010Sample(FixedY10(r[0], g[0], b[0]));
+        if (x + 1 < width)
+            yRow[x + 1] = ToP010Sample(FixedY10(r[1], g[1], b[1]));
+        uvRow[x] = ToP010Sample(FixedAverageUV10x2(FixedU10(r[0], g[0], b[0]) + FixedU10(r[1], g[1], b[1])));
+        uvRow[x + 1] = ToP010Sample(FixedAverageUV10x2(FixedV10(r[0], g[0], b[0]) + FixedV10(r[1], g[1], b[1])));
+    }
+
+    template <HDRInputFormat Format>
+    void ConvertRowPairTail(const BYTE* srcRow0, const BYTE* srcRow1, UINT16* yRow0, UINT16* yRow1,
+                            UINT16* uvRow, UINT firstPixel, UINT width)
+    {
+        // 奇数高度的最后一行：色度只来自这一行（两行相同）
+        const UINT16* table = GetPQEncodeTable();
+        const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+        for (UINT x = firstPixel; x < width; x += 2)
+        {
+            ConvertBlockFixed<Format>(table, srcRow0, row1, yRow0, yRow1, uvRow, x, width);
+        }
+    }
+
+    template <HDRInputFormat Format>
+    void ConvertRowTail(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT firstPixel, UINT width)
+    {
+        const UINT16* table = GetPQEncodeTable();
+        for (UINT x = firstPixel; x < width; x += 2)
+        {
+            ConvertPairFixed<Format>(table, srcRow, yRow, uvRow, x, width);
+        }
+    }
+
+    // ---------------------------------------------------------------------------
+    // 浮点参考：双精度矩阵和逐像素pow，不使用查表
+
+    // scRGB到BT.2020基色（未乘80/10000）
+    const double kBT709ToBT2020[3][3] = {
+        { 0.627403895934699, 0.329283038377884, 0.043313065687417 },
+        { 0.069097289358232, 0.919540395075459, 0.011362315566309 },
+        { 0.016391438875150, 0.088013307877226, 0.895595253247624 },
+    };
+
+    struct YUV10Double
+    {
+        double Y;
+        double U;
+        double V;
+    };
+
+    // NaN和负值按黑色处理
+    inline double ClampUnit(double value)
+    {
+        return value > 0.0 ? (value < 1.0 ? value : 1.0) : 0.0;
+    }
+
+    template <HDRInputFormat Format>
+    inline YUV10Double ConvertPixelFloat(const BYTE* row, UINT x)
+    {
+        double rgb[3];
+        if constexpr (Format == HDRInputFormat::R16G16B16A16Float)
+        {
+            UINT16 half[3];
+            memcpy(half, row + x * 8, sizeof(half));
+            double linear[3] = { HalfToFloat(half[0]), HalfToFloat(half[1]), HalfToFloat(half[2]) };
+            for (int i = 0; i < 3; i++)
+            {
+                const double* m = kBT709ToBT2020[i];
+                double value = (m[0] * linear[0] + m[1] * linear[1] + m[2] * linear[2]) * (80.0 / 10000.0);
+                rgb[i] = PQEncode(ClampUnit(value));
+            }
+        }
+        else
+        {
+            UINT value;
+            memcpy(&value, row + x * 4, sizeof(value));
+            for (int i = 0; i < 3; i++)
+            {
+                rgb[i] = ((value >> (i * 10)) & 0x3FF) / 1023.0;
+            }
+        }
+
+        // BT.2020非恒定亮度，10位限制范围；UV与定点路径一样逐像素钳位后再平均
+        double luma = 0.2627 * rgb[0] + 0.6780 * rgb[1] + 0.0593 * rgb[2];
+        YUV10Double yuv;
+        yuv.Y = 64.0 + 876.0 * luma;
+        yuv.U = (std::min)((std::max)(512.0 + 896.0 * (rgb[2] - luma) / 1.8814, 64.0), 960.0);
+        yuv.V = (std::min)((std::max)(512.0 + 896.0 * (rgb[0] - luma) / 1.4746, 64.0), 960.0);
+        return yuv;
+    }
+
+    inline UINT16 RoundY10(double value)
+    {
+        return ToP010Sample(static_cast<UINT>((std::min)((std::max)(std::floor(value + 0.5), 64.0), 940.0)));
+    }
+
+    inline UINT16 RoundUV10(double value)
+    {
+        return ToP010Sample(static_cast<UINT>(std::floor(value + 0.5)));
+    }
+
+    template <HDRInputFormat Format>
+    void ConvertRowPairFloat(const BYTE* srcRow0, const BYTE* srcRow1, UINT16* yRow0, UINT16* yRow1,
+                             UINT16* uvRow, UINT width)
+    {
+        const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+        for (UINT x = 0; x < width; x += 2)
+        {
+            UINT x1 = (x + 1 < width) ? x + 1 : x;
+            YUV10Double yuv[4] = { ConvertPixelFloat<Format>(srcRow0, x), ConvertPixelFloat<Format>(srcRow0, x1),
+                                   ConvertPixelFloat<Format>(row1, x), ConvertPixelFloat<Format>(row1, x1) };
+
+            yRow0[x] = RoundY10(yuv[0].Y);
+            if (x + 1 < width)
+                yRow0[x + 1] = RoundY10(yuv[1].Y);
+            if (yRow1)
+            {
+                yRow1[x] = RoundY10(yuv[2].Y);
+                if (x + 1 < width)
+                    yRow1[x + 1] = RoundY10(yuv[3].Y);
+            }
+            uvRow[x] = RoundUV10((yuv[0].U + yuv[1].U + yuv[2].U + yuv[3].U) * 0.25);
+            uvRow[x + 1] = RoundUV10((yuv[0].V + yuv[1].V + yuv[2].V + yuv[3].V) * 0.25);
+        }
+    }
+
+    template <HDRInputFormat Format>
+    void ConvertRowFloat(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+    {
+        for (UINT x = 0; x < width; x += 2)
+        {
+            UINT x1 = (x + 1 < width) ? x + 1 : x;
+            YUV10Double yuv[2] = { ConvertPixelFloat<Format>(srcRow, x), ConvertPixelFloat<Format>(srcRow, x1) };
+
+            yRow[x] = RoundY10(yuv[0].Y);
+            if (x + 1 < width)
+                yRow[x + 1] = RoundY10(yuv[1].Y);
+            uvRow[x] = RoundUV10((yuv[0].U + yuv[1].U) * 0.5);
+            uvRow[x + 1] = RoundUV10((yuv[0].V + yuv[1].V) * 0.5);
+        }
+    }
+}
+
+double PQEncode(double linear)
+{
+    const double m1 = 2610.0 / 16384.0;
+    const double m2 = 2523.0 / 4096.0 * 128.0;
+    const double c1 = 3424.0 / 4096.0;
+    const double c2 = 2413.0 / 4096.0 * 32.0;
+    const double c3 = 2392.0 / 4096.0 * 32.0;
+
+    double lm = std::pow(linear, m1);
+    return std::pow((c1 + c2 * lm) / (1.0 + c3 * lm), m2);
+}
+
+const UINT16* GetPQEncodeTable()
+{
+    // 局部静态对象的初始化是线程安全的，第一次使用时生成（约40K项）
+    static const PQEncodeTable table;
+    return table.Values;
+}
+
+void HDRToP010RowPairTail_C(HDRInputFormat format, const BYTE* srcRow0, const BYTE* srcRow1,
+                            UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT firstPixel, UINT width)
+{
+    if (format == HDRInputFormat::R16G16B16A16Float)
+        ConvertRowPairTail<HDRInputFormat::R16G16B16A16Float>(srcRow0, srcRow1, yRow0, yRow1, uvRow, firstPixel, width);
+    else
+        ConvertRowPairTail<HDRInputFormat::R10G10B10A2>(srcRow0, srcRow1, yRow0, yRow1, uvRow, firstPixel, width);
+}
+
+void HDRToP210RowTail_C(HDRInputFormat format, const BYTE* srcRow, UINT16* yRow, UINT16* uvRow,
+                        UINT firstPixel, UINT width)
+{
+    if (format == HDRInputFormat::R16G16B16A16Float)
+        ConvertRowTail<HDRInputFormat::R16G16B16A16Float>(srcRow, yRow, uvRow, firstPixel, width);
+    else
+        ConvertRowTail<HDRInputFormat::R10G10B10A2>(srcRow, yRow, uvRow, firstPixel, width);
+}
+
+void R10G10B10A2ToP010RowPair_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                                UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width)
+{
+    ConvertRowPairTail<HDRInputFormat::R10G10B10A2>(srcRow0, srcRow1, yRow0, yRow1, uvRow, 0, width);
+}
+
+void ScRGBToP010RowPair_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                          UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width)
+{
+    ConvertRowPairTail<HDRInputFormat::R16G16B16A16Float>(srcRow0, srcRow1, yRow0, yRow1, uvRow, 0, width);
+}
+
+void R10G10B10A2ToP210Row_C(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+{
+    ConvertRowTail<HDRInputFormat::R10G10B10A2>(srcRow, yRow, uvRow, 0, width);
+}
+
+void ScRGBToP210Row_C(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+{
+    ConvertRowTail<HDRInputFormat::R16G16B16A16Float>(srcRow, yRow, uvRow, 0, width);
+}
+
+void R10G10B10A2ToP010RowPair_Float(const BYTE* srcRow0, const BYTE* srcRow1,
+                                    UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width)
+{
+    ConvertRowPairFloat<HDRInputFormat::R10G10B10A2>(srcRow0, srcRow1, yRow0, yRow1, uvRow, width);
+}
+
+void ScRGBToP010RowPair_Float(const BYTE* srcRow0, const BYTE* srcRow1,
+                              UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width)
+{
+    ConvertRowPairFloat<HDRInputFormat::R16G16B16A16Float>(srcRow0, srcRow1, yRow0, yRow1, uvRow, width);
+}
+
+void R10G10B10A2ToP210Row_Float(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+{
+    ConvertRowFloat<HDRInputFormat::R10G10B10A2>(srcRow, yRow, uvRow, width);
+}
+
+void ScRGBToP210Row_Float(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+{
+    ConvertRowFloat<HDRInputFormat::R16G16B16A16Float>(srcRow, yRow, uvRow, width);
+}
+
+HDRToP010RowPairFunc GetHDRToP010RowPairKernel(HDRInputFormat format, SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    bool scRGB = format == HDRInputFormat::R16G16B16A16Float;
+    HDRToP010RowPairFunc kernel = scRGB ? ScRGBToP010RowPair_C : R10G10B10A2ToP010RowPair_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernel = scRGB ? ScRGBToP010RowPair_AVX2 : R10G10B10A2ToP010RowPair_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = scRGB ? ScRGBToP010RowPair_SSE41 : R10G10B10A2ToP010RowPair_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
+
+HDRToP210RowFunc GetHDRToP210RowKernel(HDRInputFormat format, SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    bool scRGB = format == HDRInputFormat::R16G16B16A16Float;
+    HDRToP210RowFunc kernel = scRGB ? ScRGBToP210Row_C : R10G10B10A2ToP210Row_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernel = scRGB ? ScRGBToP210Row_AVX2 : R10G10B10A2ToP210Row_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = scRGB ? ScRGBToP210Row_SSE41 : R10G10B10A2ToP210Row_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
+
+HDRToP010RowPairFunc GetHDRToP010RowPairFloatKernel(HDRInputFormat format)
+{
+    return format == HDRInputFormat::R16G16B16A16Float ? ScRGBToP010RowPair_Float : R10G10B10A2ToP010RowPair_Float;
+}
+
+HDRToP210RowFunc GetHDRToP210RowFloatKernel(HDRInputFormat format)
+{
+    return format == HDRInputFormat::R16G16B16A16Float ? ScRGBToP210Row_Float : R10G10B10A2ToP210Row_Float;
+}
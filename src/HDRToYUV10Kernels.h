@@ -0,0 +1,70 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+
+// HDR桌面格式到10位YUV的CPU内核，颜色公式见HDRConversionMath.h（BT.2020、PQ、10位限制范围）
+enum class HDRInputFormat
+{
+    R10G10B10A2,        // DXGI_FORMAT_R10G10B10A2_UNORM，PQ编码的BT.2020（HDR10），每像素4字节
+    R16G16B16A16Float   // DXGI_FORMAT_R16G16B16A16_FLOAT，scRGB线性光，每像素8字节
+};
+
+inline UINT GetHDRInputBytesPerPixel(HDRInputFormat format)
+{
+    return format == HDRInputFormat::R16G16B16A16Float ? 8 : 4;
+}
+
+// P010（4:2:0）行对内核：一次读取两行源像素，写出两行Y以及一行交错的UV（U在前，每个样本16位）。
+// UV取2x2块四个像素的定点UV（各自钳位后）的平均值，奇数宽度时最后一列复制自身，
+// srcRow1/yRow1为空时（奇数高度的最后一行）第二行取第一行，与BGRAToYUV420Kernels.h的约定相同。
+// 所有定点内核使用同一张PQ编码表和同一套定点系数，输出逐位一致；SIMD内核最高提供AVX2版本
+typedef void (*HDRToP010RowPairFunc)(const BYTE* srcRow0, const BYTE* srcRow1,
+                                     UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+
+// P210（4:2:2）行内核：UV取水平相邻两个像素的平均值
+typedef void (*HDRToP210RowFunc)(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+
+void R10G10B10A2ToP010RowPair_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                                UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+void ScRGBToP010RowPair_C(const BYTE* srcRow0, const BYTE* srcRow1,
+                          UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+void R10G10B10A2ToP210Row_C(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+void ScRGBToP210Row_C(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+
+// 浮点参考（双精度矩阵、逐像素计算PQ曲线），ConversionPrecision::FloatReference使用
+void R10G10B10A2ToP010RowPair_Float(const BYTE* srcRow0, const BYTE* srcRow1,
+                                    UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+void ScRGBToP010RowPair_Float(const BYTE* srcRow0, const BYTE* srcRow1,
+                              UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+void R10G10B10A2ToP210Row_Float(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+void ScRGBToP210Row_Float(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+void R10G10B10A2ToP010RowPair_SSE41(const BYTE* srcRow0, const BYTE* srcRow1,
+                                    UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+void ScRGBToP010RowPair_SSE41(const BYTE* srcRow0, const BYTE* srcRow1,
+                              UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+void R10G10B10A2ToP210Row_SSE41(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+void ScRGBToP210Row_SSE41(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+
+void R10G10B10A2ToP010RowPair_AVX2(const BYTE* srcRow0, const BYTE* srcRow1,
+                                   UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+void ScRGBToP010RowPair_AVX2(const BYTE* srcRow0, const BYTE* srcRow1,
+                             UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width);
+void R10G10B10A2ToP210Row_AVX2(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+void ScRGBToP210Row_AVX2(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width);
+#endif
+
+// 从第firstPixel个像素（必须为偶数）开始用标量定点代码转换到行尾，供SIMD内核处理尾部
+void HDRToP010RowPairTail_C(HDRInputFormat format, const BYTE* srcRow0, const BYTE* srcRow1,
+                            UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT firstPixel, UINT width);
+void HDRToP210RowTail_C(HDRInputFormat format, const BYTE* srcRow, UINT16* yRow, UINT16* uvRow,
+                        UINT firstPixel, UINT width);
+
+// 返回该输入格式不超过level的最优内核（最高提供AVX2版本）
+HDRToP010RowPairFunc GetHDRToP010RowPairKernel(HDRInputFormat format, SimdLevel level,
+                                               SimdLevel* selectedLevel = nullptr);
+HDRToP210RowFunc GetHDRToP210RowKernel(HDRInputFormat format, SimdLevel level, SimdLevel* selectedLevel = nullptr);
+
+HDRToP010RowPairFunc GetHDRToP010RowPairFloatKernel(HDRInputFormat format);
+HDRToP210RowFunc GetHDRToP210RowFloatKernel(HDRInputFormat format);
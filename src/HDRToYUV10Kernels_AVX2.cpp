@@ -0,0 +1,238 @@
+#include "HDRToYUV10Kernels.h"
+#include "ColorConversionMath.h"
+#include "HDRConversionMath.h"
+#include <immintrin.h>
+
+// AVX2内核：算法与SSE4.1版本相同，每个寄存器处理8个像素，每次迭代处理16个像素（P010为两行各16个）。
+// PQ编码表用32位gather读取（比例2，读取的高16位丢弃，表末尾有一项填充）。
+// scRGB的RG/BA拆分和Y、UV打包都在128位通道内进行，再用一次64位置换恢复像素顺序
+namespace
+{
+    struct KernelConstants
+    {
+        __m256i YRG;
+        __m256i YBOne;
+        __m256i URG;
+        __m256i UBOne;
+        __m256i VRG;
+        __m256i VBOne;
+    };
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.YRG = _mm256_set1_epi32(PackCoefficientPair(kY10CoefR, kY10CoefG));
+        c.YBOne = _mm256_set1_epi32(PackCoefficientPair(kY10CoefB, kY10CoefOne));
+        c.URG = _mm256_set1_epi32(PackCoefficientPair(kU10CoefR, kU10CoefG));
+        c.UBOne = _mm256_set1_epi32(PackCoefficientPair(kU10CoefB, kUV10CoefOne));
+        c.VRG = _mm256_set1_epi32(PackCoefficientPair(kV10CoefR, kV10CoefG));
+        c.VBOne = _mm256_set1_epi32(PackCoefficientPair(kV10CoefB, kUV10CoefOne));
+        return c;
+    }
+
+    inline __m256i ExpandTo14Bit(__m256i value)
+    {
+        return _mm256_or_si256(_mm256_slli_epi32(value, 4), _mm256_srli_epi32(value, 6));
+    }
+
+    struct R10G10B10A2Decoder
+    {
+        static const HDRInputFormat Format = HDRInputFormat::R10G10B10A2;
+        static const UINT BytesPerPixel = 4;
+
+        static void Decode8(const UINT16*, const BYTE* src, __m256i& r, __m256i& g, __m256i& b)
+        {
+            const __m256i mask = _mm256_set1_epi32(0x3FF);
+            __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            r = ExpandTo14Bit(_mm256_and_si256(pixels, mask));
+            g = ExpandTo14Bit(_mm256_and_si256(_mm256_srli_epi32(pixels, 10), mask));
+            b = ExpandTo14Bit(_mm256_and_si256(_mm256_srli_epi32(pixels, 20), mask));
+        }
+    };
+
+    inline __m256 HalfToFloat8(__m256i half)
+    {
+        __m256i magnitude = _mm256_slli_epi32(_mm256_and_si256(half, _mm256_set1_epi32(0x7FFF)), 13);
+        __m256 value = _mm256_mul_ps(_mm256_castsi256_ps(magnitude), _mm256_set1_ps(5.192296858534828e33f));
+        __m256i sign = _mm256_slli_epi32(_mm256_and_si256(half, _mm256_set1_epi32(0x8000)), 16);
+        return _mm256_or_ps(value, _mm256_castsi256_ps(sign));
+    }
+
+    inline __m256 ApplyMatrixRow(const float* m, __m256 r, __m256 g, __m256 b)
+    {
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(m[0]), r),
+                                           _mm256_mul_ps(_mm256_set1_ps(m[1]), g)),
+                             _mm256_mul_ps(_mm256_set1_ps(m[2]), b));
+    }
+
+    inline __m256i PQEncode8(const UINT16* table, __m256 linear)
+    {
+        linear = _mm256_max_ps(linear, _mm256_set1_ps(kPQTableMinValue));
+        linear = _mm256_min_ps(linear, _mm256_set1_ps(1.0f));
+        __m256i index = _mm256_add_epi32(_mm256_castps_si256(linear), _mm256_set1_epi32(1 << 12));
+        index = _mm256_sub_epi32(_mm256_srli_epi32(index, 13), _mm256_set1_epi32(static_cast<int>(kPQTableBase)));
+        __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), index, 2);
+        return _mm256_and_si256(values, _mm256_set1_epi32(0xFFFF));
+    }
+
+    struct ScRGBDecoder
+    {
+        static const HDRInputFormat Format = HDRInputFormat::R16G16B16A16Float;
+        static const UINT BytesPerPixel = 8;
+
+        static void Decode8(const UINT16* table, const BYTE* src, __m256i& r, __m256i& g, __m256i& b)
+        {
+            // 通道内拆分后像素顺序为[0 1 4 5 | 2 3 6 7]，64位置换后恢复为顺序排列
+            __m256 pixels0 = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)));
+            __m256 pixels1 = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32)));
+            __m256i rg = _mm256_castps_si256(_mm256_shuffle_ps(pixels0, pixels1, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m256i ba = _mm256_castps_si256(_mm256_shuffle_ps(pixels0, pixels1, _MM_SHUFFLE(3, 1, 3, 1)));
+            rg = _mm256_permute4x64_epi64(rg, _MM_SHUFFLE(3, 1, 2, 0));
+            ba = _mm256_permute4x64_epi64(ba, _MM_SHUFFLE(3, 1, 2, 0));
+
+            const __m256i lowMask = _mm256_set1_epi32(0xFFFF);
+            __m256 r709 = HalfToFloat8(_mm256_and_si256(rg, lowMask));
+            __m256 g709 = HalfToFloat8(_mm256_srli_epi32(rg, 16));
+            __m256 b709 = HalfToFloat8(_mm256_and_si256(ba, lowMask));
+
+            r = PQEncode8(table, ApplyMatrixRow(kScRGBToBT2020[0], r709, g709, b709));
+            g = PQEncode8(table, ApplyMatrixRow(kScRGBToBT2020[1], r709, g709, b709));
+            b = PQEncode8(table, ApplyMatrixRow(kScRGBToBT2020[2], r709, g709, b709));
+        }
+    };
+
+    template <typename Decoder>
+    inline __m256i ConvertPixels8(const UINT16* table, const BYTE* src, const KernelConstants& c,
+                                  __m256i& u, __m256i& v)
+    {
+        __m256i r;
+        __m256i g;
+        __m256i b;
+        Decoder::Decode8(table, src, r, g, b);
+
+        const __m256i uvMin = _mm256_set1_epi32(kUV10FixedMin);
+        const __m256i uvMax = _mm256_set1_epi32(kUV10FixedMax);
+        __m256i rg = _mm256_or_si256(r, _mm256_slli_epi32(g, 16));
+        __m256i bOne = _mm256_or_si256(b, _mm256_set1_epi32(kPQFixedOne << 16));
+
+        __m256i y = _mm256_add_epi32(_mm256_madd_epi16(rg, c.YRG), _mm256_madd_epi16(bOne, c.YBOne));
+        y = _mm256_srai_epi32(y, kYUV10Shift);
+        y = _mm256_min_epi32(_mm256_max_epi32(y, _mm256_set1_epi32(64)), _mm256_set1_epi32(940));
+        u = _mm256_add_epi32(_mm256_madd_epi16(rg, c.URG), _mm256_madd_epi16(bOne, c.UBOne));
+        v = _mm256_add_epi32(_mm256_madd_epi16(rg, c.VRG), _mm256_madd_epi16(bOne, c.VBOne));
+        u = _mm256_min_epi32(_mm256_max_epi32(u, uvMin), uvMax);
+        v = _mm256_min_epi32(_mm256_max_epi32(v, uvMin), uvMax);
+        return y;
+    }
+
+    // 通道内打包后64位单元的顺序为[a0-3 b0-3 | a4-7 b4-7]，置换后恢复顺序
+    inline __m256i PackSamples(__m256i a, __m256i b)
+    {
+        __m256i packed = _mm256_packus_epi32(_mm256_slli_epi32(a, 6), _mm256_slli_epi32(b, 6));
+        return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+    }
+
+    // 水平相加后的块顺序与PackSamples相同，组成8个UV对（U | V << 16）后用同样的置换恢复顺序
+    inline __m256i PackUVPairs(__m256i uSum, __m256i vSum, __m256i round, int shift)
+    {
+        __m256i u = _mm256_srli_epi32(_mm256_add_epi32(uSum, round), shift);
+        __m256i v = _mm256_srli_epi32(_mm256_add_epi32(vSum, round), shift);
+        __m256i uv = _mm256_or_si256(_mm256_slli_epi32(u, 6), _mm256_slli_epi32(v, 16 + 6));
+        return _mm256_permute4x64_epi64(uv, _MM_SHUFFLE(3, 1, 2, 0));
+    }
+
+    template <typename Decoder>
+    void ConvertRowPair(const BYTE* srcRow0, const BYTE* srcRow1, UINT16* yRow0, UINT16* yRow1,
+                        UINT16* uvRow, UINT width)
+    {
+        const KernelConstants c = LoadConstants();
+        const UINT16* table = GetPQEncodeTable();
+        const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+        const __m256i uvRound = _mm256_set1_epi32(1 << (kYUV10Shift + 1));
+
+        UINT x = 0;
+        for (; x + 16 <= width; x += 16)
+        {
+            const BYTE* src0 = srcRow0 + x * Decoder::BytesPerPixel;
+            const BYTE* src1 = row1 + x * Decoder::BytesPerPixel;
+            const UINT halfBytes = 8 * Decoder::BytesPerPixel;
+
+            __m256i u0;
+            __m256i v0;
+            __m256i u1;
+            __m256i v1;
+            __m256i y00 = ConvertPixels8<Decoder>(table, src0, c, u0, v0);
+            __m256i y01 = ConvertPixels8<Decoder>(table, src0 + halfBytes, c, u1, v1);
+
+            __m256i u2;
+            __m256i v2;
+            __m256i u3;
+            __m256i v3;
+            __m256i y10 = ConvertPixels8<Decoder>(table, src1, c, u2, v2);
+            __m256i y11 = ConvertPixels8<Decoder>(table, src1 + halfBytes, c, u3, v3);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(yRow0 + x), PackSamples(y00, y01));
+            if (yRow1)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(yRow1 + x), PackSamples(y10, y11));
+            }
+
+            __m256i uSum = _mm256_hadd_epi32(_mm256_add_epi32(u0, u2), _mm256_add_epi32(u1, u3));
+            __m256i vSum = _mm256_hadd_epi32(_mm256_add_epi32(v0, v2), _mm256_add_epi32(v1, v3));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(uvRow + x),
+                                PackUVPairs(uSum, vSum, uvRound, kYUV10Shift + 2));
+        }
+
+        HDRToP010RowPairTail_C(Decoder::Format, srcRow0, srcRow1, yRow0, yRow1, uvRow, x, width);
+    }
+
+    template <typename Decoder>
+    void ConvertRow(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+    {
+        const KernelConstants c = LoadConstants();
+        const UINT16* table = GetPQEncodeTable();
+        const __m256i uvRound = _mm256_set1_epi32(1 << kYUV10Shift);
+
+        UINT x = 0;
+        for (; x + 16 <= width; x += 16)
+        {
+            const BYTE* src = srcRow + x * Decoder::BytesPerPixel;
+
+            __m256i u0;
+            __m256i v0;
+            __m256i u1;
+            __m256i v1;
+            __m256i y0 = ConvertPixels8<Decoder>(table, src, c, u0, v0);
+            __m256i y1 = ConvertPixels8<Decoder>(table, src + 8 * Decoder::BytesPerPixel, c, u1, v1);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(yRow + x), PackSamples(y0, y1));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(uvRow + x),
+                                PackUVPairs(_mm256_hadd_epi32(u0, u1), _mm256_hadd_epi32(v0, v1), uvRound,
+                                            kYUV10Shift + 1));
+        }
+
+        HDRToP210RowTail_C(Decoder::Format, srcRow, yRow, uvRow, x, width);
+    }
+}
+
+void R10G10B10A2ToP010RowPair_AVX2(const BYTE* srcRow0, const BYTE* srcRow1,
+                                   UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width)
+{
+    ConvertRowPair<R10G10B10A2Decoder>(srcRow0, srcRow1, yRow0, yRow1, uvRow, width);
+}
+
+void ScRGBToP010RowPair_AVX2(const BYTE* srcRow0, const BYTE* srcRow1,
+                             UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width)
+{
+    ConvertRowPair<ScRGBDecoder>(srcRow0, srcRow1, yRow0, yRow1, uvRow, width);
+}
+
+void R10G10B10A2ToP210Row_AVX2(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+{
+    ConvertRow<R10G10B10A2Decoder>(srcRow, yRow, uvRow, width);
+}
+
+void ScRGBToP210Row_AVX2(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+{
+    ConvertRow<ScRGBDecoder>(srcRow, yRow, uvRow, width);
+}
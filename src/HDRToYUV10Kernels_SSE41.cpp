@@ -0,0 +1,237 @@
+#include "HDRToYUV10Kernels.h"
+#include "ColorConversionMath.h"
+#include "HDRConversionMath.h"
+#include <smmintrin.h>
+
+// SSE4.1内核：每个32位通道一个像素，每次迭代处理8个像素（P010为两行各8个）。
+// 源像素先解码为Q14的R'G'B'（scRGB在通道内完成半精度解码、矩阵运算和钳位，
+// 查表下标计算与PQEncodeFixed相同，4个表项逐个读取），之后两种输入共用定点矩阵。
+// 浮点矩阵按与标量代码相同的顺序先乘后加，查表下标与标量代码逐位一致
+namespace
+{
+    struct KernelConstants
+    {
+        __m128i YRG;
+        __m128i YBOne;
+        __m128i URG;
+        __m128i UBOne;
+        __m128i VRG;
+        __m128i VBOne;
+    };
+
+    inline KernelConstants LoadConstants()
+    {
+        KernelConstants c;
+        c.YRG = _mm_set1_epi32(PackCoefficientPair(kY10CoefR, kY10CoefG));
+        c.YBOne = _mm_set1_epi32(PackCoefficientPair(kY10CoefB, kY10CoefOne));
+        c.URG = _mm_set1_epi32(PackCoefficientPair(kU10CoefR, kU10CoefG));
+        c.UBOne = _mm_set1_epi32(PackCoefficientPair(kU10CoefB, kUV10CoefOne));
+        c.VRG = _mm_set1_epi32(PackCoefficientPair(kV10CoefR, kV10CoefG));
+        c.VBOne = _mm_set1_epi32(PackCoefficientPair(kV10CoefB, kUV10CoefOne));
+        return c;
+    }
+
+    inline __m128i ExpandTo14Bit(__m128i value)
+    {
+        return _mm_or_si128(_mm_slli_epi32(value, 4), _mm_srli_epi32(value, 6));
+    }
+
+    struct R10G10B10A2Decoder
+    {
+        static const HDRInputFormat Format = HDRInputFormat::R10G10B10A2;
+        static const UINT BytesPerPixel = 4;
+
+        static void Decode4(const UINT16*, const BYTE* src, __m128i& r, __m128i& g, __m128i& b)
+        {
+            const __m128i mask = _mm_set1_epi32(0x3FF);
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            r = ExpandTo14Bit(_mm_and_si128(pixels, mask));
+            g = ExpandTo14Bit(_mm_and_si128(_mm_srli_epi32(pixels, 10), mask));
+            b = ExpandTo14Bit(_mm_and_si128(_mm_srli_epi32(pixels, 20), mask));
+        }
+    };
+
+    // 每个32位通道的低16位为半精度浮点，见HalfToFloat
+    inline __m128 HalfToFloat4(__m128i half)
+    {
+        __m128i magnitude = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x7FFF)), 13);
+        __m128 value = _mm_mul_ps(_mm_castsi128_ps(magnitude), _mm_set1_ps(5.192296858534828e33f));
+        __m128i sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+        return _mm_or_ps(value, _mm_castsi128_ps(sign));
+    }
+
+    inline __m128 ApplyMatrixRow(const float* m, __m128 r, __m128 g, __m128 b)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[0]), r), _mm_mul_ps(_mm_set1_ps(m[1]), g)),
+                          _mm_mul_ps(_mm_set1_ps(m[2]), b));
+    }
+
+    // 与PQEncodeFixed相同：max/min的操作数顺序使NaN得到下限
+    inline __m128i PQEncode4(const UINT16* table, __m128 linear)
+    {
+        linear = _mm_max_ps(linear, _mm_set1_ps(kPQTableMinValue));
+        linear = _mm_min_ps(linear, _mm_set1_ps(1.0f));
+        __m128i index = _mm_add_epi32(_mm_castps_si128(linear), _mm_set1_epi32(1 << 12));
+        index = _mm_sub_epi32(_mm_srli_epi32(index, 13), _mm_set1_epi32(static_cast<int>(kPQTableBase)));
+        return _mm_setr_epi32(table[_mm_extract_epi32(index, 0)], table[_mm_extract_epi32(index, 1)],
+                              table[_mm_extract_epi32(index, 2)], table[_mm_extract_epi32(index, 3)]);
+    }
+
+    struct ScRGBDecoder
+    {
+        static const HDRInputFormat Format = HDRInputFormat::R16G16B16A16Float;
+        static const UINT BytesPerPixel = 8;
+
+        static void Decode4(const UINT16* table, const BYTE* src, __m128i& r, __m128i& g, __m128i& b)
+        {
+            // 两次读取4个像素，32位单元分别为[RG BA RG BA]，拆分为RG和BA两组
+            __m128 pixels01 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+            __m128 pixels23 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)));
+            __m128i rg = _mm_castps_si128(_mm_shuffle_ps(pixels01, pixels23, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m128i ba = _mm_castps_si128(_mm_shuffle_ps(pixels01, pixels23, _MM_SHUFFLE(3, 1, 3, 1)));
+
+            const __m128i lowMask = _mm_set1_epi32(0xFFFF);
+            __m128 r709 = HalfToFloat4(_mm_and_si128(rg, lowMask));
+            __m128 g709 = HalfToFloat4(_mm_srli_epi32(rg, 16));
+            __m128 b709 = HalfToFloat4(_mm_and_si128(ba, lowMask));
+
+            r = PQEncode4(table, ApplyMatrixRow(kScRGBToBT2020[0], r709, g709, b709));
+            g = PQEncode4(table, ApplyMatrixRow(kScRGBToBT2020[1], r709, g709, b709));
+            b = PQEncode4(table, ApplyMatrixRow(kScRGBToBT2020[2], r709, g709, b709));
+        }
+    };
+
+    // 转换4个像素：y为钳位后的10位Y，u/v为钳位后的定点UV（保留小数位）
+    template <typename Decoder>
+    inline __m128i ConvertPixels4(const UINT16* table, const BYTE* src, const KernelConstants& c,
+                                  __m128i& u, __m128i& v)
+    {
+        __m128i r;
+        __m128i g;
+        __m128i b;
+        Decoder::Decode4(table, src, r, g, b);
+
+        const __m128i uvMin = _mm_set1_epi32(kUV10FixedMin);
+        const __m128i uvMax = _mm_set1_epi32(kUV10FixedMax);
+        __m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+        __m128i bOne = _mm_or_si128(b, _mm_set1_epi32(kPQFixedOne << 16));
+
+        __m128i y = _mm_add_epi32(_mm_madd_epi16(rg, c.YRG), _mm_madd_epi16(bOne, c.YBOne));
+        y = _mm_srai_epi32(y, kYUV10Shift);
+        y = _mm_min_epi32(_mm_max_epi32(y, _mm_set1_epi32(64)), _mm_set1_epi32(940));
+        u = _mm_add_epi32(_mm_madd_epi16(rg, c.URG), _mm_madd_epi16(bOne, c.UBOne));
+        v = _mm_add_epi32(_mm_madd_epi16(rg, c.VRG), _mm_madd_epi16(bOne, c.VBOne));
+        u = _mm_min_epi32(_mm_max_epi32(u, uvMin), uvMax);
+        v = _mm_min_epi32(_mm_max_epi32(v, uvMin), uvMax);
+        return y;
+    }
+
+    // 两组各4个10位值打包为8个16位样本（码值在高位）
+    inline __m128i PackSamples(__m128i a, __m128i b)
+    {
+        return _mm_packus_epi32(_mm_slli_epi32(a, 6), _mm_slli_epi32(b, 6));
+    }
+
+    // 相邻像素的UV之和舍入右移后组成4个UV对（U | V << 16）
+    inline __m128i PackUVPairs(__m128i uSum, __m128i vSum, __m128i round, int shift)
+    {
+        __m128i u = _mm_srli_epi32(_mm_add_epi32(uSum, round), shift);
+        __m128i v = _mm_srli_epi32(_mm_add_epi32(vSum, round), shift);
+        return _mm_or_si128(_mm_slli_epi32(u, 6), _mm_slli_epi32(v, 16 + 6));
+    }
+
+    template <typename Decoder>
+    void ConvertRowPair(const BYTE* srcRow0, const BYTE* srcRow1, UINT16* yRow0, UINT16* yRow1,
+                        UINT16* uvRow, UINT width)
+    {
+        const KernelConstants c = LoadConstants();
+        const UINT16* table = GetPQEncodeTable();
+        const BYTE* row1 = srcRow1 ? srcRow1 : srcRow0;
+        const __m128i uvRound = _mm_set1_epi32(1 << (kYUV10Shift + 1));
+
+        UINT x = 0;
+        for (; x + 8 <= width; x += 8)
+        {
+            const BYTE* src0 = srcRow0 + x * Decoder::BytesPerPixel;
+            const BYTE* src1 = row1 + x * Decoder::BytesPerPixel;
+            const UINT halfBytes = 4 * Decoder::BytesPerPixel;
+
+            __m128i u0;
+            __m128i v0;
+            __m128i u1;
+            __m128i v1;
+            __m128i y00 = ConvertPixels4<Decoder>(table, src0, c, u0, v0);
+            __m128i y01 = ConvertPixels4<Decoder>(table, src0 + halfBytes, c, u1, v1);
+
+            __m128i u2;
+            __m128i v2;
+            __m128i u3;
+            __m128i v3;
+            __m128i y10 = ConvertPixels4<Decoder>(table, src1, c, u2, v2);
+            __m128i y11 = ConvertPixels4<Decoder>(table, src1 + halfBytes, c, u3, v3);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(yRow0 + x), PackSamples(y00, y01));
+            if (yRow1)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(yRow1 + x), PackSamples(y10, y11));
+            }
+
+            // 上下两行相加后再水平相加，得到4个2x2块之和（不超过2^31，见HDRConversionMath.h）
+            __m128i uSum = _mm_hadd_epi32(_mm_add_epi32(u0, u2), _mm_add_epi32(u1, u3));
+            __m128i vSum = _mm_hadd_epi32(_mm_add_epi32(v0, v2), _mm_add_epi32(v1, v3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(uvRow + x),
+                             PackUVPairs(uSum, vSum, uvRound, kYUV10Shift + 2));
+        }
+
+        HDRToP010RowPairTail_C(Decoder::Format, srcRow0, srcRow1, yRow0, yRow1, uvRow, x, width);
+    }
+
+    template <typename Decoder>
+    void ConvertRow(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+    {
+        const KernelConstants c = LoadConstants();
+        const UINT16* table = GetPQEncodeTable();
+        const __m128i uvRound = _mm_set1_epi32(1 << kYUV10Shift);
+
+        UINT x = 0;
+        for (; x + 8 <= width; x += 8)
+        {
+            const BYTE* src = srcRow + x * Decoder::BytesPerPixel;
+
+            __m128i u0;
+            __m128i v0;
+            __m128i u1;
+            __m128i v1;
+            __m128i y0 = ConvertPixels4<Decoder>(table, src, c, u0, v0);
+            __m128i y1 = ConvertPixels4<Decoder>(table, src + 4 * Decoder::BytesPerPixel, c, u1, v1);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(yRow + x), PackSamples(y0, y1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(uvRow + x),
+                             PackUVPairs(_mm_hadd_epi32(u0, u1), _mm_hadd_epi32(v0, v1), uvRound, kYUV10Shift + 1));
+        }
+
+        HDRToP210RowTail_C(Decoder::Format, srcRow, yRow, uvRow, x, width);
+    }
+}
+
+void R10G10B10A2ToP010RowPair_SSE41(const BYTE* srcRow0, const BYTE* srcRow1,
+                                    UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width)
+{
+    ConvertRowPair<R10G10B10A2Decoder>(srcRow0, srcRow1, yRow0, yRow1, uvRow, width);
+}
+
+void ScRGBToP010RowPair_SSE41(const BYTE* srcRow0, const BYTE* srcRow1,
+                              UINT16* yRow0, UINT16* yRow1, UINT16* uvRow, UINT width)
+{
+    ConvertRowPair<ScRGBDecoder>(srcRow0, srcRow1, yRow0, yRow1, uvRow, width);
+}
+
+void R10G10B10A2ToP210Row_SSE41(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+{
+    ConvertRow<R10G10B10A2Decoder>(srcRow, yRow, uvRow, width);
+}
+
+void ScRGBToP210Row_SSE41(const BYTE* srcRow, UINT16* yRow, UINT16* uvRow, UINT width)
+{
+    ConvertRow<ScRGBDecoder>(srcRow, yRow, uvRow, width);
+}
@@ -0,0 +1,94 @@
+#include "ImageOrientationKernels.h"
+#include <cstring>
+
+namespace
+{
+    // 标量转置的分块大小：8x8个像素的源和目标各占8个缓存行
+    const UINT kScalarTransposeBlock = 8;
+
+    inline void CopyPixel(const BYTE* src, BYTE* dst)
+    {
+        memcpy(dst, src, 4);
+    }
+}
+
+void TransposeBGRA_C(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch, UINT width, UINT height)
+{
+    for (UINT r0 = 0; r0 < height; r0 += kScalarTransposeBlock)
+    {
+        UINT r1 = r0 + kScalarTransposeBlock < height ? r0 + kScalarTransposeBlock : height;
+        for (UINT c0 = 0; c0 < width; c0 += kScalarTransposeBlock)
+        {
+            UINT c1 = c0 + kScalarTransposeBlock < width ? c0 + kScalarTransposeBlock : width;
+            for (UINT r = r0; r < r1; r++)
+            {
+                const BYTE* srcRow = src + (ptrdiff_t)r * srcPitch;
+                for (UINT c = c0; c < c1; c++)
+                {
+                    CopyPixel(srcRow + (size_t)c * 4, dst + (ptrdiff_t)c * dstPitch + (size_t)r * 4);
+                }
+            }
+        }
+    }
+}
+
+void TransposeBGRAEdges_C(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch, UINT width, UINT height,
+                          UINT blockSize)
+{
+    UINT fullWidth = width - width % blockSize;
+    UINT fullHeight = height - height % blockSize;
+    // 右侧的列（所有行）
+    if (fullWidth < width)
+    {
+        TransposeBGRA_C(src + (size_t)fullWidth * 4, srcPitch, dst + (ptrdiff_t)fullWidth * dstPitch, dstPitch,
+                        width - fullWidth, height);
+    }
+    // 底部的行（只到fullWidth，右下角已经处理）
+    if (fullHeight < height && fullWidth > 0)
+    {
+        TransposeBGRA_C(src + (ptrdiff_t)fullHeight * srcPitch, srcPitch, dst + (size_t)fullHeight * 4, dstPitch,
+                        fullWidth, height - fullHeight);
+    }
+}
+
+void ReverseBGRARowTail_C(const BYTE* srcRow, BYTE* dstRow, UINT first, UINT width)
+{
+    for (UINT i = first; i < width; i++)
+    {
+        CopyPixel(srcRow + (size_t)(width - 1 - i) * 4, dstRow + (size_t)i * 4);
+    }
+}
+
+void ReverseBGRARow_C(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    ReverseBGRARowTail_C(srcRow, dstRow, 0, width);
+}
+
+OrientationKernels GetOrientationKernels(SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    OrientationKernels kernels = { TransposeBGRA_C, ReverseBGRARow_C };
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernels.Transpose = TransposeBGRA_AVX2;
+        kernels.Reverse = ReverseBGRARow_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernels.Transpose = TransposeBGRA_SSE41;
+        kernels.Reverse = ReverseBGRARow_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernels;
+}
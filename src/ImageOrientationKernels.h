@@ -0,0 +1,42 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+#include <cstddef>
+
+// 旋转和翻转的CPU内核（CpuBGRAToYUY2Converter和CpuNV12ToRGBAConverter的方向变换使用）
+// 像素按32位整体搬移（BGRA/RGBA），与通道顺序无关。
+// 转置按小方块（SSE4.1为4x4、AVX2为8x8，寄存器内转置）处理，每次读写都只涉及少数几行，
+// 调用者再把整幅图像拆成几十行的条带，使转置的源和目标都留在缓存中。
+// 行步长可以为负（倒序访问行），所有内核结果相同。
+
+// 转置：src为height行、每行width个像素，写出width行、每行height个像素：
+// dst[c * dstPitch + r * 4] = src[r * srcPitch + c * 4]
+typedef void (*TransposeBGRAFunc)(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch,
+                                  UINT width, UINT height);
+// 水平翻转一行：dstRow[i] = srcRow[width - 1 - i]（按像素），源和目标不能重叠
+typedef void (*ReverseBGRARowFunc)(const BYTE* srcRow, BYTE* dstRow, UINT width);
+
+struct OrientationKernels
+{
+    TransposeBGRAFunc Transpose;
+    ReverseBGRARowFunc Reverse;
+};
+
+void TransposeBGRA_C(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch, UINT width, UINT height);
+void ReverseBGRARow_C(const BYTE* srcRow, BYTE* dstRow, UINT width);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+void TransposeBGRA_SSE41(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch, UINT width, UINT height);
+void ReverseBGRARow_SSE41(const BYTE* srcRow, BYTE* dstRow, UINT width);
+void TransposeBGRA_AVX2(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch, UINT width, UINT height);
+void ReverseBGRARow_AVX2(const BYTE* srcRow, BYTE* dstRow, UINT width);
+#endif
+
+// SIMD内核处理完整的方块后，用标量代码处理右侧宽度不足blockSize的列和底部高度不足的行
+void TransposeBGRAEdges_C(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch, UINT width, UINT height,
+                          UINT blockSize);
+// 从第first个像素开始用标量代码处理到行尾
+void ReverseBGRARowTail_C(const BYTE* srcRow, BYTE* dstRow, UINT first, UINT width);
+
+// 返回不超过level的最优内核（最高提供AVX2版本）
+OrientationKernels GetOrientationKernels(SimdLevel level, SimdLevel* selectedLevel = nullptr);
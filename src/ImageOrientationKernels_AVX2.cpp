@@ -0,0 +1,67 @@
+#include "ImageOrientationKernels.h"
+#include <immintrin.h>
+
+// AVX2内核：8x8个像素的方块在寄存器内转置（32位、64位unpack在128位通道内完成，最后一轮交换通道），
+// 翻转用vpermd倒序8个像素
+void TransposeBGRA_AVX2(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch, UINT width, UINT height)
+{
+    UINT fullWidth = width & ~7u;
+    UINT fullHeight = height & ~7u;
+    for (UINT r = 0; r < fullHeight; r += 8)
+    {
+        const BYTE* srcRow = src + (ptrdiff_t)r * srcPitch;
+        for (UINT c = 0; c < fullWidth; c += 8)
+        {
+            const BYTE* s = srcRow + (size_t)c * 4;
+            __m256i row[8];
+            for (int i = 0; i < 8; i++)
+            {
+                row[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + srcPitch * i));
+            }
+
+            // 每个128位通道内按4x4转置：通道0为列0..3，通道1为列4..7
+            __m256i t0 = _mm256_unpacklo_epi32(row[0], row[1]);
+            __m256i t1 = _mm256_unpackhi_epi32(row[0], row[1]);
+            __m256i t2 = _mm256_unpacklo_epi32(row[2], row[3]);
+            __m256i t3 = _mm256_unpackhi_epi32(row[2], row[3]);
+            __m256i t4 = _mm256_unpacklo_epi32(row[4], row[5]);
+            __m256i t5 = _mm256_unpackhi_epi32(row[4], row[5]);
+            __m256i t6 = _mm256_unpacklo_epi32(row[6], row[7]);
+            __m256i t7 = _mm256_unpackhi_epi32(row[6], row[7]);
+
+            __m256i u0 = _mm256_unpacklo_epi64(t0, t2);     // 列0/4的行0..3
+            __m256i u1 = _mm256_unpackhi_epi64(t0, t2);     // 列1/5
+            __m256i u2 = _mm256_unpacklo_epi64(t1, t3);     // 列2/6
+            __m256i u3 = _mm256_unpackhi_epi64(t1, t3);     // 列3/7
+            __m256i u4 = _mm256_unpacklo_epi64(t4, t6);     // 列0/4的行4..7
+            __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+            __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+            __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+            // 行0..3与行4..7拼成完整的8个像素：低通道组合成列0..3，高通道组合成列4..7
+            BYTE* d = dst + (ptrdiff_t)c * dstPitch + (size_t)r * 4;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm256_permute2x128_si256(u0, u4, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + dstPitch), _mm256_permute2x128_si256(u1, u5, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + dstPitch * 2), _mm256_permute2x128_si256(u2, u6, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + dstPitch * 3), _mm256_permute2x128_si256(u3, u7, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + dstPitch * 4), _mm256_permute2x128_si256(u0, u4, 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + dstPitch * 5), _mm256_permute2x128_si256(u1, u5, 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + dstPitch * 6), _mm256_permute2x128_si256(u2, u6, 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + dstPitch * 7), _mm256_permute2x128_si256(u3, u7, 0x31));
+        }
+    }
+    TransposeBGRAEdges_C(src, srcPitch, dst, dstPitch, width, height, 8);
+}
+
+void ReverseBGRARow_AVX2(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    UINT i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(srcRow + (size_t)(width - 8 - i) * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstRow + (size_t)i * 4),
+                            _mm256_permutevar8x32_epi32(pixels, reverse));
+    }
+    ReverseBGRARowTail_C(srcRow, dstRow, i, width);
+}
@@ -0,0 +1,45 @@
+#include "ImageOrientationKernels.h"
+#include <smmintrin.h>
+
+// SSE4.1内核：4x4个像素的方块在寄存器内转置（两轮32位/64位unpack），翻转用pshufd倒序4个像素
+void TransposeBGRA_SSE41(const BYTE* src, ptrdiff_t srcPitch, BYTE* dst, ptrdiff_t dstPitch, UINT width, UINT height)
+{
+    UINT fullWidth = width & ~3u;
+    UINT fullHeight = height & ~3u;
+    for (UINT r = 0; r < fullHeight; r += 4)
+    {
+        const BYTE* srcRow = src + (ptrdiff_t)r * srcPitch;
+        for (UINT c = 0; c < fullWidth; c += 4)
+        {
+            const BYTE* s = srcRow + (size_t)c * 4;
+            __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + srcPitch));
+            __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + srcPitch * 2));
+            __m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + srcPitch * 3));
+
+            __m128i t0 = _mm_unpacklo_epi32(row0, row1);    // 00 10 01 11
+            __m128i t1 = _mm_unpacklo_epi32(row2, row3);    // 20 30 21 31
+            __m128i t2 = _mm_unpackhi_epi32(row0, row1);    // 02 12 03 13
+            __m128i t3 = _mm_unpackhi_epi32(row2, row3);    // 22 32 23 33
+
+            BYTE* d = dst + (ptrdiff_t)c * dstPitch + (size_t)r * 4;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm_unpacklo_epi64(t0, t1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + dstPitch), _mm_unpackhi_epi64(t0, t1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + dstPitch * 2), _mm_unpacklo_epi64(t2, t3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + dstPitch * 3), _mm_unpackhi_epi64(t2, t3));
+        }
+    }
+    TransposeBGRAEdges_C(src, srcPitch, dst, dstPitch, width, height, 4);
+}
+
+void ReverseBGRARow_SSE41(const BYTE* srcRow, BYTE* dstRow, UINT width)
+{
+    UINT i = 0;
+    for (; i + 4 <= width; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcRow + (size_t)(width - 4 - i) * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + (size_t)i * 4),
+                         _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3)));
+    }
+    ReverseBGRARowTail_C(srcRow, dstRow, i, width);
+}
@@ -0,0 +1,457 @@
+#pragma once
+#include "Utils.h"
+#include <cstddef>
+
+// 图像平面描述：数据指针、每行有效字节数、行数和行步长
+// 行步长可以大于有效字节数（解码器表面、Map返回的RowPitch等带填充的缓冲区），
+// 转换器按行步长寻址，无需先重新打包成紧凑布局
+struct ImagePlane
+{
+    BYTE* Data;
+    UINT RowBytes;  // 每行有效数据的字节数
+    UINT Height;    // 行数
+    UINT Pitch;     // 行步长（字节），不小于RowBytes
+};
+
+const UINT kMaxImagePlanes = 3;
+
+// 图像视图：不持有内存，只描述调用者提供的各个平面
+//   BGRA/RGBA：1个平面，每像素4字节
+//   YUY2：     1个平面，每个像素对4字节
+//   NV12：     Y平面 + 交错UV平面（(height + 1) / 2行）
+//   I420/YV12：Y平面 + U平面 + V平面（各(width + 1) / 2列、(height + 1) / 2行），
+//              Planes[1]总是U、Planes[2]总是V，两种格式只是内存中平面的先后顺序不同
+//   I444：     Y平面 + U平面 + V平面（均为完整分辨率）
+//   AYUV：     1个平面，每像素4字节（[V U Y A]）
+//   P010/P210：16位样本（10位码值在高位），Y平面 + 交错UV平面，
+//              UV平面P010为(height + 1) / 2行，P210为height行
+struct ImageView
+{
+    UINT Width;     // 图像宽度（像素）
+    UINT Height;    // 图像高度（像素）
+    UINT PlaneCount;
+    ImagePlane Planes[kMaxImagePlanes];
+};
+
+// pitch为0时使用紧凑布局（pitch = rowBytes）
+inline ImagePlane MakeImagePlane(BYTE* data, UINT rowBytes, UINT height, UINT pitch = 0)
+{
+    ImagePlane plane;
+    plane.Data = data;
+    plane.RowBytes = rowBytes;
+    plane.Height = height;
+    plane.Pitch = pitch ? pitch : rowBytes;
+    return plane;
+}
+
+// 平面占用的字节数（最后一行不要求包含填充）
+inline size_t GetImagePlaneSize(const ImagePlane& plane)
+{
+    return plane.Height ? (size_t)plane.Pitch * (plane.Height - 1) + plane.RowBytes : 0;
+}
+
+inline ImageView MakeSinglePlaneImageView(BYTE* data, UINT width, UINT height, UINT rowBytes, UINT pitch)
+{
+    ImageView view = {};
+    view.Width = width;
+    view.Height = height;
+    view.PlaneCount = 1;
+    view.Planes[0] = MakeImagePlane(data, rowBytes, height, pitch);
+    return view;
+}
+
+inline ImageView MakeBGRAImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    return MakeSinglePlaneImageView(data, width, height, width * 4, pitch);
+}
+
+inline ImageView MakeRGBAImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    return MakeSinglePlaneImageView(data, width, height, width * 4, pitch);
+}
+
+inline ImageView MakeYUY2ImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    return MakeSinglePlaneImageView(data, width, height, ((width + 1) / 2) * 4, pitch);
+}
+
+// NV12：Y平面与UV平面分别给出指针和行步长
+inline ImageView MakeNV12ImageView(BYTE* yData, UINT yPitch, BYTE* uvData, UINT uvPitch, UINT width, UINT height)
+{
+    ImageView view = {};
+    view.Width = width;
+    view.Height = height;
+    view.PlaneCount = 2;
+    view.Planes[0] = MakeImagePlane(yData, width, height, yPitch);
+    view.Planes[1] = MakeImagePlane(uvData, ((width + 1) / 2) * 2, (height + 1) / 2, uvPitch);
+    return view;
+}
+
+// NV12：UV平面紧跟在Y平面之后，两个平面使用相同的行步长（解码器表面的常见布局）
+inline ImageView MakeNV12ImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    UINT rowPitch = pitch ? pitch : ((width + 1) / 2) * 2;
+    return MakeNV12ImageView(data, rowPitch, data + (size_t)rowPitch * height, rowPitch, width, height);
+}
+
+// I420/YV12：三个平面分别给出指针和行步长（编码器输入图像的常见形式）
+inline ImageView MakeI420ImageView(BYTE* yData, UINT yPitch, BYTE* uData, UINT uPitch,
+                                   BYTE* vData, UINT vPitch, UINT width, UINT height)
+{
+    ImageView view = {};
+    view.Width = width;
+    view.Height = height;
+    view.PlaneCount = 3;
+    view.Planes[0] = MakeImagePlane(yData, width, height, yPitch);
+    view.Planes[1] = MakeImagePlane(uData, (width + 1) / 2, (height + 1) / 2, uPitch);
+    view.Planes[2] = MakeImagePlane(vData, (width + 1) / 2, (height + 1) / 2, vPitch);
+    return view;
+}
+
+// 连续布局的色度平面行步长：Y平面行步长的一半（向上取整），pitch为0时为紧凑布局
+inline UINT GetPlanarChromaPitch(UINT width, UINT pitch)
+{
+    return pitch ? (pitch + 1) / 2 : (width + 1) / 2;
+}
+
+// I420：Y、U、V平面依次连续存放
+inline ImageView MakeI420ImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    UINT yPitch = pitch ? pitch : width;
+    UINT chromaPitch = GetPlanarChromaPitch(width, pitch);
+    BYTE* uData = data + (size_t)yPitch * height;
+    BYTE* vData = uData + (size_t)chromaPitch * ((height + 1) / 2);
+    return MakeI420ImageView(data, yPitch, uData, chromaPitch, vData, chromaPitch, width, height);
+}
+
+// YV12：Y、V、U平面依次连续存放（视图中仍然是Planes[1]为U）
+inline ImageView MakeYV12ImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    UINT yPitch = pitch ? pitch : width;
+    UINT chromaPitch = GetPlanarChromaPitch(width, pitch);
+    BYTE* vData = data + (size_t)yPitch * height;
+    BYTE* uData = vData + (size_t)chromaPitch * ((height + 1) / 2);
+    return MakeI420ImageView(data, yPitch, uData, chromaPitch, vData, chromaPitch, width, height);
+}
+
+// I444：三个完整分辨率的平面分别给出指针和行步长
+inline ImageView MakeI444ImageView(BYTE* yData, UINT yPitch, BYTE* uData, UINT uPitch,
+                                   BYTE* vData, UINT vPitch, UINT width, UINT height)
+{
+    ImageView view = {};
+    view.Width = width;
+    view.Height = height;
+    view.PlaneCount = 3;
+    view.Planes[0] = MakeImagePlane(yData, width, height, yPitch);
+    view.Planes[1] = MakeImagePlane(uData, width, height, uPitch);
+    view.Planes[2] = MakeImagePlane(vData, width, height, vPitch);
+    return view;
+}
+
+// I444：Y、U、V平面依次连续存放，使用相同的行步长
+inline ImageView MakeI444ImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    UINT rowPitch = pitch ? pitch : width;
+    size_t planeSize = (size_t)rowPitch * height;
+    return MakeI444ImageView(data, rowPitch, data + planeSize, rowPitch, data + planeSize * 2, rowPitch,
+                             width, height);
+}
+
+inline ImageView MakeAYUVImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    return MakeSinglePlaneImageView(data, width, height, width * 4, pitch);
+}
+
+// P010/P210：Y平面与UV平面分别给出指针和行步长，chromaHeight为UV平面行数
+inline ImageView MakeYUV10ImageView(BYTE* yData, UINT yPitch, BYTE* uvData, UINT uvPitch,
+                                    UINT width, UINT height, UINT chromaHeight)
+{
+    ImageView view = {};
+    view.Width = width;
+    view.Height = height;
+    view.PlaneCount = 2;
+    view.Planes[0] = MakeImagePlane(yData, width * 2, height, yPitch);
+    view.Planes[1] = MakeImagePlane(uvData, ((width + 1) / 2) * 4, chromaHeight, uvPitch);
+    return view;
+}
+
+inline ImageView MakeP010ImageView(BYTE* yData, UINT yPitch, BYTE* uvData, UINT uvPitch, UINT width, UINT height)
+{
+    return MakeYUV10ImageView(yData, yPitch, uvData, uvPitch, width, height, (height + 1) / 2);
+}
+
+inline ImageView MakeP210ImageView(BYTE* yData, UINT yPitch, BYTE* uvData, UINT uvPitch, UINT width, UINT height)
+{
+    return MakeYUV10ImageView(yData, yPitch, uvData, uvPitch, width, height, height);
+}
+
+// P010/P210：UV平面紧跟在Y平面之后，两个平面使用相同的行步长（与NV12的连续布局相同）
+inline ImageView MakeP010ImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    UINT rowPitch = pitch ? pitch : ((width + 1) / 2) * 4;
+    return MakeP010ImageView(data, rowPitch, data + (size_t)rowPitch * height, rowPitch, width, height);
+}
+
+inline ImageView MakeP210ImageView(BYTE* data, UINT width, UINT height, UINT pitch = 0)
+{
+    UINT rowPitch = pitch ? pitch : ((width + 1) / 2) * 4;
+    return MakeP210ImageView(data, rowPitch, data + (size_t)rowPitch * height, rowPitch, width, height);
+}
+
+// 检查视图的平面数量、指针和行步长是否有效，并与期望的图像尺寸一致
+inline bool IsImageViewValid(const ImageView& view, UINT planeCount, UINT width, UINT height)
+{
+    if (view.PlaneCount != planeCount || view.Width != width || view.Height != height || width == 0 || height == 0)
+        return false;
+
+    for (UINT i = 0; i < planeCount; i++)
+    {
+        const ImagePlane& plane = view.Planes[i];
+        if (!plane.Data || plane.Pitch < plane.RowBytes || plane.RowBytes == 0 || plane.Height == 0)
+            return false;
+    }
+    // 第一个平面（BGRA/YUY2/RGBA或NV12的Y平面）与图像行数相同
+    return view.Planes[0].Height >= height;
+}
+
+// 图像中的矩形区域（像素坐标，不包含Right/Bottom，与RECT的约定相同）
+struct ImageRect
+{
+    UINT Left;
+    UINT Top;
+    UINT Right;
+    UINT Bottom;
+};
+
+inline ImageRect MakeImageRect(UINT left, UINT top, UINT right, UINT bottom)
+{
+    ImageRect rect;
+    rect.Left = left;
+    rect.Top = top;
+    rect.Right = right;
+    rect.Bottom = bottom;
+    return rect;
+}
+
+inline bool IsImageRectEmpty(const ImageRect& rect)
+{
+    return rect.Left >= rect.Right || rect.Top >= rect.Bottom;
+}
+
+inline unsigned long long GetImageRectArea(const ImageRect& rect)
+{
+    return IsImageRectEmpty(rect) ? 0 : (unsigned long long)(rect.Right - rect.Left) * (rect.Bottom - rect.Top);
+}
+
+// 两个矩形的外接矩形
+inline ImageRect UnionImageRect(const ImageRect& a, const ImageRect& b)
+{
+    if (IsImageRectEmpty(a))
+        return b;
+    if (IsImageRectEmpty(b))
+        return a;
+    return MakeImageRect(a.Left < b.Left ? a.Left : b.Left, a.Top < b.Top ? a.Top : b.Top,
+                         a.Right > b.Right ? a.Right : b.Right, a.Bottom > b.Bottom ? a.Bottom : b.Bottom);
+}
+
+// 裁剪到图像范围内，返回裁剪后是否非空
+inline bool ClipImageRect(ImageRect& rect, UINT width, UINT height)
+{
+    if (rect.Right > width)
+        rect.Right = width;
+    if (rect.Bottom > height)
+        rect.Bottom = height;
+    return !IsImageRectEmpty(rect);
+}
+
+// 扩展到偶数x边界，使矩形覆盖完整的YUY2像素对（一对像素共享UV，必须一起重新转换）。
+// 右边界不超过图像宽度，奇数宽度图像的最后一个像素对与整帧转换一样复制最后一个像素
+inline void AlignImageRectToPixelPairs(ImageRect& rect, UINT width)
+{
+    rect.Left &= ~1u;
+    rect.Right = (rect.Right + 1) & ~1u;
+    if (rect.Right > width)
+        rect.Right = width;
+}
+
+// BGRA/RGBA图像中rect区域的子视图（共用原缓冲区和行步长），rect必须非空且在图像范围内。
+// 每像素4字节，任意x偏移都可以直接寻址
+inline ImageView CropBGRAImageView(const ImageView& view, const ImageRect& rect)
+{
+    const ImagePlane& plane = view.Planes[0];
+    return MakeSinglePlaneImageView(plane.Data + (size_t)rect.Top * plane.Pitch + (size_t)rect.Left * 4,
+                                    rect.Right - rect.Left, rect.Bottom - rect.Top, (rect.Right - rect.Left) * 4,
+                                    plane.Pitch);
+}
+
+// 区域移动（滚动、拖动窗口）：把上一帧中以(SourceLeft, SourceTop)为左上角的区域移到Destination，
+// 与DXGI_OUTDUPL_MOVE_RECT的约定相同
+struct ImageMove
+{
+    ImageRect Destination;
+    UINT SourceLeft;
+    UINT SourceTop;
+};
+
+inline ImageMove MakeImageMove(const ImageRect& destination, UINT sourceLeft, UINT sourceTop)
+{
+    ImageMove move;
+    move.Destination = destination;
+    move.SourceLeft = sourceLeft;
+    move.SourceTop = sourceTop;
+    return move;
+}
+
+inline ImageRect GetImageMoveSource(const ImageMove& move)
+{
+    return MakeImageRect(move.SourceLeft, move.SourceTop,
+                         move.SourceLeft + (move.Destination.Right - move.Destination.Left),
+                         move.SourceTop + (move.Destination.Bottom - move.Destination.Top));
+}
+
+// 两个矩形的交集，不相交时返回空矩形
+inline ImageRect IntersectImageRect(const ImageRect& a, const ImageRect& b)
+{
+    ImageRect rect = MakeImageRect(a.Left > b.Left ? a.Left : b.Left, a.Top > b.Top ? a.Top : b.Top,
+                                   a.Right < b.Right ? a.Right : b.Right, a.Bottom < b.Bottom ? a.Bottom : b.Bottom);
+    if (IsImageRectEmpty(rect))
+        return MakeImageRect(0, 0, 0, 0);
+    return rect;
+}
+
+// 输出图像相对于源图像的方向：先顺时针旋转Rotation，再在旋转后的图像上水平/垂直翻转。
+// 旋转90/270度时输出的宽高与源图像交换
+enum class ImageRotation
+{
+    None,
+    Rotate90,
+    Rotate180,
+    Rotate270
+};
+
+struct ImageOrientation
+{
+    ImageRotation Rotation;
+    bool FlipHorizontal;
+    bool FlipVertical;
+};
+
+inline ImageOrientation MakeImageOrientation(ImageRotation rotation, bool flipHorizontal = false,
+                                             bool flipVertical = false)
+{
+    ImageOrientation orientation;
+    orientation.Rotation = rotation;
+    orientation.FlipHorizontal = flipHorizontal;
+    orientation.FlipVertical = flipVertical;
+    return orientation;
+}
+
+inline bool IsIdentityOrientation(const ImageOrientation& orientation)
+{
+    return orientation.Rotation == ImageRotation::None && !orientation.FlipHorizontal && !orientation.FlipVertical;
+}
+
+// 旋转90/270度：输出的行对应源图像的列
+inline bool IsTransposingOrientation(const ImageOrientation& orientation)
+{
+    return orientation.Rotation == ImageRotation::Rotate90 || orientation.Rotation == ImageRotation::Rotate270;
+}
+
+inline void GetOrientedSize(const ImageOrientation& orientation, UINT sourceWidth, UINT sourceHeight,
+                            UINT& width, UINT& height)
+{
+    bool transposing = IsTransposingOrientation(orientation);
+    width = transposing ? sourceHeight : sourceWidth;
+    height = transposing ? sourceWidth : sourceHeight;
+}
+
+// 输出坐标到源坐标的映射（各步长为0或±1）：
+//   sx = OriginX + ox * XStepX + oy * YStepX
+//   sy = OriginY + ox * XStepY + oy * YStepY
+struct ImageOrientationMap
+{
+    int OriginX;
+    int OriginY;
+    int XStepX;
+    int XStepY;
+    int YStepX;
+    int YStepY;
+};
+
+inline ImageOrientationMap GetImageOrientationMap(const ImageOrientation& orientation, UINT sourceWidth,
+                                                  UINT sourceHeight)
+{
+    int w = static_cast<int>(sourceWidth) - 1;
+    int h = static_cast<int>(sourceHeight) - 1;
+    ImageOrientationMap map = {};
+    switch (orientation.Rotation)
+    {
+    case ImageRotation::Rotate90:   // 输出(ox, oy)来自源(oy, h - ox)
+        map.OriginY = h;
+        map.XStepY = -1;
+        map.YStepX = 1;
+        break;
+    case ImageRotation::Rotate180:
+        map.OriginX = w;
+        map.OriginY = h;
+        map.XStepX = -1;
+        map.YStepY = -1;
+        break;
+    case ImageRotation::Rotate270:  // 输出(ox, oy)来自源(w - oy, ox)
+        map.OriginX = w;
+        map.XStepY = 1;
+        map.YStepX = -1;
+        break;
+    default:
+        map.XStepX = 1;
+        map.YStepY = 1;
+        break;
+    }
+
+    // 翻转作用在输出坐标上：ox换成(outputWidth - 1 - ox)，oy同理
+    UINT width;
+    UINT height;
+    GetOrientedSize(orientation, sourceWidth, sourceHeight, width, height);
+    if (orientation.FlipHorizontal)
+    {
+        map.OriginX += (static_cast<int>(width) - 1) * map.XStepX;
+        map.OriginY += (static_cast<int>(width) - 1) * map.XStepY;
+        map.XStepX = -map.XStepX;
+        map.XStepY = -map.XStepY;
+    }
+    if (orientation.FlipVertical)
+    {
+        map.OriginX += (static_cast<int>(height) - 1) * map.YStepX;
+        map.OriginY += (static_cast<int>(height) - 1) * map.YStepY;
+        map.YStepX = -map.YStepX;
+        map.YStepY = -map.YStepY;
+    }
+    return map;
+}
+
+// 源图像中的矩形在输出图像中的位置（脏矩形、移动区域随图像一起变换）。
+// 映射矩阵是置换矩阵，逆映射为其转置
+inline ImageRect TransformImageRect(const ImageOrientationMap& map, const ImageRect& rect)
+{
+    int corners[2][2] = { { static_cast<int>(rect.Left), static_cast<int>(rect.Top) },
+                          { static_cast<int>(rect.Right) - 1, static_cast<int>(rect.Bottom) - 1 } };
+    int ox[2];
+    int oy[2];
+    for (int i = 0; i < 2; i++)
+    {
+        int dx = corners[i][0] - map.OriginX;
+        int dy = corners[i][1] - map.OriginY;
+        ox[i] = dx * map.XStepX + dy * map.XStepY;
+        oy[i] = dx * map.YStepX + dy * map.YStepY;
+    }
+    return MakeImageRect(static_cast<UINT>(ox[0] < ox[1] ? ox[0] : ox[1]),
+                         static_cast<UINT>(oy[0] < oy[1] ? oy[0] : oy[1]),
+                         static_cast<UINT>((ox[0] > ox[1] ? ox[0] : ox[1]) + 1),
+                         static_cast<UINT>((oy[0] > oy[1] ? oy[0] : oy[1]) + 1));
+}
+
+inline ImageMove TransformImageMove(const ImageOrientationMap& map, const ImageMove& move)
+{
+    ImageRect source = TransformImageRect(map, GetImageMoveSource(move));
+    return MakeImageMove(TransformImageRect(map, move.Destination), source.Left, source.Top);
+}
@@ -107,12 +107,14 @@ HRESULT NV12ToRGBAConverter::CompileShader()
     return hr;
 }
 
-HRESULT NV12ToRGBAConverter::CreateNV12InputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer)
+HRESULT NV12ToRGBAConverter::CreateNV12InputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer,
+                                                  UINT inputPitch)
 {
-    // NV12格式大小：Y平面 + UV平面（UV是Y的一半大小）
-    UINT yPlaneSize = width * height;
-    UINT uvPlaneSize = width * height / 2;  // UV平面是Y平面的一半
-    UINT totalSize = yPlaneSize + uvPlaneSize;
+    if (GetInputPitch(width, inputPitch) < ((width + 1) / 2) * 2)
+        return E_INVALIDARG;
+
+    // NV12格式大小：Y平面 + UV平面（(height + 1) / 2行），含行填充
+    UINT totalSize = GetInputBufferSize(width, height, inputPitch);
 
     D3D11_BUFFER_DESC bufferDesc = {};
     bufferDesc.ByteWidth = totalSize;
@@ -158,21 +160,26 @@ HRESULT NV12ToRGBAConverter::CreateOutputTexture(UINT width, UINT height, ID3D11
 HRESULT NV12ToRGBAConverter::WriteNV12Data(ID3D11Buffer* buffer, const BYTE* yPlaneData, 
                                           const BYTE* uvPlaneData, UINT width, UINT height)
 {
-    if (!buffer || !yPlaneData || !uvPlaneData)
+    // 紧凑布局的输入只读取，不会通过视图写入
+    UINT uvStride = GetInputPitch(width, 0);
+    return WriteNV12Data(buffer, MakeNV12ImageView(const_cast<BYTE*>(yPlaneData), width,
+                                                   const_cast<BYTE*>(uvPlaneData), uvStride, width, height));
+}
+
+HRESULT NV12ToRGBAConverter::WriteNV12Data(ID3D11Buffer* buffer, const ImageView& source, UINT inputPitch)
+{
+    UINT width = source.Width;
+    UINT height = source.Height;
+    if (!buffer || !IsImageViewValid(source, 2, width, height) ||
+        source.Planes[1].Height < (height + 1) / 2)
         return E_INVALIDARG;
 
-    UINT yPlaneSize = width * height;
-    UINT uvPlaneSize = width * height / 2;
-    UINT totalSize = yPlaneSize + uvPlaneSize;
+    UINT pitch = GetInputPitch(width, inputPitch);
+    UINT uvRowBytes = ((width + 1) / 2) * 2;
+    if (pitch < uvRowBytes || source.Planes[0].RowBytes < width || source.Planes[1].RowBytes < uvRowBytes)
+        return E_INVALIDARG;
 
-    // 创建临时缓冲区来组合Y和UV数据
-    std::vector<BYTE> nv12Data(totalSize);
-    
-    // 复制Y平面数据
-    memcpy(nv12Data.data(), yPlaneData, yPlaneSize);
-    
-    // 复制UV平面数据
-    memcpy(nv12Data.data() + yPlaneSize, uvPlaneData, uvPlaneSize);
+    UINT totalSize = GetInputBufferSize(width, height, inputPitch);
 
     // 创建staging buffer用于上传数据
     D3D11_BUFFER_DESC stagingDesc = {};
@@ -187,13 +194,25 @@ HRESULT NV12ToRGBAConverter::WriteNV12Data(ID3D11Buffer* buffer, const BYTE* yPl
     if (FAILED(hr))
         return hr;
 
-    // 映射并写入数据
+    // 映射后按行从源平面直接写入，源平面的行步长可以与缓冲区布局不同
     D3D11_MAPPED_SUBRESOURCE mappedResource;
     hr = m_context->Map(stagingBuffer, 0, D3D11_MAP_WRITE, 0, &mappedResource);
     
     if (SUCCEEDED(hr))
     {
-        memcpy(mappedResource.pData, nv12Data.data(), totalSize);
+        BYTE* yDst = static_cast<BYTE*>(mappedResource.pData);
+        BYTE* uvDst = yDst + (size_t)pitch * height;
+        const ImagePlane& yPlane = source.Planes[0];
+        const ImagePlane& uvPlane = source.Planes[1];
+
+        for (UINT y = 0; y < height; y++)
+        {
+            memcpy(yDst + (size_t)y * pitch, yPlane.Data + (size_t)y * yPlane.Pitch, width);
+        }
+        for (UINT y = 0; y < (height + 1) / 2; y++)
+        {
+            memcpy(uvDst + (size_t)y * pitch, uvPlane.Data + (size_t)y * uvPlane.Pitch, uvRowBytes);
+        }
         m_context->Unmap(stagingBuffer, 0);
         
         // 复制到目标缓冲区
@@ -205,11 +224,32 @@ HRESULT NV12ToRGBAConverter::WriteNV12Data(ID3D11Buffer* buffer, const BYTE* yPl
 }
 
 HRESULT NV12ToRGBAConverter::Convert(ID3D11Buffer* nv12Buffer, ID3D11Texture2D* outputTexture,
-                                    UINT width, UINT height)
+                                    UINT width, UINT height, UINT inputPitch)
+{
+    return Convert(nv12Buffer, outputTexture, width, height, MakeImageOrientation(ImageRotation::None), inputPitch);
+}
+
+HRESULT NV12ToRGBAConverter::Convert(ID3D11Buffer* nv12Buffer, ID3D11Texture2D* outputTexture,
+                                    UINT width, UINT height, const ImageOrientation& orientation, UINT inputPitch)
 {
     if (!m_initialized || !nv12Buffer || !outputTexture)
         return E_INVALIDARG;
 
+    UINT pitch = GetInputPitch(width, inputPitch);
+    if (pitch < ((width + 1) / 2) * 2)
+        return E_INVALIDARG;
+
+    UINT outputWidth;
+    UINT outputHeight;
+    GetOrientedSize(orientation, width, height, outputWidth, outputHeight);
+    D3D11_TEXTURE2D_DESC outputDesc;
+    outputTexture->GetDesc(&outputDesc);
+    if (outputWidth > outputDesc.Width || outputHeight > outputDesc.Height)
+        return E_INVALIDARG;
+
+    // 映射矩阵是置换矩阵，源到输出的映射为其转置：o = M^T * (s - Origin)
+    ImageOrientationMap map = GetImageOrientationMap(orientation, width, height);
+
     try
     {
         // 创建输入缓冲区的UAV
@@ -218,7 +258,7 @@ HRESULT NV12ToRGBAConverter::Convert(ID3D11Buffer* nv12Buffer, ID3D11Texture2D*
         inputUavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
         inputUavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
         inputUavDesc.Buffer.FirstElement = 0;
-        inputUavDesc.Buffer.NumElements = (width * height * 3 / 2) / 4; // NV12总字节数/4
+        inputUavDesc.Buffer.NumElements = GetInputBufferSize(width, height, inputPitch) / 4; // NV12总字节数/4
         inputUavDesc.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;
 
         ThrowIfFailed(m_device->CreateUnorderedAccessView(nv12Buffer, &inputUavDesc, &inputUAV),
@@ -242,8 +282,16 @@ HRESULT NV12ToRGBAConverter::Convert(ID3D11Buffer* nv12Buffer, ID3D11Texture2D*
         NV12ConversionParams* params = (NV12ConversionParams*)mappedResource.pData;
         params->ImageWidth = width;
         params->ImageHeight = height;
-        params->YPlaneStride = width;        // Y平面每行的字节数
-        params->UVPlaneStride = width;       // UV平面每行的字节数
+        params->YPlaneStride = pitch;        // Y平面每行的字节数
+        params->UVPlaneStride = pitch;       // UV平面每行的字节数
+        params->UVPlaneOffset = pitch * height;
+        params->OutputOriginX = -(map.XStepX * map.OriginX + map.XStepY * map.OriginY);
+        params->OutputOriginY = -(map.YStepX * map.OriginX + map.YStepY * map.OriginY);
+        params->ColumnStepX = map.XStepX;
+        params->ColumnStepY = map.YStepX;
+        params->RowStepX = map.XStepY;
+        params->RowStepY = map.YStepY;
+        params->Padding = 0;
 
         m_context->Unmap(m_constantBuffer, 0);
 
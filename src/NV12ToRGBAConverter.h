@@ -1,4 +1,5 @@
 #pragma once
+#include "ImageView.h"
 #include "Utils.h"
 #include <chrono>
 
@@ -8,6 +9,15 @@ struct NV12ConversionParams
     UINT ImageHeight;
     UINT YPlaneStride;    // Y平面的行步长
     UINT UVPlaneStride;   // UV平面的行步长
+    UINT UVPlaneOffset;   // UV平面相对缓冲区起始的字节偏移
+    // 源像素(x, y)写到输出纹理的OutputOrigin + x * ColumnStep + y * RowStep（旋转/翻转，步长为0或±1）
+    INT OutputOriginX;
+    INT OutputOriginY;
+    INT ColumnStepX;
+    INT ColumnStepY;
+    INT RowStepX;
+    INT RowStepY;
+    UINT Padding;         // 常量缓冲区大小须为16字节的倍数
 };
 
 class NV12ToRGBAConverter
@@ -17,14 +27,34 @@ public:
     ~NV12ToRGBAConverter();
 
     HRESULT Initialize(ID3D11Device* device, ID3D11DeviceContext* context);
+    // 输入缓冲区布局：Y平面在前，UV平面紧随其后，两个平面使用相同的行步长
+    // inputPitch（字节，0表示width向上取偶数），与解码器表面的常见布局一致
     HRESULT Convert(ID3D11Buffer* nv12Buffer, ID3D11Texture2D* outputTexture,
-                   UINT width, UINT height);
+                   UINT width, UINT height, UINT inputPitch = 0);
+    // 旋转/翻转转换：width/height为NV12图像的尺寸，输出纹理至少为GetOrientedSize的尺寸。
+    // 每个线程仍按源像素读取，直接写到变换后的位置
+    HRESULT Convert(ID3D11Buffer* nv12Buffer, ID3D11Texture2D* outputTexture,
+                   UINT width, UINT height, const ImageOrientation& orientation, UINT inputPitch = 0);
     HRESULT CreateOutputTexture(UINT width, UINT height, ID3D11Texture2D** outTexture);
-    HRESULT CreateNV12InputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer);
+    HRESULT CreateNV12InputBuffer(UINT width, UINT height, ID3D11Buffer** outBuffer, UINT inputPitch = 0);
     HRESULT WriteNV12Data(ID3D11Buffer* buffer, const BYTE* yPlaneData, const BYTE* uvPlaneData,
                          UINT width, UINT height);
+    // 按视图中各平面的行步长读取，直接写入输入缓冲区布局，无需中间打包
+    HRESULT WriteNV12Data(ID3D11Buffer* buffer, const ImageView& source, UINT inputPitch = 0);
     void Cleanup();
 
+    static UINT GetInputPitch(UINT width, UINT inputPitch)
+    {
+        return inputPitch ? inputPitch : ((width + 1) / 2) * 2;
+    }
+
+    // 输入缓冲区大小，向上取整到4字节（RAW缓冲区按32位访问）
+    static UINT GetInputBufferSize(UINT width, UINT height, UINT inputPitch)
+    {
+        UINT pitch = GetInputPitch(width, inputPitch);
+        return (pitch * (height + (height + 1) / 2) + 3) & ~3u;
+    }
+
 private:
     HRESULT CompileShader();
 
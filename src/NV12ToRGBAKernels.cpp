@@ -0,0 +1,102 @@
+#include "NV12ToRGBAKernels.h"
+#include "ColorConversionMath.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    template <UINT (*ConvertPixel)(BYTE, BYTE, BYTE)>
+    void ConvertRowPair(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                        BYTE* rgbaRow0, BYTE* rgbaRow1, UINT firstPixel, UINT width)
+    {
+        for (UINT x = firstPixel; x < width; x++)
+        {
+            // 计算UV平面中的位置（UV是2:1采样）
+            const BYTE* uv = uvRow + (x / 2) * 2;
+
+            UINT pixel0 = ConvertPixel(yRow0[x], uv[0], uv[1]);
+            memcpy(rgbaRow0 + x * 4, &pixel0, sizeof(pixel0));
+
+            if (yRow1)
+            {
+                UINT pixel1 = ConvertPixel(yRow1[x], uv[0], uv[1]);
+                memcpy(rgbaRow1 + x * 4, &pixel1, sizeof(pixel1));
+            }
+        }
+    }
+}
+
+void NV12ToRGBARowPairTail_C(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                             BYTE* rgbaRow0, BYTE* rgbaRow1, UINT firstPixel, UINT width)
+{
+    ConvertRowPair<ConvertNV12PixelToRGBAFixed>(yRow0, yRow1, uvRow, rgbaRow0, rgbaRow1, firstPixel, width);
+}
+
+void NV12ToRGBARowPair_C(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                         BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width)
+{
+    ConvertRowPair<ConvertNV12PixelToRGBAFixed>(yRow0, yRow1, uvRow, rgbaRow0, rgbaRow1, 0, width);
+}
+
+void NV12ToRGBARowPair_Float(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                             BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width)
+{
+    ConvertRowPair<ConvertNV12PixelToRGBA>(yRow0, yRow1, uvRow, rgbaRow0, rgbaRow1, 0, width);
+}
+
+NV12FixedPointDeviation MeasureNV12FixedPointDeviation()
+{
+    NV12FixedPointDeviation result = {};
+
+    for (int y = 0; y < 256; y++)
+    {
+        for (int u = 0; u < 256; u++)
+        {
+            for (int v = 0; v < 256; v++)
+            {
+                UINT fixedPixel = ConvertNV12PixelToRGBAFixed(static_cast<BYTE>(y), static_cast<BYTE>(u), static_cast<BYTE>(v));
+                UINT floatPixel = ConvertNV12PixelToRGBA(static_cast<BYTE>(y), static_cast<BYTE>(u), static_cast<BYTE>(v));
+
+                int deltaR = static_cast<int>(fixedPixel & 0xFF) - static_cast<int>(floatPixel & 0xFF);
+                int deltaG = static_cast<int>((fixedPixel >> 8) & 0xFF) - static_cast<int>((floatPixel >> 8) & 0xFF);
+                int deltaB = static_cast<int>((fixedPixel >> 16) & 0xFF) - static_cast<int>((floatPixel >> 16) & 0xFF);
+
+                result.MismatchR += deltaR != 0;
+                result.MismatchG += deltaG != 0;
+                result.MismatchB += deltaB != 0;
+                result.MaxDeviation = (std::max)(result.MaxDeviation,
+                                               (std::max)(std::abs(deltaR), (std::max)(std::abs(deltaG), std::abs(deltaB))));
+                result.SampleCount++;
+            }
+        }
+    }
+
+    return result;
+}
+
+NV12ToRGBARowPairFunc GetNV12ToRGBARowPairKernel(SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    NV12ToRGBARowPairFunc kernel = NV12ToRGBARowPair_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX2)
+    {
+        kernel = NV12ToRGBARowPair_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = NV12ToRGBARowPair_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+
+// NV12到RGBA的CPU行对转换内核
+// 一次处理共享同一UV行的两行Y（对应shader中uvY = y / 2的寻址），
+// 每个色度样本只读取和计算一次，写出两行RGBA8（Alpha = 255）。
+// yRow1/rgbaRow1为空时只处理一行（奇数高度的最后一行）。
+// 所有内核使用ColorConversionMath.h中的定点公式，输出逐位一致。
+typedef void (*NV12ToRGBARowPairFunc)(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                                      BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width);
+
+// 定点路径相对浮点路径的偏差统计（穷举全部2^24种YUV输入）
+struct NV12FixedPointDeviation
+{
+    unsigned long long SampleCount;
+    unsigned long long MismatchR;
+    unsigned long long MismatchG;
+    unsigned long long MismatchB;
+    int MaxDeviation;
+};
+
+void NV12ToRGBARowPair_C(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                         BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width);
+void NV12ToRGBARowPair_Float(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                             BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+void NV12ToRGBARowPair_SSE41(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                             BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width);
+void NV12ToRGBARowPair_AVX2(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                            BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width);
+#endif
+
+// 从第firstPixel个像素（必须为偶数）开始用标量定点代码转换到行尾，供SIMD内核处理尾部
+void NV12ToRGBARowPairTail_C(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                             BYTE* rgbaRow0, BYTE* rgbaRow1, UINT firstPixel, UINT width);
+
+NV12FixedPointDeviation MeasureNV12FixedPointDeviation();
+
+// 返回不超过level的最优内核（该转换最高提供AVX2版本）
+NV12ToRGBARowPairFunc GetNV12ToRGBARowPairKernel(SimdLevel level, SimdLevel* selectedLevel = nullptr);
@@ -0,0 +1,110 @@
+#include "NV12ToRGBAKernels.h"
+#include "ColorConversionMath.h"
+#include <immintrin.h>
+
+// AVX2内核：
+//   - 4个UV样本零扩展为64位后复制到高32位，得到8个像素各自的 (U-128) | (V-128)<<16 通道；
+//   - 色度项用拆分后的系数做两次pmaddwd合并，每个UV样本只计算一次并由两行Y共享；
+//   - Y项用32位乘法，与色度项相加后右移、钳位，打包为RGBA（Alpha = 255）。
+namespace
+{
+    struct ChromaCoefficients
+    {
+        __m256i RHigh;
+        __m256i RLow;
+        __m256i GHigh;
+        __m256i GLow;
+        __m256i BHigh;
+        __m256i BLow;
+    };
+
+    // 8个像素的色度项（已含取整偏移），两行像素共用
+    struct ChromaTerms
+    {
+        __m256i R;
+        __m256i G;
+        __m256i B;
+    };
+
+    inline ChromaCoefficients LoadChromaCoefficients()
+    {
+        ChromaCoefficients c;
+        c.RHigh = _mm256_set1_epi32(PackCoefficientPair(0, NV12CoefficientHigh(kNV12CoefRV)));
+        c.RLow = _mm256_set1_epi32(PackCoefficientPair(0, NV12CoefficientLow(kNV12CoefRV)));
+        c.GHigh = _mm256_set1_epi32(PackCoefficientPair(NV12CoefficientHigh(kNV12CoefGU), NV12CoefficientHigh(kNV12CoefGV)));
+        c.GLow = _mm256_set1_epi32(PackCoefficientPair(NV12CoefficientLow(kNV12CoefGU), NV12CoefficientLow(kNV12CoefGV)));
+        c.BHigh = _mm256_set1_epi32(PackCoefficientPair(NV12CoefficientHigh(kNV12CoefBU), 0));
+        c.BLow = _mm256_set1_epi32(PackCoefficientPair(NV12CoefficientLow(kNV12CoefBU), 0));
+        return c;
+    }
+
+    inline __m256i MultiplyAdd(__m256i uv, __m256i high, __m256i low)
+    {
+        __m256i result = _mm256_slli_epi32(_mm256_madd_epi16(uv, high), kNV12CoefSplitShift);
+        return _mm256_add_epi32(_mm256_add_epi32(result, _mm256_madd_epi16(uv, low)), _mm256_set1_epi32(kNV12Round));
+    }
+
+    // 由4个UV样本（8字节）计算8个像素的色度项
+    inline ChromaTerms ComputeChroma8(const BYTE* uvRow, const ChromaCoefficients& c)
+    {
+        __m128i samples = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(uvRow)));
+        __m256i uv = _mm256_cvtepu32_epi64(samples);
+        uv = _mm256_or_si256(uv, _mm256_slli_epi64(uv, 32));
+
+        __m256i lanes = _mm256_or_si256(_mm256_and_si256(uv, _mm256_set1_epi32(0xFF)),
+                                        _mm256_slli_epi32(_mm256_and_si256(uv, _mm256_set1_epi32(0xFF00)), 8));
+        lanes = _mm256_sub_epi16(lanes, _mm256_set1_epi32(128 | (128 << 16)));
+
+        ChromaTerms terms;
+        terms.R = MultiplyAdd(lanes, c.RHigh, c.RLow);
+        terms.G = MultiplyAdd(lanes, c.GHigh, c.GLow);
+        terms.B = MultiplyAdd(lanes, c.BHigh, c.BLow);
+        return terms;
+    }
+
+    inline __m256i ClampToByte(__m256i value)
+    {
+        value = _mm256_srai_epi32(value, kNV12FixedShift);
+        return _mm256_min_epi32(_mm256_max_epi32(value, _mm256_setzero_si256()), _mm256_set1_epi32(255));
+    }
+
+    // 转换8个像素，输出8个RGBA像素
+    inline void ConvertPixels8(const BYTE* yRow, BYTE* rgbaRow, const ChromaTerms& chroma)
+    {
+        __m256i y = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(yRow)));
+        __m256i yTerm = _mm256_mullo_epi32(_mm256_sub_epi32(y, _mm256_set1_epi32(16)), _mm256_set1_epi32(kNV12CoefY));
+
+        __m256i r = ClampToByte(_mm256_add_epi32(yTerm, chroma.R));
+        __m256i g = ClampToByte(_mm256_add_epi32(yTerm, chroma.G));
+        __m256i b = ClampToByte(_mm256_add_epi32(yTerm, chroma.B));
+
+        __m256i rgba = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                       _mm256_or_si256(_mm256_slli_epi32(b, 16),
+                                                       _mm256_set1_epi32(static_cast<int>(0xFF000000u))));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgbaRow), rgba);
+    }
+}
+
+void NV12ToRGBARowPair_AVX2(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                            BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width)
+{
+    const ChromaCoefficients c = LoadChromaCoefficients();
+
+    // 每次迭代处理16个像素（8个UV样本）
+    UINT x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        ChromaTerms chroma0 = ComputeChroma8(uvRow + x, c);
+        ChromaTerms chroma1 = ComputeChroma8(uvRow + x + 8, c);
+
+        ConvertPixels8(yRow0 + x, rgbaRow0 + x * 4, chroma0);
+        ConvertPixels8(yRow0 + x + 8, rgbaRow0 + (x + 8) * 4, chroma1);
+        if (yRow1)
+        {
+            ConvertPixels8(yRow1 + x, rgbaRow1 + x * 4, chroma0);
+            ConvertPixels8(yRow1 + x + 8, rgbaRow1 + (x + 8) * 4, chroma1);
+        }
+    }
+
+    NV12ToRGBARowPairTail_C(yRow0, yRow1, uvRow, rgbaRow0, rgbaRow1, x, width);
+}
@@ -0,0 +1,113 @@
+#include "NV12ToRGBAKernels.h"
+#include "ColorConversionMath.h"
+#include <cstring>
+#include <smmintrin.h>
+
+// SSE4.1内核：算法与AVX2版本相同，每个寄存器处理4个像素
+namespace
+{
+    struct ChromaCoefficients
+    {
+        __m128i RHigh;
+        __m128i RLow;
+        __m128i GHigh;
+        __m128i GLow;
+        __m128i BHigh;
+        __m128i BLow;
+    };
+
+    // 4个像素的色度项（已含取整偏移），两行像素共用
+    struct ChromaTerms
+    {
+        __m128i R;
+        __m128i G;
+        __m128i B;
+    };
+
+    inline ChromaCoefficients LoadChromaCoefficients()
+    {
+        ChromaCoefficients c;
+        c.RHigh = _mm_set1_epi32(PackCoefficientPair(0, NV12CoefficientHigh(kNV12CoefRV)));
+        c.RLow = _mm_set1_epi32(PackCoefficientPair(0, NV12CoefficientLow(kNV12CoefRV)));
+        c.GHigh = _mm_set1_epi32(PackCoefficientPair(NV12CoefficientHigh(kNV12CoefGU), NV12CoefficientHigh(kNV12CoefGV)));
+        c.GLow = _mm_set1_epi32(PackCoefficientPair(NV12CoefficientLow(kNV12CoefGU), NV12CoefficientLow(kNV12CoefGV)));
+        c.BHigh = _mm_set1_epi32(PackCoefficientPair(NV12CoefficientHigh(kNV12CoefBU), 0));
+        c.BLow = _mm_set1_epi32(PackCoefficientPair(NV12CoefficientLow(kNV12CoefBU), 0));
+        return c;
+    }
+
+    inline __m128i MultiplyAdd(__m128i uv, __m128i high, __m128i low)
+    {
+        __m128i result = _mm_slli_epi32(_mm_madd_epi16(uv, high), kNV12CoefSplitShift);
+        return _mm_add_epi32(_mm_add_epi32(result, _mm_madd_epi16(uv, low)), _mm_set1_epi32(kNV12Round));
+    }
+
+    inline __m128i LoadBytes4(const BYTE* data)
+    {
+        int value;
+        memcpy(&value, data, sizeof(value));
+        return _mm_cvtsi32_si128(value);
+    }
+
+    // 由2个UV样本（4字节）计算4个像素的色度项，每个32位通道为 (U-128) | (V-128)<<16
+    inline ChromaTerms ComputeChroma4(const BYTE* uvRow, const ChromaCoefficients& c)
+    {
+        __m128i uv = _mm_cvtepu16_epi64(LoadBytes4(uvRow));
+        uv = _mm_or_si128(uv, _mm_slli_epi64(uv, 32));
+
+        __m128i lanes = _mm_or_si128(_mm_and_si128(uv, _mm_set1_epi32(0xFF)),
+                                     _mm_slli_epi32(_mm_and_si128(uv, _mm_set1_epi32(0xFF00)), 8));
+        lanes = _mm_sub_epi16(lanes, _mm_set1_epi32(128 | (128 << 16)));
+
+        ChromaTerms terms;
+        terms.R = MultiplyAdd(lanes, c.RHigh, c.RLow);
+        terms.G = MultiplyAdd(lanes, c.GHigh, c.GLow);
+        terms.B = MultiplyAdd(lanes, c.BHigh, c.BLow);
+        return terms;
+    }
+
+    inline __m128i ClampToByte(__m128i value)
+    {
+        value = _mm_srai_epi32(value, kNV12FixedShift);
+        return _mm_min_epi32(_mm_max_epi32(value, _mm_setzero_si128()), _mm_set1_epi32(255));
+    }
+
+    // 转换4个像素，输出4个RGBA像素
+    inline void ConvertPixels4(const BYTE* yRow, BYTE* rgbaRow, const ChromaTerms& chroma)
+    {
+        __m128i y = _mm_cvtepu8_epi32(LoadBytes4(yRow));
+        __m128i yTerm = _mm_mullo_epi32(_mm_sub_epi32(y, _mm_set1_epi32(16)), _mm_set1_epi32(kNV12CoefY));
+
+        __m128i r = ClampToByte(_mm_add_epi32(yTerm, chroma.R));
+        __m128i g = ClampToByte(_mm_add_epi32(yTerm, chroma.G));
+        __m128i b = ClampToByte(_mm_add_epi32(yTerm, chroma.B));
+
+        __m128i rgba = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                                    _mm_or_si128(_mm_slli_epi32(b, 16), _mm_set1_epi32(static_cast<int>(0xFF000000u))));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgbaRow), rgba);
+    }
+}
+
+void NV12ToRGBARowPair_SSE41(const BYTE* yRow0, const BYTE* yRow1, const BYTE* uvRow,
+                             BYTE* rgbaRow0, BYTE* rgbaRow1, UINT width)
+{
+    const ChromaCoefficients c = LoadChromaCoefficients();
+
+    // 每次迭代处理8个像素（4个UV样本）
+    UINT x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        ChromaTerms chroma0 = ComputeChroma4(uvRow + x, c);
+        ChromaTerms chroma1 = ComputeChroma4(uvRow + x + 4, c);
+
+        ConvertPixels4(yRow0 + x, rgbaRow0 + x * 4, chroma0);
+        ConvertPixels4(yRow0 + x + 4, rgbaRow0 + (x + 4) * 4, chroma1);
+        if (yRow1)
+        {
+            ConvertPixels4(yRow1 + x, rgbaRow1 + x * 4, chroma0);
+            ConvertPixels4(yRow1 + x + 4, rgbaRow1 + (x + 4) * 4, chroma1);
+        }
+    }
+
+    NV12ToRGBARowPairTail_C(yRow0, yRow1, uvRow, rgbaRow0, rgbaRow1, x, width);
+}
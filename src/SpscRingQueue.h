@@ -0,0 +1,103 @@
+#pragma once
+#include "Utils.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+// 有界单生产者/单消费者无锁环形队列
+// 槽位在Initialize时一次性分配（容量向上取整到2的幂），之后入队/出队只移动元素，
+// 不加锁也不分配内存。只能由一个线程TryPush、另一个线程TryPop。
+// 队列本身不阻塞，满/空时由调用者决定等待或丢弃
+template <typename T>
+class SpscRingQueue
+{
+public:
+    SpscRingQueue()
+        : m_mask(0)
+        , m_head(0)
+        , m_cachedTail(0)
+        , m_tail(0)
+        , m_cachedHead(0)
+    {
+    }
+
+    HRESULT Initialize(UINT capacity)
+    {
+        if (capacity == 0)
+            return E_INVALIDARG;
+
+        size_t slotCount = 1;
+        while (slotCount < capacity)
+            slotCount *= 2;
+
+        try
+        {
+            m_slots.clear();
+            m_slots.resize(slotCount);
+        }
+        catch (const std::bad_alloc&)
+        {
+            return E_OUTOFMEMORY;
+        }
+
+        m_mask = slotCount - 1;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        m_cachedHead = 0;
+        m_cachedTail = 0;
+        return S_OK;
+    }
+
+    // 生产者线程：成功时item被移入队列
+    bool TryPush(T& item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask)
+        {
+            // 缓存的消费位置显示已满，重新读取一次
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask)
+                return false;
+        }
+
+        m_slots[tail & m_mask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程：成功时队首元素被移出到item
+    bool TryPop(T& item)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+                return false;
+        }
+
+        item = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 近似值，仅用于统计
+    UINT GetSize() const
+    {
+        return static_cast<UINT>(m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire));
+    }
+
+    UINT GetCapacity() const { return static_cast<UINT>(m_slots.size()); }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask;
+
+    // 消费者写入的位置与它缓存的生产位置放在同一缓存行，与生产者一侧分开，避免伪共享
+    alignas(64) std::atomic<size_t> m_head;
+    size_t m_cachedTail;
+    alignas(64) std::atomic<size_t> m_tail;
+    size_t m_cachedHead;
+};
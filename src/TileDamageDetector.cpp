@@ -0,0 +1,618 @@
+#include "TileDamageDetector.h"
+#include "DirtyRegionTracker.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const UINT kMinScrollRows = 8;          // 搬移的最少连续匹配行数，更短的匹配按变化处理
+    const UINT kScrollAnchorRows = 48;      // 每段抽取的锚点行数
+    const UINT kScrollMaxCandidates = 4;    // 锚点在上一帧中出现超过这么多次时不参与投票
+
+    // 上下边界相同、左右相接的矩形合并
+    void MergeRectsHorizontally(std::vector<ImageRect>& rects)
+    {
+        std::sort(rects.begin(), rects.end(), [](const ImageRect& a, const ImageRect& b)
+        {
+            if (a.Top != b.Top)
+                return a.Top < b.Top;
+            if (a.Bottom != b.Bottom)
+                return a.Bottom < b.Bottom;
+            return a.Left < b.Left;
+        });
+
+        size_t count = 0;
+        for (size_t i = 0; i < rects.size(); i++)
+        {
+            const ImageRect& rect = rects[i];
+            if (count > 0)
+            {
+                ImageRect& last = rects[count - 1];
+                if (last.Top == rect.Top && last.Bottom == rect.Bottom && last.Right == rect.Left)
+                {
+                    last.Right = rect.Right;
+                    continue;
+                }
+            }
+            rects[count++] = rect;
+        }
+        rects.resize(count);
+    }
+
+    // 左右边界相同、上下间隔不超过maxGap行的矩形合并（间隔中的行也被转换）
+    void MergeRectsVertically(std::vector<ImageRect>& rects, UINT maxGap)
+    {
+        std::sort(rects.begin(), rects.end(), [](const ImageRect& a, const ImageRect& b)
+        {
+            if (a.Left != b.Left)
+                return a.Left < b.Left;
+            if (a.Right != b.Right)
+                return a.Right < b.Right;
+            return a.Top < b.Top;
+        });
+
+        size_t count = 0;
+        for (size_t i = 0; i < rects.size(); i++)
+        {
+            const ImageRect& rect = rects[i];
+            if (count > 0)
+            {
+                ImageRect& last = rects[count - 1];
+                if (last.Left == rect.Left && last.Right == rect.Right && rect.Top <= last.Bottom + maxGap)
+                {
+                    last.Bottom = (std::max)(last.Bottom, rect.Bottom);
+                    continue;
+                }
+            }
+            rects[count++] = rect;
+        }
+        rects.resize(count);
+    }
+
+    // 目标区域上下边界相同、源行相同（偏移相同）、左右相接的移动合并
+    void MergeMovesHorizontally(std::vector<ImageMove>& moves)
+    {
+        std::sort(moves.begin(), moves.end(), [](const ImageMove& a, const ImageMove& b)
+        {
+            if (a.Destination.Top != b.Destination.Top)
+                return a.Destination.Top < b.Destination.Top;
+            if (a.Destination.Bottom != b.Destination.Bottom)
+                return a.Destination.Bottom < b.Destination.Bottom;
+            if (a.SourceTop != b.SourceTop)
+                return a.SourceTop < b.SourceTop;
+            return a.Destination.Left < b.Destination.Left;
+        });
+
+        size_t count = 0;
+        for (size_t i = 0; i < moves.size(); i++)
+        {
+            const ImageMove& move = moves[i];
+            if (count > 0)
+            {
+                ImageMove& last = moves[count - 1];
+                if (last.Destination.Top == move.Destination.Top && last.Destination.Bottom == move.Destination.Bottom &&
+                    last.SourceTop == move.SourceTop && last.Destination.Right == move.Destination.Left)
+                {
+                    last.Destination.Right = move.Destination.Right;
+                    continue;
+                }
+            }
+            moves[count++] = move;
+        }
+        moves.resize(count);
+    }
+}
+
+TileDamageDetector::TileDamageDetector()
+    : m_rowKernel(nullptr)
+    , m_simdLevel(SimdLevel::Scalar)
+    , m_threadPool(nullptr)
+    , m_width(0)
+    , m_height(0)
+    , m_tilesX(0)
+    , m_tilesY(0)
+    , m_changedTiles(0)
+    , m_lastShift(0)
+    , m_hasPrevious(false)
+    , m_hasPreviousPixels(false)
+    , m_initialized(false)
+{
+}
+
+TileDamageDetector::~TileDamageDetector()
+{
+    Cleanup();
+}
+
+HRESULT TileDamageDetector::Initialize(const CpuConversionOptions& options)
+{
+    m_rowKernel = GetTileHashRowKernel(options.MaxSimdLevel, &m_simdLevel);
+
+    if (options.ThreadPool)
+    {
+        m_threadPool = options.ThreadPool;
+    }
+    else if (options.ThreadCount != 1)
+    {
+        m_ownedThreadPool.reset(new WorkerThreadPool());
+        HRESULT hr = m_ownedThreadPool->Initialize(options.ThreadCount, options.PinThreads);
+        if (FAILED(hr))
+        {
+            LogError("Failed to start tile damage worker threads");
+            Cleanup();
+            return hr;
+        }
+        m_threadPool = m_ownedThreadPool.get();
+    }
+
+    m_initialized = true;
+    LogMessage(std::string("Tile damage detector initialized successfully (") + GetSimdLevelName(m_simdLevel) +
+              ", " + std::to_string(GetThreadCount()) + " threads)");
+    return S_OK;
+}
+
+void TileDamageDetector::HashTileRow(void* context, UINT tileRow)
+{
+    const HashContext* hash = static_cast<const HashContext*>(context);
+
+    UINT rowBegin = tileRow * kDamageTileSize;
+    UINT rowEnd = (std::min)(rowBegin + kDamageTileSize, hash->Height);
+    for (UINT y = rowBegin; y < rowEnd; y++)
+    {
+        hash->RowKernel(hash->Source.Data + (size_t)y * hash->Source.Pitch, hash->Width,
+                        hash->RowHashes + (size_t)y * hash->TilesX);
+    }
+
+    if (!hash->Previous)
+        return;
+
+    // 分块中任意一个行段变化即分块变化
+    BYTE* changed = hash->Changed + (size_t)tileRow * hash->TilesX;
+    memset(changed, 0, hash->TilesX);
+    for (UINT y = rowBegin; y < rowEnd; y++)
+    {
+        const unsigned long long* current = hash->RowHashes + (size_t)y * hash->TilesX;
+        const unsigned long long* previous = hash->Previous + (size_t)y * hash->TilesX;
+        for (UINT tile = 0; tile < hash->TilesX; tile++)
+        {
+            changed[tile] |= current[tile] != previous[tile] ? 1 : 0;
+        }
+    }
+}
+
+HRESULT TileDamageDetector::HashFrame(const ImageView& source, bool& fullFrame)
+{
+    fullFrame = true;
+    if (!m_initialized)
+        return E_FAIL;
+
+    UINT width = source.Width;
+    UINT height = source.Height;
+    if (!IsImageViewValid(source, 1, width, height) || source.Planes[0].RowBytes < width * 4)
+    {
+        // 这一帧没有参与比较，下一帧不能再与更早的帧比较
+        m_hasPrevious = false;
+        return E_INVALIDARG;
+    }
+
+    if (width != m_width || height != m_height)
+    {
+        UINT tilesX = (width + kDamageTileSize - 1) / kDamageTileSize;
+        UINT tilesY = (height + kDamageTileSize - 1) / kDamageTileSize;
+        try
+        {
+            m_rowHashes.resize((size_t)height * tilesX);
+            m_previousRows.resize((size_t)height * tilesX);
+            m_changed.resize((size_t)tilesX * tilesY);
+            m_rowMatches.resize(height);
+        }
+        catch (const std::bad_alloc&)
+        {
+            LogError("Failed to allocate tile hash buffers");
+            m_width = 0;
+            m_height = 0;
+            m_hasPrevious = false;
+            return E_OUTOFMEMORY;
+        }
+        m_width = width;
+        m_height = height;
+        m_tilesX = tilesX;
+        m_tilesY = tilesY;
+        m_hasPrevious = false;
+    }
+
+    HashContext context;
+    context.RowKernel = m_rowKernel;
+    context.Source = source.Planes[0];
+    context.Width = width;
+    context.Height = height;
+    context.TilesX = m_tilesX;
+    context.RowHashes = m_rowHashes.data();
+    context.Previous = m_hasPrevious ? m_previousRows.data() : nullptr;
+    context.Changed = m_changed.data();
+
+    if (m_threadPool && m_tilesY > 1)
+    {
+        m_threadPool->Run(m_tilesY, HashTileRow, &context);
+    }
+    else
+    {
+        for (UINT tileRow = 0; tileRow < m_tilesY; tileRow++)
+        {
+            HashTileRow(&context, tileRow);
+        }
+    }
+
+    if (!m_hasPrevious)
+    {
+        m_changedTiles = m_tilesX * m_tilesY;
+        m_previousRows.swap(m_rowHashes);
+        m_hasPrevious = true;
+        return S_OK;
+    }
+
+    fullFrame = false;
+    m_changedTiles = 0;
+    for (BYTE changed : m_changed)
+    {
+        m_changedTiles += changed;
+    }
+    return S_OK;
+}
+
+HRESULT TileDamageDetector::DetectDamage(const ImageView& source, std::vector<ImageRect>& outRects, bool& fullFrame)
+{
+    outRects.clear();
+    // 不检测滚动时不维护像素副本，之后检测滚动的帧需要重新复制整帧
+    m_hasPreviousPixels = false;
+    HRESULT hr = HashFrame(source, fullFrame);
+    if (FAILED(hr) || fullFrame)
+        return hr;
+
+    // 同一分块行中连续变化的分块合并为一个矩形；与上一分块行中某个矩形左右边界相同时向下延伸它。
+    // openBegin..openEnd是上一分块行产生或延伸的矩形（按Left递增）
+    size_t openBegin = 0;
+    size_t openEnd = 0;
+    for (UINT tileRow = 0; tileRow < m_tilesY; tileRow++)
+    {
+        const BYTE* changed = m_changed.data() + (size_t)tileRow * m_tilesX;
+        UINT top = tileRow * kDamageTileSize;
+        UINT bottom = (std::min)(top + kDamageTileSize, m_height);
+        size_t rowBegin = outRects.size();
+        size_t open = openBegin;
+
+        for (UINT tile = 0; tile < m_tilesX; )
+        {
+            if (!changed[tile])
+            {
+                tile++;
+                continue;
+            }
+
+            UINT runBegin = tile;
+            while (tile < m_tilesX && changed[tile])
+            {
+                tile++;
+            }
+
+            UINT left = runBegin * kDamageTileSize;
+            UINT right = (std::min)(tile * kDamageTileSize, m_width);
+            while (open < openEnd && outRects[open].Left < left)
+            {
+                open++;
+            }
+            if (open < openEnd && outRects[open].Left == left && outRects[open].Right == right)
+            {
+                // 延伸的矩形移到本分块行的末尾，使本分块行的矩形保持连续并按Left递增
+                ImageRect rect = outRects[open];
+                rect.Bottom = bottom;
+                outRects.erase(outRects.begin() + open);
+                openEnd--;
+                rowBegin--;
+                outRects.push_back(rect);
+            }
+            else
+            {
+                outRects.push_back(MakeImageRect(left, top, right, bottom));
+            }
+        }
+
+        openBegin = rowBegin;
+        openEnd = outRects.size();
+    }
+
+    m_previousRows.swap(m_rowHashes);
+    return S_OK;
+}
+
+bool TileDamageDetector::IsRowMoved(const ImagePlane& source, UINT y, UINT sourceRow, UINT left, UINT right) const
+{
+    return memcmp(source.Data + (size_t)y * source.Pitch + left * 4,
+                  m_previousPixels.data() + ((size_t)sourceRow * m_width + left) * 4, (right - left) * 4) == 0;
+}
+
+HRESULT TileDamageDetector::StorePreviousPixels(const ImagePlane& source, bool changedOnly)
+{
+    size_t rowBytes = (size_t)m_width * 4;
+    if (!changedOnly)
+    {
+        try
+        {
+            m_previousPixels.resize(rowBytes * m_height);
+        }
+        catch (const std::bad_alloc&)
+        {
+            LogError("Failed to allocate previous frame buffer for scroll detection");
+            m_hasPreviousPixels = false;
+            return E_OUTOFMEMORY;
+        }
+
+        for (UINT y = 0; y < m_height; y++)
+        {
+            memcpy(m_previousPixels.data() + y * rowBytes, source.Data + (size_t)y * source.Pitch, rowBytes);
+        }
+        m_hasPreviousPixels = true;
+        return S_OK;
+    }
+
+    // 未变化的分块哈希相同，副本中的内容已经是最新的；同一分块行中连续变化的分块一起复制
+    for (UINT tileRow = 0; tileRow < m_tilesY; tileRow++)
+    {
+        const BYTE* changed = m_changed.data() + (size_t)tileRow * m_tilesX;
+        UINT top = tileRow * kDamageTileSize;
+        UINT bottom = (std::min)(top + kDamageTileSize, m_height);
+        for (UINT tile = 0; tile < m_tilesX; )
+        {
+            if (!changed[tile])
+            {
+                tile++;
+                continue;
+            }
+
+            UINT runBegin = tile;
+            while (tile < m_tilesX && changed[tile])
+            {
+                tile++;
+            }
+            size_t left = (size_t)runBegin * kDamageTileSize * 4;
+            size_t bytes = (std::min)((size_t)tile * kDamageTileSize * 4, rowBytes) - left;
+            for (UINT y = top; y < bottom; y++)
+            {
+                memcpy(m_previousPixels.data() + y * rowBytes + left, source.Data + (size_t)y * source.Pitch + left, bytes);
+            }
+        }
+    }
+    return S_OK;
+}
+
+bool TileDamageDetector::IsAnchorRow(UINT column, UINT top, UINT y) const
+{
+    // 内容未变的行和与上一行相同的行（纯色背景等）不能确定偏移
+    size_t index = (size_t)y * m_tilesX + column;
+    unsigned long long hash = m_rowHashes[index];
+    return hash != m_previousRows[index] && (y == top || hash != m_rowHashes[index - m_tilesX]);
+}
+
+int TileDamageDetector::FindColumnShift(UINT column, UINT top, UINT bottom)
+{
+    const unsigned long long* current = m_rowHashes.data() + column;
+    const unsigned long long* previous = m_previousRows.data() + column;
+    size_t stride = m_tilesX;
+    UINT step = (std::max)(1u, (bottom - top) / kScrollAnchorRows);
+
+    // 滚动通常持续多帧并且覆盖多个分块列：先用最近一次找到的偏移验证锚点，大部分锚点匹配时直接采用
+    if (m_lastShift != 0)
+    {
+        UINT anchors = 0;
+        UINT matches = 0;
+        for (UINT y = top; y < bottom; y += step)
+        {
+            if (!IsAnchorRow(column, top, y))
+                continue;
+            anchors++;
+            int sourceRow = (int)y - m_lastShift;
+            if (sourceRow >= (int)top && sourceRow < (int)bottom && current[y * stride] == previous[(UINT)sourceRow * stride])
+                matches++;
+        }
+        if (matches >= 2 && matches * 2 >= anchors)
+            return m_lastShift;
+    }
+
+    // 上一帧的行段按哈希排序；与上一行相同的行（纯色背景等）不能确定位置，不参与查找
+    m_rowLookup.clear();
+    for (UINT y = top; y < bottom; y++)
+    {
+        unsigned long long hash = previous[y * stride];
+        if (y == top || hash != previous[(y - 1) * stride])
+            m_rowLookup.push_back(std::make_pair(hash, y));
+    }
+    std::sort(m_rowLookup.begin(), m_rowLookup.end());
+
+    // 均匀抽取内容变化的行作为锚点，在上一帧中查找相同的行，按偏移投票
+    m_shiftVotes.clear();
+    for (UINT y = top; y < bottom; y += step)
+    {
+        if (!IsAnchorRow(column, top, y))
+            continue;
+        unsigned long long hash = current[y * stride];
+
+        auto range = std::equal_range(m_rowLookup.begin(), m_rowLookup.end(), std::make_pair(hash, 0u),
+                                      [](const std::pair<unsigned long long, UINT>& a,
+                                         const std::pair<unsigned long long, UINT>& b) { return a.first < b.first; });
+        // 重复出现的内容（表格、空行之间的分隔线等）无法确定偏移
+        if (range.first == range.second || range.second - range.first > (ptrdiff_t)kScrollMaxCandidates)
+            continue;
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            int shift = (int)y - (int)it->second;
+            auto vote = std::find_if(m_shiftVotes.begin(), m_shiftVotes.end(),
+                                     [shift](const std::pair<int, UINT>& v) { return v.first == shift; });
+            if (vote != m_shiftVotes.end())
+                vote->second++;
+            else
+                m_shiftVotes.push_back(std::make_pair(shift, 1u));
+        }
+    }
+
+    int best = 0;
+    UINT bestVotes = 1;
+    for (const std::pair<int, UINT>& vote : m_shiftVotes)
+    {
+        if (vote.second > bestVotes)
+        {
+            best = vote.first;
+            bestVotes = vote.second;
+        }
+    }
+    if (best != 0)
+        m_lastShift = best;
+    return best;
+}
+
+HRESULT TileDamageDetector::DetectDamage(const ImageView& source, std::vector<ImageMove>& outMoves,
+                                         std::vector<ImageRect>& outRects, bool& fullFrame)
+{
+    outMoves.clear();
+    outRects.clear();
+    HRESULT hr = HashFrame(source, fullFrame);
+    if (FAILED(hr))
+    {
+        m_hasPreviousPixels = false;
+        return hr;
+    }
+    if (fullFrame)
+        return StorePreviousPixels(source.Planes[0], false);
+
+    // 没有上一帧的像素副本（上一帧没有检测滚动）时无法验证移动，这一帧只报告变化的矩形
+    bool detectMoves = m_hasPreviousPixels;
+    const ImagePlane& sourcePlane = source.Planes[0];
+
+    // 逐个分块列处理其中连续变化的分块。滚动的源行限制在同一段内，
+    // 不同段、不同列的移动互不重叠，与移动的执行顺序无关
+    size_t stride = m_tilesX;
+    for (UINT column = 0; column < m_tilesX; column++)
+    {
+        const unsigned long long* current = m_rowHashes.data() + column;
+        const unsigned long long* previous = m_previousRows.data() + column;
+        UINT left = column * kDamageTileSize;
+        UINT right = (std::min)(left + kDamageTileSize, m_width);
+
+        for (UINT tileRow = 0; tileRow < m_tilesY; )
+        {
+            if (!m_changed[(size_t)tileRow * m_tilesX + column])
+            {
+                tileRow++;
+                continue;
+            }
+
+            UINT runBegin = tileRow;
+            while (tileRow < m_tilesY && m_changed[(size_t)tileRow * m_tilesX + column])
+            {
+                tileRow++;
+            }
+            UINT top = runBegin * kDamageTileSize;
+            UINT bottom = (std::min)(tileRow * kDamageTileSize, m_height);
+
+            int shift = detectMoves && bottom - top >= kMinScrollRows ? FindColumnShift(column, top, bottom) : 0;
+
+            // 按偏移逐行验证（先比较哈希，相同时再比较像素），足够长的连续匹配行之间的区域整体搬移
+            UINT moveTop = bottom;
+            UINT moveBottom = top;
+            if (shift != 0)
+            {
+                UINT matchBegin = top;
+                for (UINT y = top; y <= bottom; y++)
+                {
+                    int sourceRow = (int)y - shift;
+                    bool match = y < bottom && sourceRow >= (int)top && sourceRow < (int)bottom &&
+                                 current[y * stride] == previous[(UINT)sourceRow * stride] &&
+                                 IsRowMoved(sourcePlane, y, (UINT)sourceRow, left, right);
+                    if (y < bottom)
+                        m_rowMatches[y] = match ? 1 : 0;
+                    if (match)
+                        continue;
+
+                    if (y - matchBegin >= kMinScrollRows)
+                    {
+                        moveTop = (std::min)(moveTop, matchBegin);
+                        moveBottom = y;
+                    }
+                    matchBegin = y + 1;
+                }
+            }
+
+            if (moveTop >= moveBottom)
+            {
+                outRects.push_back(MakeImageRect(left, top, right, bottom));
+                continue;
+            }
+
+            outMoves.push_back(MakeImageMove(MakeImageRect(left, moveTop, right, moveBottom), left,
+                                             (UINT)((int)moveTop - shift)));
+
+            // 移动范围内不匹配的行被移动覆盖，必须转换；范围外只转换内容变化的行
+            UINT dirtyBegin = bottom;
+            for (UINT y = top; y <= bottom; y++)
+            {
+                bool dirty = false;
+                if (y < bottom)
+                    dirty = (y >= moveTop && y < moveBottom) ? !m_rowMatches[y] : current[y * stride] != previous[y * stride];
+
+                if (dirty)
+                {
+                    dirtyBegin = (std::min)(dirtyBegin, y);
+                }
+                else if (dirtyBegin < y)
+                {
+                    outRects.push_back(MakeImageRect(left, dirtyBegin, right, y));
+                    dirtyBegin = bottom;
+                }
+            }
+        }
+    }
+
+    // 相邻分块列中上下边界相同的矩形和移动合并。边缘分块列中滚动的文档和静态背景各占一部分时，
+    // 匹配的行可能被背景的变化切得很碎：矩形超过每帧的上限时合并同一列中相近的矩形（多转换间隔中的行），
+    // 避免DirtyRegionTracker把超出的矩形并成一个很大的外接矩形
+    MergeRectsHorizontally(outRects);
+    for (UINT gap = kMinScrollRows; outRects.size() > kMaxDirtyRectsPerFrame && gap < m_height; gap *= 2)
+    {
+        MergeRectsVertically(outRects, gap);
+        MergeRectsHorizontally(outRects);
+    }
+    MergeMovesHorizontally(outMoves);
+
+    m_previousRows.swap(m_rowHashes);
+    return StorePreviousPixels(sourcePlane, m_hasPreviousPixels);
+}
+
+void TileDamageDetector::Reset()
+{
+    m_hasPrevious = false;
+    m_hasPreviousPixels = false;
+    m_lastShift = 0;
+}
+
+void TileDamageDetector::Cleanup()
+{
+    m_ownedThreadPool.reset();
+    m_threadPool = nullptr;
+    m_rowKernel = nullptr;
+    m_rowHashes.clear();
+    m_previousRows.clear();
+    m_changed.clear();
+    m_rowLookup.clear();
+    m_shiftVotes.clear();
+    m_rowMatches.clear();
+    m_previousPixels.clear();
+    m_width = 0;
+    m_height = 0;
+    m_tilesX = 0;
+    m_tilesY = 0;
+    m_changedTiles = 0;
+    m_lastShift = 0;
+    m_hasPrevious = false;
+    m_hasPreviousPixels = false;
+    m_initialized = false;
+}
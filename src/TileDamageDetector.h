@@ -0,0 +1,92 @@
+#pragma once
+#include "CpuConversionOptions.h"
+#include "ImageView.h"
+#include "TileHashKernels.h"
+#include "Utils.h"
+#include "WorkerThreadPool.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+// 基于内容的分块损坏检测
+// 帧源不提供脏矩形时（文件回放、合成图案、其他采集后端），按kDamageTileSize x kDamageTileSize的BGRA分块
+// 计算哈希（见TileHashKernels.h）并与上一帧比较，只有哈希变化的分块需要重新转换。
+// 变化的分块在同一分块行内合并为水平连续的矩形，宽度相同的矩形再跨分块行合并。
+// 哈希按行段保存（每行每个分块列一个），除了判断分块是否变化，还用于检测垂直滚动：
+// 某一分块列中连续变化的分块里，当前帧的行段与上一帧上下错开dy行后逐行相同时，
+// 这部分输出可以从上一帧的输出整块搬移（见DirtyRegionTracker），只有新露出的行需要转换。
+// 哈希相同的行在搬移之前还要与保存的上一帧像素逐字节比较，哈希碰撞不会产生错误的移动；
+// 像素副本只在使用滚动检测时维护，每帧只复制变化的分块。
+// 哈希内核在Initialize时按CPUID选择，多线程时按分块行拆分，由常驻线程池执行
+class TileDamageDetector
+{
+public:
+    TileDamageDetector();
+    ~TileDamageDetector();
+
+    HRESULT Initialize(const CpuConversionOptions& options = CpuConversionOptions());
+    // 计算source（BGRA）的分块哈希并与上一次调用比较，outRects为内容变化的区域（为空表示整帧未变）。
+    // fullFrame为true表示没有可比较的上一帧（第一帧、尺寸变化或Reset之后），此时outRects为空
+    HRESULT DetectDamage(const ImageView& source, std::vector<ImageRect>& outRects, bool& fullFrame);
+    // 同上，并检测变化区域中的垂直滚动：outMoves为可以从上一帧的输出搬移的区域（x偏移为0，左右边界与分块对齐），
+    // outRects为其余需要转换的区域，与DirtyRegionTracker::AddFrame的顺序相同（先执行移动，再转换矩形）
+    HRESULT DetectDamage(const ImageView& source, std::vector<ImageMove>& outMoves, std::vector<ImageRect>& outRects,
+                         bool& fullFrame);
+    // 丢弃保存的哈希，下一帧按整帧变化处理（帧源在两次检测之间改用了其他方式报告变化等）
+    void Reset();
+    void Cleanup();
+
+    SimdLevel GetSimdLevel() const { return m_simdLevel; }
+    UINT GetThreadCount() const { return m_threadPool ? m_threadPool->GetThreadCount() : 1; }
+    // 上一次检测中内容变化的分块数和分块总数
+    UINT GetChangedTileCount() const { return m_changedTiles; }
+    UINT GetTileCount() const { return m_tilesX * m_tilesY; }
+
+private:
+    // 线程池的每个任务是一个分块行
+    struct HashContext
+    {
+        TileHashRowFunc RowKernel;
+        ImagePlane Source;
+        UINT Width;
+        UINT Height;
+        UINT TilesX;
+        unsigned long long* RowHashes;          // 每行TilesX个行段哈希
+        const unsigned long long* Previous;     // 上一帧的行段哈希，没有上一帧时为nullptr
+        BYTE* Changed;                          // 每个分块一个标志
+    };
+
+    static void HashTileRow(void* context, UINT tileRow);
+    // 计算当前帧的行段哈希和变化的分块；fullFrame为true表示没有可比较的上一帧
+    HRESULT HashFrame(const ImageView& source, bool& fullFrame);
+    // 在column列的[top, bottom)行中寻找上一帧内容的垂直偏移（当前行y对应上一帧的y - dy行），没有找到时返回0
+    int FindColumnShift(UINT column, UINT top, UINT bottom);
+    // 当前帧第y行的行段可以作为查找偏移的锚点
+    bool IsAnchorRow(UINT column, UINT top, UINT y) const;
+    // 当前帧第y行与上一帧第sourceRow行在[left, right)列的像素逐字节相同
+    bool IsRowMoved(const ImagePlane& source, UINT y, UINT sourceRow, UINT left, UINT right) const;
+    // 把当前帧复制到上一帧的像素副本：changedOnly为true时只复制变化的分块
+    HRESULT StorePreviousPixels(const ImagePlane& source, bool changedOnly);
+
+    TileHashRowFunc m_rowKernel;
+    SimdLevel m_simdLevel;
+    std::unique_ptr<WorkerThreadPool> m_ownedThreadPool;
+    WorkerThreadPool* m_threadPool;
+    std::vector<unsigned long long> m_rowHashes;        // 当前帧
+    std::vector<unsigned long long> m_previousRows;     // 上一帧
+    std::vector<BYTE> m_changed;
+    // 滚动检测的临时数据，跨帧复用
+    std::vector<std::pair<unsigned long long, UINT>> m_rowLookup;
+    std::vector<std::pair<int, UINT>> m_shiftVotes;
+    std::vector<BYTE> m_rowMatches;
+    std::vector<BYTE> m_previousPixels;     // 上一帧的BGRA像素（紧凑布局），用于验证移动
+    UINT m_width;
+    UINT m_height;
+    UINT m_tilesX;
+    UINT m_tilesY;
+    UINT m_changedTiles;
+    int m_lastShift;        // 最近一次找到的滚动偏移
+    bool m_hasPrevious;
+    bool m_hasPreviousPixels;
+    bool m_initialized;
+};
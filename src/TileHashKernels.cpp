@@ -0,0 +1,97 @@
+#include "TileHashKernels.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    inline void AccumulateStripe(unsigned long long* acc, const BYTE* stripe, const unsigned long long* key)
+    {
+        for (UINT i = 0; i < kTileHashLanes; i++)
+        {
+            unsigned long long data;
+            memcpy(&data, stripe + i * 8, sizeof(data));
+            unsigned long long dataKey = data ^ key[i];
+            acc[i] += (dataKey & 0xFFFFFFFFULL) * (dataKey >> 32) + data;
+        }
+    }
+
+    inline unsigned long long ScrambleAndSum(const unsigned long long* acc)
+    {
+        const unsigned long long* key = kTileHashSecret + kTileHashScrambleKey;
+        unsigned long long sum = 0;
+        for (UINT i = 0; i < kTileHashLanes; i++)
+        {
+            unsigned long long value = acc[i];
+            value ^= value >> 47;
+            value ^= key[i];
+            sum += value * kTileHashPrime32;
+        }
+        return sum;
+    }
+}
+
+void TileHashRowTail_C(const BYTE* srcRow, UINT firstSegment, UINT width, unsigned long long* segmentHashes)
+{
+    for (UINT segmentX = firstSegment * kDamageTileSize; segmentX < width; segmentX += kDamageTileSize)
+    {
+        const BYTE* segment = srcRow + (size_t)segmentX * 4;
+        UINT bytes = (std::min)(width - segmentX, kDamageTileSize) * 4;
+
+        unsigned long long acc[kTileHashLanes];
+        memcpy(acc, kTileHashInit, sizeof(acc));
+
+        UINT stripe = 0;
+        for (; (stripe + 1) * kTileHashStripeBytes <= bytes; stripe++)
+        {
+            AccumulateStripe(acc, segment + stripe * kTileHashStripeBytes, kTileHashSecret + stripe * 2);
+        }
+
+        // 不完整的条带补零后按同样方式处理（同一列行段的宽度固定，补零不会产生歧义）
+        UINT remaining = bytes - stripe * kTileHashStripeBytes;
+        if (remaining)
+        {
+            BYTE padded[kTileHashStripeBytes] = {};
+            memcpy(padded, segment + stripe * kTileHashStripeBytes, remaining);
+            AccumulateStripe(acc, padded, kTileHashSecret + stripe * 2);
+        }
+
+        segmentHashes[segmentX / kDamageTileSize] = FinalizeSegmentHash(ScrambleAndSum(acc));
+    }
+}
+
+void TileHashRow_C(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes)
+{
+    TileHashRowTail_C(srcRow, 0, width, segmentHashes);
+}
+
+TileHashRowFunc GetTileHashRowKernel(SimdLevel level, SimdLevel* selectedLevel)
+{
+    SimdLevel best = GetBestSimdLevel();
+    if (level > best)
+        level = best;
+
+    TileHashRowFunc kernel = TileHashRow_C;
+    SimdLevel chosen = SimdLevel::Scalar;
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+    if (level >= SimdLevel::AVX512BW)
+    {
+        kernel = TileHashRow_AVX512BW;
+        chosen = SimdLevel::AVX512BW;
+    }
+    else if (level >= SimdLevel::AVX2)
+    {
+        kernel = TileHashRow_AVX2;
+        chosen = SimdLevel::AVX2;
+    }
+    else if (level >= SimdLevel::SSE41)
+    {
+        kernel = TileHashRow_SSE41;
+        chosen = SimdLevel::SSE41;
+    }
+#endif
+
+    if (selectedLevel)
+        *selectedLevel = chosen;
+    return kernel;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "Utils.h"
+
+// 分块内容哈希的行内核（TileDamageDetector使用）
+// 图像的每一行按kDamageTileSize个像素分段（行段），每个行段计算一个64位哈希，算法与XXH3的长输入路径同类：
+// 8个64位累加器，每个64字节条带 acc[i] += lo32(d ^ key) * hi32(d ^ key) + d，
+// 条带按其在行段内的位置使用不同的密钥（水平移动会改变哈希）；
+// 最后每个累加器打乱一次（acc ^= acc >> 47; acc ^= key; acc *= kTileHashPrime32），求和后雪崩。
+// 分块变化即其中某个行段的哈希变化；同一列行段的哈希序列还用于检测垂直滚动。
+// 所有内核逐位一致；SIMD内核只处理完整宽度的行段，最右侧不完整的行段由标量代码完成。
+// 哈希只用于检测内容变化，不是密码学哈希。
+
+const UINT kDamageTileSize = 64;
+const UINT kTileHashLanes = 8;                              // 每个行段的累加器数量
+const UINT kTileHashStripeBytes = kTileHashLanes * 8;       // 每个条带的字节数
+const UINT kTileHashRowBytes = kDamageTileSize * 4;         // 完整行段的字节数（4个条带）
+const UINT kTileHashScrambleKey = 8;                        // 打乱使用的密钥在kTileHashSecret中的偏移
+
+const unsigned long long kTileHashPrime32 = 0x9E3779B1ULL;
+
+// 累加器初值（与XXH3相同）
+const unsigned long long kTileHashInit[kTileHashLanes] =
+{
+    0x00000000C2B2AE3DULL, 0x9E3779B185EBCA87ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL,
+    0x85EBCA77C2B2AE63ULL, 0x0000000085EBCA77ULL, 0x27D4EB2F165667C5ULL, 0x000000009E3779B1ULL,
+};
+
+// 第s个条带使用kTileHashSecret[s * 2 .. s * 2 + 7]，打乱使用kTileHashSecret[8 .. 15]
+const unsigned long long kTileHashSecret[16] =
+{
+    0x2CB0F69F4ABEA221ULL, 0x9417034723148989ULL, 0xDD555950609DFE03ULL, 0xDBAFB150DEB12800ULL,
+    0x7E789B2E6C442CB6ULL, 0xF41E5636C7E4F8C4ULL, 0x0959D150F8FBA7E4ULL, 0xA97316F13CDB9EEAULL,
+    0x74CD8258F9520068ULL, 0x55C74A62E116868BULL, 0xD2F4C799A2023CBDULL, 0xDF98CB79A37B51B9ULL,
+    0x396F5885524F3905ULL, 0xAF1D56386CA3B276ULL, 0xA9FFBE6B5104E85AULL, 0x6BD0C51B9FD533B3ULL,
+};
+
+// 处理一行图像：第t个行段的哈希写入segmentHashes[t]，segmentHashes至少容纳ceil(width / kDamageTileSize)个元素
+typedef void (*TileHashRowFunc)(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes);
+
+void TileHashRow_C(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes);
+
+#if defined(COLORCONV_ENABLE_X86_SIMD)
+void TileHashRow_SSE41(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes);
+void TileHashRow_AVX2(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes);
+void TileHashRow_AVX512BW(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes);
+#endif
+
+// 从第firstSegment个行段开始用标量代码处理到行尾，供SIMD内核处理不完整的行段
+void TileHashRowTail_C(const BYTE* srcRow, UINT firstSegment, UINT width, unsigned long long* segmentHashes);
+
+// 打乱后的累加器之和 → 行段哈希（SIMD内核在寄存器中求和后调用）
+inline unsigned long long FinalizeSegmentHash(unsigned long long laneSum)
+{
+    laneSum ^= laneSum >> 37;
+    laneSum *= 0x165667919E3779F9ULL;
+    laneSum ^= laneSum >> 32;
+    return laneSum;
+}
+
+// 返回不超过level的最优内核；level为CPU不支持或未编译的等级时自动降级
+TileHashRowFunc GetTileHashRowKernel(SimdLevel level, SimdLevel* selectedLevel = nullptr);
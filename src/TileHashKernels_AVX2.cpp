@@ -0,0 +1,56 @@
+#include "TileHashKernels.h"
+#include <immintrin.h>
+
+// AVX2内核：每个行段的8个累加器放在2个寄存器中，算法与SSE4.1版本相同
+namespace
+{
+    inline __m256i AccumulateLanes(__m256i acc, __m256i data, __m256i key)
+    {
+        __m256i dataKey = _mm256_xor_si256(data, key);
+        __m256i product = _mm256_mul_epu32(dataKey, _mm256_srli_epi64(dataKey, 32));
+        return _mm256_add_epi64(acc, _mm256_add_epi64(product, data));
+    }
+
+    inline __m256i ScrambleLanes(__m256i acc, __m256i key, __m256i prime)
+    {
+        acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+        acc = _mm256_xor_si256(acc, key);
+        __m256i low = _mm256_mul_epu32(acc, prime);
+        __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime);
+        return _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+    }
+}
+
+void TileHashRow_AVX2(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes)
+{
+    const __m256i prime = _mm256_set1_epi64x(static_cast<long long>(kTileHashPrime32));
+    const __m256i init0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kTileHashInit));
+    const __m256i init1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kTileHashInit + 4));
+    const __m256i scrambleKey0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kTileHashSecret + kTileHashScrambleKey));
+    const __m256i scrambleKey1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kTileHashSecret + kTileHashScrambleKey + 4));
+
+    UINT segment = 0;
+    for (; (segment + 1) * kDamageTileSize <= width; segment++)
+    {
+        const BYTE* segmentData = srcRow + (size_t)segment * kTileHashRowBytes;
+        __m256i acc0 = init0;
+        __m256i acc1 = init1;
+
+        for (UINT stripe = 0; stripe < kTileHashRowBytes / kTileHashStripeBytes; stripe++)
+        {
+            const __m256i* data = reinterpret_cast<const __m256i*>(segmentData + stripe * kTileHashStripeBytes);
+            const unsigned long long* key = kTileHashSecret + stripe * 2;
+            acc0 = AccumulateLanes(acc0, _mm256_loadu_si256(data + 0),
+                                   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key)));
+            acc1 = AccumulateLanes(acc1, _mm256_loadu_si256(data + 1),
+                                   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + 4)));
+        }
+
+        __m256i sum = _mm256_add_epi64(ScrambleLanes(acc0, scrambleKey0, prime), ScrambleLanes(acc1, scrambleKey1, prime));
+        __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half = _mm_add_epi64(half, _mm_unpackhi_epi64(half, half));
+        segmentHashes[segment] = FinalizeSegmentHash(static_cast<unsigned long long>(_mm_cvtsi128_si64(half)));
+    }
+
+    TileHashRowTail_C(srcRow, segment, width, segmentHashes);
+}
@@ -0,0 +1,44 @@
+#include "TileHashKernels.h"
+#include <immintrin.h>
+
+// AVX-512内核：每个行段的8个累加器正好是一个寄存器，算法与SSE4.1版本相同
+namespace
+{
+    inline __m512i AccumulateLanes(__m512i acc, __m512i data, __m512i key)
+    {
+        __m512i dataKey = _mm512_xor_si512(data, key);
+        __m512i product = _mm512_mul_epu32(dataKey, _mm512_srli_epi64(dataKey, 32));
+        return _mm512_add_epi64(acc, _mm512_add_epi64(product, data));
+    }
+}
+
+void TileHashRow_AVX512BW(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes)
+{
+    const __m512i prime = _mm512_set1_epi64(static_cast<long long>(kTileHashPrime32));
+    const __m512i init = _mm512_loadu_si512(kTileHashInit);
+    const __m512i scrambleKey = _mm512_loadu_si512(kTileHashSecret + kTileHashScrambleKey);
+    const __m512i key0 = _mm512_loadu_si512(kTileHashSecret + 0);
+    const __m512i key1 = _mm512_loadu_si512(kTileHashSecret + 2);
+    const __m512i key2 = _mm512_loadu_si512(kTileHashSecret + 4);
+    const __m512i key3 = _mm512_loadu_si512(kTileHashSecret + 6);
+
+    UINT segment = 0;
+    for (; (segment + 1) * kDamageTileSize <= width; segment++)
+    {
+        const BYTE* segmentData = srcRow + (size_t)segment * kTileHashRowBytes;
+
+        __m512i value = AccumulateLanes(init, _mm512_loadu_si512(segmentData + 0 * kTileHashStripeBytes), key0);
+        value = AccumulateLanes(value, _mm512_loadu_si512(segmentData + 1 * kTileHashStripeBytes), key1);
+        value = AccumulateLanes(value, _mm512_loadu_si512(segmentData + 2 * kTileHashStripeBytes), key2);
+        value = AccumulateLanes(value, _mm512_loadu_si512(segmentData + 3 * kTileHashStripeBytes), key3);
+
+        value = _mm512_xor_si512(value, _mm512_srli_epi64(value, 47));
+        value = _mm512_xor_si512(value, scrambleKey);
+        __m512i low = _mm512_mul_epu32(value, prime);
+        __m512i high = _mm512_mul_epu32(_mm512_srli_epi64(value, 32), prime);
+        value = _mm512_add_epi64(low, _mm512_slli_epi64(high, 32));
+        segmentHashes[segment] = FinalizeSegmentHash(static_cast<unsigned long long>(_mm512_reduce_add_epi64(value)));
+    }
+
+    TileHashRowTail_C(srcRow, segment, width, segmentHashes);
+}
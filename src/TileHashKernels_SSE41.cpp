@@ -0,0 +1,62 @@
+#include "TileHashKernels.h"
+#include <smmintrin.h>
+
+// SSE4.1内核：每个行段的8个累加器放在4个寄存器中，每个寄存器2个64位通道
+namespace
+{
+    inline __m128i AccumulateLanes(__m128i acc, __m128i data, __m128i key)
+    {
+        __m128i dataKey = _mm_xor_si128(data, key);
+        __m128i product = _mm_mul_epu32(dataKey, _mm_srli_epi64(dataKey, 32));
+        return _mm_add_epi64(acc, _mm_add_epi64(product, data));
+    }
+
+    inline __m128i ScrambleLanes(__m128i acc, __m128i key, __m128i prime)
+    {
+        acc = _mm_xor_si128(acc, _mm_srli_epi64(acc, 47));
+        acc = _mm_xor_si128(acc, key);
+        // 64位乘以32位常数：低32位乘积加上高32位乘积左移32位
+        __m128i low = _mm_mul_epu32(acc, prime);
+        __m128i high = _mm_mul_epu32(_mm_srli_epi64(acc, 32), prime);
+        return _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+    }
+}
+
+void TileHashRow_SSE41(const BYTE* srcRow, UINT width, unsigned long long* segmentHashes)
+{
+    const __m128i* secret = reinterpret_cast<const __m128i*>(kTileHashSecret);
+    const __m128i* init = reinterpret_cast<const __m128i*>(kTileHashInit);
+    const __m128i prime = _mm_set1_epi64x(static_cast<long long>(kTileHashPrime32));
+
+    UINT segment = 0;
+    for (; (segment + 1) * kDamageTileSize <= width; segment++)
+    {
+        const BYTE* segmentData = srcRow + (size_t)segment * kTileHashRowBytes;
+        __m128i acc0 = _mm_loadu_si128(init + 0);
+        __m128i acc1 = _mm_loadu_si128(init + 1);
+        __m128i acc2 = _mm_loadu_si128(init + 2);
+        __m128i acc3 = _mm_loadu_si128(init + 3);
+
+        for (UINT stripe = 0; stripe < kTileHashRowBytes / kTileHashStripeBytes; stripe++)
+        {
+            const __m128i* data = reinterpret_cast<const __m128i*>(segmentData + stripe * kTileHashStripeBytes);
+            // 第s个条带的密钥从kTileHashSecret[s * 2]开始，正好是整数个寄存器
+            const __m128i* key = secret + stripe;
+            acc0 = AccumulateLanes(acc0, _mm_loadu_si128(data + 0), _mm_loadu_si128(key + 0));
+            acc1 = AccumulateLanes(acc1, _mm_loadu_si128(data + 1), _mm_loadu_si128(key + 1));
+            acc2 = AccumulateLanes(acc2, _mm_loadu_si128(data + 2), _mm_loadu_si128(key + 2));
+            acc3 = AccumulateLanes(acc3, _mm_loadu_si128(data + 3), _mm_loadu_si128(key + 3));
+        }
+
+        const __m128i* scrambleKey = secret + kTileHashScrambleKey / 2;
+        __m128i sum = _mm_add_epi64(
+            _mm_add_epi64(ScrambleLanes(acc0, _mm_loadu_si128(scrambleKey + 0), prime),
+                          ScrambleLanes(acc1, _mm_loadu_si128(scrambleKey + 1), prime)),
+            _mm_add_epi64(ScrambleLanes(acc2, _mm_loadu_si128(scrambleKey + 2), prime),
+                          ScrambleLanes(acc3, _mm_loadu_si128(scrambleKey + 3), prime)));
+        sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+        segmentHashes[segment] = FinalizeSegmentHash(static_cast<unsigned long long>(_mm_cvtsi128_si64(sum)));
+    }
+
+    TileHashRowTail_C(srcRow, segment, width, segmentHashes);
+}
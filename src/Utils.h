@@ -1,7 +1,26 @@
 #pragma once
+#ifdef _WIN32
 #include <windows.h>
 #include <d3d11.h>
+#else
+// 非Windows平台：提供CPU转换路径所需的最小Win32类型与HRESULT定义
+#include <cstdint>
+
+typedef int32_t HRESULT;
+typedef uint8_t BYTE;
+typedef uint16_t UINT16;
+typedef uint32_t UINT;
+
+#define S_OK            ((HRESULT)0)
+#define S_FALSE         ((HRESULT)1)
+#define E_FAIL          ((HRESULT)0x80004005)
+#define E_INVALIDARG    ((HRESULT)0x80070057)
+#define E_OUTOFMEMORY   ((HRESULT)0x8007000E)
+#define SUCCEEDED(hr)   (((HRESULT)(hr)) >= 0)
+#define FAILED(hr)      (((HRESULT)(hr)) < 0)
+#endif
 #include <iostream>
+#include <stdexcept>
 #include <string>
 
 #define SAFE_RELEASE(p) { if(p) { (p)->Release(); (p) = nullptr; } }
@@ -28,4 +47,4 @@ inline void LogMessage(const std::string& message)
 inline void LogError(const std::string& message)
 {
     std::cerr << "[ERROR] " << message << std::endl;
-}
\ No newline at end of file
+}
@@ -0,0 +1,270 @@
+#include "WorkerThreadPool.h"
+#include <algorithm>
+
+#if !defined(_WIN32) && defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+WorkerThreadPool::WorkerThreadPool()
+    : m_func(nullptr)
+    , m_context(nullptr)
+    , m_taskCount(0)
+    , m_generation(0)
+    , m_activeWorkers(0)
+    , m_stopping(false)
+    , m_nextTask(0)
+    , m_pendingTasks(0)
+{
+}
+
+WorkerThreadPool::~WorkerThreadPool()
+{
+    Cleanup();
+}
+
+HRESULT WorkerThreadPool::Initialize(UINT threadCount, bool pinThreads)
+{
+    Cleanup();
+
+    std::vector<CpuSlot> cpus;
+    if (pinThreads && !GetAvailableCpus(cpus))
+    {
+        LogMessage("Thread pinning is not supported on this platform, worker threads will not be pinned");
+        pinThreads = false;
+    }
+
+    UINT cpuCount = cpus.empty() ? (std::max)(1u, std::thread::hardware_concurrency()) : static_cast<UINT>(cpus.size());
+    if (threadCount == 0)
+        threadCount = cpuCount;
+
+    UINT pinnedCount = 0;
+    try
+    {
+        m_stopping = false;
+        // 调用线程承担第0份工作，只需创建threadCount-1个工作线程；
+        // cpus[0]是调用线程当前所在的CPU，工作线程从cpus[1]开始绑定，线程数超过CPU数时才回绕
+        for (UINT i = 1; i < threadCount; i++)
+        {
+            m_threads.emplace_back(&WorkerThreadPool::WorkerMain, this, i);
+            if (pinThreads)
+            {
+                const CpuSlot& cpu = cpus[i % cpuCount];
+                if (PinThread(m_threads.back(), cpu))
+                {
+                    pinnedCount++;
+                }
+                else
+                {
+                    LogError("Failed to pin worker thread " + std::to_string(i) + " to CPU " +
+                             std::to_string(cpu.Group) + ":" + std::to_string(cpu.Number));
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LogError(std::string("Failed to create worker threads: ") + e.what());
+        Cleanup();
+        return E_FAIL;
+    }
+
+    std::string pinState;
+    if (pinThreads && !m_threads.empty())
+    {
+        pinState = pinnedCount == m_threads.size()
+            ? " (pinned)"
+            : " (" + std::to_string(pinnedCount) + " of " + std::to_string(m_threads.size()) + " workers pinned)";
+    }
+    LogMessage("Worker thread pool started with " + std::to_string(GetThreadCount()) + " threads" + pinState);
+    return S_OK;
+}
+
+bool WorkerThreadPool::GetAvailableCpus(std::vector<CpuSlot>& cpus)
+{
+    cpus.clear();
+#if defined(_WIN32)
+    // 进程可能跨多个处理器组（Windows 11起线程默认可调度到所有组），逐组收集可用处理器
+    USHORT groupCount = 0;
+    GetProcessGroupAffinity(GetCurrentProcess(), &groupCount, nullptr);
+    std::vector<USHORT> groups((std::max)(groupCount, USHORT(1)));
+    groupCount = static_cast<USHORT>(groups.size());
+    if (!GetProcessGroupAffinity(GetCurrentProcess(), &groupCount, groups.data()))
+        return false;
+
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        return false;
+
+    for (USHORT i = 0; i < groupCount; i++)
+    {
+        // 单组进程使用进程亲和性掩码；多组时GetProcessAffinityMask返回0，使用组内全部活动处理器
+        DWORD_PTR mask = processMask;
+        if (groupCount > 1 || mask == 0)
+        {
+            DWORD active = GetActiveProcessorCount(groups[i]);
+            mask = active >= sizeof(DWORD_PTR) * 8 ? ~DWORD_PTR(0) : (DWORD_PTR(1) << active) - 1;
+        }
+        for (UINT bit = 0; bit < sizeof(DWORD_PTR) * 8; bit++)
+        {
+            if (mask & (DWORD_PTR(1) << bit))
+                cpus.push_back({ groups[i], bit });
+        }
+    }
+
+    PROCESSOR_NUMBER current;
+    GetCurrentProcessorNumberEx(&current);
+    CpuSlot callerCpu = { current.Group, current.Number };
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+        return false;
+
+    for (UINT cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &cpuSet))
+            cpus.push_back({ 0, cpu });
+    }
+
+    int current = sched_getcpu();
+    CpuSlot callerCpu = { 0, current < 0 ? 0u : static_cast<UINT>(current) };
+#else
+    return false;
+#endif
+
+#if defined(_WIN32) || defined(__linux__)
+    if (cpus.empty())
+        return false;
+
+    // 调用线程所在的CPU移到最前面，工作线程从第二个开始分配
+    auto caller = std::find_if(cpus.begin(), cpus.end(), [&](const CpuSlot& cpu) {
+        return cpu.Group == callerCpu.Group && cpu.Number == callerCpu.Number;
+    });
+    if (caller != cpus.end())
+        std::rotate(cpus.begin(), caller, caller + 1);
+    return true;
+#endif
+}
+
+bool WorkerThreadPool::PinThread(std::thread& thread, const CpuSlot& cpu)
+{
+#if defined(_WIN32)
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = static_cast<WORD>(cpu.Group);
+    affinity.Mask = KAFFINITY(1) << cpu.Number;
+    return SetThreadGroupAffinity(static_cast<HANDLE>(thread.native_handle()), &affinity, nullptr) != FALSE;
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu.Number, &cpuSet);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+    (void)thread;
+    (void)cpu;
+    return false;
+#endif
+}
+
+void WorkerThreadPool::ExecuteTasks(TaskFunc func, void* context, UINT taskCount)
+{
+    while (true)
+    {
+        UINT taskIndex = m_nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (taskIndex >= taskCount)
+            break;
+
+        func(context, taskIndex);
+
+        if (m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_doneCondition.notify_all();
+        }
+    }
+}
+
+void WorkerThreadPool::WorkerMain(UINT workerIndex)
+{
+    (void)workerIndex;
+    unsigned long long lastGeneration = 0;
+
+    while (true)
+    {
+        TaskFunc func;
+        void* context;
+        UINT taskCount;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCondition.wait(lock, [&] { return m_stopping || m_generation != lastGeneration; });
+            if (m_stopping)
+                return;
+
+            lastGeneration = m_generation;
+            func = m_func;
+            context = m_context;
+            taskCount = m_taskCount;
+            m_activeWorkers++;
+        }
+
+        ExecuteTasks(func, context, taskCount);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_activeWorkers--;
+            m_doneCondition.notify_all();
+        }
+    }
+}
+
+void WorkerThreadPool::Run(UINT taskCount, TaskFunc func, void* context)
+{
+    if (taskCount == 0 || !func)
+        return;
+
+    // 没有工作线程或只有一个任务时直接在调用线程执行
+    if (m_threads.empty() || taskCount == 1)
+    {
+        for (UINT i = 0; i < taskCount; i++)
+            func(context, i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(m_runMutex);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // 等待上一批次中迟到的工作线程退出任务循环，避免其读取到新批次的任务计数
+        m_doneCondition.wait(lock, [&] { return m_activeWorkers == 0; });
+
+        m_func = func;
+        m_context = context;
+        m_taskCount = taskCount;
+        m_nextTask.store(0, std::memory_order_relaxed);
+        m_pendingTasks.store(taskCount, std::memory_order_relaxed);
+        m_generation++;
+    }
+    m_workCondition.notify_all();
+
+    ExecuteTasks(func, context, taskCount);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [&] { return m_pendingTasks.load(std::memory_order_acquire) == 0; });
+}
+
+void WorkerThreadPool::Cleanup()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workCondition.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+    m_threads.clear();
+    m_activeWorkers = 0;
+}
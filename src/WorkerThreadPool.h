@@ -0,0 +1,60 @@
+#pragma once
+#include "Utils.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 常驻工作线程池
+// 线程在Initialize时创建（可选绑定到固定CPU核心），之后每帧只做唤醒/等待，
+// 不再为每帧创建线程。Run会阻塞直到全部任务完成，调用线程本身也参与执行任务。
+// 绑定时只使用进程亲和性掩码内的CPU（Windows上包括64核以上的处理器组），
+// 并跳过调用线程当前所在的CPU，调用线程本身不绑定。
+class WorkerThreadPool
+{
+public:
+    typedef void (*TaskFunc)(void* context, UINT taskIndex);
+
+    WorkerThreadPool();
+    ~WorkerThreadPool();
+
+    // threadCount为参与计算的线程总数（含调用线程），0表示使用全部逻辑核心
+    HRESULT Initialize(UINT threadCount, bool pinThreads);
+    void Run(UINT taskCount, TaskFunc func, void* context);
+    void Cleanup();
+
+    UINT GetThreadCount() const { return static_cast<UINT>(m_threads.size()) + 1; }
+
+private:
+    // 可绑定的逻辑CPU：Windows上为处理器组及组内编号，其他平台Group恒为0
+    struct CpuSlot
+    {
+        UINT Group;
+        UINT Number;
+    };
+
+    void WorkerMain(UINT workerIndex);
+    void ExecuteTasks(TaskFunc func, void* context, UINT taskCount);
+    // 按进程亲和性列出可用CPU，调用线程所在的CPU排在第一个；平台不支持时返回false
+    static bool GetAvailableCpus(std::vector<CpuSlot>& cpus);
+    static bool PinThread(std::thread& thread, const CpuSlot& cpu);
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_runMutex;      // 串行化来自多个调用者的Run
+    std::mutex m_mutex;
+    std::condition_variable m_workCondition;
+    std::condition_variable m_doneCondition;
+
+    // 当前任务批次，由m_mutex保护
+    TaskFunc m_func;
+    void* m_context;
+    UINT m_taskCount;
+    unsigned long long m_generation;
+    UINT m_activeWorkers;
+    bool m_stopping;
+
+    std::atomic<UINT> m_nextTask;
+    std::atomic<UINT> m_pendingTasks;
+};
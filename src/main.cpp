@@ -1,7 +1,15 @@
 #include "DXGICapture.h"
+#include "DirtyRegionTracker.h"
+#include "FramePool.h"
+#include "FramePipeline.h"
+#include "FrameSources.h"
 #include "BGRAToYUY2Converter.h"
+#include "BGRAToNV12Converter.h"
+#include "CpuBGRAToNV12Converter.h"
+#include "CpuHDRToYUV10Converter.h"
 #include "NV12ToRGBAConverter.h"
 #include "Utils.h"
+#include <d3d10.h>
 #include <chrono>
 #include <thread>
 #include <iomanip>
@@ -9,18 +17,280 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
 enum class ConversionMode
 {
     BGRA_TO_YUY2,
-    NV12_TO_RGBA
+    NV12_TO_RGBA,
+    BGRA_TO_NV12,
+    HDR_TO_P010
 };
 
-class Demo
+// 流水线帧源：桌面采集，采集纹理从帧池借用
+class DesktopCaptureSource : public IFrameSource
 {
 public:
-    Demo(ConversionMode mode) : m_mode(mode), m_device(nullptr), m_context(nullptr), 
-                               m_frameCount(0), m_totalFrameTime(0) {}
+    DesktopCaptureSource(DXGICapture& capture, FramePool& framePool)
+        : m_capture(capture), m_framePool(framePool), m_lastCursorRect(MakeImageRect(0, 0, 0, 0)) {}
+
+    HRESULT ReadFrame(PipelineFrame& frame) override
+    {
+        // AcquireNextFrame内部带超时等待，桌面没有变化时返回S_FALSE
+        HRESULT hr = m_capture.CaptureFrame(m_framePool, frame.Source, frame.Width, frame.Height);
+        if (hr == DXGI_ERROR_WAIT_TIMEOUT)
+        {
+            return S_FALSE;
+        }
+        if (FAILED(hr))
+        {
+            // 采集失败（桌面切换等）不停止流水线，稍后重试
+            LogError("Failed to capture frame");
+            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            return S_FALSE;
+        }
+
+        // 旋转的显示器：采集图像保持未旋转的方向，由转换阶段在转换的同时旋转
+        frame.Orientation = m_capture.GetOrientation();
+
+        // 转换阶段据此只搬移和转换变化的区域
+        const ImageMove* moves = nullptr;
+        const ImageRect* rects = nullptr;
+        UINT moveCount = 0;
+        UINT rectCount = 0;
+        frame.DirtyRectCount = 0;
+        frame.MoveCount = 0;
+        frame.DirtyRectsValid = m_capture.GetDirtyRects(moves, moveCount, rects, rectCount);
+        for (UINT i = 0; i < moveCount; i++)
+        {
+            AddPipelineMove(frame, moves[i]);
+        }
+        for (UINT i = 0; i < rectCount; i++)
+        {
+            AddPipelineDirtyRect(frame, rects[i]);
+        }
+
+        // 指针在转换时合成，它的新旧位置都按脏区域处理；只有指针移动的帧没有其他脏矩形
+        ImageRect cursorRect = MakeImageRect(0, 0, 0, 0);
+        if (m_capture.GetCursor(frame.Cursor, frame.CursorX, frame.CursorY))
+        {
+            cursorRect = GetCursorRect(*frame.Cursor, frame.CursorX, frame.CursorY, frame.Width, frame.Height);
+        }
+        if (frame.DirtyRectsValid)
+        {
+            // 移动会把上一帧合成的指针一起搬走，搬到的位置也需要重新转换
+            for (UINT i = 0; i < moveCount; i++)
+            {
+                ImageRect source = GetImageMoveSource(moves[i]);
+                ImageRect carried = IntersectImageRect(m_lastCursorRect, source);
+                if (!IsImageRectEmpty(carried))
+                {
+                    UINT left = carried.Left - source.Left + moves[i].Destination.Left;
+                    UINT top = carried.Top - source.Top + moves[i].Destination.Top;
+                    AddPipelineDirtyRect(frame, MakeImageRect(left, top, left + (carried.Right - carried.Left),
+                                                              top + (carried.Bottom - carried.Top)));
+                }
+            }
+            if (!IsImageRectEmpty(m_lastCursorRect))
+            {
+                AddPipelineDirtyRect(frame, m_lastCursorRect);
+            }
+            if (!IsImageRectEmpty(cursorRect))
+            {
+                AddPipelineDirtyRect(frame, cursorRect);
+            }
+        }
+        m_lastCursorRect = cursorRect;
+        return S_OK;
+    }
+
+private:
+    DXGICapture& m_capture;
+    FramePool& m_framePool;
+    ImageRect m_lastCursorRect;     // 上一帧合成了指针的区域
+};
+
+// 流水线转换阶段：GPU上的BGRA到YUY2转换，输出缓冲区从帧池借用。
+// 帧源提供脏矩形时只转换输出缓冲区上次写入之后变化的区域，滚动和拖动的区域直接在输出上搬移
+// （缓冲区在帧池中轮换，见DirtyRegionTracker）；内容未变的帧直接共享上一帧的输出，不提交GPU工作。
+// 帧带有旋转/翻转时输出为变换后的画面，脏矩形和移动先变换到输出坐标再交给DirtyRegionTracker
+class YUY2ConvertStage : public IFrameConverter
+{
+public:
+    YUY2ConvertStage(BGRAToYUY2Converter& converter, FramePool& framePool)
+        : m_converter(converter), m_framePool(framePool), m_orientation(MakeImageOrientation(ImageRotation::None))
+    {
+        m_updateMoves.reserve(kDirtyHistoryFrames * kMaxDirtyMovesPerFrame);
+        m_updateRects.reserve(kMaxDirtyUpdateRects);
+    }
+
+    HRESULT ConvertFrame(PipelineFrame& frame) override
+    {
+        UINT width;
+        UINT height;
+        GetOrientedSize(frame.Orientation, frame.Width, frame.Height, width, height);
+        bool orientationChanged = frame.Orientation.Rotation != m_orientation.Rotation ||
+                                  frame.Orientation.FlipHorizontal != m_orientation.FlipHorizontal ||
+                                  frame.Orientation.FlipVertical != m_orientation.FlipVertical;
+        if (width != m_tracker.GetWidth() || height != m_tracker.GetHeight() || orientationChanged)
+        {
+            // 分辨率或方向变化后帧池中的旧缓冲区不再使用，内容全部视为未知
+            m_tracker.Initialize(width, height);
+            m_orientation = frame.Orientation;
+        }
+
+        bool oriented = !IsIdentityOrientation(frame.Orientation);
+        const ImageRect* dirtyRects = frame.DirtyRects;
+        const ImageMove* moves = frame.Moves;
+        if (oriented)
+        {
+            ImageOrientationMap map = GetImageOrientationMap(frame.Orientation, frame.Width, frame.Height);
+            for (UINT i = 0; i < frame.DirtyRectCount; i++)
+            {
+                m_orientedRects[i] = TransformImageRect(map, frame.DirtyRects[i]);
+            }
+            for (UINT i = 0; i < frame.MoveCount; i++)
+            {
+                m_orientedMoves[i] = TransformImageMove(map, frame.Moves[i]);
+            }
+            dirtyRects = m_orientedRects;
+            moves = m_orientedMoves;
+        }
+        m_tracker.AddFrame(frame.FrameIndex, dirtyRects, frame.DirtyRectCount, moves, frame.MoveCount,
+                           !frame.DirtyRectsValid);
+
+        // 指针形状只在变化时上传，位置每帧设置
+        if (frame.Cursor != m_cursor)
+        {
+            m_cursor = frame.Cursor;
+            if (m_cursor && FAILED(m_converter.SetCursorShape(*m_cursor)))
+            {
+                m_cursor.reset();
+            }
+        }
+        m_converter.SetCursorPosition(frame.CursorX, frame.CursorY, m_cursor != nullptr);
+
+        // 上一帧的输出已经是最新内容时不再借用和写入新的缓冲区（输出阶段只读取它）
+        if (m_lastOutput.IsValid() && m_tracker.GetUpdateRects(m_lastOutput.GetBuffer(), m_updateMoves, m_updateRects) &&
+            m_updateMoves.empty() && m_updateRects.empty())
+        {
+            frame.Output = m_lastOutput;
+            m_tracker.MarkUpdated(m_lastOutput.GetBuffer());
+            return S_OK;
+        }
+        m_lastOutput.Reset();
+
+        HRESULT hr = m_framePool.AcquireBuffer(BGRAToYUY2Converter::GetOutputBufferDesc(width, height), frame.Output);
+        if (FAILED(hr))
+        {
+            LogError("Failed to create output buffer");
+            return S_FALSE;
+        }
+
+        ID3D11Buffer* outputBuffer = frame.Output.GetBuffer();
+        if (m_tracker.GetUpdateRects(outputBuffer, m_updateMoves, m_updateRects))
+        {
+            hr = m_converter.MoveRegions(outputBuffer, width, height,
+                                         m_updateMoves.data(), (UINT)m_updateMoves.size());
+            if (SUCCEEDED(hr) && oriented)
+            {
+                hr = m_converter.Convert(frame.Source.GetTexture(), outputBuffer, frame.Width, frame.Height,
+                                         frame.Orientation, m_updateRects.data(), (UINT)m_updateRects.size());
+            }
+            else if (SUCCEEDED(hr))
+            {
+                hr = m_converter.Convert(frame.Source.GetTexture(), outputBuffer, frame.Width, frame.Height,
+                                         m_updateRects.data(), (UINT)m_updateRects.size());
+            }
+        }
+        else if (oriented)
+        {
+            hr = m_converter.Convert(frame.Source.GetTexture(), outputBuffer, frame.Width, frame.Height,
+                                     frame.Orientation);
+        }
+        else
+        {
+            hr = m_converter.Convert(frame.Source.GetTexture(), outputBuffer, frame.Width, frame.Height);
+        }
+        if (FAILED(hr))
+        {
+            // 转换可能只完成了一部分，缓冲区内容不再可信
+            m_tracker.Invalidate();
+
+            // 对于SRV创建失败这种临时性错误（桌面切换、分辨率变化等），
+            // 不记录错误，只是静默跳过这一帧
+            if (hr != E_INVALIDARG)
+            {
+                LogError("Failed to convert frame");
+            }
+            return S_FALSE;
+        }
+        m_tracker.MarkUpdated(outputBuffer);
+        m_lastOutput = frame.Output;
+        return S_OK;
+    }
+
+private:
+    BGRAToYUY2Converter& m_converter;
+    FramePool& m_framePool;
+    DirtyRegionTracker m_tracker;
+    FrameHandle m_lastOutput;
+    ImageOrientation m_orientation;
+    std::shared_ptr<const CursorImage> m_cursor;    // 已上传到转换器的指针形状
+    ImageRect m_orientedRects[kMaxPipelineDirtyRects];
+    ImageMove m_orientedMoves[kMaxPipelineMoves];
+    std::vector<ImageMove> m_updateMoves;
+    std::vector<ImageRect> m_updateRects;
+};
+
+// 流水线帧源：把CPU帧源（合成图案、文件回放）的帧上传到帧池中的纹理，替代桌面采集
+class TextureUploadSource : public IFrameSource
+{
+public:
+    TextureUploadSource(IFrameSource* cpuSource, BGRAToYUY2Converter& converter, FramePool& framePool)
+        : m_cpuSource(cpuSource), m_converter(converter), m_framePool(framePool) {}
+
+    HRESULT ReadFrame(PipelineFrame& frame) override
+    {
+        HRESULT hr = m_cpuSource->ReadFrame(frame);
+        if (hr != S_OK)
+        {
+            return hr;
+        }
+
+        FrameHandle texture;
+        hr = m_framePool.AcquireTexture(BGRAToYUY2Converter::GetInputTextureDesc(frame.Width, frame.Height), texture);
+        if (SUCCEEDED(hr))
+        {
+            hr = m_converter.WriteBGRAData(texture.GetTexture(), frame.SourceView);
+        }
+        if (FAILED(hr))
+        {
+            LogError("Failed to upload source frame");
+            return hr;
+        }
+
+        // CPU帧上传后立即归还帧池
+        frame.Source = std::move(texture);
+        frame.SourceView = ImageView();
+        return S_OK;
+    }
+
+private:
+    IFrameSource* m_cpuSource;
+    BGRAToYUY2Converter& m_converter;
+    FramePool& m_framePool;
+};
+
+// Demo本身是流水线的输出阶段：保存调试帧并定期验证转换结果
+class Demo : public IFrameSink
+{
+public:
+    // sourceSpec为空时采集桌面，否则为合成图案名（bars/checker/noise）或回放文件路径
+    Demo(ConversionMode mode, double targetFrameRate, const std::string& sourceSpec)
+        : m_mode(mode), m_targetFrameRate(targetFrameRate), m_sourceSpec(sourceSpec),
+          m_device(nullptr), m_context(nullptr), m_frameCount(0) {}
 
     int Run()
     {
@@ -34,6 +304,14 @@ public:
             {
                 return RunNV12ToRGBADemo();
             }
+            else if (m_mode == ConversionMode::BGRA_TO_NV12)
+            {
+                return RunBGRAToNV12Demo();
+            }
+            else if (m_mode == ConversionMode::HDR_TO_P010)
+            {
+                return RunHDRToP010Demo();
+            }
             else
             {
                 LogError("Unknown conversion mode");
@@ -50,11 +328,28 @@ public:
 private:
     int RunBGRAToYUY2Demo()
     {
-        // 初始化DXGI捕获
-        ThrowIfFailed(m_capture.Initialize(), "Failed to initialize DXGI capture");
+        ID3D11Device* device = nullptr;
+        ID3D11DeviceContext* context = nullptr;
+        if (m_sourceSpec.empty())
+        {
+            // 初始化DXGI捕获
+            ThrowIfFailed(m_capture.Initialize(), "Failed to initialize DXGI capture");
+            device = m_capture.GetDevice();
+            context = m_capture.GetContext();
+        }
+        else
+        {
+            // 合成图案/文件回放不需要桌面复制，只创建设备
+            ThrowIfFailed(InitializeDirectX(), "Failed to initialize DirectX");
+            device = m_device;
+            context = m_context;
+        }
+
+        // 采集纹理和转换输出缓冲区都从帧池借用
+        ThrowIfFailed(m_framePool.Initialize(device), "Failed to initialize frame pool");
 
         // 初始化BGRA到YUY2转换器
-        ThrowIfFailed(m_bgraToYuy2Converter.Initialize(m_capture.GetDevice(), m_capture.GetContext()),
+        ThrowIfFailed(m_bgraToYuy2Converter.Initialize(device, context),
                      "Failed to initialize BGRA to YUY2 converter");
 
         LogMessage("BGRA to YUY2 demo initialized successfully. Starting capture loop...");
@@ -85,114 +380,209 @@ private:
         return 0;
     }
 
-    void MainLoop()
+    int RunBGRAToNV12Demo()
     {
-        auto lastStatsTime = std::chrono::steady_clock::now();
-        const auto statsInterval = std::chrono::seconds(5); // 每5秒输出统计信息
-
-        while (true)
+        // 初始化DirectX设备
+        if (FAILED(InitializeDirectX()))
         {
-            auto frameStart = std::chrono::high_resolution_clock::now();
+            LogError("Failed to initialize DirectX");
+            return -1;
+        }
 
-            if (ProcessFrame())
-            {
-                m_frameCount++;
-                
-                auto frameEnd = std::chrono::high_resolution_clock::now();
-                auto frameDuration = std::chrono::duration_cast<std::chrono::microseconds>(
-                    frameEnd - frameStart);
-                m_totalFrameTime += frameDuration.count();
-
-                // 输出统计信息
-                auto currentTime = std::chrono::steady_clock::now();
-                if (currentTime - lastStatsTime >= statsInterval)
-                {
-                    PrintStatistics();
-                    lastStatsTime = currentTime;
-                }
-            }
+        // 初始化BGRA到NV12转换器
+        ThrowIfFailed(m_bgraToNv12Converter.Initialize(m_device, m_context),
+                     "Failed to initialize BGRA to NV12 converter");
 
-            // 限制帧率，避免100% CPU使用
-            std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60fps
-        }
+        LogMessage("BGRA to NV12 demo initialized successfully. Starting conversion test...");
+
+        // 运行BGRA到NV12转换测试
+        RunBGRAToNV12ConversionTest();
+        return 0;
     }
 
-    bool ProcessFrame()
+    int RunHDRToP010Demo()
     {
-        ID3D11Texture2D* capturedTexture = nullptr;
-        UINT width, height;
+        // 按桌面的实际格式采集，HDR桌面不经过系统的8位转换
+        ThrowIfFailed(m_capture.Initialize(true), "Failed to initialize DXGI capture");
+        ThrowIfFailed(m_framePool.Initialize(m_capture.GetDevice()), "Failed to initialize frame pool");
 
-        // 捕获帧
-        HRESULT hr = m_capture.CaptureFrame(&capturedTexture, width, height);
-        if (hr == DXGI_ERROR_WAIT_TIMEOUT)
+        HDRInputFormat inputFormat;
+        if (!m_capture.GetHDRInputFormat(inputFormat))
         {
-            return false; // 没有新帧
-        }
-        if (FAILED(hr))
-        {
-            LogError("Failed to capture frame");
-            return false;
+            LogError("Desktop is captured as B8G8R8A8; turn on HDR for the display to capture 10-bit frames");
+            return -1;
         }
 
-        // 创建输出缓冲区
-        ID3D11Buffer* outputBuffer = nullptr;
-        hr = m_bgraToYuy2Converter.CreateOutputBuffer(width, height, &outputBuffer);
-        if (FAILED(hr))
+        CpuConversionOptions options;
+        options.ThreadCount = 0;
+        CpuHDRToYUV10Converter converter;
+        ThrowIfFailed(converter.Initialize(options), "Failed to initialize HDR to P010 converter");
+
+        LogMessage(std::string("HDR to P010 demo initialized successfully. Capture format: ") +
+                  (inputFormat == HDRInputFormat::R16G16B16A16Float ? "R16G16B16A16_FLOAT" : "R10G10B10A2_UNORM"));
+
+        // 采集固定帧数，在CPU上转换为P010（BT.2020、PQ）并统计转换耗时
+        const UINT kDemoFrames = 120;
+        ID3D11DeviceContext* context = m_capture.GetContext();
+        std::vector<BYTE> p010Data;
+        ImageView p010View = {};
+        UINT convertedFrames = 0;
+        double convertMs = 0.0;
+        while (convertedFrames < kDemoFrames)
         {
-            SAFE_RELEASE(capturedTexture);
-            LogError("Failed to create output buffer");
-            return false;
-        }
+            FrameHandle frame;
+            UINT width = 0;
+            UINT height = 0;
+            HRESULT hr = m_capture.CaptureFrame(m_framePool, frame, width, height);
+            if (hr == DXGI_ERROR_WAIT_TIMEOUT)
+                continue;
+            ThrowIfFailed(hr, "Failed to capture frame");
+
+            // staging纹理与采集纹理格式相同，从帧池借用
+            D3D11_TEXTURE2D_DESC stagingDesc;
+            frame.GetTexture()->GetDesc(&stagingDesc);
+            stagingDesc.Usage = D3D11_USAGE_STAGING;
+            stagingDesc.BindFlags = 0;
+            stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+            stagingDesc.MiscFlags = 0;
+            FrameHandle stagingFrame;
+            ThrowIfFailed(m_framePool.AcquireTexture(stagingDesc, stagingFrame), "Failed to create staging texture");
+            context->CopyResource(stagingFrame.GetTexture(), frame.GetTexture());
+
+            if (p010View.Width != width || p010View.Height != height)
+            {
+                ThrowIfFailed(converter.CreateOutputBuffer(width, height, 0, YUV10Format::P010, p010Data, p010View),
+                              "Failed to allocate P010 buffer");
+            }
 
-        // 保存有效帧的BGRA原始数据用于调试（跳过前几个可能为空的帧）
-        if (m_frameCount == 30)  // 保存第4帧，通常这时数据已经稳定
-        {
-            SaveBGRAToFile(capturedTexture, width, height);
-            
-            // 调试信息已简化
+            D3D11_MAPPED_SUBRESOURCE mappedResource;
+            ThrowIfFailed(context->Map(stagingFrame.GetTexture(), 0, D3D11_MAP_READ, 0, &mappedResource),
+                          "Failed to map captured frame");
+            ImageView source = MakeSinglePlaneImageView(static_cast<BYTE*>(mappedResource.pData), width, height,
+                                                        width * GetHDRInputBytesPerPixel(inputFormat),
+                                                        mappedResource.RowPitch);
+            auto startTime = std::chrono::high_resolution_clock::now();
+            hr = converter.Convert(source, inputFormat, p010View, YUV10Format::P010);
+            auto endTime = std::chrono::high_resolution_clock::now();
+            context->Unmap(stagingFrame.GetTexture(), 0);
+            ThrowIfFailed(hr, "HDR to P010 conversion failed");
+
+            convertMs += std::chrono::duration<double, std::milli>(endTime - startTime).count();
+            convertedFrames++;
         }
 
-        // 执行转换
-        hr = m_bgraToYuy2Converter.Convert(capturedTexture, outputBuffer, width, height);
-        if (FAILED(hr))
+        // 画面中心像素的10位Y值（码值在16位样本的高10位）
+        const ImagePlane& yPlane = p010View.Planes[0];
+        UINT16 centerY;
+        memcpy(&centerY, yPlane.Data + (size_t)(p010View.Height / 2) * yPlane.Pitch + (p010View.Width / 2) * 2,
+               sizeof(centerY));
+        LogMessage("Converted " + std::to_string(convertedFrames) + " HDR frames to P010, average " +
+                  std::to_string(convertMs / convertedFrames) + " ms per frame (" +
+                  GetSimdLevelName(converter.GetSimdLevel()) + ", " + std::to_string(converter.GetThreadCount()) +
+                  " threads), center Y = " + std::to_string(centerY >> 6));
+        return 0;
+    }
+
+    void MainLoop()
+    {
+        // 采集、转换和输出（验证）在各自的线程上运行，
+        // 采集第N+1帧的同时转换第N帧，帧率由最慢的阶段决定；
+        // 采集按目标帧率的绝对期限限速，而不是每帧处理完再sleep固定时长
+        DesktopCaptureSource desktopSource(m_capture, m_framePool);
+        SyntheticFrameSource syntheticSource;
+        FileReplaySource replaySource;
+        IFrameSource* cpuSource = nullptr;
+        if (!m_sourceSpec.empty())
         {
-            SAFE_RELEASE(capturedTexture);
-            SAFE_RELEASE(outputBuffer);
-            
-            // 对于SRV创建失败这种临时性错误，不退出程序，只是跳过这一帧
-            if (hr == E_INVALIDARG)
+            SyntheticSourceOptions syntheticOptions;
+            if (SyntheticFrameSource::ParsePattern(m_sourceSpec, syntheticOptions.Pattern))
             {
-                // 这通常是临时性问题，如桌面切换、分辨率变化等
-                // 不记录错误，只是静默跳过这一帧
-                return false;
+                ThrowIfFailed(syntheticSource.Initialize(&m_framePool, syntheticOptions),
+                             "Failed to initialize synthetic source");
+                cpuSource = &syntheticSource;
             }
             else
             {
-                LogError("Failed to convert frame");
-                return false;
+                ThrowIfFailed(replaySource.Initialize(m_sourceSpec, &m_framePool), "Failed to open replay file");
+                cpuSource = &replaySource;
+            }
+        }
+        // 合成图案和文件回放大多不提供脏矩形，由分块哈希检测变化的区域
+        TileDamageSource damageSource;
+        if (cpuSource)
+        {
+            ThrowIfFailed(damageSource.Initialize(cpuSource), "Failed to initialize tile damage detection");
+            cpuSource = &damageSource;
+        }
+        TextureUploadSource uploadSource(cpuSource, m_bgraToYuy2Converter, m_framePool);
+        IFrameSource* source = cpuSource ? static_cast<IFrameSource*>(&uploadSource) : &desktopSource;
+
+        YUY2ConvertStage convertStage(m_bgraToYuy2Converter, m_framePool);
+        IFrameSink* sinks[] = { this };
+
+        FramePipelineOptions options;
+        options.DropFramesWhenFull = true;  // 实时采集：转换跟不上时丢弃新帧，避免延迟累积
+        options.TargetFrameRate = m_targetFrameRate;
+
+        FramePipeline pipeline;
+        ThrowIfFailed(pipeline.Initialize(source, &convertStage, sinks, 1, options),
+                     "Failed to initialize frame pipeline");
+        ThrowIfFailed(pipeline.Start(), "Failed to start frame pipeline");
+
+        const auto statsInterval = std::chrono::seconds(5); // 每5秒输出统计信息
+        FramePipelineStats lastStats = pipeline.GetStats();
+        auto lastStatsTime = std::chrono::steady_clock::now();
+
+        while (pipeline.IsRunning())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+            auto currentTime = std::chrono::steady_clock::now();
+            if (currentTime - lastStatsTime >= statsInterval)
+            {
+                FramePipelineStats stats = pipeline.GetStats();
+                PrintStatistics(lastStats, stats,
+                                std::chrono::duration<double>(currentTime - lastStatsTime).count());
+                lastStats = stats;
+                lastStatsTime = currentTime;
             }
         }
 
+        ThrowIfFailed(pipeline.Wait(), "Frame pipeline stopped");
+    }
+
+    // 输出线程：处理转换完成的帧
+    HRESULT WriteFrame(const PipelineFrame& frame) override
+    {
+        // 保存有效帧的BGRA原始数据用于调试（跳过前几个可能为空的帧）
+        if (m_frameCount == 30)
+        {
+            SaveBGRAToFile(frame.Source.GetTexture(), frame.Width, frame.Height);
+        }
+
         // 可选：读取转换后的数据进行验证或保存
         if (m_frameCount == 30 || m_frameCount % 300 == 0) // 第30帧和每300帧验证一次
         {
-            ValidateConversion(outputBuffer, width, height);
+            UINT width;
+            UINT height;
+            GetOrientedSize(frame.Orientation, frame.Width, frame.Height, width, height);
+            ValidateConversion(frame.Output.GetBuffer(), width, height);
         }
 
-        SAFE_RELEASE(capturedTexture);
-        SAFE_RELEASE(outputBuffer);
-
-        return true;
+        m_frameCount++;
+        return S_OK;
     }
 
     void ValidateConversion(ID3D11Buffer* buffer, UINT width, UINT height)
     {
-        BYTE* yuy2Data = nullptr;
-        UINT dataSize = 0;
-
-        HRESULT hr = m_bgraToYuy2Converter.ReadOutputBuffer(buffer, width, height, &yuy2Data, dataSize);
-        if (SUCCEEDED(hr) && yuy2Data)
+        // 直接在映射的staging buffer上验证，不分配和复制整帧
+        ImageView yuy2View;
+        HRESULT hr = m_bgraToYuy2Converter.MapOutputBuffer(buffer, width, height, yuy2View);
+        if (SUCCEEDED(hr))
         {
+            const BYTE* yuy2Data = yuy2View.Planes[0].Data;
+            UINT dataSize = static_cast<UINT>(GetImagePlaneSize(yuy2View.Planes[0]));
+
             // 验证YUY2数据的有效性
             bool isValid = ValidateYUY2Data(yuy2Data, dataSize, width, height);
             
@@ -218,7 +608,7 @@ private:
                 LogError("YUY2 conversion validation: FAILED");
             }
 
-            delete[] yuy2Data;
+            m_bgraToYuy2Converter.UnmapOutputBuffer();
         }
         else
         {
@@ -348,21 +738,29 @@ private:
                 std::ofstream file(filename, std::ios::binary);
                 if (file.is_open())
                 {
-                    // 保存BGRA数据
-                    UINT dataSize = width * height * 4;
-                    file.write(reinterpret_cast<const char*>(mappedResource.pData), dataSize);
+                    // 保存BGRA数据（Map返回的RowPitch可能大于width * 4，逐行写出有效数据）
+                    ImageView view = MakeBGRAImageView(static_cast<BYTE*>(mappedResource.pData),
+                                                       width, height, mappedResource.RowPitch);
+                    const ImagePlane& plane = view.Planes[0];
+                    for (UINT y = 0; y < height; y++)
+                    {
+                        file.write(reinterpret_cast<const char*>(plane.Data + (size_t)y * plane.Pitch), plane.RowBytes);
+                    }
                     file.close();
                     LogMessage("Saved BGRA frame to: " + filename);
 
                     // 检查BGRA数据有效性
-                    BYTE* pixelData = (BYTE*)mappedResource.pData;
                     int nonZeroPixels = 0;
                     int totalPixels = width * height;
-                    for (UINT i = 0; i < dataSize; i += 4)
+                    for (UINT y = 0; y < height; y++)
                     {
-                        if (pixelData[i] != 0 || pixelData[i+1] != 0 || pixelData[i+2] != 0)
+                        const BYTE* pixelData = plane.Data + (size_t)y * plane.Pitch;
+                        for (UINT i = 0; i < plane.RowBytes; i += 4)
                         {
-                            nonZeroPixels++;
+                            if (pixelData[i] != 0 || pixelData[i+1] != 0 || pixelData[i+2] != 0)
+                            {
+                                nonZeroPixels++;
+                            }
                         }
                     }
                     LogMessage("[BGRA] Saved frame with " + std::to_string(nonZeroPixels) + "/" + std::to_string(totalPixels) + 
@@ -381,18 +779,44 @@ private:
         SAFE_RELEASE(device);
     }
 
-    void PrintStatistics()
+    static double AverageStageMs(const PipelineStageStats& previous, const PipelineStageStats& current)
     {
-        if (m_frameCount > 0)
+        unsigned long long frames = current.Frames - previous.Frames;
+        return frames ? (current.BusyMicroseconds - previous.BusyMicroseconds) / 1000.0 / frames : 0.0;
+    }
+
+    // 统计区间内的输出帧率和各阶段平均耗时，帧率应接近最慢阶段的耗时所决定的上限
+    void PrintStatistics(const FramePipelineStats& previous, const FramePipelineStats& current, double seconds)
+    {
+        unsigned long long frames = current.Sinks[0].Frames - previous.Sinks[0].Frames;
+        if (frames == 0)
         {
-            double avgFrameTime = static_cast<double>(m_totalFrameTime) / m_frameCount / 1000.0; // ms
-            double fps = m_frameCount * 1000000.0 / m_totalFrameTime; // frames per second
+            return;
+        }
+
+        double latencyMs = (current.Sinks[0].LatencyMicroseconds - previous.Sinks[0].LatencyMicroseconds)
+                           / 1000.0 / frames;
 
-            std::cout << "[STATS] Frames: " << m_frameCount 
-                      << ", Avg frame time: " << std::fixed << std::setprecision(2) 
-                      << avgFrameTime << "ms"
-                      << ", FPS: " << std::setprecision(1) << fps << std::endl;
+        std::cout << "[STATS] Frames: " << current.Sinks[0].Frames
+                  << ", FPS: " << std::fixed << std::setprecision(1) << frames / seconds
+                  << ", Stage times: capture " << std::setprecision(2)
+                  << AverageStageMs(previous.Source, current.Source) << "ms"
+                  << ", convert " << AverageStageMs(previous.Convert, current.Convert) << "ms"
+                  << ", output " << AverageStageMs(previous.Sinks[0], current.Sinks[0]) << "ms"
+                  << ", Latency: " << latencyMs << "ms"
+                  << ", Dropped: " << current.DroppedFrames;
+
+        // 采集阶段错过的帧期限（采集或上游处理超过一个帧周期）
+        if (m_targetFrameRate > 0.0)
+        {
+            std::cout << ", Missed deadlines: " << current.Pacing.MissedDeadlines
+                      << " (max wake-up lateness " << current.Pacing.MaxLatenessMicroseconds << "us)";
         }
+
+        // 帧池稳定后分配次数不再增长
+        FramePoolStats poolStats = m_framePool.GetStats();
+        std::cout << ", Pool frames: " << poolStats.FrameCount
+                  << ", Pool allocations: " << poolStats.AllocationCount << std::endl;
     }
 
     HRESULT InitializeDirectX()
@@ -422,6 +846,14 @@ private:
             return hr;
         }
 
+        // 流水线的帧源和转换阶段在不同线程上使用即时上下文
+        ID3D10Multithread* multithread = nullptr;
+        if (SUCCEEDED(m_device->QueryInterface(__uuidof(ID3D10Multithread), (void**)&multithread)))
+        {
+            multithread->SetMultithreadProtected(TRUE);
+            multithread->Release();
+        }
+
         LogMessage("DirectX device initialized successfully");
         return S_OK;
     }
@@ -492,6 +924,124 @@ private:
         SAFE_RELEASE(rgbaTexture);
     }
 
+    void RunBGRAToNV12ConversionTest()
+    {
+        const UINT testWidth = 1920;
+        const UINT testHeight = 1080;
+
+        LogMessage("Starting BGRA to NV12 conversion test...");
+        LogMessage("Test resolution: " + std::to_string(testWidth) + "x" + std::to_string(testHeight));
+
+        // 用彩条图案创建测试BGRA纹理
+        std::vector<BYTE> testBGRAData((size_t)testWidth * testHeight * 4);
+        ImageView bgraView = MakeBGRAImageView(testBGRAData.data(), testWidth, testHeight);
+        SyntheticFrameSource::RenderFrame(SyntheticPattern::ColorBars, 0, bgraView);
+
+        D3D11_TEXTURE2D_DESC texDesc = {};
+        texDesc.Width = testWidth;
+        texDesc.Height = testHeight;
+        texDesc.MipLevels = 1;
+        texDesc.ArraySize = 1;
+        texDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+        texDesc.SampleDesc.Count = 1;
+        texDesc.Usage = D3D11_USAGE_DEFAULT;
+        texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+        D3D11_SUBRESOURCE_DATA initData = {};
+        initData.pSysMem = testBGRAData.data();
+        initData.SysMemPitch = testWidth * 4;
+
+        ID3D11Texture2D* bgraTexture = nullptr;
+        HRESULT hr = m_device->CreateTexture2D(&texDesc, &initData, &bgraTexture);
+        if (FAILED(hr))
+        {
+            LogError("Failed to create BGRA test texture");
+            return;
+        }
+
+        // 创建NV12输出缓冲区
+        ID3D11Buffer* nv12Buffer = nullptr;
+        hr = m_bgraToNv12Converter.CreateOutputBuffer(testWidth, testHeight, &nv12Buffer);
+        if (FAILED(hr))
+        {
+            LogError("Failed to create NV12 output buffer");
+            SAFE_RELEASE(bgraTexture);
+            return;
+        }
+
+        // 执行转换
+        auto startTime = std::chrono::high_resolution_clock::now();
+        hr = m_bgraToNv12Converter.Convert(bgraTexture, nv12Buffer, testWidth, testHeight);
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        if (SUCCEEDED(hr))
+        {
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+            LogMessage("BGRA to NV12 conversion completed successfully!");
+            LogMessage("Conversion time: " + std::to_string(duration.count() / 1000.0) + "ms");
+
+            // 验证转换结果
+            ValidateNV12Output(nv12Buffer, testBGRAData, testWidth, testHeight);
+        }
+        else
+        {
+            LogError("BGRA to NV12 conversion failed");
+        }
+
+        SAFE_RELEASE(nv12Buffer);
+        SAFE_RELEASE(bgraTexture);
+    }
+
+    void ValidateNV12Output(ID3D11Buffer* nv12Buffer, const std::vector<BYTE>& bgraData, UINT width, UINT height)
+    {
+        // 读回GPU结果（紧凑布局）
+        std::vector<BYTE> gpuNV12(CpuBGRAToNV12Converter::GetOutputSize(width, height));
+        HRESULT hr = m_bgraToNv12Converter.ReadOutputBuffer(nv12Buffer, width, height,
+                                                            MakeNV12ImageView(gpuNV12.data(), width, height));
+        if (FAILED(hr))
+        {
+            LogError("Failed to read back NV12 output");
+            return;
+        }
+
+        // 与CPU浮点参考路径（与shader相同的公式）比较，GPU浮点舍入允许相差1
+        CpuConversionOptions options;
+        options.Precision = ConversionPrecision::FloatReference;
+        options.ThreadCount = 1;
+        CpuBGRAToNV12Converter reference;
+        std::vector<BYTE> cpuNV12;
+        if (FAILED(reference.Initialize(options)) ||
+            FAILED(reference.CreateOutputBuffer(width, height, cpuNV12)) ||
+            FAILED(reference.Convert(bgraData.data(), cpuNV12.data(), width, height)))
+        {
+            LogError("CPU reference conversion failed");
+            return;
+        }
+
+        int maxDiff = 0;
+        size_t diffCount = 0;
+        for (size_t i = 0; i < gpuNV12.size(); i++)
+        {
+            int diff = std::abs((int)gpuNV12[i] - (int)cpuNV12[i]);
+            if (diff != 0)
+            {
+                diffCount++;
+                maxDiff = (std::max)(maxDiff, diff);
+            }
+        }
+
+        LogMessage("NV12 output differs from CPU reference in " + std::to_string(diffCount) +
+                  " bytes, max deviation " + std::to_string(maxDiff));
+        if (maxDiff <= 1)
+        {
+            LogMessage("NV12 output validation: PASSED");
+        }
+        else
+        {
+            LogError("NV12 output validation: FAILED");
+        }
+    }
+
     std::vector<BYTE> CreateTestNV12Data(UINT width, UINT height)
     {
         UINT yPlaneSize = width * height;
@@ -641,23 +1191,46 @@ private:
     }
 
     ConversionMode m_mode;
+    double m_targetFrameRate;   // 采集帧率，0表示不限速
+    std::string m_sourceSpec;
     DXGICapture m_capture;
+    FramePool m_framePool;
     BGRAToYUY2Converter m_bgraToYuy2Converter;
+    BGRAToNV12Converter m_bgraToNv12Converter;
     NV12ToRGBAConverter m_nv12ToRgbaConverter;
     ID3D11Device* m_device;
     ID3D11DeviceContext* m_context;
-    UINT m_frameCount;
-    long long m_totalFrameTime; // microseconds
+    UINT m_frameCount;  // 只在输出线程上访问
 };
 
-int main()
+// 用法: BGRAToYUY2Demo [targetFps] [bars|checker|noise|desktop|file.bgra]
+//   targetFps：采集目标帧率，默认60，0表示不限速（如120/144Hz显示器）
+//   第二个参数用合成图案或回放SaveBGRAToFile保存的文件代替桌面采集，直接运行BGRA到YUY2模式
+int main(int argc, char* argv[])
 {
+    double targetFrameRate = argc > 1 ? std::atof(argv[1]) : 60.0;
+    if (targetFrameRate < 0.0)
+    {
+        LogError("Invalid target frame rate. Defaulting to 60 fps");
+        targetFrameRate = 60.0;
+    }
+
     LogMessage("DirectX Color Conversion Demo Starting...");
+
+    if (argc > 2)
+    {
+        LogMessage("Selected: BGRA to YUY2 conversion from " + std::string(argv[2]));
+        Demo demo(ConversionMode::BGRA_TO_YUY2, targetFrameRate, argv[2]);
+        return demo.Run();
+    }
+
     LogMessage("Available conversion modes:");
     LogMessage("1. BGRA to YUY2 (Desktop capture to YUV format)");
     LogMessage("2. NV12 to RGBA (YUV format to RGB format)");
+    LogMessage("3. BGRA to NV12 (RGB format to encoder input format)");
+    LogMessage("4. HDR to P010 (10-bit HDR desktop capture to 10-bit encoder input, CPU)");
     
-    std::cout << "Please select conversion mode (1 or 2): ";
+    std::cout << "Please select conversion mode (1, 2, 3 or 4): ";
     int choice;
     std::cin >> choice;
     
@@ -672,12 +1245,20 @@ int main()
         mode = ConversionMode::NV12_TO_RGBA;
         LogMessage("Selected: NV12 to RGBA conversion");
         break;
+    case 3:
+        mode = ConversionMode::BGRA_TO_NV12;
+        LogMessage("Selected: BGRA to NV12 conversion");
+        break;
+    case 4:
+        mode = ConversionMode::HDR_TO_P010;
+        LogMessage("Selected: HDR to P010 conversion");
+        break;
     default:
         LogError("Invalid choice. Defaulting to BGRA to YUY2 conversion");
         mode = ConversionMode::BGRA_TO_YUY2;
         break;
     }
     
-    Demo demo(mode);
+    Demo demo(mode, targetFrameRate, std::string());
     return demo.Run();
 }
\ No newline at end of file